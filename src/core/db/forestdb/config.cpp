@@ -22,6 +22,7 @@ extern "C" {
 #include "sds.h"
 }
 
+#include <common/convert2string.h>
 #include <common/file_system/types.h>  // for prepare_path
 #include <common/sprintf.h>            // for MemSPrintf
 
@@ -44,6 +45,16 @@ Config ParseOptions(int argc, char** argv) {
       cfg.db_path = argv[++i];
     } else if (!strcmp(argv[i], "-n") && !lastarg) {
       cfg.db_name = argv[++i];
+    } else if (!strcmp(argv[i], "-b") && !lastarg) {
+      unsigned int write_batch_size;
+      if (common::ConvertFromString(argv[++i], &write_batch_size) && write_batch_size) {
+        cfg.write_batch_size = write_batch_size;
+      }
+    } else if (!strcmp(argv[i], "-w") && !lastarg) {
+      unsigned int wal_flush;
+      if (common::ConvertFromString(argv[++i], &wal_flush)) {
+        cfg.wal_flush_before_commit = wal_flush != 0;
+      }
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -64,7 +75,11 @@ Config ParseOptions(int argc, char** argv) {
 }  // namespace
 
 const std::string Config::default_db_name = "default";
-Config::Config() : LocalConfig(common::file_system::prepare_path("~/test.forestdb")), db_name(default_db_name) {}
+Config::Config()
+    : LocalConfig(common::file_system::prepare_path("~/test.forestdb")),
+      db_name(default_db_name),
+      write_batch_size(default_write_batch_size),
+      wal_flush_before_commit(true) {}
 
 }  // namespace forestdb
 }  // namespace core
@@ -80,6 +95,11 @@ std::string ConvertToString(const fastonosql::core::forestdb::Config& conf) {
     argv.push_back(conf.db_name);
   }
 
+  argv.push_back("-b");
+  argv.push_back(common::ConvertToString(conf.write_batch_size));
+  argv.push_back("-w");
+  argv.push_back(common::ConvertToString(conf.wal_flush_before_commit ? 1u : 0u));
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -26,9 +26,12 @@ namespace forestdb {
 
 struct Config : public LocalConfig {
   static const std::string default_db_name;
+  enum { default_write_batch_size = 10000 };
   Config();
 
   std::string db_name;
+  unsigned int write_batch_size;  // write operations per commit for bulk writes
+  bool wal_flush_before_commit;   // flush WAL into main index on every commit
 };
 
 }  // namespace forestdb
@@ -20,6 +20,10 @@
 
 #include <libforestdb/forestdb.h>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include <common/file_system/file_system.h>
 #include <common/file_system/string_path_utils.h>
 #include <common/utils.h>  // for c_strornull
@@ -27,6 +31,7 @@
 #include "core/db/forestdb/command_translator.h"
 #include "core/db/forestdb/database_info.h"
 #include "core/db/forestdb/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 namespace fastonosql {
 namespace core {
@@ -176,6 +181,16 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         INFINITE_COMMAND_ARGS,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Delete),
+                                          CommandHolder(FORESTDB_MSET_COMMAND,
+                                                        "<key> <value> [key value ...]",
+                                                        "Set multiple keys to multiple values, "
+                                                        "written in batches of write batch size",
+                                                        UNDEFINED_SINCE,
+                                                        UNDEFINED_EXAMPLE_STR,
+                                                        2,
+                                                        INFINITE_COMMAND_ARGS,
+                                                        CommandInfo::Native,
+                                                        &CommandsApi::Mset),
                                           CommandHolder(DB_QUIT_COMMAND,
                                                         "-",
                                                         "Close the connection",
@@ -271,6 +286,61 @@ fdb_status forestdb_open(fdb** context, const char* db_path, fdb_config* fconfig
   return rc;
 }
 
+typedef std::function<fdb_status(fdb_kvs_handle*, size_t)> write_op_t;
+
+// runs count write operations, commits every batch_size of them and after the last one
+fdb_status forestdb_write_batched(fdb* context, size_t batch_size, size_t count, write_op_t op) {
+  for (size_t i = 0; i < count; ++i) {
+    fdb_status rc = op(context->kvs, i);
+    if (rc != FDB_RESULT_SUCCESS) {
+      return rc;
+    }
+
+    if ((i + 1) % batch_size == 0 || i + 1 == count) {
+      rc = fdb_commit(context->handle, FDB_COMMIT_NORMAL);
+      if (rc != FDB_RESULT_SUCCESS) {
+        return rc;
+      }
+    }
+  }
+
+  return FDB_RESULT_SUCCESS;
+}
+
+// collects up to batch_size live keys, deletes them and commits, until store is empty
+fdb_status forestdb_flush(fdb* context, size_t batch_size) {
+  std::vector<std::string> keys;
+  while (true) {
+    fdb_iterator* it = NULL;
+    fdb_status rc = fdb_iterator_init(context->kvs, &it, NULL, 0, NULL, 0, FDB_ITR_NO_DELETES);
+    if (rc == FDB_RESULT_ITERATOR_FAIL) {  // nothing to iterate
+      return FDB_RESULT_SUCCESS;
+    } else if (rc != FDB_RESULT_SUCCESS) {
+      return rc;
+    }
+
+    keys.clear();
+    do {
+      fdb_doc* doc = NULL;
+      if (fdb_iterator_get(it, &doc) != FDB_RESULT_SUCCESS) {
+        break;
+      }
+
+      keys.push_back(std::string(static_cast<const char*>(doc->key), doc->keylen));
+      fdb_doc_free(doc);
+    } while (keys.size() < batch_size && fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
+    fdb_iterator_close(it);
+
+    auto del = [&keys](fdb_kvs_handle* kvs, size_t index) {
+      return fdb_del_kv(kvs, keys[index].data(), keys[index].size());
+    };
+    rc = forestdb_write_batched(context, batch_size, keys.size(), del);
+    if (rc != FDB_RESULT_SUCCESS || keys.size() < batch_size) {
+      return rc;
+    }
+  }
+}
+
 void forestdb_close(fdb** context) {
   if (!context) {
     return;
@@ -360,6 +430,9 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
     return common::make_error(common::MemSPrintf("Invalid input path: (%s), please create folder.", folder));
   }
 
+  // WAL has to hold whole write batch, otherwise it is flushed into main index in the middle of the batch
+  fconfig.wal_threshold = std::max<uint64_t>(fconfig.wal_threshold, config.write_batch_size);
+  fconfig.wal_flush_before_commit = config.wal_flush_before_commit;
   // fconfig.flags = FDB_OPEN_FLAG_CREATE;
   const char* db_path_ptr = db_path.c_str();  // start point must be file
   fdb_status st = forestdb_open(&lcontext, db_path_ptr, &fconfig);
@@ -420,6 +493,39 @@ common::Error DBConnection::Info(const std::string& args, ServerInfo::Stats* sta
   return common::Error();
 }
 
+common::Error DBConnection::Mset(const NDbKValues& keys, NDbKValues* added_keys) {
+  if (!added_keys) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  auto conf = GetConfig();
+  auto set = [&keys](fdb_kvs_handle* kvs, size_t index) {
+    const readable_string_t key_slice = keys[index].GetKey().GetKey().GetData();
+    const readable_string_t value_raw = keys[index].GetValue().GetValue().GetData();
+    return fdb_set_kv(kvs, key_slice.data(), key_slice.size(), value_raw.data(), value_raw.size());
+  };
+
+  err = CheckResultCommand(FORESTDB_MSET_COMMAND,
+                           forestdb_write_batched(connection_.handle_, conf->write_batch_size, keys.size(), set));
+  if (err) {
+    return err;
+  }
+
+  *added_keys = keys;
+  if (client_) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      client_->OnAddedKey(keys[i]);
+    }
+  }
+  return common::Error();
+}
+
 common::Error DBConnection::SetInner(const key_t& key, const value_t& value) {
   const readable_string_t key_slice = key.GetData();
   const readable_string_t value_raw = value.GetData();
@@ -438,6 +544,7 @@ common::Error DBConnection::GetInner(const key_t& key, std::string* ret_val) {
   }
 
   *ret_val = std::string(reinterpret_cast<const char*>(value_out), valuelen_out);
+  fdb_free_block(value_out);
   return common::Error();
 }
 
@@ -458,11 +565,29 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
                                      keys_limit_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      cursor_t* cursor_out) {
+  return ScanFilteredImpl(cursor_in, pattern, count_keys, KeysFilter(), keys_out, cursor_out);
+}
+
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsPlainStringsAllowed()) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   fdb_iterator* it = NULL;
   fdb_iterator_opt_t opt = FDB_ITR_NONE;
+  const GlobPattern glob(pattern);
+  const std::string prefix = glob.GetPrefix();
 
-  common::Error err =
-      CheckResultCommand(DB_SCAN_COMMAND, fdb_iterator_init(connection_.handle_->kvs, &it, NULL, 0, NULL, 0, opt));
+  common::Error err = CheckResultCommand(
+      DB_SCAN_COMMAND, fdb_iterator_init(connection_.handle_->kvs, &it, prefix.empty() ? NULL : prefix.c_str(),
+                                         prefix.size(), NULL, 0, opt));
   if (err) {
     return err;
   }
@@ -477,9 +602,14 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
       break;
     }
 
+    std::string skey = std::string(static_cast<const char*>(doc->key), doc->keylen);
+    if (glob.IsPastPrefix(skey)) {
+      fdb_doc_free(doc);
+      break;
+    }
+
     if (lkeys_out.size() < count_keys) {
-      std::string skey = std::string(static_cast<const char*>(doc->key), doc->keylen);
-      if (common::MatchPattern(skey, pattern)) {
+      if (glob.Match(skey) && filter.IsSizeAllowed(doc->bodylen)) {
         if (offset_pos == 0) {
           lkeys_out.push_back(skey);
         } else {
@@ -561,33 +691,8 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  fdb_iterator* it = NULL;
-  fdb_iterator_opt_t opt = FDB_ITR_NONE;
-
-  common::Error err =
-      CheckResultCommand(DB_FLUSHDB_COMMAND, fdb_iterator_init(connection_.handle_->kvs, &it, NULL, 0, NULL, 0, opt));
-  if (err) {
-    return err;
-  }
-
-  fdb_doc* doc = NULL;
-  do {
-    fdb_status rc = fdb_iterator_get(it, &doc);
-    if (rc != FDB_RESULT_SUCCESS) {
-      break;
-    }
-
-    std::string key;
-    err = CheckResultCommand(DB_FLUSHDB_COMMAND, fdb_del_kv(connection_.handle_->kvs, key.c_str(), key.size()));
-    if (err) {
-      fdb_iterator_close(it);
-      return err;
-    }
-    fdb_doc_free(doc);
-  } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
-  fdb_iterator_close(it);
-
-  return common::Error();
+  auto conf = GetConfig();
+  return CheckResultCommand(DB_FLUSHDB_COMMAND, forestdb_flush(connection_.handle_, conf->write_batch_size));
 }
 
 common::Error DBConnection::CreateDBImpl(const std::string& name, IDataBaseInfo** info) {
@@ -657,15 +762,36 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
-  for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
-      continue;
+  // fdb_del_kv doesn't report missing keys, so only existing ones are deleted
+  std::vector<bool> deleted(keys.size(), false);
+  auto del = [&keys, &deleted](fdb_kvs_handle* kvs, size_t index) {
+    const readable_string_t key_slice = keys[index].GetKey().GetData();
+    void* value_out = NULL;
+    size_t valuelen_out = 0;
+    fdb_status rc = fdb_get_kv(kvs, key_slice.data(), key_slice.size(), &value_out, &valuelen_out);
+    if (rc == FDB_RESULT_KEY_NOT_FOUND) {
+      return FDB_RESULT_SUCCESS;
+    } else if (rc != FDB_RESULT_SUCCESS) {
+      return rc;
     }
 
-    deleted_keys->push_back(key);
+    fdb_free_block(value_out);
+    rc = fdb_del_kv(kvs, key_slice.data(), key_slice.size());
+    deleted[index] = rc == FDB_RESULT_SUCCESS;
+    return rc;
+  };
+
+  auto conf = GetConfig();
+  common::Error err = CheckResultCommand(
+      DB_DELETE_KEY_COMMAND, forestdb_write_batched(connection_.handle_, conf->write_batch_size, keys.size(), del));
+  if (err) {
+    return err;
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (deleted[i]) {
+      deleted_keys->push_back(keys[i]);
+    }
   }
 
   return common::Error();
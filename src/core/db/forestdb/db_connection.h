@@ -43,6 +43,7 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
 
   virtual std::string GetCurrentDBName() const override;
   common::Error Info(const std::string& args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
+  common::Error Mset(const NDbKValues& keys, NDbKValues* added_keys) WARN_UNUSED_RESULT;
 
  private:
   common::Error CheckResultCommand(const std::string& cmd, fdb_status err) WARN_UNUSED_RESULT;
@@ -56,6 +57,12 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
                                  keys_limit_t count_keys,
                                  std::vector<std::string>* keys_out,
                                  cursor_t* cursor_out) override;
+  virtual common::Error ScanFilteredImpl(cursor_t cursor_in,
+                                         const std::string& pattern,
+                                         keys_limit_t count_keys,
+                                         const KeysFilter& filter,
+                                         std::vector<std::string>* keys_out,
+                                         cursor_t* cursor_out) override;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  keys_limit_t limit,
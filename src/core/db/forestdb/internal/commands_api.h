@@ -20,6 +20,8 @@
 
 #include "core/internal/commands_api.h"
 
+#define FORESTDB_MSET_COMMAND "MSET"
+
 namespace fastonosql {
 namespace core {
 namespace forestdb {
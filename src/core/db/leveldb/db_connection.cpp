@@ -28,6 +28,7 @@
 #include "core/db/leveldb/comparators/indexed_db.h"
 #include "core/db/leveldb/database_info.h"
 #include "core/db/leveldb/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 #define LEVELDB_HEADER_STATS                             \
   "                               Compactions\n"         \
@@ -74,6 +75,16 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         4,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Scan),
+                                          CommandHolder(DB_SEARCH_COMMAND,
+                                                        "<pattern> [COUNT count]",
+                                                        "Find keys which values match the given pattern, "
+                                                        "key space scanned in parallel",
+                                                        UNDEFINED_SINCE,
+                                                        UNDEFINED_EXAMPLE_STR,
+                                                        1,
+                                                        2,
+                                                        CommandInfo::Native,
+                                                        &CommandsApi::Search),
                                           CommandHolder(DB_JSONDUMP_COMMAND,
                                                         "<cursor> PATH absolute_path [MATCH pattern] [COUNT count]",
                                                         "Dump DB into json file by path.",
@@ -371,15 +382,37 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
                                      keys_limit_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      cursor_t* cursor_out) {
+  return ScanFilteredImpl(cursor_in, pattern, count_keys, KeysFilter(), keys_out, cursor_out);
+}
+
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsPlainStringsAllowed()) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   ::leveldb::ReadOptions ro;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  const GlobPattern glob(pattern);
+  config_t conf = GetConfig();
+  const bool seek_prefix = conf && conf->comparator == COMP_BYTEWISE && !glob.GetPrefix().empty();
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+  for (seek_prefix ? it->Seek(glob.GetPrefix()) : it->SeekToFirst(); it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
+    if (seek_prefix && glob.IsPastPrefix(key)) {
+      break;
+    }
+
     if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
+      if (glob.Match(key) && filter.IsSizeAllowed(it->value().size())) {
         if (offset_pos == 0) {
           lkeys_out.push_back(key);
         } else {
@@ -431,26 +464,125 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
   return CheckResultCommand(DB_KEYS_COMMAND, st);
 }
 
-common::Error DBConnection::DBkcountImpl(size_t* size) {
+internal::key_ranges_t DBConnection::GetScanRanges(const ::leveldb::Snapshot* snapshot) {
+  config_t conf = GetConfig();
+  if (!conf || conf->comparator != COMP_BYTEWISE) {
+    return {internal::KeyRange()};
+  }
+
   ::leveldb::ReadOptions ro;
+  ro.snapshot = snapshot;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
-  size_t sz = 0;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    sz++;
+  it->SeekToFirst();
+  if (!it->Valid()) {
+    delete it;
+    return {internal::KeyRange()};
   }
 
-  auto st = it->status();
+  const std::string first_key = it->key().ToString();
+  it->SeekToLast();
+  const std::string last_key = it->Valid() ? it->key().ToString() : first_key;
   delete it;
 
-  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, st);
+  const internal::key_ranges_t ranges = internal::SplitKeyRange(first_key, last_key);
+  const std::string end_key = last_key + '\0';
+  std::vector<::leveldb::Range> sizes_ranges;
+  for (const internal::KeyRange& range : ranges) {
+    sizes_ranges.push_back(::leveldb::Range(range.start, range.limit.empty() ? end_key : range.limit));
+  }
+
+  std::vector<uint64_t> weights(ranges.size(), 0);
+  connection_.handle_->GetApproximateSizes(sizes_ranges.data(), static_cast<int>(sizes_ranges.size()),
+                                           weights.data());
+  return internal::MergeKeyRanges(ranges, weights, internal::GetScanThreadsCount() * 4);
+}
+
+common::Error DBConnection::DBkcountImpl(size_t* size) {
+  const ::leveldb::Snapshot* snapshot = connection_.handle_->GetSnapshot();
+  const internal::key_ranges_t ranges = GetScanRanges(snapshot);
+  std::vector<size_t> counts(ranges.size(), 0);
+  common::Error err =
+      internal::ParallelFor(ranges.size(), internal::GetScanThreadsCount(), [&](size_t i) -> common::Error {
+        const internal::KeyRange& range = ranges[i];
+        ::leveldb::ReadOptions ro;
+        ro.snapshot = snapshot;
+        ro.fill_cache = false;
+        ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+        size_t sz = 0;
+        for (range.start.empty() ? it->SeekToFirst() : it->Seek(range.start); it->Valid(); it->Next()) {
+          const ::leveldb::Slice key = it->key();
+          if (range.IsPastLimit(key.data(), key.size())) {
+            break;
+          }
+          sz++;
+        }
+
+        auto st = it->status();
+        delete it;
+        counts[i] = sz;
+        return CheckResultCommand(DB_DBKCOUNT_COMMAND, st);
+      });
+  connection_.handle_->ReleaseSnapshot(snapshot);
   if (err) {
     return err;
   }
 
+  size_t sz = 0;
+  for (size_t count : counts) {
+    sz += count;
+  }
+
   *size = sz;
   return common::Error();
 }
 
+common::Error DBConnection::SearchImpl(const std::string& pattern,
+                                       keys_limit_t limit,
+                                       std::vector<std::string>* keys_out) {
+  const GlobPattern glob(pattern);
+  const ::leveldb::Snapshot* snapshot = connection_.handle_->GetSnapshot();
+  const internal::key_ranges_t ranges = GetScanRanges(snapshot);
+  std::vector<std::vector<std::string>> found(ranges.size());
+  common::Error err =
+      internal::ParallelFor(ranges.size(), internal::GetScanThreadsCount(), [&](size_t i) -> common::Error {
+        const internal::KeyRange& range = ranges[i];
+        ::leveldb::ReadOptions ro;
+        ro.snapshot = snapshot;
+        ro.fill_cache = false;
+        ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+        for (range.start.empty() ? it->SeekToFirst() : it->Seek(range.start); it->Valid() && found[i].size() < limit;
+             it->Next()) {
+          const ::leveldb::Slice key = it->key();
+          if (range.IsPastLimit(key.data(), key.size())) {
+            break;
+          }
+
+          const ::leveldb::Slice value = it->value();
+          if (glob.Match(value.data(), value.size())) {
+            found[i].push_back(key.ToString());
+          }
+        }
+
+        auto st = it->status();
+        delete it;
+        return CheckResultCommand(DB_SEARCH_COMMAND, st);
+      });
+  connection_.handle_->ReleaseSnapshot(snapshot);
+  if (err) {
+    return err;
+  }
+
+  std::vector<std::string> lkeys_out;  // partitions in key order
+  for (size_t i = 0; i < found.size() && lkeys_out.size() < limit; ++i) {
+    for (size_t j = 0; j < found[i].size() && lkeys_out.size() < limit; ++j) {
+      lkeys_out.push_back(found[i][j]);
+    }
+  }
+
+  *keys_out = lkeys_out;
+  return common::Error();
+}
+
 common::Error DBConnection::FlushDBImpl() {
   ::leveldb::ReadOptions ro;
   ::leveldb::WriteOptions wo;
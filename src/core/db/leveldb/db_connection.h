@@ -19,12 +19,14 @@
 #pragma once
 
 #include "core/internal/cdb_connection.h"  // for CDBConnection
+#include "core/internal/parallel_scan.h"   // for key_ranges_t
 
 #include "core/db/leveldb/config.h"
 #include "core/db/leveldb/server_info.h"
 
 namespace leveldb {
 class DB;
+class Snapshot;
 class Status;
 }  // namespace leveldb
 
@@ -51,11 +53,20 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   common::Error SetInner(const key_t& key, const value_t& value) WARN_UNUSED_RESULT;
   common::Error GetInner(const key_t& key, std::string* ret_val) WARN_UNUSED_RESULT;
 
+  // partitions for parallel iterators balanced by approximate sizes, one range if comparator not bytewise
+  internal::key_ranges_t GetScanRanges(const ::leveldb::Snapshot* snapshot);
+
   virtual common::Error ScanImpl(cursor_t cursor_in,
                                  const std::string& pattern,
                                  keys_limit_t count_keys,
                                  std::vector<std::string>* keys_out,
                                  cursor_t* cursor_out) override;
+  virtual common::Error ScanFilteredImpl(cursor_t cursor_in,
+                                         const std::string& pattern,
+                                         keys_limit_t count_keys,
+                                         const KeysFilter& filter,
+                                         std::vector<std::string>* keys_out,
+                                         cursor_t* cursor_out) override;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  cursor_t limit,
@@ -69,6 +80,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error RenameImpl(const NKey& key, const key_t& new_key) override;
   virtual common::Error QuitImpl() override;
   virtual common::Error ConfigGetDatabasesImpl(std::vector<std::string>* dbs) override;
+  virtual common::Error SearchImpl(const std::string& pattern,
+                                   keys_limit_t limit,
+                                   std::vector<std::string>* keys_out) override;
 };
 
 }  // namespace leveldb
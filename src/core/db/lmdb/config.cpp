@@ -54,6 +54,21 @@ Config ParseOptions(int argc, char** argv) {
       if (common::ConvertFromString(argv[++i], &max_dbs)) {
         cfg.max_dbs = max_dbs;
       }
+    } else if (!strcmp(argv[i], "-s") && !lastarg) {
+      unsigned int map_size_mb;
+      if (common::ConvertFromString(argv[++i], &map_size_mb)) {
+        cfg.map_size_mb = map_size_mb;
+      }
+    } else if (!strcmp(argv[i], "-r") && !lastarg) {
+      unsigned int max_readers;
+      if (common::ConvertFromString(argv[++i], &max_readers)) {
+        cfg.max_readers = max_readers;
+      }
+    } else if (!strcmp(argv[i], "-b") && !lastarg) {
+      unsigned int write_batch_size;
+      if (common::ConvertFromString(argv[++i], &write_batch_size) && write_batch_size) {
+        cfg.write_batch_size = write_batch_size;
+      }
     } else if (!strcmp(argv[i], "-e") && !lastarg) {
       int env_flags;
       if (common::ConvertFromString(argv[++i], &env_flags)) {
@@ -84,7 +99,10 @@ Config::Config()
     : LocalConfig(common::file_system::prepare_path("~/test.lmdb")),
       env_flags(LMDB_DEFAULT_ENV_FLAGS),
       db_name(default_db_name),
-      max_dbs(default_dbs_count) {}
+      max_dbs(default_dbs_count),
+      map_size_mb(0),
+      max_readers(0),
+      write_batch_size(default_write_batch_size) {}
 
 bool Config::ReadOnlyDB() const {
   return env_flags & MDB_RDONLY;
@@ -110,6 +128,54 @@ void Config::SetReadOnlyDB(bool ro) {
   }
 }
 
+bool Config::IsReadAheadDB() const {
+  return !(env_flags & MDB_NORDAHEAD);
+}
+
+void Config::SetReadAheadDB(bool readahead) {
+  if (readahead) {
+    env_flags &= ~MDB_NORDAHEAD;
+  } else {
+    env_flags |= MDB_NORDAHEAD;
+  }
+}
+
+bool Config::IsSyncDB() const {
+  return !(env_flags & MDB_NOSYNC);
+}
+
+void Config::SetSyncDB(bool sync) {
+  if (sync) {
+    env_flags &= ~MDB_NOSYNC;
+  } else {
+    env_flags |= MDB_NOSYNC;
+  }
+}
+
+bool Config::IsMetaSyncDB() const {
+  return !(env_flags & MDB_NOMETASYNC);
+}
+
+void Config::SetMetaSyncDB(bool sync) {
+  if (sync) {
+    env_flags &= ~MDB_NOMETASYNC;
+  } else {
+    env_flags |= MDB_NOMETASYNC;
+  }
+}
+
+bool Config::IsNoLockDB() const {
+  return env_flags & MDB_NOLOCK;
+}
+
+void Config::SetNoLockDB(bool nolock) {
+  if (nolock) {
+    env_flags |= MDB_NOLOCK;
+  } else {
+    env_flags &= ~MDB_NOLOCK;
+  }
+}
+
 }  // namespace lmdb
 }  // namespace core
 }  // namespace fastonosql
@@ -129,6 +195,19 @@ std::string ConvertToString(const fastonosql::core::lmdb::Config& conf) {
   argv.push_back("-m");
   argv.push_back(common::ConvertToString(conf.max_dbs));
 
+  if (conf.map_size_mb) {
+    argv.push_back("-s");
+    argv.push_back(common::ConvertToString(conf.map_size_mb));
+  }
+
+  if (conf.max_readers) {
+    argv.push_back("-r");
+    argv.push_back(common::ConvertToString(conf.max_readers));
+  }
+
+  argv.push_back("-b");
+  argv.push_back(common::ConvertToString(conf.write_batch_size));
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
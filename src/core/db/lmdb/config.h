@@ -26,7 +26,7 @@ namespace lmdb {
 
 struct Config : public LocalConfig {
   static const std::string default_db_name;
-  enum { default_dbs_count = 1024 };
+  enum { default_dbs_count = 1024, default_write_batch_size = 10000 };
   Config();
 
   bool ReadOnlyDB() const;
@@ -35,9 +35,27 @@ struct Config : public LocalConfig {
   bool IsSingleFileDB() const;
   void SetSingleFileDB(bool single);
 
+  // OS readahead, better to disable for random access on environments bigger than RAM
+  bool IsReadAheadDB() const;
+  void SetReadAheadDB(bool readahead);
+
+  // without sync last commits can be lost on system crash, but database stays consistent
+  bool IsSyncDB() const;
+  void SetSyncDB(bool sync);
+  bool IsMetaSyncDB() const;
+  void SetMetaSyncDB(bool sync);
+
+  // no lock file, only for read-only copies nobody writes to (snapshots, read-only media),
+  // read-only mode with lock file is the safe way to inspect live environment
+  bool IsNoLockDB() const;
+  void SetNoLockDB(bool nolock);
+
   int env_flags;
   std::string db_name;
   unsigned int max_dbs;
+  unsigned int map_size_mb;       // 0 - size of existing environment or lmdb default, grows if full
+  unsigned int max_readers;       // 0 - lmdb default
+  unsigned int write_batch_size;  // write operations per transaction for bulk writes
 };
 
 }  // namespace lmdb
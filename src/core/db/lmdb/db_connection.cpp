@@ -22,7 +22,12 @@
 #include <lmdb.h>    // for mdb_txn_abort, MDB_val
 #include <stdlib.h>  // for NULL, free, calloc
 #include <time.h>    // for time_t
-#include <string>    // for string
+
+#include <algorithm>           // for min
+#include <condition_variable>  // for condition_variable
+#include <functional>          // for function
+#include <mutex>               // for mutex
+#include <string>              // for string
 
 #include <common/convert2string.h>
 #include <common/file_system/string_path_utils.h>
@@ -33,6 +38,7 @@
 #include "core/db/lmdb/config.h"  // for Config
 #include "core/db/lmdb/database_info.h"
 #include "core/db/lmdb/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 #define LMDB_OK 0
 
@@ -94,6 +100,16 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         4,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Scan),
+                                          CommandHolder(DB_SEARCH_COMMAND,
+                                                        "<pattern> [COUNT count]",
+                                                        "Find keys which values match the given pattern, "
+                                                        "key space scanned in parallel",
+                                                        UNDEFINED_SINCE,
+                                                        UNDEFINED_EXAMPLE_STR,
+                                                        1,
+                                                        2,
+                                                        CommandInfo::Native,
+                                                        &CommandsApi::Search),
                                           CommandHolder(DB_JSONDUMP_COMMAND,
                                                         "<cursor> PATH absolute_path [MATCH pattern] [COUNT count]",
                                                         "Dump DB into json file by path.",
@@ -140,6 +156,16 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DropDatabase),
+                                          CommandHolder(LMDB_MSET_COMMAND,
+                                                        "<key> <value> [key value ...]",
+                                                        "Set multiple keys to multiple values, "
+                                                        "written in transactions of write batch size",
+                                                        UNDEFINED_SINCE,
+                                                        UNDEFINED_EXAMPLE_STR,
+                                                        2,
+                                                        INFINITE_COMMAND_ARGS,
+                                                        CommandInfo::Native,
+                                                        &CommandsApi::Mset),
                                           CommandHolder(DB_SELECTDB_COMMAND,
                                                         "<name>",
                                                         "Change the selected database for the "
@@ -221,7 +247,46 @@ MDB_val ConvertToLMDBSlice(const char* key, size_t len) {
 }
 }  // namespace
 namespace lmdb {
+
+// transactions of process hold it shared, mdb_env_set_mapsize exclusive: it needs no active transactions
+class EnvLock {
+ public:
+  EnvLock() : mutex_(), cond_(), readers_(0), writer_(false) {}
+
+  void LockShared() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return !writer_; });
+    readers_++;
+  }
+
+  void UnlockShared() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--readers_ == 0) {
+      cond_.notify_all();
+    }
+  }
+
+  void Lock() {  // readers preferred, parallel scan workers never wait for resize
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return !writer_ && readers_ == 0; });
+    writer_ = true;
+  }
+
+  void Unlock() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_ = false;
+    cond_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  size_t readers_;
+  bool writer_;
+};
+
 struct lmdb {
+  EnvLock* lock;
   MDB_env* env;
   MDB_dbi dbi;
   char* db_name;
@@ -233,13 +298,50 @@ unsigned int lmdb_db_flag_from_env_flags(int env_flags) {
   return (env_flags & MDB_RDONLY) ? MDB_RDONLY : 0;
 }
 
+int lmdb_set_mapsize(lmdb* context, size_t map_size) {
+  context->lock->Lock();
+  int rc = mdb_env_set_mapsize(context->env, map_size);
+  context->lock->Unlock();
+  return rc;
+}
+
+// every transaction of environment begins here, released by lmdb_txn_commit or lmdb_txn_abort
+int lmdb_txn_begin(lmdb* context, unsigned int flags, MDB_txn** txn) {
+  context->lock->LockShared();
+  int rc = mdb_txn_begin(context->env, NULL, flags, txn);
+  if (rc == MDB_MAP_RESIZED) {  // grown by other process, adopt new size
+    context->lock->UnlockShared();
+    rc = lmdb_set_mapsize(context, 0);
+    context->lock->LockShared();
+    if (rc == LMDB_OK) {
+      rc = mdb_txn_begin(context->env, NULL, flags, txn);
+    }
+  }
+
+  if (rc != LMDB_OK) {
+    context->lock->UnlockShared();
+  }
+  return rc;
+}
+
+int lmdb_txn_commit(lmdb* context, MDB_txn* txn) {
+  int rc = mdb_txn_commit(txn);
+  context->lock->UnlockShared();
+  return rc;
+}
+
+void lmdb_txn_abort(lmdb* context, MDB_txn* txn) {
+  mdb_txn_abort(txn);
+  context->lock->UnlockShared();
+}
+
 int lmdb_create_db(lmdb* context, const char* db_name, int env_flags) {
   if (!context || !db_name) {
     return EINVAL;
   }
 
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(context->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
+  int rc = lmdb_txn_begin(context, lmdb_db_flag_from_env_flags(env_flags), &txn);
   if (rc != LMDB_OK) {
     return rc;
   }
@@ -248,11 +350,11 @@ int lmdb_create_db(lmdb* context, const char* db_name, int env_flags) {
   unsigned int flg = env_flags & MDB_RDONLY ? 0 : MDB_CREATE;
   rc = mdb_dbi_open(txn, db_name, flg, &ldbi);
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(context, txn);
     return rc;
   }
 
-  mdb_txn_commit(txn);
+  lmdb_txn_commit(context, txn);
   mdb_dbi_close(context->env, ldbi);
   return LMDB_OK;
 }
@@ -265,24 +367,24 @@ int lmdb_remove_db(lmdb* context, const char* db_name, int env_flags) {
   const unsigned int flg = lmdb_db_flag_from_env_flags(env_flags);
   MDB_dbi ldbi = 0;
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(context->env, NULL, flg, &txn);
+  int rc = lmdb_txn_begin(context, flg, &txn);
   if (rc != LMDB_OK) {
     return rc;
   }
 
   rc = mdb_dbi_open(txn, db_name, flg, &ldbi);
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(context, txn);
     return rc;
   }
 
   rc = mdb_drop(txn, ldbi, 1);
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(context, txn);
     return rc;
   }
 
-  return mdb_txn_commit(txn);
+  return lmdb_txn_commit(context, txn);
 }
 
 int lmdb_select(lmdb* context, const char* db_name, int env_flags) {
@@ -296,7 +398,7 @@ int lmdb_select(lmdb* context, const char* db_name, int env_flags) {
 
   // open db
   MDB_txn* txn = NULL;
-  int rc = mdb_txn_begin(context->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
+  int rc = lmdb_txn_begin(context, lmdb_db_flag_from_env_flags(env_flags), &txn);
   if (rc != LMDB_OK) {
     return rc;
   }
@@ -305,11 +407,11 @@ int lmdb_select(lmdb* context, const char* db_name, int env_flags) {
   const unsigned int flg = env_flags & MDB_RDONLY ? 0 : MDB_CREATE;
   rc = mdb_dbi_open(txn, db_name, flg, &ldbi);
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(context, txn);
     return rc;
   }
 
-  rc = mdb_txn_commit(txn);
+  rc = lmdb_txn_commit(context, txn);
   if (rc != LMDB_OK) {
     return rc;
   }
@@ -326,22 +428,35 @@ int lmdb_select(lmdb* context, const char* db_name, int env_flags) {
   return LMDB_OK;
 }
 
-int lmdb_open(lmdb** context, const char* db_path, int env_flags, MDB_dbi max_dbs) {
+int lmdb_open(lmdb** context,
+              const char* db_path,
+              int env_flags,
+              MDB_dbi max_dbs,
+              size_t map_size,
+              unsigned int max_readers) {
   lmdb* lcontext = reinterpret_cast<lmdb*>(calloc(1, sizeof(lmdb)));
   int rc = mdb_env_create(&lcontext->env);
   if (rc != LMDB_OK) {
     free(lcontext);
     return rc;
   }
+  lcontext->lock = new EnvLock;
 
   rc = mdb_env_set_maxdbs(lcontext->env, max_dbs);
-  if (rc != LMDB_OK) {
-    free(lcontext);
-    return rc;
+  if (rc == LMDB_OK && map_size) {
+    rc = mdb_env_set_mapsize(lcontext->env, map_size);
+  }
+  if (rc == LMDB_OK && max_readers) {
+    rc = mdb_env_set_maxreaders(lcontext->env, max_readers);
+  }
+  if (rc == LMDB_OK) {
+    // reader slots bound to transactions not threads, parallel scans and workers share environment
+    rc = mdb_env_open(lcontext->env, db_path, env_flags | MDB_NOTLS, 0664);
   }
 
-  rc = mdb_env_open(lcontext->env, db_path, env_flags, 0664);
   if (rc != LMDB_OK) {
+    mdb_env_close(lcontext->env);
+    delete lcontext->lock;
     free(lcontext);
     return rc;
   }
@@ -350,6 +465,66 @@ int lmdb_open(lmdb** context, const char* db_path, int env_flags, MDB_dbi max_db
   return rc;
 }
 
+// waits for active transactions of this process, caller must not hold one
+int lmdb_grow_map(lmdb* context) {
+  context->lock->Lock();
+  MDB_envinfo info;
+  int rc = mdb_env_info(context->env, &info);
+  if (rc == LMDB_OK) {
+    rc = mdb_env_set_mapsize(context->env, info.me_mapsize * 2);
+  }
+  context->lock->Unlock();
+  return rc;
+}
+
+typedef std::function<int(MDB_txn* txn, size_t index)> write_op_t;
+
+// ops [0, count) in transactions of batch_size ops, if map is full it doubled and chunk repeated
+int lmdb_write_batched(lmdb* context, int env_flags, size_t batch_size, size_t count, const write_op_t& op) {
+  if (batch_size == 0) {
+    batch_size = count;
+  }
+
+  bool grown = false;
+  size_t start = 0;
+  while (start < count) {
+    const size_t end = std::min(count, start + batch_size);
+    MDB_txn* txn = NULL;
+    int rc = lmdb_txn_begin(context, lmdb_db_flag_from_env_flags(env_flags), &txn);
+    if (rc != LMDB_OK) {
+      return rc;
+    }
+
+    for (size_t i = start; i < end && rc == LMDB_OK; ++i) {
+      rc = op(txn, i);
+    }
+
+    if (rc == LMDB_OK) {
+      rc = lmdb_txn_commit(context, txn);
+    } else {
+      lmdb_txn_abort(context, txn);
+    }
+
+    if (rc == MDB_MAP_FULL && !grown) {
+      rc = lmdb_grow_map(context);
+      if (rc != LMDB_OK) {
+        return rc;
+      }
+      grown = true;
+      continue;
+    }
+
+    if (rc != LMDB_OK) {
+      return rc;
+    }
+
+    grown = false;
+    start = end;
+  }
+
+  return LMDB_OK;
+}
+
 void lmdb_close(lmdb** context) {
   if (!context) {
     return;
@@ -366,6 +541,8 @@ void lmdb_close(lmdb** context) {
   lcontext->dbi = 0;
   mdb_env_close(lcontext->env);
   lcontext->env = NULL;
+  delete lcontext->lock;
+  lcontext->lock = NULL;
   free(lcontext);
   *context = NULL;
 }
@@ -443,10 +620,15 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
     }
   }
 
+  if (config.IsNoLockDB() && !config.ReadOnlyDB()) {
+    return common::make_error("Lock-free mode allowed only for read-only environments.");
+  }
+
   const char* db_path_ptr = db_path.c_str();
   int env_flags = config.env_flags;
   unsigned int max_dbs = config.max_dbs;
-  int st = lmdb_open(&lcontext, db_path_ptr, env_flags, max_dbs);
+  const size_t map_size = static_cast<size_t>(config.map_size_mb) * 1024 * 1024;
+  int st = lmdb_open(&lcontext, db_path_ptr, env_flags, max_dbs, map_size, config.max_readers);
   if (st != LMDB_OK) {
     std::string buff = common::MemSPrintf("Fail open database: %s", mdb_strerror(st));
     return common::make_error(buff);
@@ -510,18 +692,55 @@ common::Error DBConnection::DropDatabase() {
   auto conf = GetConfig();
   int env_flags = conf->env_flags;
   err = CheckResultCommand(LMDB_DROPDB_COMMAND,
-                           mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
+                           lmdb_txn_begin(connection_.handle_, lmdb_db_flag_from_env_flags(env_flags), &txn));
   if (err) {
     return err;
   }
 
   err = CheckResultCommand(LMDB_DROPDB_COMMAND, mdb_drop(txn, connection_.handle_->dbi, 1));
   if (err) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(connection_.handle_, txn);
+    return err;
+  }
+
+  return CheckResultCommand(LMDB_DROPDB_COMMAND, lmdb_txn_commit(connection_.handle_, txn));
+}
+
+common::Error DBConnection::Mset(const NDbKValues& keys, NDbKValues* added_keys) {
+  if (!added_keys) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  auto conf = GetConfig();
+  const MDB_dbi dbi = connection_.handle_->dbi;
+  auto put = [dbi, &keys](MDB_txn* txn, size_t index) {
+    const readable_string_t key_str = keys[index].GetKey().GetKey().GetData();
+    const readable_string_t value_str = keys[index].GetValue().GetValue().GetData();
+    MDB_val key_slice = ConvertToLMDBSlice(key_str.data(), key_str.size());
+    MDB_val mval = ConvertToLMDBSlice(value_str.data(), value_str.size());
+    return mdb_put(txn, dbi, &key_slice, &mval, 0);
+  };
+
+  err = CheckResultCommand(
+      LMDB_MSET_COMMAND,
+      lmdb_write_batched(connection_.handle_, conf->env_flags, conf->write_batch_size, keys.size(), put));
+  if (err) {
     return err;
   }
 
-  return CheckResultCommand(LMDB_DROPDB_COMMAND, mdb_txn_commit(txn));
+  *added_keys = keys;
+  if (client_) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      client_->OnAddedKey(keys[i]);
+    }
+  }
+  return common::Error();
 }
 
 common::Error DBConnection::SetInner(const key_t& key, const value_t& value) {
@@ -532,21 +751,13 @@ common::Error DBConnection::SetInner(const key_t& key, const value_t& value) {
   mval.mv_size = value_str.size();
   mval.mv_data = const_cast<char*>(value_str.data());
 
-  MDB_txn* txn = NULL;
   auto conf = GetConfig();
-  int env_flags = conf->env_flags;
-  common::Error err = CheckResultCommand(
-      DB_SET_KEY_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
-  if (err) {
-    return err;
-  }
-  err = CheckResultCommand(DB_SET_KEY_COMMAND, mdb_put(txn, connection_.handle_->dbi, &key_slice, &mval, 0));
-  if (err) {
-    mdb_txn_abort(txn);
-    return err;
-  }
-
-  return CheckResultCommand(DB_SET_KEY_COMMAND, mdb_txn_commit(txn));
+  const MDB_dbi dbi = connection_.handle_->dbi;
+  auto put = [dbi, &key_slice, &mval](MDB_txn* txn, size_t index) {
+    UNUSED(index);
+    return mdb_put(txn, dbi, &key_slice, &mval, 0);
+  };
+  return CheckResultCommand(DB_SET_KEY_COMMAND, lmdb_write_batched(connection_.handle_, conf->env_flags, 1, 1, put));
 }
 
 common::Error DBConnection::GetInner(const key_t& key, std::string* ret_val) {
@@ -555,14 +766,13 @@ common::Error DBConnection::GetInner(const key_t& key, std::string* ret_val) {
   MDB_val mval;
 
   MDB_txn* txn = NULL;
-  common::Error err =
-      CheckResultCommand(DB_GET_KEY_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn));
+  common::Error err = CheckResultCommand(DB_GET_KEY_COMMAND, lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
   if (err) {
     return err;
   }
 
   err = CheckResultCommand(DB_GET_KEY_COMMAND, mdb_get(txn, connection_.handle_->dbi, &key_slice, &mval));
-  mdb_txn_abort(txn);
+  lmdb_txn_abort(connection_.handle_, txn);
   if (err) {
     return err;
   }
@@ -575,23 +785,13 @@ common::Error DBConnection::DelInner(const key_t& key) {
   const readable_string_t key_str = key.GetData();
   MDB_val key_slice = ConvertToLMDBSlice(key_str.data(), key_str.size());
 
-  MDB_txn* txn = NULL;
   auto conf = GetConfig();
-  int env_flags = conf->env_flags;
-  common::Error err =
-      CheckResultCommand(DB_DELETE_KEY_COMMAND,
-                         mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
-  if (err) {
-    return err;
-  }
-
-  err = CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_del(txn, connection_.handle_->dbi, &key_slice, NULL));
-  if (err) {
-    mdb_txn_abort(txn);
-    return err;
-  }
-
-  return CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_txn_commit(txn));
+  const MDB_dbi dbi = connection_.handle_->dbi;
+  auto del = [dbi, &key_slice](MDB_txn* txn, size_t index) {
+    UNUSED(index);
+    return mdb_del(txn, dbi, &key_slice, NULL);
+  };
+  return CheckResultCommand(DB_DELETE_KEY_COMMAND, lmdb_write_batched(connection_.handle_, conf->env_flags, 1, 1, del));
 }
 
 common::Error DBConnection::ScanImpl(cursor_t cursor_in,
@@ -599,29 +799,51 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
                                      keys_limit_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      cursor_t* cursor_out) {
+  return ScanFilteredImpl(cursor_in, pattern, count_keys, KeysFilter(), keys_out, cursor_out);
+}
+
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsPlainStringsAllowed()) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
-  common::Error err =
-      CheckResultCommand(DB_SCAN_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn));
+  common::Error err = CheckResultCommand(DB_SCAN_COMMAND, lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
   if (err) {
     return err;
   }
 
   err = CheckResultCommand(DB_SCAN_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
   if (err) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(connection_.handle_, txn);
     return err;
   }
 
-  MDB_val key;
+  const GlobPattern glob(pattern);
+  const std::string prefix = glob.GetPrefix();
+  MDB_val key = ConvertToLMDBSlice(prefix.data(), prefix.size());
   MDB_val data;
+  MDB_cursor_op op = prefix.empty() ? MDB_NEXT : MDB_SET_RANGE;  // first key not less than prefix
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
-  while ((mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK)) {
+  while ((mdb_cursor_get(cursor, &key, &data, op) == LMDB_OK)) {
+    op = MDB_NEXT;
+    std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+    if (glob.IsPastPrefix(skey)) {
+      break;
+    }
+
     if (lkeys_out.size() < count_keys) {
-      std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
-      if (common::MatchPattern(skey, pattern)) {
+      if (glob.Match(skey) && filter.IsSizeAllowed(data.mv_size)) {
         if (offset_pos == 0) {
           lkeys_out.push_back(skey);
         } else {
@@ -637,7 +859,7 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
+  lmdb_txn_abort(connection_.handle_, txn);
   return common::Error();
 }
 
@@ -647,15 +869,14 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      std::vector<std::string>* ret) {
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
-  common::Error err =
-      CheckResultCommand(DB_KEYS_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn));
+  common::Error err = CheckResultCommand(DB_KEYS_COMMAND, lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
   if (err) {
     return err;
   }
 
   err = CheckResultCommand(DB_KEYS_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
   if (err) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(connection_.handle_, txn);
     return err;
   }
 
@@ -669,35 +890,120 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
   }
 
   mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
+  lmdb_txn_abort(connection_.handle_, txn);
   return common::Error();
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
+  MDB_txn* txn = NULL;
+  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
+  if (err) {
+    return err;
+  }
+
+  MDB_stat stat;
+  err = CheckResultCommand(DB_DBKCOUNT_COMMAND, mdb_stat(txn, connection_.handle_->dbi, &stat));
+  lmdb_txn_abort(connection_.handle_, txn);
+  if (err) {
+    return err;
+  }
+
+  *size = stat.ms_entries;
+  return common::Error();
+}
+
+common::Error DBConnection::GetScanRanges(internal::key_ranges_t* ranges) {
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
-  common::Error err =
-      CheckResultCommand(DB_DBKCOUNT_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn));
+  common::Error err = CheckResultCommand(DB_SEARCH_COMMAND, lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
   if (err) {
     return err;
   }
 
-  err = CheckResultCommand(DB_DBKCOUNT_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
+  err = CheckResultCommand(DB_SEARCH_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
   if (err) {
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(connection_.handle_, txn);
     return err;
   }
 
   MDB_val key;
   MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
+  if (mdb_cursor_get(cursor, &key, &data, MDB_FIRST) != LMDB_OK) {
+    *ranges = {internal::KeyRange()};
+    mdb_cursor_close(cursor);
+    lmdb_txn_abort(connection_.handle_, txn);
+    return common::Error();
+  }
+
+  const std::string first_key(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+  std::string last_key = first_key;
+  if (mdb_cursor_get(cursor, &key, &data, MDB_LAST) == LMDB_OK) {
+    last_key = std::string(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
   }
   mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
+  lmdb_txn_abort(connection_.handle_, txn);
 
-  *size = sz;
+  *ranges = internal::SplitKeyRange(first_key, last_key);
+  return common::Error();
+}
+
+common::Error DBConnection::SearchImpl(const std::string& pattern,
+                                       keys_limit_t limit,
+                                       std::vector<std::string>* keys_out) {
+  internal::key_ranges_t ranges;
+  common::Error err = GetScanRanges(&ranges);
+  if (err) {
+    return err;
+  }
+
+  const GlobPattern glob(pattern);
+  std::vector<std::vector<std::string>> found(ranges.size());
+  err = internal::ParallelFor(ranges.size(), internal::GetScanThreadsCount(), [&](size_t i) -> common::Error {
+    const internal::KeyRange& range = ranges[i];
+    MDB_cursor* cursor = NULL;
+    MDB_txn* txn = NULL;  // read transaction per worker thread
+    common::Error err = CheckResultCommand(DB_SEARCH_COMMAND, lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
+    if (err) {
+      return err;
+    }
+
+    err = CheckResultCommand(DB_SEARCH_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
+    if (err) {
+      lmdb_txn_abort(connection_.handle_, txn);
+      return err;
+    }
+
+    MDB_val key = ConvertToLMDBSlice(range.start.data(), range.start.size());
+    MDB_val data;
+    MDB_cursor_op op = range.start.empty() ? MDB_FIRST : MDB_SET_RANGE;
+    while (found[i].size() < limit && mdb_cursor_get(cursor, &key, &data, op) == LMDB_OK) {
+      op = MDB_NEXT;
+      const char* key_data = reinterpret_cast<const char*>(key.mv_data);
+      if (range.IsPastLimit(key_data, key.mv_size)) {
+        break;
+      }
+
+      if (glob.Match(reinterpret_cast<const char*>(data.mv_data), data.mv_size)) {
+        found[i].push_back(std::string(key_data, key.mv_size));
+      }
+    }
+
+    mdb_cursor_close(cursor);
+    lmdb_txn_abort(connection_.handle_, txn);
+    return common::Error();
+  });
+  if (err) {
+    return err;
+  }
+
+  std::vector<std::string> lkeys_out;  // partitions in key order
+  for (size_t i = 0; i < found.size() && lkeys_out.size() < limit; ++i) {
+    for (size_t j = 0; j < found[i].size() && lkeys_out.size() < limit; ++j) {
+      lkeys_out.push_back(found[i][j]);
+    }
+  }
+
+  *keys_out = lkeys_out;
   return common::Error();
 }
 
@@ -728,42 +1034,63 @@ common::Error DBConnection::RemoveDBImpl(const std::string& name, IDataBaseInfo*
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  MDB_cursor* cursor = NULL;
-  MDB_txn* txn = NULL;
   auto conf = GetConfig();
-  int env_flags = conf->env_flags;
-  common::Error err = CheckResultCommand(
-      DB_FLUSHDB_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
-  if (err) {
-    return err;
-  }
+  const size_t batch_size = conf->write_batch_size ? conf->write_batch_size : Config::default_write_batch_size;
+  // committed every batch_size deletions, so dirty pages of one transaction stay bounded
+  // deletions copy pages too, if map is full it doubled and batch repeated
+  bool grown = false;
+  while (true) {
+    MDB_txn* txn = NULL;
+    int rc = lmdb_txn_begin(connection_.handle_, lmdb_db_flag_from_env_flags(conf->env_flags), &txn);
+    if (rc != LMDB_OK) {
+      return CheckResultCommand(DB_FLUSHDB_COMMAND, rc);
+    }
 
-  err = CheckResultCommand(DB_FLUSHDB_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
-  if (err) {
-    mdb_txn_abort(txn);
-    return err;
-  }
+    MDB_cursor* cursor = NULL;
+    rc = mdb_cursor_open(txn, connection_.handle_->dbi, &cursor);
+    if (rc != LMDB_OK) {
+      lmdb_txn_abort(connection_.handle_, txn);
+      return CheckResultCommand(DB_FLUSHDB_COMMAND, rc);
+    }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-    err = CheckResultCommand(DB_FLUSHDB_COMMAND, mdb_del(txn, connection_.handle_->dbi, &key, NULL));
-    if (err) {
-      mdb_cursor_close(cursor);
-      mdb_txn_abort(txn);
-      return err;
+    MDB_val key;
+    MDB_val data;
+    size_t sz = 0;
+    while (rc == LMDB_OK && sz < batch_size && mdb_cursor_get(cursor, &key, &data, MDB_FIRST) == LMDB_OK) {
+      rc = mdb_cursor_del(cursor, 0);
+      sz++;
     }
-  }
 
-  mdb_cursor_close(cursor);
-  if (sz != 0) {
-    return CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_txn_commit(txn));
-  }
+    mdb_cursor_close(cursor);
+    if (rc == LMDB_OK && sz == 0) {
+      lmdb_txn_abort(connection_.handle_, txn);
+      return common::Error();
+    }
 
-  mdb_txn_abort(txn);
-  return common::Error();
+    if (rc == LMDB_OK) {
+      rc = lmdb_txn_commit(connection_.handle_, txn);
+    } else {
+      lmdb_txn_abort(connection_.handle_, txn);
+    }
+
+    if (rc == MDB_MAP_FULL && !grown) {
+      rc = lmdb_grow_map(connection_.handle_);
+      if (rc != LMDB_OK) {
+        return CheckResultCommand(DB_FLUSHDB_COMMAND, rc);
+      }
+      grown = true;
+      continue;
+    }
+
+    if (rc != LMDB_OK) {
+      return CheckResultCommand(DB_FLUSHDB_COMMAND, rc);
+    }
+
+    grown = false;
+    if (sz < batch_size) {
+      return common::Error();
+    }
+  }
 }
 
 common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo** info) {
@@ -811,15 +1138,28 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  auto conf = GetConfig();
+  const MDB_dbi dbi = connection_.handle_->dbi;
+  std::vector<bool> deleted(keys.size(), false);
+  auto del = [dbi, &keys, &deleted](MDB_txn* txn, size_t index) {
+    const readable_string_t key_str = keys[index].GetKey().GetData();
+    MDB_val key_slice = ConvertToLMDBSlice(key_str.data(), key_str.size());
+    int rc = mdb_del(txn, dbi, &key_slice, NULL);
+    deleted[index] = rc == LMDB_OK;
+    return rc == MDB_NOTFOUND ? LMDB_OK : rc;
+  };
+
+  common::Error err = CheckResultCommand(
+      DB_DELETE_KEY_COMMAND,
+      lmdb_write_batched(connection_.handle_, conf->env_flags, conf->write_batch_size, keys.size(), del));
+  if (err) {
+    return err;
+  }
+
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
-      continue;
+    if (deleted[i]) {
+      deleted_keys->push_back(keys[i]);
     }
-
-    deleted_keys->push_back(key);
   }
 
   return common::Error();
@@ -860,13 +1200,13 @@ common::Error DBConnection::ConfigGetDatabasesImpl(std::vector<std::string>* dbs
   {
     MDB_txn* txn = NULL;
     common::Error err =
-        CheckResultCommand("CONFIG GET DATABASES", mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn));
+        CheckResultCommand("CONFIG GET DATABASES", lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn));
     if (err) {
       return err;
     }
 
     err = CheckResultCommand("CONFIG GET DATABASES", mdb_dbi_open(txn, NULL, 0, &ldbi));
-    mdb_txn_abort(txn);
+    lmdb_txn_abort(connection_.handle_, txn);
     if (err) {
       return err;
     }
@@ -875,7 +1215,7 @@ common::Error DBConnection::ConfigGetDatabasesImpl(std::vector<std::string>* dbs
   MDB_cursor* cursor = NULL;
   MDB_txn* txn_dbs = NULL;
   common::Error err =
-      CheckResultCommand("CONFIG GET DATABASES", mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn_dbs));
+      CheckResultCommand("CONFIG GET DATABASES", lmdb_txn_begin(connection_.handle_, MDB_RDONLY, &txn_dbs));
   if (err) {
     mdb_dbi_close(connection_.handle_->env, ldbi);
     return err;
@@ -883,7 +1223,7 @@ common::Error DBConnection::ConfigGetDatabasesImpl(std::vector<std::string>* dbs
 
   err = CheckResultCommand("CONFIG GET DATABASES", mdb_cursor_open(txn_dbs, ldbi, &cursor));
   if (err) {
-    mdb_txn_abort(txn_dbs);
+    lmdb_txn_abort(connection_.handle_, txn_dbs);
     mdb_dbi_close(connection_.handle_->env, ldbi);
     return err;
   }
@@ -897,7 +1237,7 @@ common::Error DBConnection::ConfigGetDatabasesImpl(std::vector<std::string>* dbs
   }
 
   mdb_cursor_close(cursor);
-  mdb_txn_abort(txn_dbs);
+  lmdb_txn_abort(connection_.handle_, txn_dbs);
   mdb_dbi_close(connection_.handle_->env, ldbi);
   return common::Error();
 }
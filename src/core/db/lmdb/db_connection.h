@@ -19,6 +19,7 @@
 #pragma once
 
 #include "core/internal/cdb_connection.h"  // for CDBConnection
+#include "core/internal/parallel_scan.h"   // for key_ranges_t
 
 #include "core/db/lmdb/config.h"
 #include "core/db/lmdb/server_info.h"  // for ServerInfo
@@ -41,6 +42,7 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual std::string GetCurrentDBName() const override;
   common::Error Info(const std::string& args, ServerInfo::Stats* statsout) WARN_UNUSED_RESULT;
   common::Error DropDatabase() WARN_UNUSED_RESULT;
+  common::Error Mset(const NDbKValues& keys, NDbKValues* added_keys) WARN_UNUSED_RESULT;
 
  private:
   common::Error CheckResultCommand(const std::string& cmd, int err) WARN_UNUSED_RESULT;
@@ -49,11 +51,20 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   common::Error GetInner(const key_t& key, std::string* ret_val) WARN_UNUSED_RESULT;
   common::Error DelInner(const key_t& key) WARN_UNUSED_RESULT;
 
+  // one partition per byte after common prefix of first and last keys, balanced by free workers
+  common::Error GetScanRanges(internal::key_ranges_t* ranges) WARN_UNUSED_RESULT;
+
   virtual common::Error ScanImpl(cursor_t cursor_in,
                                  const std::string& pattern,
                                  keys_limit_t count_keys,
                                  std::vector<std::string>* keys_out,
                                  cursor_t* cursor_out) override;
+  virtual common::Error ScanFilteredImpl(cursor_t cursor_in,
+                                         const std::string& pattern,
+                                         keys_limit_t count_keys,
+                                         const KeysFilter& filter,
+                                         std::vector<std::string>* keys_out,
+                                         cursor_t* cursor_out) override;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  keys_limit_t limit,
@@ -69,6 +80,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error RenameImpl(const NKey& key, const key_t& new_key) override;
   virtual common::Error QuitImpl() override;
   virtual common::Error ConfigGetDatabasesImpl(std::vector<std::string>* dbs) override;
+  virtual common::Error SearchImpl(const std::string& pattern,
+                                   keys_limit_t limit,
+                                   std::vector<std::string>* keys_out) override;
 };
 
 }  // namespace lmdb
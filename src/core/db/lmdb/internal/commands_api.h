@@ -21,6 +21,7 @@
 #include "core/internal/commands_api.h"
 
 #define LMDB_DROPDB_COMMAND "DROPDB"
+#define LMDB_MSET_COMMAND "MSET"
 
 namespace fastonosql {
 namespace core {
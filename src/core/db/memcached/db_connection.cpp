@@ -18,8 +18,12 @@
 
 #include "core/db/memcached/db_connection.h"
 
+#include <stdio.h>   // for sscanf
+#include <stdlib.h>  // for strtoull
 #include <string.h>  // for strcasecmp
 
+#include <limits>  // for numeric_limits
+#include <map>     // for map
 #include <memory>  // for __shared_ptr
 #include <string>  // for string, operator<, etc
 
@@ -29,6 +33,7 @@
 #include <libmemcached/util.h>
 
 #include <common/convert2string.h>  // for ConvertFromString
+#include <common/net/socket_tcp.h>  // for ClientSocketTcp
 #include <common/net/types.h>       // for HostAndPort
 #include <common/sprintf.h>         // for MemSPrintf
 #include <common/utils.h>           // for c_strornull
@@ -38,6 +43,7 @@
 #include "core/db/memcached/config.h"  // for Config
 #include "core/db/memcached/database_info.h"
 #include "core/db/memcached/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 // hacked
 struct hacked_memcached_instance_st {
@@ -130,24 +136,50 @@ memcached_return_t memcached_dump_keys_callback(const memcached_st* ptr,
   return holder->addKey(key, key_length, exp);
 }
 
+fastonosql::core::ttl_t ConvertFromExpiration(time_t exp, time_t server_time) {
+  time_t cur_t = time(NULL);
+  if (cur_t > exp) {
+    if (server_time > exp) {
+      return NO_TTL;
+    }
+    return EXPIRED_TTL;
+  }
+  return exp - cur_t;
+}
+
 struct ScanHolder {
-  ScanHolder(uint64_t cursor_in, const std::string& pattern, uint64_t limit)
-      : cursor_in(cursor_in), pattern(pattern), limit(limit), r(), cursor_out(0), offset_pos(cursor_in) {}
+  ScanHolder(uint64_t cursor_in,
+             const std::string& pattern,
+             uint64_t limit,
+             const fastonosql::core::KeysFilter* filter = nullptr,
+             time_t server_time = 0)
+      : cursor_in(cursor_in),
+        glob(pattern),
+        limit(limit),
+        filter(filter),
+        server_time(server_time),
+        r(),
+        cursor_out(0),
+        offset_pos(cursor_in) {}
 
   const uint64_t cursor_in;
-  const std::string pattern;
+  const fastonosql::core::GlobPattern glob;
   const uint64_t limit;
+  const fastonosql::core::KeysFilter* filter;  // ttl part checked on dump metadata
+  const time_t server_time;
   std::vector<std::string> r;
   uint64_t cursor_out;
   uint64_t offset_pos;
 
   memcached_return_t addKey(const char* key, size_t key_length, time_t exp) {
-    UNUSED(exp);
     if (r.size() < limit) {
-      std::string received_key(key, key_length);
-      if (common::MatchPattern(received_key, pattern)) {
+      if (filter && !filter->IsTTLAllowed(ConvertFromExpiration(exp, server_time))) {
+        return MEMCACHED_SUCCESS;
+      }
+
+      if (glob.Match(key, key_length)) {
         if (offset_pos == 0) {
-          r.push_back(received_key);
+          r.push_back(std::string(key, key_length));
         } else {
           offset_pos--;
         }
@@ -199,6 +231,122 @@ memcached_return_t memcached_dump_ttl_callback(const memcached_st* ptr,
   return holder->CheckKey(key, key_length, exp);
 }
 
+#define MEMCACHED_END_REPLY "END\r\n"
+#define MEMCACHED_READ_CHUNK_SIZE (16 * 1024)
+
+bool IsErrorReply(const std::string& reply) {
+  return reply.compare(0, 5, "ERROR") == 0 || reply.compare(0, 12, "CLIENT_ERROR") == 0 ||
+         reply.compare(0, 12, "SERVER_ERROR") == 0;
+}
+
+// ascii reply of stats commands, lines up to END line
+common::Error ReadStatsReply(common::net::ClientSocketTcp* client, std::string* out) {
+  const size_t end_size = sizeof(MEMCACHED_END_REPLY) - 1;
+  out->clear();
+  while (true) {
+    std::string chunk;
+    size_t nread = 0;
+    common::ErrnoError errn = client->Read(&chunk, MEMCACHED_READ_CHUNK_SIZE, &nread);
+    if (errn) {
+      return common::make_error_from_errno(errn);
+    }
+
+    if (nread == 0) {
+      return common::make_error("Connection closed");
+    }
+
+    out->append(chunk.data(), nread);
+    const size_t size = out->size();
+    if (size >= 2 && out->compare(size - 2, 2, "\r\n") == 0 && IsErrorReply(*out)) {
+      return common::make_error(out->substr(0, size - 2));
+    }
+
+    if (size >= end_size && out->compare(size - end_size, end_size, MEMCACHED_END_REPLY) == 0 &&
+        (size == end_size || (*out)[size - end_size - 1] == '\n')) {
+      return common::Error();
+    }
+  }
+}
+
+common::Error ExecStats(common::net::ClientSocketTcp* client, const std::string& command, std::string* out) {
+  size_t nwrite = 0;
+  common::ErrnoError errn = client->Write(command, &nwrite);
+  if (errn) {
+    return common::make_error_from_errno(errn);
+  }
+
+  return ReadStatsReply(client, out);
+}
+
+// libmemcached dump drops value size which "stats cachedump" reports in "ITEM <key> [<bytes> b; <exp> s]" lines
+common::Error DumpItemsSizes(common::net::ClientSocketTcp* client, std::map<std::string, size_t>* sizes) {
+  std::string items;
+  common::Error err = ExecStats(client, "stats items\r\n", &items);
+  if (err) {
+    return err;
+  }
+
+  std::vector<unsigned int> slabs;
+  for (size_t pos = 0; pos < items.size();) {
+    size_t end = items.find("\r\n", pos);
+    if (end == std::string::npos) {
+      end = items.size();
+    }
+
+    const std::string line = items.substr(pos, end - pos);
+    pos = end + 2;
+    unsigned int slab = 0;
+    unsigned long long number = 0;
+    if (sscanf(line.c_str(), "STAT items:%u:number %llu", &slab, &number) == 2 && number != 0) {
+      slabs.push_back(slab);
+    }
+  }
+
+  for (unsigned int slab : slabs) {
+    std::string dump;
+    err = ExecStats(client, common::MemSPrintf("stats cachedump %u 0\r\n", slab), &dump);
+    if (err) {
+      return err;
+    }
+
+    for (size_t pos = 0; pos < dump.size();) {
+      size_t end = dump.find("\r\n", pos);
+      if (end == std::string::npos) {
+        end = dump.size();
+      }
+
+      const std::string line = dump.substr(pos, end - pos);
+      pos = end + 2;
+      if (line.compare(0, 5, "ITEM ") != 0) {
+        continue;
+      }
+
+      const size_t key_end = line.find(" [", 5);
+      if (key_end == std::string::npos) {
+        continue;
+      }
+
+      const unsigned long long bytes = strtoull(line.c_str() + key_end + 2, NULL, 10);
+      (*sizes)[line.substr(5, key_end - 5)] = bytes;
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error DumpItemsSizes(const common::net::HostAndPort& host, std::map<std::string, size_t>* sizes) {
+  common::net::ClientSocketTcp client(host);
+  common::ErrnoError errn = client.Connect();
+  if (errn) {
+    return common::make_error_from_errno(errn);
+  }
+
+  common::Error err = DumpItemsSizes(&client, sizes);
+  common::ErrnoError close_err = client.Close();
+  DCHECK(!close_err) << "Close client error: " << close_err->GetDescription();
+  return err;
+}
+
 }  // namespace
 
 namespace fastonosql {
@@ -844,17 +992,7 @@ common::Error DBConnection::TTL(key_t key, ttl_t* expiration) {
     return err;
   }
 
-  time_t cur_t = time(NULL);
-  time_t server_t = current_info_.time;
-  if (cur_t > exp) {
-    if (server_t > exp) {
-      *expiration = NO_TTL;
-    } else {
-      *expiration = EXPIRED_TTL;
-    }
-  } else {
-    *expiration = exp - cur_t;
-  }
+  *expiration = ConvertFromExpiration(exp, current_info_.time);
   return common::Error();
 }
 
@@ -886,6 +1024,87 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
   return common::Error();
 }
 
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsTypeAllowed(common::Value::TYPE_STRING)) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
+  // libmemcached dump carries expiration but not value length, so size filtering needs all candidates before paging
+  const bool with_size = filter.HasSizeRange();
+  ScanHolder hld(with_size ? 0 : cursor_in, pattern, with_size ? std::numeric_limits<uint64_t>::max() : count_keys,
+                 &filter, current_info_.time);
+  memcached_dump_fn func[1] = {0};
+  func[0] = memcached_dump_scan_callback;
+  common::Error err =
+      CheckResultCommand(DB_SCAN_COMMAND, memcached_dump(connection_.handle_, func, &hld, SIZEOFMASS(func)));
+  if (err) {
+    return err;
+  }
+
+  if (!with_size) {
+    *keys_out = hld.r;
+    *cursor_out = hld.cursor_out;
+    return common::Error();
+  }
+
+  // sizes from one cachedump pass, ascii stats aren't served to SASL clients so there values are read
+  auto conf = GetConfig();
+  const bool is_sasl = !conf->user.empty() && !conf->password.empty();
+  std::map<std::string, size_t> sizes;
+  if (!is_sasl) {
+    err = DumpItemsSizes(conf->host, &sizes);
+    if (err) {
+      return err;
+    }
+  }
+
+  uint64_t offset_pos = cursor_in;
+  uint64_t lcursor_out = 0;
+  std::vector<std::string> lkeys_out;
+  for (size_t i = 0; i < hld.r.size(); ++i) {
+    if (lkeys_out.size() == count_keys) {
+      lcursor_out = cursor_in + count_keys;
+      break;
+    }
+
+    size_t value_size = 0;
+    if (is_sasl) {
+      std::string value_str;
+      if (GetInner(hld.r[i], &value_str)) {
+        continue;
+      }
+      value_size = value_str.size();
+    } else {
+      auto it = sizes.find(hld.r[i]);
+      if (it == sizes.end()) {  // gone between dumps
+        continue;
+      }
+      value_size = it->second;
+    }
+
+    if (!filter.IsSizeAllowed(value_size)) {
+      continue;
+    }
+
+    if (offset_pos == 0) {
+      lkeys_out.push_back(hld.r[i]);
+    } else {
+      offset_pos--;
+    }
+  }
+
+  *keys_out = lkeys_out;
+  *cursor_out = lcursor_out;
+  return common::Error();
+}
+
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      keys_limit_t limit,
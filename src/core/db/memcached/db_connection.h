@@ -67,6 +67,12 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
                                  keys_limit_t count_keys,
                                  std::vector<std::string>* keys_out,
                                  cursor_t* cursor_out) override;
+  virtual common::Error ScanFilteredImpl(cursor_t cursor_in,
+                                         const std::string& pattern,
+                                         keys_limit_t count_keys,
+                                         const KeysFilter& filter,
+                                         std::vector<std::string>* keys_out,
+                                         cursor_t* cursor_out) override;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  keys_limit_t limit,
@@ -3104,27 +3104,24 @@ common::Error DBConnection::XAddImpl(const NDbKValue& key, NDbKValue* added_key,
 }
 
 common::Error DBConnection::XRangeImpl(const NKey& key, NDbKValue* loaded_key, fastonosql::core::FastoObject* out) {
-  command_buffer_t get_cmd;
-  redis_translator_t tran = GetSpecificTranslator<redis_compatible::CommandTranslator>();
-  common::Error err = tran->LoadKeyCommand(key, StreamValue::TYPE_STREAM, &get_cmd);
-  if (err) {
-    return err;
-  }
+  TypedCommand xrange_cmd("XRANGE");
+  xrange_cmd << key.GetKey() << "-" << "+";
 
   redisReply* reply = NULL;
-  err = redis_compatible::ExecRedisCommand(connection_.handle_, get_cmd, &reply);
+  common::Error err = ExecRead(xrange_cmd.GetArgv(), std::string(), &reply);
   if (err) {
     return err;
   }
 
   if (reply->type == REDIS_REPLY_NIL) {
-    // key_t key_str = key.GetKey();
+    freeReplyObject(reply);
     return GenerateError("XRANGE", "key not found.");
   }
 
   CHECK(reply->type == REDIS_REPLY_ARRAY) << "Unexpected replay type: " << reply->type;
   err = CliFormatReplyRaw(out, reply);
   if (err) {
+    freeReplyObject(reply);
     return err;
   }
 
@@ -0,0 +1,548 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/async_connection.h"
+
+#if defined(OS_WIN)
+#include <winsock2.h>
+#define poll WSAPoll
+#else
+#include <poll.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <hiredis/hiredis.h>
+
+#include <common/convert2string.h>  // for ConvertToString
+#include <common/sprintf.h>         // for MemSPrintf
+
+#include "core/db/redis_compatible/db_connection.h"  // for ValueFromReplay
+#include "core/logger.h"
+
+#define REDIS_AUTH_COMMAND "AUTH"
+#define REDIS_SELECT_COMMAND "SELECT"
+
+#define ASYNC_LOOP_TICK_MSEC 100  // latency of posted tasks while sockets polled
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+common::Error MakeContextError(redisContext* context) {
+  if (context->errstr[0] != '\0') {
+    return common::make_error(context->errstr);
+  }
+
+  return common::make_error("Connection closed");
+}
+
+}  // namespace
+
+AsyncConnection::AsyncConnection() : context_(nullptr), want_write_(false), next_id_(0), pending_() {}
+
+AsyncConnection::~AsyncConnection() {
+  Disconnect();
+}
+
+common::Error AsyncConnection::Connect(const Config& config, async_callback_t on_ready) {
+  if (context_) {
+    return common::Error();
+  }
+
+  if (config.is_ssl) {
+    return common::make_error("SSL connections not supported in async mode.");
+  }
+
+  redisContext* lcontext = nullptr;
+  if (!config.hostsocket.empty()) {
+    lcontext = redisConnectUnixNonBlock(config.hostsocket.c_str());
+  } else {
+    const std::string host = config.host.GetHost();
+    lcontext = redisConnectNonBlock(host.c_str(), config.host.GetPort());
+  }
+
+  if (!lcontext) {
+    return common::make_error("Could not allocate redis context.");
+  }
+
+  if (lcontext->err) {
+    const std::string buff = common::MemSPrintf("Could not connect to Redis at %s : %s",
+                                                common::ConvertToString(config.host), lcontext->errstr);
+    redisFree(lcontext);
+    return common::make_error(buff);
+  }
+
+  context_ = lcontext;
+
+  std::vector<commands_args_t> handshake;
+  if (!config.auth.empty()) {
+    handshake.push_back({REDIS_AUTH_COMMAND, config.auth});
+  }
+  if (config.db_num != Config::db_num_default) {
+    handshake.push_back({REDIS_SELECT_COMMAND, common::ConvertToString(config.db_num)});
+  }
+
+  if (handshake.empty()) {
+    if (on_ready) {
+      on_ready(common::Error(), common::ValueSPtr());
+    }
+    return common::Error();
+  }
+
+  // first error of handshake reported, rest of it finished by disconnect
+  std::shared_ptr<bool> reported = std::make_shared<bool>(false);
+  for (size_t i = 0; i < handshake.size(); ++i) {
+    const bool last = i == handshake.size() - 1;
+    async_callback_t cb = [this, on_ready, reported, last](common::Error err, common::ValueSPtr reply) {
+      if (*reported) {
+        return;
+      }
+
+      if (err) {
+        *reported = true;
+        if (on_ready) {
+          on_ready(err, reply);
+        }
+        Disconnect();
+        return;
+      }
+
+      if (last) {
+        *reported = true;
+        if (on_ready) {
+          on_ready(common::Error(), common::ValueSPtr());
+        }
+      }
+    };
+
+    common::Error err = Send(handshake[i], cb, false);
+    if (err) {
+      Disconnect();
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
+void AsyncConnection::Disconnect() {
+  Fail(common::make_error("Connection closed"));
+}
+
+bool AsyncConnection::IsConnected() const {
+  return context_ != nullptr;
+}
+
+common::Error AsyncConnection::Send(const commands_args_t& argv,
+                                    async_callback_t cb,
+                                    bool streaming,
+                                    async_request_id_t* id) {
+  if (!context_) {
+    return common::make_error("Not connected");
+  }
+
+  if (argv.empty()) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  std::vector<const char*> argvc(argv.size());
+  std::vector<size_t> argvlen(argv.size());
+  for (size_t i = 0; i < argv.size(); ++i) {
+    argvc[i] = argv[i].data();
+    argvlen[i] = argv[i].size();
+  }
+
+  if (redisAppendCommandArgv(context_, static_cast<int>(argv.size()), argvc.data(), argvlen.data()) != REDIS_OK) {
+    return MakeContextError(context_);
+  }
+
+  Request req;
+  req.id = ++next_id_;
+  req.cb = cb;
+  req.streaming = streaming;
+  pending_.push_back(req);
+  want_write_ = true;
+  if (id) {
+    *id = req.id;
+  }
+  return common::Error();
+}
+
+void AsyncConnection::Cancel(async_request_id_t id) {
+  for (Request& req : pending_) {
+    if (req.id != id) {
+      continue;
+    }
+
+    async_callback_t cb = req.cb;
+    req.cb = async_callback_t();
+    if (cb) {
+      cb(common::make_error(common::COMMON_EINTR), common::ValueSPtr());
+    }
+    return;
+  }
+}
+
+size_t AsyncConnection::GetPendingCount() const {
+  size_t count = 0;
+  for (const Request& req : pending_) {
+    if (req.cb) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int AsyncConnection::GetFd() const {
+  if (!context_) {
+    return -1;
+  }
+
+  return context_->fd;
+}
+
+bool AsyncConnection::IsWantWrite() const {
+  return want_write_;
+}
+
+void AsyncConnection::HandleRead() {
+  if (!context_) {
+    return;
+  }
+
+  if (redisBufferRead(context_) != REDIS_OK) {
+    Fail(MakeContextError(context_));
+    return;
+  }
+
+  while (context_) {  // callbacks can disconnect
+    void* raw = NULL;
+    if (redisGetReplyFromReader(context_, &raw) != REDIS_OK) {
+      Fail(MakeContextError(context_));
+      return;
+    }
+
+    if (!raw) {
+      return;
+    }
+
+    redisReply* reply = static_cast<redisReply*>(raw);
+    common::Value* val = nullptr;
+    common::Error err = ValueFromReplay(reply, &val);
+    freeReplyObject(reply);
+    common::ValueSPtr value(val);
+    if (pending_.empty()) {  // reply without request
+      DNOTREACHED();
+      continue;
+    }
+
+    Request req = pending_.front();
+    if (!req.streaming) {
+      pending_.pop_front();
+    }
+    if (req.cb) {
+      req.cb(err, value);
+    }
+  }
+}
+
+void AsyncConnection::HandleWrite() {
+  if (!context_) {
+    return;
+  }
+
+  int done = 0;
+  if (redisBufferWrite(context_, &done) != REDIS_OK) {  // also failed non blocking connect
+    Fail(MakeContextError(context_));
+    return;
+  }
+
+  want_write_ = !done;
+}
+
+void AsyncConnection::Fail(common::Error err) {
+  std::deque<Request> pending;
+  pending.swap(pending_);
+  if (context_) {
+    redisFree(context_);
+    context_ = nullptr;
+  }
+  want_write_ = false;
+
+  for (const Request& req : pending) {
+    if (req.cb) {
+      req.cb(err, common::ValueSPtr());
+    }
+  }
+}
+
+AsyncLoop::AsyncLoop() : tasks_mutex_(), tasks_cond_(), tasks_(), stop_(true), thread_(), connections_() {}
+
+AsyncLoop::~AsyncLoop() {
+  Stop();
+}
+
+AsyncLoop* AsyncLoop::GetShared() {
+  static AsyncLoop loop;
+  loop.Start();
+  return &loop;
+}
+
+void AsyncLoop::Start() {
+  std::unique_lock<std::mutex> lock(tasks_mutex_);
+  if (!stop_) {
+    return;
+  }
+
+  stop_ = false;
+  thread_ = std::thread(&AsyncLoop::Run, this);
+}
+
+void AsyncLoop::Stop() {
+  {
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    if (stop_) {
+      return;
+    }
+    stop_ = true;
+  }
+
+  tasks_cond_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void AsyncLoop::Post(task_t task) {
+  {
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    tasks_.push_back(task);
+  }
+  tasks_cond_.notify_all();
+}
+
+void AsyncLoop::Add(AsyncConnection* connection) {
+  if (!connection) {
+    DNOTREACHED();
+    return;
+  }
+
+  if (std::find(connections_.begin(), connections_.end(), connection) == connections_.end()) {
+    connections_.push_back(connection);
+  }
+}
+
+void AsyncLoop::Remove(AsyncConnection* connection) {
+  connections_.erase(std::remove(connections_.begin(), connections_.end(), connection), connections_.end());
+}
+
+common::Error AsyncLoop::RunOnce(int timeout_msec) {
+  std::deque<task_t> tasks;
+  {
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    tasks.swap(tasks_);
+  }
+  for (const task_t& task : tasks) {
+    task();
+  }
+
+  std::vector<pollfd> fds;
+  std::vector<AsyncConnection*> ready;
+  fds.reserve(connections_.size());
+  ready.reserve(connections_.size());
+  for (AsyncConnection* connection : connections_) {
+    const int fd = connection->GetFd();
+    if (fd < 0) {
+      continue;
+    }
+
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    if (connection->IsWantWrite()) {
+      pfd.events |= POLLOUT;
+    }
+    pfd.revents = 0;
+    fds.push_back(pfd);
+    ready.push_back(connection);
+  }
+
+  if (fds.empty()) {  // nothing to poll, sleep until task posted
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    tasks_cond_.wait_for(lock, std::chrono::milliseconds(timeout_msec),
+                         [this]() { return stop_ || !tasks_.empty(); });
+    return common::Error();
+  }
+
+  int res = poll(fds.data(), fds.size(), timeout_msec);
+  if (res < 0) {
+    if (errno == EINTR) {
+      return common::Error();
+    }
+    return common::make_error(common::MemSPrintf("poll error: %s", strerror(errno)));
+  }
+
+  // connections removed only by tasks, so all of ready alive here
+  for (size_t i = 0; i < fds.size() && res > 0; ++i) {
+    const short revents = fds[i].revents;
+    if (revents == 0) {
+      continue;
+    }
+
+    if (revents & POLLOUT) {
+      ready[i]->HandleWrite();
+    }
+    if (revents & (POLLIN | POLLERR | POLLHUP)) {
+      ready[i]->HandleRead();
+    }
+  }
+
+  return common::Error();
+}
+
+void AsyncLoop::Run() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(tasks_mutex_);
+      if (stop_) {
+        return;
+      }
+    }
+
+    common::Error err = RunOnce(ASYNC_LOOP_TICK_MSEC);
+    if (err) {
+      LOG_CORE_MSG(err->GetDescription(), common::logging::LOG_LEVEL_WARNING, true);
+    }
+  }
+}
+
+AsyncStream::State::State() : mutex(), cond(), run(0), canceled(false), replies(), err() {}
+
+void AsyncStream::State::Push(uint64_t run_id, common::Error error, common::ValueSPtr reply) {
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (run_id != run) {
+      return;
+    }
+
+    if (error) {
+      if (!err) {
+        err = error;
+      }
+    } else {
+      replies.push_back(reply);
+    }
+  }
+  cond.notify_all();
+}
+
+AsyncStream::AsyncStream() : state_(std::make_shared<State>()) {}
+
+common::Error AsyncStream::Run(const Config& config, const commands_args_t& argv, reply_callback_t on_reply) {
+  if (argv.empty() || !on_reply) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  std::shared_ptr<State> state = state_;
+  uint64_t run = 0;
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    run = ++state->run;
+    state->replies.clear();
+    state->err = common::Error();
+  }
+
+  AsyncLoop* loop = AsyncLoop::GetShared();
+  std::shared_ptr<AsyncConnection> connection = std::make_shared<AsyncConnection>();
+  const Config lconfig = config;
+  loop->Post([loop, connection, lconfig, argv, state, run]() {
+    async_callback_t push = [state, run](common::Error err, common::ValueSPtr reply) { state->Push(run, err, reply); };
+    common::Error err = connection->Connect(lconfig, [push](common::Error err, common::ValueSPtr reply) {
+      if (err) {  // AUTH or SELECT failed
+        push(err, reply);
+      }
+    });
+    if (err) {
+      push(err, common::ValueSPtr());
+      return;
+    }
+
+    loop->Add(connection.get());
+    err = connection->Send(argv, push, true);
+    if (err) {
+      push(err, common::ValueSPtr());
+    }
+  });
+
+  common::Error err;
+  while (!err) {
+    std::deque<common::ValueSPtr> replies;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->cond.wait(lock, [state]() { return state->canceled || state->err || !state->replies.empty(); });
+      if (state->canceled) {
+        err = common::make_error(common::COMMON_EINTR);
+        break;
+      }
+
+      if (state->replies.empty()) {
+        err = state->err;
+        break;
+      }
+      replies.swap(state->replies);
+    }
+
+    for (const common::ValueSPtr& reply : replies) {
+      err = on_reply(reply);
+      if (err) {
+        break;
+      }
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    ++state->run;  // rest of replies dropped
+  }
+  loop->Post([loop, connection]() {
+    loop->Remove(connection.get());
+    connection->Disconnect();
+  });
+  return err;
+}
+
+void AsyncStream::SetCanceled(bool canceled) {
+  {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->canceled = canceled;
+  }
+  state_->cond.notify_all();
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,150 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <common/error.h>
+#include <common/value.h>
+
+#include "core/db/redis_compatible/config.h"
+#include "core/types.h"
+
+struct redisContext;
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+typedef uint64_t async_request_id_t;
+// err - reply error, canceled (COMMON_EINTR) or connection closed, called on AsyncLoop thread
+typedef std::function<void(common::Error err, common::ValueSPtr reply)> async_callback_t;
+
+// non blocking connection, many requests in flight on one socket, replies delivered in order,
+// streaming request (MONITOR, SUBSCRIBE) gets every reply after its own one,
+// used only from thread of AsyncLoop it added to
+class AsyncConnection {
+ public:
+  AsyncConnection();
+  ~AsyncConnection();
+
+  // tcp or unix socket, without ssh/ssl, on_ready called with result of AUTH and SELECT,
+  // failed of them disconnects
+  common::Error Connect(const Config& config, async_callback_t on_ready) WARN_UNUSED_RESULT;
+  void Disconnect();  // pending requests finished with error
+  bool IsConnected() const;
+
+  common::Error Send(const commands_args_t& argv,
+                     async_callback_t cb,
+                     bool streaming,
+                     async_request_id_t* id = nullptr) WARN_UNUSED_RESULT;
+
+  // callback called immediately with COMMON_EINTR, server reply dropped on arrival
+  void Cancel(async_request_id_t id);
+  size_t GetPendingCount() const;
+
+ private:
+  friend class AsyncLoop;
+
+  struct Request {
+    async_request_id_t id;
+    async_callback_t cb;  // empty - canceled
+    bool streaming;
+  };
+
+  int GetFd() const;
+  bool IsWantWrite() const;
+  void HandleRead();
+  void HandleWrite();
+  void Fail(common::Error err);
+
+  redisContext* context_;
+  bool want_write_;
+  async_request_id_t next_id_;
+  std::deque<Request> pending_;
+};
+
+// one thread services connections of many servers: polls all sockets and dispatches ready ones
+class AsyncLoop {
+ public:
+  typedef std::function<void()> task_t;
+
+  AsyncLoop();
+  ~AsyncLoop();
+
+  static AsyncLoop* GetShared();  // started on first use
+
+  void Start();
+  void Stop();
+  void Post(task_t task);  // thread safe, task runs on loop thread
+
+  // loop thread
+  void Add(AsyncConnection* connection);
+  void Remove(AsyncConnection* connection);
+  common::Error RunOnce(int timeout_msec) WARN_UNUSED_RESULT;
+
+ private:
+  void Run();
+
+  std::mutex tasks_mutex_;
+  std::condition_variable tasks_cond_;
+  std::deque<task_t> tasks_;
+  bool stop_;
+  std::thread thread_;
+  std::vector<AsyncConnection*> connections_;
+};
+
+// runs streaming command on own connection of shared AsyncLoop, replies handed to calling thread,
+// SetCanceled from any thread wakes it at once
+class AsyncStream {
+ public:
+  typedef std::function<common::Error(common::ValueSPtr reply)> reply_callback_t;
+
+  AsyncStream();
+
+  // until canceled (COMMON_EINTR), connection or on_reply error
+  common::Error Run(const Config& config, const commands_args_t& argv, reply_callback_t on_reply) WARN_UNUSED_RESULT;
+  void SetCanceled(bool canceled);
+
+ private:
+  struct State {
+    State();
+
+    void Push(uint64_t run_id, common::Error error, common::ValueSPtr reply);
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint64_t run;  // replies of previous runs dropped
+    bool canceled;
+    std::deque<common::ValueSPtr> replies;
+    common::Error err;
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
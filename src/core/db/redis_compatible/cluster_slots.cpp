@@ -0,0 +1,341 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/cluster_slots.h"
+
+extern "C" {
+#include "sds.h"
+}
+
+#include <common/macros.h>       // for SIZEOFMASS
+#include <common/string_util.h>  // for StartsWithASCII
+
+#include "core/command_holder.h"  // for CommandHolder
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+struct Crc16Table {
+  Crc16Table() {
+    for (uint16_t i = 0; i < 256; ++i) {
+      uint16_t crc = i << 8;
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+      }
+      values[i] = crc;
+    }
+  }
+
+  uint16_t values[256];
+};
+
+const Crc16Table kCrc16Table;
+
+const char* kMultiKeyCommands[] = {"MGET", "DEL", "UNLINK", "EXISTS", "TOUCH"};
+
+bool IsMultiKeyCommand(const CommandHolder* cmd) {
+  for (size_t i = 0; i < SIZEOFMASS(kMultiKeyCommands); ++i) {
+    if (cmd->IsEqualName(kMultiKeyCommands[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsKeyedCommand(const CommandHolder* cmd) {
+  return common::StartsWithASCII(cmd->params, "<key>", true) || common::StartsWithASCII(cmd->params, "key", true);
+}
+
+}  // namespace
+
+uint16_t Crc16(const char* buf, size_t len) {  // CRC16-CCITT (XModem) as redis cluster
+  uint16_t crc = 0;
+  for (size_t i = 0; i < len; ++i) {
+    crc = (crc << 8) ^ kCrc16Table.values[((crc >> 8) ^ static_cast<uint8_t>(buf[i])) & 0x00FF];
+  }
+  return crc;
+}
+
+slot_t KeyHashSlot(const command_buffer_t& key) {
+  const size_t start = key.find('{');
+  if (start != command_buffer_t::npos) {
+    const size_t end = key.find('}', start + 1);
+    if (end != command_buffer_t::npos && end != start + 1) {
+      return Crc16(key.data() + start + 1, end - start - 1) & (REDIS_CLUSTER_SLOTS - 1);
+    }
+  }
+
+  return Crc16(key.data(), key.size()) & (REDIS_CLUSTER_SLOTS - 1);
+}
+
+SlotMap::SlotMap() : slots_(REDIS_CLUSTER_SLOTS, -1), hosts_() {}
+
+bool SlotMap::IsEmpty() const {
+  return hosts_.empty();
+}
+
+void SlotMap::Clear() {
+  slots_.assign(REDIS_CLUSTER_SLOTS, -1);
+  hosts_.clear();
+}
+
+void SlotMap::SetSlotOwner(slot_t slot, const host_t& host) {
+  SetSlotsOwner(slot, slot, host);
+}
+
+void SlotMap::SetSlotsOwner(slot_t start, slot_t end, const host_t& host) {
+  if (start > end || end >= REDIS_CLUSTER_SLOTS) {
+    return;
+  }
+
+  int index = -1;
+  for (size_t i = 0; i < hosts_.size(); ++i) {
+    if (hosts_[i] == host) {
+      index = static_cast<int>(i);
+      break;
+    }
+  }
+
+  if (index == -1) {
+    index = static_cast<int>(hosts_.size());
+    hosts_.push_back(host);
+  }
+
+  for (size_t i = start; i <= end; ++i) {
+    slots_[i] = index;
+  }
+}
+
+void SlotMap::RemoveHost(const host_t& host) {
+  for (size_t i = 0; i < hosts_.size(); ++i) {
+    if (hosts_[i] != host) {
+      continue;
+    }
+
+    const int index = static_cast<int>(i);
+    for (size_t j = 0; j < slots_.size(); ++j) {
+      if (slots_[j] == index) {
+        slots_[j] = -1;
+      } else if (slots_[j] > index) {
+        slots_[j]--;
+      }
+    }
+    hosts_.erase(hosts_.begin() + i);
+    return;
+  }
+}
+
+bool SlotMap::GetSlotOwner(slot_t slot, host_t* host) const {
+  if (!host || slot >= REDIS_CLUSTER_SLOTS) {
+    return false;
+  }
+
+  const int index = slots_[slot];
+  if (index == -1) {
+    return false;
+  }
+
+  *host = hosts_[index];
+  return true;
+}
+
+bool SlotMap::GetKeyOwner(const command_buffer_t& key, host_t* host) const {
+  return GetSlotOwner(KeyHashSlot(key), host);
+}
+
+SlotCommand::SlotCommand() : keyed(false), slot(0), command(), keys() {}
+
+SlotCommand::SlotCommand(slot_t slot, const command_buffer_t& command)
+    : keyed(true), slot(slot), command(command), keys() {}
+
+common::Error SplitCommandBySlots(const ICommandTranslator* translator,
+                                  const command_buffer_t& command,
+                                  std::vector<SlotCommand>* commands) {
+  if (!translator || command.empty() || !commands) {
+    return common::make_error_inval();
+  }
+
+  int argc;
+  sds* argv = sdssplitargslong(command.data(), &argc);
+  if (!argv) {
+    return common::make_error_inval();
+  }
+
+  commands_args_t standart_argv;
+  for (int i = 0; i < argc; ++i) {
+    standart_argv.push_back(command_buffer_t(argv[i], sdslen(argv[i])));
+  }
+  sdsfreesplitres(argv, argc);
+
+  const CommandHolder* cmd = nullptr;
+  size_t off = 0;
+  common::Error err = translator->FindCommand(standart_argv, &cmd, &off);
+  if (err || !IsKeyedCommand(cmd) || standart_argv.size() <= off) {  // unknown or without keys, node decides
+    SlotCommand keyless;
+    keyless.command = command;
+    commands->push_back(keyless);
+    return common::Error();
+  }
+
+  if (!IsMultiKeyCommand(cmd) || standart_argv.size() == off + 1) {
+    commands->push_back(SlotCommand(KeyHashSlot(standart_argv[off]), command));
+    return common::Error();
+  }
+
+  std::vector<slot_t> slots;  // in order of first key appearance
+  std::vector<TypedCommand> sliced;
+  std::vector<std::vector<size_t>> positions;
+  for (size_t i = off; i < standart_argv.size(); ++i) {
+    const command_buffer_t key = standart_argv[i];
+    const slot_t slot = KeyHashSlot(key);
+    size_t pos = 0;
+    while (pos < slots.size() && slots[pos] != slot) {
+      pos++;
+    }
+
+    if (pos == slots.size()) {
+      slots.push_back(slot);
+      TypedCommand head;
+      for (size_t j = 0; j < off; ++j) {
+        head << standart_argv[j];
+      }
+      sliced.push_back(head);
+      positions.push_back(std::vector<size_t>());
+    }
+    sliced[pos] << key;
+    positions[pos].push_back(i - off);
+  }
+
+  for (size_t i = 0; i < slots.size(); ++i) {
+    SlotCommand part(slots[i], sliced[i].GetCommandLine());
+    part.keys = positions[i];
+    commands->push_back(part);
+  }
+  return common::Error();
+}
+
+common::Error ParseClusterSlots(common::ArrayValue* reply, SlotMap* map) {
+  if (!reply || !map) {
+    return common::make_error_inval();
+  }
+
+  SlotMap slots;
+  for (size_t i = 0; i < reply->GetSize(); ++i) {
+    common::Value* range = nullptr;
+    common::ArrayValue* range_arr = nullptr;
+    if (!reply->Get(i, &range) || !range->GetAsList(&range_arr) || range_arr->GetSize() < 3) {
+      return common::make_error("Invalid CLUSTER SLOTS reply");
+    }
+
+    common::Value* start = nullptr;
+    common::Value* end = nullptr;
+    common::Value* master = nullptr;
+    common::ArrayValue* master_arr = nullptr;
+    common::Value* port = nullptr;
+    long long start_slot = 0;
+    long long end_slot = 0;
+    long long port_num = 0;
+    std::string host;
+    if (!range_arr->Get(0, &start) || !start->GetAsLongLongInteger(&start_slot) || !range_arr->Get(1, &end) ||
+        !end->GetAsLongLongInteger(&end_slot) || !range_arr->Get(2, &master) || !master->GetAsList(&master_arr) ||
+        master_arr->GetSize() < 2 || !master_arr->GetString(0, &host) || !master_arr->Get(1, &port) ||
+        !port->GetAsLongLongInteger(&port_num)) {
+      return common::make_error("Invalid CLUSTER SLOTS reply");
+    }
+
+    if (start_slot < 0 || end_slot >= REDIS_CLUSTER_SLOTS || start_slot > end_slot) {
+      return common::make_error("Invalid CLUSTER SLOTS range");
+    }
+
+    slots.SetSlotsOwner(static_cast<slot_t>(start_slot), static_cast<slot_t>(end_slot),
+                        SlotMap::host_t(host, static_cast<uint16_t>(port_num)));
+  }
+
+  *map = slots;
+  return common::Error();
+}
+
+common::Error MergeSlotReplies(const std::vector<SlotCommand>& parts,
+                               const std::vector<common::Value*>& replies,
+                               common::Value** out) {
+  if (parts.empty() || parts.size() != replies.size() || !out) {
+    return common::make_error_inval();
+  }
+
+  for (common::Value* reply : replies) {
+    if (!reply) {
+      return common::make_error_inval();
+    }
+  }
+
+  if (parts.size() == 1) {
+    *out = replies[0]->DeepCopy();
+    return common::Error();
+  }
+
+  if (replies[0]->GetType() == common::Value::TYPE_LONG_LONG_INTEGER) {
+    long long total = 0;
+    for (common::Value* reply : replies) {
+      long long count = 0;
+      if (!reply->GetAsLongLongInteger(&count)) {
+        return common::make_error("Can't merge replies of different types");
+      }
+      total += count;
+    }
+
+    *out = common::Value::CreateLongLongIntegerValue(total);
+    return common::Error();
+  }
+
+  size_t keys_count = 0;
+  for (const SlotCommand& part : parts) {
+    keys_count += part.keys.size();
+  }
+
+  std::vector<common::Value*> values(keys_count, nullptr);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    common::ArrayValue* arr = nullptr;
+    if (!replies[i]->GetAsList(&arr) || arr->GetSize() != parts[i].keys.size()) {
+      return common::make_error("Can't merge replies of different types");
+    }
+
+    for (size_t j = 0; j < parts[i].keys.size(); ++j) {
+      common::Value* val = nullptr;
+      const size_t pos = parts[i].keys[j];
+      if (pos >= keys_count || !arr->Get(j, &val)) {
+        return common::make_error_inval();
+      }
+      values[pos] = val;
+    }
+  }
+
+  common::ArrayValue* merged = common::Value::CreateArrayValue();
+  for (common::Value* val : values) {
+    merged->Append(val ? val->DeepCopy() : common::Value::CreateNullValue());
+  }
+
+  *out = merged;
+  return common::Error();
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
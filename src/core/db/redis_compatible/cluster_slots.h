@@ -0,0 +1,91 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint16_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>      // for Error
+#include <common/net/types.h>  // for HostAndPort
+#include <common/value.h>      // for ArrayValue
+
+#include "core/icommand_translator.h"  // for ICommandTranslator
+
+#define REDIS_CLUSTER_SLOTS 16384
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+typedef uint16_t slot_t;
+
+uint16_t Crc16(const char* buf, size_t len);
+slot_t KeyHashSlot(const command_buffer_t& key);  // hash only {tag} part if key contains it
+
+// slot -> node table of cluster, loaded from CLUSTER SLOTS and patched by MOVED replies
+class SlotMap {
+ public:
+  typedef common::net::HostAndPort host_t;
+
+  SlotMap();
+
+  bool IsEmpty() const;
+  void Clear();
+
+  void SetSlotOwner(slot_t slot, const host_t& host);
+  void SetSlotsOwner(slot_t start, slot_t end, const host_t& host);  // [start, end]
+  void RemoveHost(const host_t& host);
+
+  bool GetSlotOwner(slot_t slot, host_t* host) const WARN_UNUSED_RESULT;
+  bool GetKeyOwner(const command_buffer_t& key, host_t* host) const WARN_UNUSED_RESULT;
+
+ private:
+  std::vector<int> slots_;  // index in hosts_ or -1
+  std::vector<host_t> hosts_;
+};
+
+struct SlotCommand {
+  SlotCommand();
+  SlotCommand(slot_t slot, const command_buffer_t& command);
+
+  bool keyed;  // false for commands without keys (INFO, PING, ...)
+  slot_t slot;
+  command_buffer_t command;
+  std::vector<size_t> keys;  // positions of keys in source command, for parts of split command
+};
+
+// commands with "<key> [key ...]" arguments (MGET, DEL, UNLINK, EXISTS, TOUCH) split into one command per slot,
+// other keyed commands routed by first key
+common::Error SplitCommandBySlots(const ICommandTranslator* translator,
+                                  const command_buffer_t& command,
+                                  std::vector<SlotCommand>* commands) WARN_UNUSED_RESULT;
+
+// reply of CLUSTER SLOTS: [start, end, [host, port, id], replicas...] for every range
+common::Error ParseClusterSlots(common::ArrayValue* reply, SlotMap* map) WARN_UNUSED_RESULT;
+
+// one reply for parts of split command: MGET values back in order of keys, counters (DEL, EXISTS, ...) summed
+common::Error MergeSlotReplies(const std::vector<SlotCommand>& parts,
+                               const std::vector<common::Value*>& replies,
+                               common::Value** out) WARN_UNUSED_RESULT;
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
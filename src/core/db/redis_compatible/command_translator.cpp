@@ -44,6 +44,8 @@
 #define REDIS_PERSIST_KEY_COMMAND "PERSIST"
 
 #define REDIS_GET_TTL_COMMAND DB_GET_TTL_COMMAND
+#define REDIS_TYPE_COMMAND "TYPE"
+#define REDIS_MEMORY_USAGE_COMMAND "MEMORY USAGE"
 #define REDIS_PUBLISH_COMMAND DB_PUBLISH_COMMAND
 #define REDIS_SUBSCRIBE_COMMAND DB_SUBSCRIBE_COMMAND
 
@@ -75,6 +77,44 @@ namespace fastonosql {
 namespace core {
 namespace redis_compatible {
 
+namespace {
+
+void AppendValueArgs(NValue value, TypedCommand* cmd) {
+  common::Value* val = value.get();
+  if (!val) {
+    return;
+  }
+
+  const common::Value::Type type = val->GetType();
+  if (type == common::Value::TYPE_ARRAY) {
+    common::ArrayValue* array = static_cast<common::ArrayValue*>(val);
+    for (auto it = array->begin(); it != array->end(); ++it) {
+      *cmd << ConvertValue(*it, DEFAULT_DELIMITER);
+    }
+  } else if (type == common::Value::TYPE_SET) {
+    common::SetValue* set = static_cast<common::SetValue*>(val);
+    for (auto it = set->begin(); it != set->end(); ++it) {
+      *cmd << ConvertValue(*it, DEFAULT_DELIMITER);
+    }
+  } else if (type == common::Value::TYPE_ZSET) {
+    common::ZSetValue* zset = static_cast<common::ZSetValue*>(val);
+    for (auto it = zset->begin(); it != zset->end(); ++it) {
+      auto v = *it;
+      *cmd << ConvertValue(v.first, DEFAULT_DELIMITER) << ConvertValue(v.second, DEFAULT_DELIMITER);
+    }
+  } else if (type == common::Value::TYPE_HASH) {
+    common::HashValue* hash = static_cast<common::HashValue*>(val);
+    for (auto it = hash->begin(); it != hash->end(); ++it) {
+      auto v = *it;
+      *cmd << ConvertValue(v.first, DEFAULT_DELIMITER) << ConvertValue(v.second, DEFAULT_DELIMITER);
+    }
+  } else {
+    *cmd << ConvertValue(val, DEFAULT_DELIMITER);
+  }
+}
+
+}  // namespace
+
 CommandTranslator::CommandTranslator(const std::vector<CommandHolder>& commands) : ICommandTranslator(commands) {}
 
 const char* CommandTranslator::GetDBName() const {
@@ -86,14 +126,17 @@ common::Error CommandTranslator::Zrange(const NKey& key,
                                         int stop,
                                         bool withscores,
                                         command_buffer_t* cmdstring) {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_ZRANGE " " << key_str.GetForCommandLine() << " " << start << " " << stop;
-  if (withscores) {
-    wr << " WITHSCORES";
+  if (!cmdstring) {
+    return common::make_error_inval();
   }
 
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Zrange(key, start, stop, withscores, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -102,10 +145,13 @@ common::Error CommandTranslator::Hgetall(const NKey& key, command_buffer_t* cmds
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_HGETALL " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Hgetall(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -114,16 +160,13 @@ common::Error CommandTranslator::Mset(const std::vector<NDbKValue>& keys, comman
     return common::make_error_inval();
   }
 
-  command_buffer_writer_t wr;
-  wr << REDIS_MSET;
-  for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i].GetKey();
-    key_t key_str = key.GetKey();
-    NValue value = keys[i].GetValue();
-    value_t value_str = value.GetValue();
-    wr << " " << key_str.GetForCommandLine() << " " << value_str.GetForCommandLine();
+  TypedCommand cmd;
+  common::Error err = Mset(keys, &cmd);
+  if (err) {
+    return err;
   }
-  *cmdstring = wr.str();
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -132,16 +175,13 @@ common::Error CommandTranslator::MsetNX(const std::vector<NDbKValue>& keys, comm
     return common::make_error_inval();
   }
 
-  command_buffer_writer_t wr;
-  wr << REDIS_MSETNX;
-  for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i].GetKey();
-    key_t key_str = key.GetKey();
-    NValue value = keys[i].GetValue();
-    value_t value_str = value.GetValue();
-    wr << " " << key_str.GetForCommandLine() << " " << value_str.GetForCommandLine();
+  TypedCommand cmd;
+  common::Error err = MsetNX(keys, &cmd);
+  if (err) {
+    return err;
   }
-  *cmdstring = wr.str();
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -150,13 +190,13 @@ common::Error CommandTranslator::Mget(const std::vector<NKey>& keys, command_buf
     return common::make_error_inval();
   }
 
-  command_buffer_writer_t wr;
-  wr << REDIS_MGET;
-  for (size_t i = 0; i < keys.size(); ++i) {
-    key_t key_str = keys[i].GetKey();
-    wr << " " << key_str.GetForCommandLine();
+  TypedCommand cmd;
+  common::Error err = Mget(keys, &cmd);
+  if (err) {
+    return err;
   }
-  *cmdstring = wr.str();
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -165,10 +205,13 @@ common::Error CommandTranslator::Smembers(const NKey& key, command_buffer_t* cmd
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_SMEMBERS " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Smembers(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -177,10 +220,13 @@ common::Error CommandTranslator::Lrange(const NKey& key, int start, int stop, co
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_LRANGE " " << key_str.GetForCommandLine() << " " << start << " " << stop;
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Lrange(key, start, stop, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -189,13 +235,13 @@ common::Error CommandTranslator::SetEx(const NDbKValue& key, ttl_t ttl, command_
     return common::make_error_inval();
   }
 
-  const NKey cur = key.GetKey();
-  key_t key_str = cur.GetKey();
-  NValue value = key.GetValue();
-  value_t value_str = value.GetValue();
-  command_buffer_writer_t wr;
-  wr << REDIS_SETEX " " << key_str.GetForCommandLine() << " " << ttl << " " << value_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = SetEx(key, ttl, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -204,13 +250,13 @@ common::Error CommandTranslator::SetNX(const NDbKValue& key, command_buffer_t* c
     return common::make_error_inval();
   }
 
-  const NKey cur = key.GetKey();
-  key_t key_str = cur.GetKey();
-  NValue value = key.GetValue();
-  value_t value_str = value.GetValue();
-  command_buffer_writer_t wr;
-  wr << REDIS_SETNX " " << key_str.GetForCommandLine() << " " << value_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = SetNX(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -219,10 +265,13 @@ common::Error CommandTranslator::Decr(const NKey& key, command_buffer_t* cmdstri
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_DECR " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Decr(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -231,10 +280,13 @@ common::Error CommandTranslator::DecrBy(const NKey& key, int inc, command_buffer
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_DECRBY " " << key_str.GetForCommandLine() << " " << inc;
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = DecrBy(key, inc, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -243,10 +295,13 @@ common::Error CommandTranslator::Incr(const NKey& key, command_buffer_t* cmdstri
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_INCR " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Incr(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -255,10 +310,13 @@ common::Error CommandTranslator::IncrBy(const NKey& key, int inc, command_buffer
     return common::make_error_inval();
   }
 
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_INCRBY " " << key_str.GetForCommandLine() << " " << inc;
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = IncrBy(key, inc, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -297,23 +355,425 @@ common::Error CommandTranslator::ModuleUnload(const ModuleInfo& module, command_
 }
 
 common::Error CommandTranslator::PExpire(const NKey& key, ttl_t ttl, command_buffer_t* cmdstring) const {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  if (ttl == NO_TTL) {
-    wr << REDIS_PERSIST_KEY_COMMAND " " << key_str.GetForCommandLine();
-  } else {
-    wr << REDIS_CHANGE_PTTL_COMMAND " " << key_str.GetForCommandLine() << " " << ttl;
+  if (!cmdstring) {
+    return common::make_error_inval();
   }
 
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = PExpire(key, ttl, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
 common::Error CommandTranslator::PTTL(const NKey& key, command_buffer_t* cmdstring) const {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_GET_PTTL_COMMAND " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  if (!cmdstring) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand cmd;
+  common::Error err = PTTL(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
+  return common::Error();
+}
+
+common::Error CommandTranslator::CreateKeyCommand(const NDbKValue& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  std::vector<TypedCommand> cmds;
+  common::Error err = CreateKeyCommands(key, &cmds);
+  if (err) {
+    return err;
+  }
+
+  if (cmds.size() != 1) {
+    return InvalidInputArguments(REDIS_SET_KEY_STREAM_COMMAND);
+  }
+
+  *cmd = cmds[0];
+  return common::Error();
+}
+
+common::Error CommandTranslator::CreateKeyCommands(const NDbKValue& key, std::vector<TypedCommand>* cmds) const {
+  if (!cmds) {
+    return common::make_error_inval();
+  }
+
+  const NKey cur = key.GetKey();
+  key_t key_str = cur.GetKey();
+  NValue value = key.GetValue();
+  common::Value::Type type = key.GetType();
+
+  TypedCommand create_cmd;
+  if (type == common::Value::TYPE_ARRAY) {
+    create_cmd = TypedCommand(REDIS_SET_KEY_ARRAY_COMMAND);
+    create_cmd << key_str;
+    AppendValueArgs(value, &create_cmd);
+  } else if (type == common::Value::TYPE_SET) {
+    create_cmd = TypedCommand(REDIS_SET_KEY_SET_COMMAND);
+    create_cmd << key_str;
+    AppendValueArgs(value, &create_cmd);
+  } else if (type == common::Value::TYPE_ZSET) {
+    create_cmd = TypedCommand(REDIS_SET_KEY_ZSET_COMMAND);
+    create_cmd << key_str;
+    AppendValueArgs(value, &create_cmd);
+  } else if (type == common::Value::TYPE_HASH) {
+    create_cmd = TypedCommand(REDIS_SET_KEY_HASH_COMMAND);
+    create_cmd << key_str;
+    AppendValueArgs(value, &create_cmd);
+  } else if (type == StreamValue::TYPE_STREAM) {  // one XADD per stream id
+    StreamValue* stream = static_cast<StreamValue*>(value.get());
+    const StreamValue::streams_t& streams = stream->GetStreams();
+    if (streams.empty()) {
+      return InvalidInputArguments(REDIS_SET_KEY_STREAM_COMMAND);
+    }
+
+    std::vector<TypedCommand> xadd_cmds;
+    for (size_t i = 0; i < streams.size(); ++i) {
+      const StreamValue::Stream& cur_str = streams[i];
+      TypedCommand xadd_cmd(REDIS_SET_KEY_STREAM_COMMAND);
+      xadd_cmd << key_str << cur_str.id_;
+      for (size_t j = 0; j < cur_str.entries_.size(); ++j) {
+        xadd_cmd << cur_str.entries_[j].name << cur_str.entries_[j].value;
+      }
+      xadd_cmds.push_back(xadd_cmd);
+    }
+
+    *cmds = xadd_cmds;
+    return common::Error();
+  } else if (type == JsonValue::TYPE_JSON) {
+    create_cmd = TypedCommand(REDIS_SET_KEY_JSON_COMMAND);
+    create_cmd << key_str << "." << value.GetValue();
+  } else if (type == GraphValue::TYPE_GRAPH) {
+    return NotSupported(REDIS_GRAPH_MODULE_COMMAND("SET"));
+  } else if (type == BloomValue::TYPE_BLOOM) {
+    return NotSupported(REDIS_BLOOM_MODULE_COMMAND("SET"));
+  } else if (type == SearchValue::TYPE_FT_INDEX) {
+    return NotSupported(REDIS_SEARCH_MODULE_COMMAND("INDEX.SET"));
+  } else if (type == SearchValue::TYPE_FT_TERM) {
+    return NotSupported(REDIS_SEARCH_MODULE_COMMAND("TERM.SET"));
+  } else {
+    create_cmd = TypedCommand(REDIS_SET_KEY_COMMAND);
+    create_cmd << key_str << value.GetValue();
+  }
+
+  *cmds = std::vector<TypedCommand>(1, create_cmd);
+  return common::Error();
+}
+
+common::Error CommandTranslator::Get(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand get_cmd(REDIS_GET_KEY_COMMAND);
+  get_cmd << key.GetKey();
+  *cmd = get_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Del(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand del_cmd(REDIS_DELETE_KEY_COMMAND);
+  del_cmd << key.GetKey();
+  *cmd = del_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Rename(const NKey& key, const key_t& new_name, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand rename_cmd(REDIS_RENAME_KEY_COMMAND);
+  rename_cmd << key.GetKey() << new_name;
+  *cmd = rename_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Expire(const NKey& key, ttl_t ttl, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  if (ttl == NO_TTL) {
+    TypedCommand persist_cmd(REDIS_PERSIST_KEY_COMMAND);
+    persist_cmd << key.GetKey();
+    *cmd = persist_cmd;
+    return common::Error();
+  }
+
+  TypedCommand expire_cmd(REDIS_CHANGE_TTL_COMMAND);
+  expire_cmd << key.GetKey() << ttl;
+  *cmd = expire_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::TTL(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand ttl_cmd(REDIS_GET_TTL_COMMAND);
+  ttl_cmd << key.GetKey();
+  *cmd = ttl_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Type(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand type_cmd(REDIS_TYPE_COMMAND);
+  type_cmd << key.GetKey();
+  *cmd = type_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Scan(cursor_t cursor_in,
+                                      const std::string& pattern,
+                                      keys_limit_t count_keys,
+                                      TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand scan_cmd(DB_SCAN_COMMAND);
+  scan_cmd << cursor_in << "MATCH" << pattern << "COUNT" << count_keys;
+  *cmd = scan_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Scan(cursor_t cursor_in,
+                                      const std::string& pattern,
+                                      keys_limit_t count_keys,
+                                      const std::string& type,
+                                      TypedCommand* cmd) const {
+  if (!cmd || type.empty()) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand scan_cmd(DB_SCAN_COMMAND);
+  scan_cmd << cursor_in << "MATCH" << pattern << "COUNT" << count_keys << "TYPE" << type;
+  *cmd = scan_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::MemoryUsage(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand usage_cmd(REDIS_MEMORY_USAGE_COMMAND);
+  usage_cmd << key.GetKey();
+  *cmd = usage_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Zrange(const NKey& key,
+                                        int start,
+                                        int stop,
+                                        bool withscores,
+                                        TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand zrange_cmd(REDIS_ZRANGE);
+  zrange_cmd << key.GetKey() << start << stop;
+  if (withscores) {
+    zrange_cmd << "WITHSCORES";
+  }
+
+  *cmd = zrange_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Hgetall(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand hgetall_cmd(REDIS_HGETALL);
+  hgetall_cmd << key.GetKey();
+  *cmd = hgetall_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Mget(const std::vector<NKey>& keys, TypedCommand* cmd) const {
+  if (keys.empty() || !cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand mget_cmd(REDIS_MGET);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    mget_cmd << keys[i].GetKey();
+  }
+  *cmd = mget_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Mset(const std::vector<NDbKValue>& keys, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand mset_cmd(REDIS_MSET);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    NKey key = keys[i].GetKey();
+    NValue value = keys[i].GetValue();
+    mset_cmd << key.GetKey() << value.GetValue();
+  }
+  *cmd = mset_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::MsetNX(const std::vector<NDbKValue>& keys, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand msetnx_cmd(REDIS_MSETNX);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    NKey key = keys[i].GetKey();
+    NValue value = keys[i].GetValue();
+    msetnx_cmd << key.GetKey() << value.GetValue();
+  }
+  *cmd = msetnx_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Smembers(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand smembers_cmd(REDIS_SMEMBERS);
+  smembers_cmd << key.GetKey();
+  *cmd = smembers_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Lrange(const NKey& key, int start, int stop, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand lrange_cmd(REDIS_LRANGE);
+  lrange_cmd << key.GetKey() << start << stop;
+  *cmd = lrange_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::SetEx(const NDbKValue& key, ttl_t ttl, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  const NKey cur = key.GetKey();
+  NValue value = key.GetValue();
+  TypedCommand setex_cmd(REDIS_SETEX);
+  setex_cmd << cur.GetKey() << ttl << value.GetValue();
+  *cmd = setex_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::SetNX(const NDbKValue& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  const NKey cur = key.GetKey();
+  NValue value = key.GetValue();
+  TypedCommand setnx_cmd(REDIS_SETNX);
+  setnx_cmd << cur.GetKey() << value.GetValue();
+  *cmd = setnx_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Decr(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand decr_cmd(REDIS_DECR);
+  decr_cmd << key.GetKey();
+  *cmd = decr_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::DecrBy(const NKey& key, int inc, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand decrby_cmd(REDIS_DECRBY);
+  decrby_cmd << key.GetKey() << inc;
+  *cmd = decrby_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::Incr(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand incr_cmd(REDIS_INCR);
+  incr_cmd << key.GetKey();
+  *cmd = incr_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::IncrBy(const NKey& key, int inc, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand incrby_cmd(REDIS_INCRBY);
+  incrby_cmd << key.GetKey() << inc;
+  *cmd = incrby_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::PExpire(const NKey& key, ttl_t ttl, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  if (ttl == NO_TTL) {
+    TypedCommand persist_cmd(REDIS_PERSIST_KEY_COMMAND);
+    persist_cmd << key.GetKey();
+    *cmd = persist_cmd;
+    return common::Error();
+  }
+
+  TypedCommand pexpire_cmd(REDIS_CHANGE_PTTL_COMMAND);
+  pexpire_cmd << key.GetKey() << ttl;
+  *cmd = pexpire_cmd;
+  return common::Error();
+}
+
+common::Error CommandTranslator::PTTL(const NKey& key, TypedCommand* cmd) const {
+  if (!cmd) {
+    return common::make_error_inval();
+  }
+
+  TypedCommand pttl_cmd(REDIS_GET_PTTL_COMMAND);
+  pttl_cmd << key.GetKey();
+  *cmd = pttl_cmd;
   return common::Error();
 }
 
@@ -399,43 +859,50 @@ common::Error CommandTranslator::LoadKeyCommandImpl(const NKey& key,
 }
 
 common::Error CommandTranslator::DeleteKeyCommandImpl(const NKey& key, command_buffer_t* cmdstring) const {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_DELETE_KEY_COMMAND " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Del(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
 common::Error CommandTranslator::RenameKeyCommandImpl(const NKey& key,
                                                       const key_t& new_name,
                                                       command_buffer_t* cmdstring) const {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_RENAME_KEY_COMMAND " " << key_str.GetForCommandLine() << " " << new_name.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = Rename(key, new_name, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
 common::Error CommandTranslator::ChangeKeyTTLCommandImpl(const NKey& key,
                                                          ttl_t ttl,
                                                          command_buffer_t* cmdstring) const {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  if (ttl == NO_TTL) {
-    wr << REDIS_PERSIST_KEY_COMMAND " " << key_str.GetForCommandLine();
-  } else {
-    wr << REDIS_CHANGE_TTL_COMMAND " " << key_str.GetForCommandLine() << " " << ttl;
+  TypedCommand cmd;
+  common::Error err = Expire(key, ttl, &cmd);
+  if (err) {
+    return err;
   }
 
-  *cmdstring = wr.str();
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
 common::Error CommandTranslator::LoadKeyTTLCommandImpl(const NKey& key, command_buffer_t* cmdstring) const {
-  key_t key_str = key.GetKey();
-  command_buffer_writer_t wr;
-  wr << REDIS_GET_TTL_COMMAND " " << key_str.GetForCommandLine();
-  *cmdstring = wr.str();
+  TypedCommand cmd;
+  common::Error err = TTL(key, &cmd);
+  if (err) {
+    return err;
+  }
+
+  *cmdstring = cmd.GetCommandLine();
   return common::Error();
 }
 
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/connection_types.h"     // for cursor_t, keys_limit_t
 #include "core/icommand_translator.h"  // for ICommandTranslator
 
 #include "core/module_info.h"
@@ -62,6 +63,43 @@ class CommandTranslator : public ICommandTranslator {
   common::Error PExpire(const NKey& key, ttl_t ttl, command_buffer_t* cmdstring) const WARN_UNUSED_RESULT;
   common::Error PTTL(const NKey& key, command_buffer_t* cmdstring) const WARN_UNUSED_RESULT;
 
+  // typed versions, arguments passed to hiredis as is without escaping
+  using ICommandTranslator::CreateKeyCommand;
+  common::Error CreateKeyCommand(const NDbKValue& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;  // single command
+  common::Error CreateKeyCommands(const NDbKValue& key, std::vector<TypedCommand>* cmds) const
+      WARN_UNUSED_RESULT;  // streams with several ids need several XADD
+  common::Error Get(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Del(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Rename(const NKey& key, const key_t& new_name, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Expire(const NKey& key, ttl_t ttl, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error TTL(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Type(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Scan(cursor_t cursor_in, const std::string& pattern, keys_limit_t count_keys, TypedCommand* cmd) const
+      WARN_UNUSED_RESULT;
+  common::Error Scan(cursor_t cursor_in,
+                     const std::string& pattern,
+                     keys_limit_t count_keys,
+                     const std::string& type,
+                     TypedCommand* cmd) const WARN_UNUSED_RESULT;  // server side type filter, redis >= 6.0
+  common::Error MemoryUsage(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+
+  common::Error Zrange(const NKey& key, int start, int stop, bool withscores, TypedCommand* cmd) const
+      WARN_UNUSED_RESULT;
+  common::Error Hgetall(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Mget(const std::vector<NKey>& keys, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Mset(const std::vector<NDbKValue>& keys, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error MsetNX(const std::vector<NDbKValue>& keys, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Smembers(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Lrange(const NKey& key, int start, int stop, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error SetEx(const NDbKValue& key, ttl_t ttl, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error SetNX(const NDbKValue& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Decr(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error DecrBy(const NKey& key, int inc, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error Incr(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error IncrBy(const NKey& key, int inc, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error PExpire(const NKey& key, ttl_t ttl, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+  common::Error PTTL(const NKey& key, TypedCommand* cmd) const WARN_UNUSED_RESULT;
+
  private:
   virtual common::Error CreateKeyCommandImpl(const NDbKValue& key, command_buffer_t* cmdstring) const override;
   virtual common::Error LoadKeyCommandImpl(const NKey& key,
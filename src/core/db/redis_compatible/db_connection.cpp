@@ -18,22 +18,40 @@
 
 #include "core/db/redis_compatible/db_connection.h"
 
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>      // for copy
+#include <unordered_set>  // for unordered_set
+
 extern "C" {
 #include <hiredis/hiredis.h>
 }
 
+#include <common/file_system/file.h>  // for ANSIFile
 #include <common/file_system/string_path_utils.h>
+#include <common/time.h>  // for current_mstime
 
 #include "core/db/redis_compatible/cluster_infos.h"
 #include "core/db/redis_compatible/database_info.h"
+#include "core/db/redis_compatible/query_cost.h"
+#include "core/db/redis_compatible/resp_stream_reader.h"
 #include "core/db/redis_compatible/sentinel_info.h"
 
+#include "core/value.h"  // for CompactArrayValue
+
 #define GET_SERVER_TYPE "CLUSTER NODES"
 #define GET_SENTINEL_MASTERS "SENTINEL MASTERS"
 #define GET_SENTINEL_SLAVES_PATTERN_1ARGS_S "SENTINEL SLAVES %s"
 
 #define DBSIZE "DBSIZE"
 
+#define COMPACT_ARRAY_MIN_SIZE 1024
+#define REPLY_READ_CHUNK_SIZE (16 * 1024)
+#define REPLY_SPILL_MIN_SIZE (64 * 1024 * 1024)
+#define QUERY_PAGE_SIZE 1000
+#define SAMPLE_INTERRUPT_CHECK_MSEC 100
+
 #define HIREDIS_VERSION    \
   STRINGIZE(HIREDIS_MAJOR) \
   "." STRINGIZE(HIREDIS_MINOR) "." STRINGIZE(HIREDIS_PATCH)
@@ -265,6 +283,46 @@ bool IsPipeLineCommand(const char* command) {
   return !skip;
 }
 
+ChannelTraffic::ChannelTraffic() : messages(0), bytes(0) {}
+
+bool GetNumberOfSubscribers(common::Value* value, long long* count) {
+  common::Value::Type t = value->GetType();
+  if (t == common::Value::TYPE_LONG_LONG_INTEGER) {
+    return value->GetAsLongLongInteger(count);
+  }
+
+  std::string count_str;
+  return t == common::Value::TYPE_STRING && value->GetAsString(&count_str) &&
+         common::ConvertFromString(count_str, count);
+}
+
+void SetChannelsTraffic(const channels_traffic_t& traffic, uint32_t seconds, std::vector<NDbPSChannel>* channels) {
+  if (seconds == 0 || !channels) {
+    DNOTREACHED();
+    return;
+  }
+
+  for (auto it = traffic.begin(); it != traffic.end(); ++it) {
+    const double messages_per_second = static_cast<double>(it->second.messages) / seconds;
+    const double bytes_per_second = static_cast<double>(it->second.bytes) / seconds;
+    bool found = false;
+    for (size_t i = 0; i < channels->size(); ++i) {
+      NDbPSChannel& channel = (*channels)[i];
+      if (channel.GetName() == it->first) {
+        channel.SetTraffic(messages_per_second, bytes_per_second);
+        found = true;
+        break;
+      }
+    }
+
+    if (!found) {  // published without subscribers, or subscribed after PUBSUB CHANNELS
+      NDbPSChannel channel(it->first, 0);
+      channel.SetTraffic(messages_per_second, bytes_per_second);
+      channels->push_back(channel);
+    }
+  }
+}
+
 common::Error PrintRedisContextError(NativeConnection* context) {
   if (!context) {
     DNOTREACHED();
@@ -274,7 +332,332 @@ common::Error PrintRedisContextError(NativeConnection* context) {
   return common::make_error(common::MemSPrintf("Error: %s", context->errstr));
 }
 
+namespace {
+
+bool IsCompactArrayReply(redisReply* r, size_t compact_min_size, size_t* bytes) {
+  if (!compact_min_size || r->type != REDIS_REPLY_ARRAY || r->elements < compact_min_size) {
+    return false;
+  }
+
+  size_t total = 0;
+  for (size_t i = 0; i < r->elements; ++i) {
+    const int type = r->element[i]->type;
+    if (type != REDIS_REPLY_STRING && type != REDIS_REPLY_STATUS) {
+      return false;
+    }
+    total += r->element[i]->len;
+  }
+
+  *bytes = total;
+  return true;
+}
+
+bool IsUserCommand(FastoObject* out) {
+  FastoObjectCommand* command = dynamic_cast<FastoObjectCommand*>(out);
+  return command && command->GetCommandLoggingType() == C_USER;
+}
+
+// error replies become errors, MOVED/ASK carry new node as payload
+common::Error HandleReply(redisReply* rreply, redisReply** out_reply) {
+  if (rreply->type == REDIS_REPLY_ERROR) {
+    if (!strncmp(rreply->str, "MOVED", 5) || !strcmp(rreply->str, "ASK")) {
+      char* p = rreply->str;
+      char* s = strchr(p, ' '); /* MOVED[S]3999 127.0.0.1:6381 */
+      p = strchr(s + 1, ' ');   /* MOVED[S]3999[P]127.0.0.1:6381 */
+      *p = '\0';
+      int slot = atoi(s + 1);
+      s = strrchr(p + 1, ':'); /* MOVED 3999[P]127.0.0.1[S]6381 */
+      *s = '\0';
+
+      std::string hostip = (p + 1);
+      int port = atoi(s + 1);
+      freeReplyObject(rreply);
+      common::Error err = common::make_error(common::COMMON_EINTR);
+      err->SetPayload(new common::net::HostAndPortAndSlot(hostip, port, slot));
+      return err;
+    }
+    std::string str(rreply->str, rreply->len);
+    freeReplyObject(rreply);
+    return common::make_error(str);
+  }
+
+  *out_reply = rreply;
+  return common::Error();
+}
+
+redisReply* CreateReply(int type) {
+  redisReply* r = static_cast<redisReply*>(calloc(1, sizeof(redisReply)));
+  if (r) {
+    r->type = type;
+  }
+  return r;
+}
+
+redisReply* CreateStringReply(int type, const char* data, size_t size) {
+  redisReply* r = CreateReply(type);
+  if (!r) {
+    return nullptr;
+  }
+
+  r->str = static_cast<char*>(malloc(size + 1));
+  if (!r->str) {
+    free(r);
+    return nullptr;
+  }
+  memcpy(r->str, data, size);
+  r->str[size] = '\0';
+  r->len = size;
+  return r;
+}
+
+// builds reply tree the way hiredis does, so it is released with freeReplyObject;
+// bulk strings of at least spill_min_size bytes are written to file instead of memory
+class ReplyTreeBuilder : public RespStreamReader::IObserver {
+ public:
+  ReplyTreeBuilder(const std::string& spill_path, size_t spill_min_size)
+      : root_(nullptr),
+        arrays_(),
+        bulk_(nullptr),
+        bulk_size_(0),
+        bulk_pos_(0),
+        spill_path_(spill_path),
+        spill_min_size_(spill_min_size),
+        spill_file_(nullptr),
+        spilled_to_(),
+        spilled_count_(0),
+        err_() {}
+
+  ~ReplyTreeBuilder() {
+    free(bulk_);
+    CloseSpillFile();
+    freeReplyObject(root_);
+  }
+
+  redisReply* Release() {
+    redisReply* root = root_;
+    root_ = nullptr;
+    return root;
+  }
+
+  common::Error GetError() const { return err_; }
+
+  virtual void OnArrayStart(size_t count) override {
+    if (err_) {  // reply is dropped anyway
+      return;
+    }
+
+    redisReply* r = CreateReply(REDIS_REPLY_ARRAY);
+    if (r && count) {
+      r->element = static_cast<redisReply**>(calloc(count, sizeof(redisReply*)));
+      if (!r->element) {
+        free(r);
+        r = nullptr;
+      }
+    }
+    if (!AddReply(r)) {
+      return;
+    }
+
+    r->elements = count;
+    arrays_.push_back(std::make_pair(r, 0));
+  }
+
+  virtual void OnArrayEnd() override {
+    if (err_) {
+      return;
+    }
+
+    if (!arrays_.empty()) {
+      arrays_.pop_back();
+    }
+  }
+
+  virtual void OnBulkStart(size_t size) override {
+    if (err_) {
+      return;
+    }
+
+    bulk_size_ = size;
+    bulk_pos_ = 0;
+    if (!spill_path_.empty() && size >= spill_min_size_) {
+      const std::string path =
+          common::MemSPrintf("%s.%lld.%llu", spill_path_, static_cast<long long>(common::time::current_mstime()),
+                             spilled_count_++);
+      spill_file_ = new common::file_system::ANSIFile;
+      common::ErrnoError errn = spill_file_->Open(path, "wb");
+      if (!errn) {
+        spilled_to_ = path;
+        return;
+      }
+      CloseSpillFile();  // keep it in memory
+    }
+
+    bulk_ = static_cast<char*>(malloc(size + 1));
+    if (!bulk_) {
+      SetOOM();
+    }
+  }
+
+  virtual void OnBulkChunk(const char* data, size_t size) override {
+    if (err_) {
+      return;
+    }
+
+    if (spill_file_) {
+      if (!spill_file_->Write(std::string(data, size))) {
+        err_ = common::make_error(common::MemSPrintf("Can't write reply to %s", spilled_to_));
+      }
+    } else if (bulk_) {
+      memcpy(bulk_ + bulk_pos_, data, size);
+    }
+    bulk_pos_ += size;
+  }
+
+  virtual void OnBulkEnd() override {
+    if (err_) {
+      return;
+    }
+
+    if (spill_file_) {
+      CloseSpillFile();
+      const std::string note = common::MemSPrintf("(%zu bytes saved to %s)", bulk_size_, spilled_to_);
+      AddReply(CreateStringReply(REDIS_REPLY_STATUS, note.data(), note.size()));
+      return;
+    }
+
+    if (!bulk_) {
+      return;
+    }
+
+    redisReply* r = CreateReply(REDIS_REPLY_STRING);
+    if (!r) {
+      free(bulk_);
+      bulk_ = nullptr;
+      SetOOM();
+      return;
+    }
+
+    bulk_[bulk_size_] = '\0';
+    r->str = bulk_;
+    r->len = bulk_size_;
+    bulk_ = nullptr;
+    AddReply(r);
+  }
+
+  virtual void OnStatus(const char* data, size_t size) override {
+    if (err_) {
+      return;
+    }
+
+    AddReply(CreateStringReply(REDIS_REPLY_STATUS, data, size));
+  }
+
+  virtual void OnError(const char* data, size_t size) override {
+    if (err_) {
+      return;
+    }
+
+    AddReply(CreateStringReply(REDIS_REPLY_ERROR, data, size));
+  }
+
+  virtual void OnInteger(long long value) override {
+    if (err_) {
+      return;
+    }
+
+    redisReply* r = CreateReply(REDIS_REPLY_INTEGER);
+    if (AddReply(r)) {
+      r->integer = value;
+    }
+  }
+
+  virtual void OnNil() override {
+    if (err_) {
+      return;
+    }
+    AddReply(CreateReply(REDIS_REPLY_NIL));
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ReplyTreeBuilder);
+
+  bool AddReply(redisReply* r) {
+    if (!r) {
+      SetOOM();
+      return false;
+    }
+
+    if (arrays_.empty()) {
+      freeReplyObject(root_);
+      root_ = r;
+      return true;
+    }
+
+    std::pair<redisReply*, size_t>& parent = arrays_.back();
+    parent.first->element[parent.second++] = r;
+    return true;
+  }
+
+  void SetOOM() {
+    if (!err_) {
+      err_ = common::make_error("Out of memory while reading reply");
+    }
+  }
+
+  void CloseSpillFile() {
+    if (spill_file_) {
+      spill_file_->Close();
+      delete spill_file_;
+      spill_file_ = nullptr;
+    }
+  }
+
+  redisReply* root_;
+  std::vector<std::pair<redisReply*, size_t>> arrays_;  // opened arrays and filled elements
+  char* bulk_;
+  size_t bulk_size_;
+  size_t bulk_pos_;
+
+  const std::string spill_path_;
+  const size_t spill_min_size_;
+  common::file_system::ANSIFile* spill_file_;
+  std::string spilled_to_;
+  unsigned long long spilled_count_;
+  common::Error err_;
+};
+
+// pmessage, pattern, channel, payload
+void CountChannelMessage(const redisReply* message, channels_traffic_t* traffic) {
+  if (message->type == REDIS_REPLY_ARRAY && message->elements == 4 &&
+      message->element[2]->type == REDIS_REPLY_STRING && message->element[3]->type == REDIS_REPLY_STRING) {
+    ChannelTraffic& channel = (*traffic)[std::string(message->element[2]->str, message->element[2]->len)];
+    channel.messages++;
+    channel.bytes += message->element[3]->len;
+  }
+}
+
+bool IsUnsubscribeConfirmation(const redisReply* reply) {
+  return reply->type == REDIS_REPLY_ARRAY && reply->elements == 3 && reply->element[0]->type == REDIS_REPLY_STRING &&
+         strcasecmp(reply->element[0]->str, "punsubscribe") == 0;
+}
+
+// command was sent but its reply is not fully read, context is unusable until reconnect
+common::Error FailStreamedContext(NativeConnection* c, common::Error err) {
+  if (!c->err) {
+    c->err = REDIS_ERR_OTHER;
+    strncpy(c->errstr, err->GetDescription().c_str(), sizeof(c->errstr) - 1);
+    c->errstr[sizeof(c->errstr) - 1] = 0;
+  }
+  return err;
+}
+
+}  // namespace
+
 common::Error ValueFromReplay(redisReply* r, common::Value** out) {
+  return ValueFromReplay(r, 0, out);
+}
+
+common::Error ValueFromReplay(redisReply* r, size_t compact_min_size, common::Value** out) {
   if (!out || !r) {
     DNOTREACHED();
     return common::make_error_inval();
@@ -303,10 +686,21 @@ common::Error ValueFromReplay(redisReply* r, common::Value** out) {
       break;
     }
     case REDIS_REPLY_ARRAY: {
+      size_t bytes = 0;
+      if (IsCompactArrayReply(r, compact_min_size, &bytes)) {
+        CompactArrayValue* compact = new CompactArrayValue;
+        compact->Reserve(r->elements, bytes);
+        for (size_t i = 0; i < r->elements; ++i) {
+          compact->Append(r->element[i]->str, r->element[i]->len);
+        }
+        *out = compact;
+        break;
+      }
+
       common::ArrayValue* arv = common::Value::CreateArrayValue();
       for (size_t i = 0; i < r->elements; ++i) {
         common::Value* val = NULL;
-        common::Error err = ValueFromReplay(r->element[i], &val);
+        common::Error err = ValueFromReplay(r->element[i], compact_min_size, &val);
         if (err) {
           delete arv;
           return err;
@@ -357,52 +751,111 @@ common::Error ExecRedisCommand(NativeConnection* c,
     return PrintRedisContextError(c);
   }
 
-  redisReply* rreply = static_cast<redisReply*>(reply);
-  if (rreply->type == REDIS_REPLY_ERROR) {
-    if (!strncmp(rreply->str, "MOVED", 5) || !strcmp(rreply->str, "ASK")) {
-      char* p = rreply->str;
-      char* s = strchr(p, ' '); /* MOVED[S]3999 127.0.0.1:6381 */
-      p = strchr(s + 1, ' ');   /* MOVED[S]3999[P]127.0.0.1:6381 */
-      *p = '\0';
-      int slot = atoi(s + 1);
-      s = strrchr(p + 1, ':'); /* MOVED 3999[P]127.0.0.1[S]6381 */
-      *s = '\0';
+  return HandleReply(static_cast<redisReply*>(reply), out_reply);
+}
 
-      std::string hostip = (p + 1);
-      int port = atoi(s + 1);
-      freeReplyObject(rreply);
-      common::Error err = common::make_error(common::COMMON_EINTR);
-      err->SetPayload(new common::net::HostAndPortAndSlot(hostip, port, slot));
-      return err;
-    }
-    std::string str(rreply->str, rreply->len);
-    freeReplyObject(rreply);
-    return common::make_error(str);
+common::Error ExecRedisCommand(NativeConnection* c, const commands_args_t& argv, redisReply** out_reply) {
+  if (argv.empty() || !out_reply) {
+    DNOTREACHED();
+    return common::make_error_inval();
   }
 
-  *out_reply = rreply;
-  return common::Error();
+  std::vector<const char*> argvc(argv.size());
+  std::vector<size_t> argvlen(argv.size());
+  for (size_t i = 0; i < argv.size(); ++i) {
+    argvc[i] = argv[i].data();
+    argvlen[i] = argv[i].size();
+  }
+
+  return ExecRedisCommand(c, static_cast<int>(argv.size()), argvc.data(), argvlen.data(), out_reply);
 }
 
-common::Error ExecRedisCommand(NativeConnection* c, const commands_args_t& argv, redisReply** out_reply) {
+ReplyStreamOptions::ReplyStreamOptions() : interrupted(), progress(), spill_path(), spill_min_size(0) {}
+
+common::Error ExecRedisCommandStreamed(NativeConnection* c,
+                                       const commands_args_t& argv,
+                                       const ReplyStreamOptions& options,
+                                       redisReply** out_reply) {
+  if (!c) {
+    DNOTREACHED();
+    return common::make_error("Not connected");
+  }
+
   if (argv.empty() || !out_reply) {
     DNOTREACHED();
     return common::make_error_inval();
   }
 
-  const char** argvc = static_cast<const char**>(calloc(sizeof(const char*), argv.size()));
-  int argcc = 0;
-  size_t* argvlen = reinterpret_cast<size_t*>(malloc(argv.size() * sizeof(size_t)));
+  if (c->reader->pos < c->reader->len) {  // replies already buffered by hiredis are read by it
+    return ExecRedisCommand(c, argv, out_reply);
+  }
+
+  std::vector<const char*> argvc(argv.size());
+  std::vector<size_t> argvlen(argv.size());
   for (size_t i = 0; i < argv.size(); ++i) {
     argvc[i] = argv[i].data();
     argvlen[i] = argv[i].size();
-    argcc++;
   }
 
-  common::Error err = ExecRedisCommand(c, argcc, argvc, argvlen, out_reply);
-  free(argvlen);
-  free(argvc);
-  return err;
+  int res = redisAppendCommandArgv(c, static_cast<int>(argv.size()), argvc.data(), argvlen.data());
+  if (res == REDIS_ERR) {
+    DNOTREACHED();
+    return PrintRedisContextError(c);
+  }
+
+  int wdone = 0;
+  do {
+    if (redisBufferWrite(c, &wdone) == REDIS_ERR) {
+      return FailStreamedContext(c, PrintRedisContextError(c));
+    }
+  } while (!wdone);
+
+  ReplyTreeBuilder builder(options.spill_path, options.spill_min_size);
+  RespStreamReader reader(&builder);
+  char buf[REPLY_READ_CHUNK_SIZE];
+  while (!reader.IsComplete()) {
+    if (options.interrupted && options.interrupted()) {
+      return FailStreamedContext(c, common::make_error(common::COMMON_EINTR));
+    }
+
+    ssize_t nread = 0;
+    errno = 0;
+    if (redisReadToBuffer(c, buf, sizeof(buf), &nread) == REDIS_ERR) {
+      return FailStreamedContext(c, common::make_error("Needed reconnect."));
+    }
+
+    if (nread == 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {  // nothing read yet, try again
+        continue;
+      }
+      return FailStreamedContext(c, common::make_error("Needed reconnect."));  // closed by server
+    }
+
+    size_t consumed = 0;
+    RespStreamReader::Status st = reader.Feed(buf, static_cast<size_t>(nread), &consumed);
+    if (st == RespStreamReader::PROTOCOL_ERROR) {
+      return FailStreamedContext(c, common::make_error(reader.GetError()));
+    }
+
+    common::Error err = builder.GetError();
+    if (err) {
+      return FailStreamedContext(c, err);
+    }
+
+    if (consumed < static_cast<size_t>(nread)) {  // next replies stay for hiredis
+      redisReaderFeed(c->reader, buf + consumed, static_cast<size_t>(nread) - consumed);
+    }
+
+    if (options.progress && reader.GetDeclaredSize()) {
+      options.progress(reader.GetReceivedSize(), reader.GetDeclaredSize());
+    }
+  }
+
+  return HandleReply(builder.Release(), out_reply);
+}
+
+common::Error ExecRedisCommand(NativeConnection* c, const TypedCommand& command, redisReply** out_reply) {
+  return ExecRedisCommand(c, command.GetArgv(), out_reply);
 }
 
 common::Error ExecRedisCommand(NativeConnection* c, command_buffer_t command, redisReply** out_reply) {
@@ -488,6 +941,12 @@ bool DBConnection<Config, ContType>::IsAuthenticated() const {
   return is_auth_;
 }
 
+template <typename Config, connectionTypes ContType>
+void DBConnection<Config, ContType>::SetInterrupted(bool interrupted) {
+  base_class::SetInterrupted(interrupted);
+  stream_.SetCanceled(interrupted);
+}
+
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::CommonExec(const commands_args_t& argv, FastoObject* out) {
   if (!out || argv.empty()) {
@@ -500,26 +959,31 @@ common::Error DBConnection<Config, ContType>::CommonExec(const commands_args_t&
     return err;
   }
 
+  // replies of user commands are only displayed, big ones are kept compact and huge strings are spilled;
+  // internal commands read results as common::ArrayValue
+  const bool user_command = IsUserCommand(out);
   redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, argv, &reply);
+  err = ExecRead(argv, user_command ? out->GetSpillPath() : std::string(), &reply);
   if (err) {
     return err;
   }
 
-  err = CliFormatReplyRaw(out, reply);
+  err = CliFormatReplyRaw(out, reply, user_command ? COMPACT_ARRAY_MIN_SIZE : 0);
   freeReplyObject(reply);
   return err;
 }
 
 template <typename Config, connectionTypes ContType>
-common::Error DBConnection<Config, ContType>::CliFormatReplyRaw(FastoObject* out, redisReply* r) {
+common::Error DBConnection<Config, ContType>::CliFormatReplyRaw(FastoObject* out,
+                                                                redisReply* r,
+                                                                size_t compact_min_size) {
   if (!out || !r) {
     DNOTREACHED();
     return common::make_error_inval();
   }
 
   common::Value* out_val = nullptr;
-  common::Error err = ValueFromReplay(r, &out_val);
+  common::Error err = ValueFromReplay(r, compact_min_size, &out_val);
   if (err) {
     if (err->GetDescription() == "NOAUTH") {  //"NOAUTH Authentication
                                               // required."
@@ -564,6 +1028,182 @@ common::Error DBConnection<Config, ContType>::CliReadReply(FastoObject* out) {
   return er;
 }
 
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::ExecStreamed(const commands_args_t& argv,
+                                                           const std::string& spill_path,
+                                                           redisReply** out_reply) {
+  ReplyStreamOptions options;
+  options.interrupted = [this]() { return this->IsInterrupted(); };
+  CDBConnectionClient* client = base_class::client_;
+  if (client) {
+    options.progress = [client](size_t received, size_t declared) { client->OnReplyProgress(received, declared); };
+  }
+  options.spill_path = spill_path;
+  options.spill_min_size = REPLY_SPILL_MIN_SIZE;
+
+  NativeConnection* handle = base_class::connection_.handle_;
+  common::Error err = ExecRedisCommandStreamed(handle, argv, options, out_reply);
+  if (!err || !handle || !handle->err) {
+    return err;
+  }
+
+  // context failed after command was sent, rest of reply may still be in socket,
+  // start over with clean connection in same database
+  const config_t config = base_class::GetConfig();
+  const int db_num = cur_db_;
+  common::Error reconnect_err = Disconnect();
+  if (!reconnect_err) {
+    reconnect_err = Connect(config);
+  }
+  if (!reconnect_err && db_num != invalid_db_num) {
+    IDataBaseInfo* info = nullptr;
+    reconnect_err = SelectImpl(common::ConvertToString(db_num), &info);
+    delete info;
+  }
+
+  return reconnect_err ? reconnect_err : err;
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::PreflightCommand(const commands_args_t& argv,
+                                                               FastoObject* out,
+                                                               size_t* paged_cardinality) {
+  *paged_cardinality = 0;
+  CDBConnectionClient* client = base_class::client_;
+  if (!client) {
+    return common::Error();
+  }
+
+  const size_t threshold = client->GetQueryCostThreshold();
+  commands_args_t probe;
+  if (!threshold || !GetQueryCostProbe(argv, &probe)) {
+    return common::Error();
+  }
+
+  // probe is only advice, command goes on as is if it fails
+  redisReply* reply = NULL;
+  common::Error err = ExecRedisCommand(base_class::connection_.handle_, probe, &reply);
+  if (err) {
+    return common::Error();
+  }
+
+  const long long cardinality = reply->type == REDIS_REPLY_INTEGER ? reply->integer : 0;
+  freeReplyObject(reply);
+  const size_t estimated = EstimateQueryCost(argv, cardinality);
+  if (estimated <= threshold) {
+    return common::Error();
+  }
+
+  // only user commands can be refused, explorer and inner loads are always read page by page
+  const command_buffer_t command = TypedCommand(argv).GetCommandLine();
+  if (IsUserCommand(out) && client->OnQueryCostExceeded(command, estimated) == QUERY_COST_REJECT) {
+    return common::make_error(common::MemSPrintf(
+        "%s would return about %zu elements (threshold %zu), confirm to execute it.", command, estimated, threshold));
+  }
+
+  *paged_cardinality = static_cast<size_t>(cardinality);
+  return common::Error();
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::ExecRead(const commands_args_t& argv,
+                                                       const std::string& spill_path,
+                                                       redisReply** out_reply) {
+  if (base_class::IsPagedCommand() && QueryPager(argv, 0, QUERY_PAGE_SIZE).IsValid()) {
+    return ExecPaged(argv, out_reply);
+  }
+
+  return ExecStreamed(argv, spill_path, out_reply);
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::ExecPaged(const commands_args_t& argv, redisReply** out_reply) {
+  const size_t cardinality = base_class::GetPagedCardinality();
+  QueryPager pager(argv, cardinality, QUERY_PAGE_SIZE);
+  const size_t item_size = pager.GetItemSize();
+  const size_t estimated = EstimateQueryCost(argv, static_cast<long long>(cardinality));
+  CDBConnectionClient* client = base_class::client_;
+
+  // elements are moved out of pages, SCAN can return same item more than once
+  std::vector<redisReply*> elements;
+  std::unordered_set<std::string> scanned;
+  common::Error err;
+  while (!pager.IsDone()) {
+    if (base_class::IsInterrupted()) {  // between pages connection stays clean
+      err = common::make_error(common::COMMON_EINTR);
+      break;
+    }
+
+    redisReply* page = NULL;
+    err = ExecRedisCommand(base_class::connection_.handle_, pager.GetPage(), &page);
+    if (err) {
+      break;
+    }
+
+    redisReply* items = page;
+    std::string position;
+    if (pager.IsScan()) {
+      if (page->type != REDIS_REPLY_ARRAY || page->elements != 2 || page->element[0]->type != REDIS_REPLY_STRING ||
+          page->element[1]->type != REDIS_REPLY_ARRAY) {
+        freeReplyObject(page);
+        err = common::make_error("Unexpected reply of paged command");
+        break;
+      }
+      position.assign(page->element[0]->str, page->element[0]->len);
+      items = page->element[1];
+    } else if (page->type != REDIS_REPLY_ARRAY) {
+      freeReplyObject(page);
+      err = common::make_error("Unexpected reply of paged command");
+      break;
+    } else if (page->elements) {  // stream entries are [id, fields]
+      redisReply* last = page->element[page->elements - 1];
+      if (last->type == REDIS_REPLY_ARRAY && last->elements && last->element[0]->type == REDIS_REPLY_STRING) {
+        position.assign(last->element[0]->str, last->element[0]->len);
+      }
+    }
+
+    const size_t count = items->elements / item_size;
+    for (size_t i = 0; i < count * item_size; i += item_size) {
+      redisReply* first = items->element[i];
+      if (pager.IsScan() && !scanned.insert(std::string(first->str ? first->str : "", first->len)).second) {
+        continue;
+      }
+      for (size_t j = i; j < i + item_size; ++j) {
+        elements.push_back(items->element[j]);
+        items->element[j] = NULL;
+      }
+    }
+    freeReplyObject(page);
+
+    pager.NextPage(position, count);
+    if (client) {
+      client->OnReplyProgress(elements.size() / item_size, estimated);
+    }
+  }
+
+  redisReply* merged = err ? NULL : CreateReply(REDIS_REPLY_ARRAY);
+  if (merged && !elements.empty()) {
+    merged->element = static_cast<redisReply**>(calloc(elements.size(), sizeof(redisReply*)));
+    if (merged->element) {
+      std::copy(elements.begin(), elements.end(), merged->element);
+      merged->elements = elements.size();
+    } else {
+      free(merged);
+      merged = NULL;
+    }
+  }
+
+  if (!merged) {
+    for (redisReply* element : elements) {
+      freeReplyObject(element);
+    }
+    return err ? err : common::make_error("Out of memory");
+  }
+
+  *out_reply = merged;
+  return common::Error();
+}
+
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::Auth(const std::string& password) {
   common::Error err = base_class::TestIsConnected();
@@ -578,6 +1218,7 @@ common::Error DBConnection<Config, ContType>::Auth(const std::string& password)
   }
 
   is_auth_ = true;
+  auth_ = password;
   return common::Error();
 }
 
@@ -595,7 +1236,7 @@ common::Error DBConnection<Config, ContType>::Lpush(const NKey& key, NValue arr,
 
   NDbKValue rarr(key, arr);
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t lpush_cmd;
+  TypedCommand lpush_cmd;
   err = tran->CreateKeyCommand(rarr, &lpush_cmd);
   if (err) {
     return err;
@@ -633,14 +1274,14 @@ common::Error DBConnection<Config, ContType>::Lrange(const NKey& key, int start,
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t lrange_cmd;
+  TypedCommand lrange_cmd;
   err = tran->Lrange(key, start, stop, &lrange_cmd);
   if (err) {
     return err;
   }
 
   redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, lrange_cmd, &reply);
+  err = ExecRead(lrange_cmd.GetArgv(), std::string(), &reply);
   if (err) {
     return err;
   }
@@ -679,7 +1320,7 @@ common::Error DBConnection<Config, ContType>::Mget(const std::vector<NKey>& keys
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t mget_cmd;
+  TypedCommand mget_cmd;
   err = tran->Mget(keys, &mget_cmd);
   if (err) {
     return err;
@@ -692,7 +1333,7 @@ common::Error DBConnection<Config, ContType>::Mget(const std::vector<NKey>& keys
   }
 
   if (reply->type != REDIS_REPLY_ARRAY) {
-    NOTREACHED() << mget_cmd << "command should return array somthing changed?";
+    NOTREACHED() << mget_cmd.GetCommandLine() << "command should return array somthing changed?";
     return common::Error();
   }
 
@@ -731,7 +1372,7 @@ common::Error DBConnection<Config, ContType>::Mset(const std::vector<NDbKValue>&
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t mset_cmd;
+  TypedCommand mset_cmd;
   err = tran->Mset(keys, &mset_cmd);
   if (err) {
     return err;
@@ -762,7 +1403,7 @@ common::Error DBConnection<Config, ContType>::MsetNX(const std::vector<NDbKValue
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t msetnx_cmd;
+  TypedCommand msetnx_cmd;
   err = tran->MsetNX(keys, &msetnx_cmd);
   if (err) {
     return err;
@@ -798,7 +1439,7 @@ common::Error DBConnection<Config, ContType>::DBConnection::SetEx(const NDbKValu
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t setex_cmd;
+  TypedCommand setex_cmd;
   err = tran->SetEx(key, ttl, &setex_cmd);
   if (err) {
     return err;
@@ -828,7 +1469,7 @@ common::Error DBConnection<Config, ContType>::DBConnection::SetNX(const NDbKValu
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t setnx_cmd;
+  TypedCommand setnx_cmd;
   err = tran->SetNX(key, &setnx_cmd);
   if (err) {
     return err;
@@ -866,7 +1507,7 @@ common::Error DBConnection<Config, ContType>::Decr(const NKey& key, long long* d
     return err;
   }
 
-  std::string decr_cmd;
+  TypedCommand decr_cmd;
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
   err = tran->Decr(key, &decr_cmd);
   if (err) {
@@ -905,7 +1546,7 @@ common::Error DBConnection<Config, ContType>::DBConnection::DecrBy(const NKey& k
     return err;
   }
 
-  std::string decrby_cmd;
+  TypedCommand decrby_cmd;
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
   err = tran->DecrBy(key, dec, &decrby_cmd);
   if (err) {
@@ -944,7 +1585,7 @@ common::Error DBConnection<Config, ContType>::DBConnection::Incr(const NKey& key
     return err;
   }
 
-  std::string incr_cmd;
+  TypedCommand incr_cmd;
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
   err = tran->Incr(key, &incr_cmd);
   if (err) {
@@ -983,7 +1624,7 @@ common::Error DBConnection<Config, ContType>::DBConnection::IncrBy(const NKey& k
     return err;
   }
 
-  std::string incrby_cmd;
+  TypedCommand incrby_cmd;
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
   err = tran->IncrBy(key, inc, &incrby_cmd);
   if (err) {
@@ -1058,7 +1699,7 @@ common::Error DBConnection<Config, ContType>::PExpire(const NKey& key, ttl_t ttl
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t ttl_cmd;
+  TypedCommand ttl_cmd;
   err = tran->PExpire(key, ttl, &ttl_cmd);
   if (err) {
     return err;
@@ -1094,7 +1735,7 @@ common::Error DBConnection<Config, ContType>::PTTL(const NKey& key, pttl_t* ttl)
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t pttl_cmd;
+  TypedCommand pttl_cmd;
   err = tran->PTTL(key, &pttl_cmd);
   if (err) {
     return err;
@@ -1140,7 +1781,7 @@ common::Error DBConnection<Config, ContType>::Sadd(const NKey& key, NValue set,
 
   NDbKValue rset(key, set);
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t sadd_cmd;
+  TypedCommand sadd_cmd;
   err = tran->CreateKeyCommand(rset, &sadd_cmd);
   if (err) {
     return err;
@@ -1178,14 +1819,14 @@ common::Error DBConnection<Config, ContType>::Smembers(const NKey& key, NDbKValu
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t smembers_cmd;
+  TypedCommand smembers_cmd;
   err = tran->Smembers(key, &smembers_cmd);
   if (err) {
     return err;
   }
 
   redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, smembers_cmd, &reply);
+  err = ExecRead(smembers_cmd.GetArgv(), std::string(), &reply);
   if (err) {
     return err;
   }
@@ -1241,7 +1882,7 @@ common::Error DBConnection<Config, ContType>::Zadd(const NKey& key, NValue score
 
   NDbKValue rzset(key, scores);
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t zadd_cmd;
+  TypedCommand zadd_cmd;
   err = tran->CreateKeyCommand(rzset, &zadd_cmd);
   if (err) {
     return err;
@@ -1283,14 +1924,14 @@ common::Error DBConnection<Config, ContType>::Zrange(const NKey& key,
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t zrange;
+  TypedCommand zrange;
   err = tran->Zrange(key, start, stop, withscores, &zrange);
   if (err) {
     return err;
   }
 
   redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, zrange, &reply);
+  err = ExecRead(zrange.GetArgv(), std::string(), &reply);
   if (err) {
     return err;
   }
@@ -1356,7 +1997,7 @@ common::Error DBConnection<Config, ContType>::Hmset(const NKey& key, NValue hash
 
   NDbKValue rhash(key, hash);
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t hmset_cmd;
+  TypedCommand hmset_cmd;
   err = tran->CreateKeyCommand(rhash, &hmset_cmd);
   if (err) {
     return err;
@@ -1393,14 +2034,14 @@ common::Error DBConnection<Config, ContType>::Hgetall(const NKey& key, NDbKValue
   }
 
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t hgetall_cmd;
+  TypedCommand hgetall_cmd;
   err = tran->Hgetall(key, &hgetall_cmd);
   if (err) {
     return err;
   }
 
   redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, hgetall_cmd, &reply);
+  err = ExecRead(hgetall_cmd.GetArgv(), std::string(), &reply);
   if (err) {
     return err;
   }
@@ -1455,6 +2096,10 @@ common::Error DBConnection<Config, ContType>::Monitor(const commands_args_t& arg
     return err;
   }
 
+  if (CanStreamAsync()) {
+    return StreamAsync(argv, out);
+  }
+
   redisReply* reply = NULL;
   err = ExecRedisCommand(base_class::connection_.handle_, argv, &reply);
   if (err) {
@@ -1490,6 +2135,10 @@ common::Error DBConnection<Config, ContType>::Subscribe(const commands_args_t& a
     return err;
   }
 
+  if (CanStreamAsync()) {
+    return StreamAsync(argv, out);
+  }
+
   redisReply* reply = NULL;
   err = ExecRedisCommand(base_class::connection_.handle_, argv, &reply);
   if (err) {
@@ -1513,6 +2162,140 @@ common::Error DBConnection<Config, ContType>::Subscribe(const commands_args_t& a
   return common::make_error(common::COMMON_EINTR);
 }
 
+template <typename Config, connectionTypes ContType>
+bool DBConnection<Config, ContType>::CanStreamAsync() const {
+  config_t config = base_class::GetConfig();
+  if (!config) {
+    return false;
+  }
+
+  return !config->is_ssl && !config->ssh_info.IsValid();
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::StreamAsync(const commands_args_t& argv, FastoObject* out) {
+  if (!out || argv.empty()) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  config_t config = base_class::GetConfig();
+  if (!config) {
+    return common::make_error("Not connected");
+  }
+
+  // same password and database as this connection, failed AUTH or SELECT ends stream with its error
+  Config lconfig = *config;
+  lconfig.auth = auth_;
+  if (cur_db_ != invalid_db_num) {
+    lconfig.db_num = cur_db_;
+  }
+
+  const std::string delimiter = base_class::GetDelimiter();
+  return stream_.Run(lconfig, argv, [out, delimiter](common::ValueSPtr reply) -> common::Error {
+    if (!reply) {
+      return common::make_error_inval();
+    }
+
+    // called on driver thread, object owns copy of reply
+    FastoObject* obj = new FastoObject(out, reply->DeepCopy(), delimiter);
+    out->AddChildren(obj);
+    return common::Error();
+  });
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::SampleChannels(const std::string& pattern,
+                                                             uint32_t seconds,
+                                                             channels_traffic_t* traffic) {
+  if (pattern.empty() || seconds == 0 || !traffic) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = base_class::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  NativeConnection* context = base_class::connection_.handle_;
+  commands_args_t argv;
+  argv.push_back("PSUBSCRIBE");
+  argv.push_back(pattern);
+  redisReply* reply = NULL;
+  err = ExecRedisCommand(context, argv, &reply);
+  if (err) {
+    return err;
+  }
+  freeReplyObject(reply);
+
+  // short reads, so interrupt of connection stops sampling in time
+  const common::time64_t finish = common::time::current_mstime() + seconds * 1000;
+  while (!base_class::IsInterrupted()) {
+    const common::time64_t left = finish - common::time::current_mstime();
+    if (left <= 0) {
+      break;
+    }
+
+    const common::time64_t wait = std::min<common::time64_t>(left, SAMPLE_INTERRUPT_CHECK_MSEC);
+    struct timeval tv;
+    tv.tv_sec = wait / 1000;
+    tv.tv_usec = (wait % 1000) * 1000;
+    if (redisSetTimeout(context, tv) != REDIS_OK) {
+      return PrintRedisContextError(context);
+    }
+
+    void* raw = NULL;
+    if (redisGetReply(context, &raw) != REDIS_OK) {
+      if (context->err == REDIS_ERR_IO && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        context->err = 0;  // nothing was read, reader keeps its state
+        context->errstr[0] = '\0';
+        continue;
+      }
+      return PrintRedisContextError(context);
+    }
+
+    redisReply* message = static_cast<redisReply*>(raw);
+    CountChannelMessage(message, traffic);
+    freeReplyObject(message);
+  }
+
+  // leave subscribed mode, messages published before confirmation still counted
+  struct timeval blocking = {0, 0};
+  if (redisSetTimeout(context, blocking) != REDIS_OK) {
+    return PrintRedisContextError(context);
+  }
+
+  const char* unsubscribe_argv[] = {"PUNSUBSCRIBE", pattern.data()};
+  const size_t unsubscribe_argvlen[] = {12, pattern.size()};
+  if (redisAppendCommandArgv(context, 2, unsubscribe_argv, unsubscribe_argvlen) != REDIS_OK) {
+    return PrintRedisContextError(context);
+  }
+
+  while (true) {
+    void* raw = NULL;
+    if (redisGetReply(context, &raw) != REDIS_OK) {
+      return PrintRedisContextError(context);
+    }
+
+    redisReply* message = static_cast<redisReply*>(raw);
+    const bool confirmed = IsUnsubscribeConfirmation(message);
+    if (!confirmed) {
+      CountChannelMessage(message, traffic);
+    }
+    freeReplyObject(message);
+    if (confirmed) {
+      break;
+    }
+  }
+
+  if (base_class::IsInterrupted()) {
+    return common::make_error(common::COMMON_EINTR);
+  }
+
+  return common::Error();
+}
+
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::SlaveMode(FastoObject* out) {
   if (!out) {
@@ -1616,9 +2399,15 @@ common::Error DBConnection<Config, ContType>::ScanImpl(cursor_t cursor_in,
                                                        keys_limit_t count_keys,
                                                        std::vector<std::string>* keys_out,
                                                        cursor_t* cursor_out) {
-  const command_buffer_t pattern_result = core::internal::GetKeysPattern(cursor_in, pattern, count_keys);
+  redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
+  TypedCommand scan_cmd;
+  common::Error err = tran->Scan(cursor_in, pattern, count_keys, &scan_cmd);
+  if (err) {
+    return err;
+  }
+
   redisReply* reply = NULL;
-  common::Error err = ExecRedisCommand(base_class::connection_.handle_, pattern_result, &reply);
+  err = ExecRedisCommand(base_class::connection_.handle_, scan_cmd, &reply);
   if (err) {
     return err;
   }
@@ -1742,9 +2531,9 @@ template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    command_buffer_t del_cmd;
+    TypedCommand del_cmd;
     redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-    common::Error err = tran->DeleteKeyCommand(key, &del_cmd);
+    common::Error err = tran->Del(key, &del_cmd);
     if (err) {
       return err;
     }
@@ -1766,35 +2555,37 @@ common::Error DBConnection<Config, ContType>::DeleteImpl(const NKeys& keys, NKey
 
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::SetImpl(const NDbKValue& key, NDbKValue* added_key) {
-  command_buffer_t set_cmd;
+  std::vector<TypedCommand> set_cmds;
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  common::Error err = tran->CreateKeyCommand(key, &set_cmd);
+  common::Error err = tran->CreateKeyCommands(key, &set_cmds);
   if (err) {
     return err;
   }
 
-  redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, set_cmd, &reply);
-  if (err) {
-    return err;
+  for (size_t i = 0; i < set_cmds.size(); ++i) {
+    redisReply* reply = NULL;
+    err = ExecRedisCommand(base_class::connection_.handle_, set_cmds[i], &reply);
+    if (err) {
+      return err;
+    }
+    freeReplyObject(reply);
   }
 
   *added_key = key;
-  freeReplyObject(reply);
   return common::Error();
 }
 
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::GetImpl(const NKey& key, NDbKValue* loaded_key) {
-  command_buffer_t get_cmd;
+  TypedCommand get_cmd;
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  common::Error err = tran->LoadKeyCommand(key, common::Value::TYPE_STRING, &get_cmd);
+  common::Error err = tran->Get(key, &get_cmd);
   if (err) {
     return err;
   }
 
   redisReply* reply = NULL;
-  err = ExecRedisCommand(base_class::connection_.handle_, get_cmd, &reply);
+  err = ExecStreamed(get_cmd.GetArgv(), std::string(), &reply);
   if (err) {
     return err;
   }
@@ -1814,8 +2605,8 @@ common::Error DBConnection<Config, ContType>::GetImpl(const NKey& key, NDbKValue
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::RenameImpl(const NKey& key, const key_t& new_key) {
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t rename_cmd;
-  common::Error err = tran->RenameKeyCommand(key, new_key, &rename_cmd);
+  TypedCommand rename_cmd;
+  common::Error err = tran->Rename(key, new_key, &rename_cmd);
   if (err) {
     return err;
   }
@@ -1833,8 +2624,8 @@ common::Error DBConnection<Config, ContType>::RenameImpl(const NKey& key, const
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::SetTTLImpl(const NKey& key, ttl_t ttl) {
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t ttl_cmd;
-  common::Error err = tran->ChangeKeyTTLCommand(key, ttl, &ttl_cmd);
+  TypedCommand ttl_cmd;
+  common::Error err = tran->Expire(key, ttl, &ttl_cmd);
   if (err) {
     return err;
   }
@@ -1856,8 +2647,8 @@ common::Error DBConnection<Config, ContType>::SetTTLImpl(const NKey& key, ttl_t
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::GetTTLImpl(const NKey& key, ttl_t* ttl) {
   redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
-  command_buffer_t ttl_cmd;
-  common::Error err = tran->LoadKeyTTLCommand(key, &ttl_cmd);
+  TypedCommand ttl_cmd;
+  common::Error err = tran->TTL(key, &ttl_cmd);
   if (err) {
     return err;
   }
@@ -1938,6 +2729,26 @@ common::Error DBConnection<Config, ContType>::ExecuteAsPipeline(
   std::vector<FastoObjectCommandIPtr> valid_cmds;
   for (size_t i = 0; i < cmds.size(); ++i) {
     FastoObjectCommandIPtr cmd = cmds[i];
+    commands_args_t args = cmd->GetInputArgs();
+    if (!args.empty()) {  // typed command, no need to parse
+      if (log_command_cb) {
+        log_command_cb(cmd);
+      }
+
+      if (IsPipeLineCommand(args[0].c_str())) {
+        valid_cmds.push_back(cmd);
+        std::vector<const char*> argvc(args.size());
+        std::vector<size_t> argvlen(args.size());
+        for (size_t j = 0; j < args.size(); ++j) {
+          argvc[j] = args[j].data();
+          argvlen[j] = args[j].size();
+        }
+        redisAppendCommandArgv(base_class::connection_.handle_, static_cast<int>(args.size()), argvc.data(),
+                               argvlen.data());
+      }
+      continue;
+    }
+
     command_buffer_t command = cmd->GetInputCommand();
     if (command.empty()) {
       continue;
@@ -1965,7 +2776,7 @@ common::Error DBConnection<Config, ContType>::ExecuteAsPipeline(
   }
 
   for (size_t i = 0; i < valid_cmds.size(); ++i) {
-    FastoObjectCommandIPtr cmd = cmds[i];
+    FastoObjectCommandIPtr cmd = valid_cmds[i];
     common::Error err = CliReadReply(cmd.get());
     if (err) {
       return err;
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <functional>  // for function
+#include <map>         // for map
+
 #include <common/convert2string.h>
 
 #include "core/internal/cdb_connection.h"  // for CDBConnection
@@ -27,9 +30,12 @@
 #include "core/db/redis_compatible/command_translator.h"
 #include "core/db/redis_compatible/config.h"
 
+#include "core/db_ps_channel.h"
 #include "core/global.h"
 #include "core/ssh_info.h"
 
+#include "core/db/redis_compatible/async_connection.h"
+
 struct redisContext;
 struct redisReply;
 
@@ -39,6 +45,19 @@ namespace redis_compatible {
 
 typedef redisContext NativeConnection;
 
+struct ChannelTraffic {
+  ChannelTraffic();
+
+  uint64_t messages;
+  uint64_t bytes;  // payload bytes
+};
+
+typedef std::map<std::string, ChannelTraffic> channels_traffic_t;
+
+bool GetNumberOfSubscribers(common::Value* value, long long* count);  // PUBSUB NUMSUB count, integer or string
+// traffic per second of channels, channels seen only while sampling appended without subscribers
+void SetChannelsTraffic(const channels_traffic_t& traffic, uint32_t seconds, std::vector<NDbPSChannel>* channels);
+
 const char* GetHiredisVersion();
 
 common::Error CreateConnection(const Config& config, const SSHInfo& sinfo, NativeConnection** context);
@@ -54,6 +73,8 @@ common::Error DiscoverySentinelConnection(const Config& rconfig,
 bool IsPipeLineCommand(const char* command);
 common::Error PrintRedisContextError(NativeConnection* context);
 common::Error ValueFromReplay(redisReply* r, common::Value** out);
+// arrays of at least compact_min_size plain strings become read only CompactArrayValue, 0 - never
+common::Error ValueFromReplay(redisReply* r, size_t compact_min_size, common::Value** out);
 common::Error ExecRedisCommand(NativeConnection* c,
                                int argc,
                                const char** argv,
@@ -61,8 +82,27 @@ common::Error ExecRedisCommand(NativeConnection* c,
                                redisReply** out_reply);
 common::Error ExecRedisCommand(NativeConnection* c, const commands_args_t& argv, redisReply** out_reply);
 common::Error ExecRedisCommand(NativeConnection* c, command_buffer_t command, redisReply** out_reply);
+common::Error ExecRedisCommand(NativeConnection* c, const TypedCommand& command, redisReply** out_reply);
 common::Error AuthContext(NativeConnection* context, const std::string& auth_str);
 
+struct ReplyStreamOptions {
+  ReplyStreamOptions();
+
+  std::function<bool()> interrupted;                               // checked between chunks of reply
+  std::function<void(size_t received, size_t declared)> progress;  // of top level array or bulk string
+  // bulk strings from spill_min_size bytes are saved to spill_path.* files, empty - kept in memory
+  std::string spill_path;
+  size_t spill_min_size;
+};
+
+// reads reply chunk by chunk instead of waiting for whole of it in redisGetReply,
+// any error after command was sent (COMMON_EINTR - interrupted) marks context failed (c->err),
+// rest of reply is left unread in connection and it must be reconnected
+common::Error ExecRedisCommandStreamed(NativeConnection* c,
+                                       const commands_args_t& argv,
+                                       const ReplyStreamOptions& options,
+                                       redisReply** out_reply);
+
 template <typename Config, connectionTypes connection_type>
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, connection_type> {
  public:
@@ -74,7 +114,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   explicit DBConnection(CDBConnectionClient* client)
       : base_class(client, new CommandTranslator(base_class::GetCommands())),
         is_auth_(false),
-        cur_db_(invalid_db_num) {}
+        cur_db_(invalid_db_num),
+        auth_(),
+        stream_() {}
 
   virtual common::Error Connect(const config_t& config) override;
   virtual common::Error Disconnect() override;
@@ -83,14 +125,21 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
 
   virtual bool IsAuthenticated() const override;
 
+  virtual void SetInterrupted(bool interrupted) override;  // also wakes async stream
+
   common::Error CommonExec(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;
 
   common::Error Auth(const std::string& password) WARN_UNUSED_RESULT;
 
   common::Error SlaveMode(FastoObject* out) WARN_UNUSED_RESULT;
 
+  // streamed on own non blocking connection when possible, so interrupt stops them at once
   common::Error Monitor(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;    // interrupt
   common::Error Subscribe(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;  // interrupt
+  // PSUBSCRIBE and count messages during seconds, PUNSUBSCRIBE after it
+  common::Error SampleChannels(const std::string& pattern,
+                               uint32_t seconds,
+                               channels_traffic_t* traffic) WARN_UNUSED_RESULT;  // interrupt
 
   common::Error Lpush(const NKey& key, NValue arr, long long* list_len) WARN_UNUSED_RESULT;
   common::Error Lrange(const NKey& key, int start, int stop, NDbKValue* loaded_key) WARN_UNUSED_RESULT;
@@ -126,7 +175,15 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
                                   void (*log_command_cb)(FastoObjectCommandIPtr)) WARN_UNUSED_RESULT;
 
  protected:
-  common::Error CliFormatReplyRaw(FastoObject* out, redisReply* r) WARN_UNUSED_RESULT;
+  common::Error CliFormatReplyRaw(FastoObject* out, redisReply* r, size_t compact_min_size = 0) WARN_UNUSED_RESULT;
+  // reads of commands marked as paged by pre-flight are made with SCAN family/ranges and merged into one reply
+  common::Error ExecRead(const commands_args_t& argv,
+                         const std::string& spill_path,
+                         redisReply** out_reply) WARN_UNUSED_RESULT;  // interrupt
+
+  virtual common::Error PreflightCommand(const commands_args_t& argv,
+                                         FastoObject* out,
+                                         size_t* paged_cardinality) override;
 
  private:
   virtual common::Error ScanImpl(cursor_t cursor_in,
@@ -153,10 +210,21 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error ConfigGetDatabasesImpl(std::vector<std::string>* dbs) override;
 
   common::Error CliReadReply(FastoObject* out) WARN_UNUSED_RESULT;
+  // big replies: progress goes to client, interrupt or broken reply reconnects as rest of it can't be skipped,
+  // spill_path - where huge bulk strings are saved (empty - kept in memory)
+  common::Error ExecStreamed(const commands_args_t& argv,
+                             const std::string& spill_path,
+                             redisReply** out_reply) WARN_UNUSED_RESULT;
   common::Error SendSync(unsigned long long* payload) WARN_UNUSED_RESULT;
+  common::Error ExecPaged(const commands_args_t& argv, redisReply** out_reply) WARN_UNUSED_RESULT;
+  // ssh tunnels and ssl exist only in blocking connection
+  bool CanStreamAsync() const;
+  common::Error StreamAsync(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;  // interrupt
 
   bool is_auth_;
   int cur_db_;
+  std::string auth_;  // password of last successful AUTH, for stream connection
+  AsyncStream stream_;
 };
 
 }  // namespace redis_compatible
@@ -0,0 +1,275 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/query_cost.h"
+
+#include <ctype.h>  // for toupper
+
+#include <algorithm>  // for min
+#include <limits>     // for numeric_limits
+
+#include <common/convert2string.h>
+#include <common/string_util.h>  // for FullEqualsASCII
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+bool IsCommand(const commands_args_t& argv, const char* name, size_t min_argc, size_t max_argc) {
+  return argv.size() >= min_argc && argv.size() <= max_argc && common::FullEqualsASCII(argv[0], name, false);
+}
+
+bool IsRangeCommand(const commands_args_t& argv) {
+  return IsCommand(argv, "LRANGE", 4, 4) || IsCommand(argv, "ZRANGE", 4, 5) || IsCommand(argv, "ZREVRANGE", 4, 5);
+}
+
+bool IsStreamRangeCommand(const commands_args_t& argv) {
+  return IsCommand(argv, "XRANGE", 4, 4) ||
+         (IsCommand(argv, "XRANGE", 6, 6) && common::FullEqualsASCII(argv[4], "COUNT", false));
+}
+
+// redis semantics of LRANGE/ZRANGE indexes: negative from the end, out of range clamped
+bool NormalizeRange(const std::string& start_str,
+                    const std::string& stop_str,
+                    long long len,
+                    long long* start,
+                    long long* stop) {
+  long long lstart = 0;
+  long long lstop = 0;
+  if (!common::ConvertFromString(start_str, &lstart) || !common::ConvertFromString(stop_str, &lstop)) {
+    return false;
+  }
+
+  if (lstart < 0) {
+    lstart = std::max(len + lstart, 0LL);
+  }
+  if (lstop < 0) {
+    lstop = len + lstop;
+  }
+  if (lstop >= len) {
+    lstop = len - 1;
+  }
+  if (lstart > lstop || lstart >= len) {
+    return false;
+  }
+
+  *start = lstart;
+  *stop = lstop;
+  return true;
+}
+
+}  // namespace
+
+bool GetQueryCostProbe(const commands_args_t& argv, commands_args_t* probe) {
+  if (!probe) {
+    return false;
+  }
+
+  if (IsCommand(argv, "KEYS", 2, 2)) {  // walks all keys whatever the pattern is
+    *probe = {"DBSIZE"};
+    return true;
+  }
+
+  const char* probe_name = nullptr;
+  if (IsCommand(argv, "HGETALL", 2, 2)) {
+    probe_name = "HLEN";
+  } else if (IsCommand(argv, "SMEMBERS", 2, 2)) {
+    probe_name = "SCARD";
+  } else if (IsCommand(argv, "LRANGE", 4, 4)) {
+    probe_name = "LLEN";
+  } else if (IsRangeCommand(argv)) {
+    probe_name = "ZCARD";
+  } else if (IsStreamRangeCommand(argv)) {
+    probe_name = "XLEN";
+  } else {
+    return false;
+  }
+
+  *probe = {probe_name, argv[1]};
+  return true;
+}
+
+size_t EstimateQueryCost(const commands_args_t& argv, long long cardinality) {
+  if (cardinality <= 0) {
+    return 0;
+  }
+
+  if (IsRangeCommand(argv)) {
+    long long start = 0;
+    long long stop = 0;
+    if (!NormalizeRange(argv[2], argv[3], cardinality, &start, &stop)) {
+      return 0;
+    }
+    return static_cast<size_t>(stop - start + 1);
+  }
+
+  if (IsStreamRangeCommand(argv) && argv.size() == 6) {
+    long long count = 0;
+    if (common::ConvertFromString(argv[5], &count) && count >= 0) {
+      return static_cast<size_t>(std::min(count, cardinality));
+    }
+  }
+
+  return static_cast<size_t>(cardinality);
+}
+
+bool IncrementStreamId(const std::string& id, std::string* next) {
+  if (!next) {
+    return false;
+  }
+
+  const std::string::size_type dash = id.find('-');
+  unsigned long long ms = 0;
+  unsigned long long seq = 0;
+  if (!common::ConvertFromString(id.substr(0, dash), &ms)) {
+    return false;
+  }
+  if (dash != std::string::npos && !common::ConvertFromString(id.substr(dash + 1), &seq)) {
+    return false;
+  }
+
+  if (seq == std::numeric_limits<unsigned long long>::max()) {
+    if (ms == std::numeric_limits<unsigned long long>::max()) {
+      return false;
+    }
+    ms++;
+    seq = 0;
+  } else {
+    seq++;
+  }
+
+  *next = common::ConvertToString(ms) + "-" + common::ConvertToString(seq);
+  return true;
+}
+
+QueryPager::QueryPager(const commands_args_t& argv, size_t cardinality, size_t page_size)
+    : type_(INVALID_PAGER),
+      argv_(argv),
+      page_size_(std::max(page_size, size_t(1))),
+      done_(false),
+      withscores_(false),
+      position_(),
+      start_(0),
+      stop_(0),
+      left_(std::numeric_limits<size_t>::max()) {
+  if (IsCommand(argv, "KEYS", 2, 2) || IsCommand(argv, "HGETALL", 2, 2) || IsCommand(argv, "SMEMBERS", 2, 2)) {
+    type_ = SCAN_PAGER;
+    position_ = "0";
+  } else if (IsRangeCommand(argv)) {
+    if (argv.size() == 5) {
+      if (!common::FullEqualsASCII(argv[4], "WITHSCORES", false)) {
+        return;
+      }
+      withscores_ = true;
+    }
+    type_ = RANGE_PAGER;
+    done_ = !NormalizeRange(argv[2], argv[3], static_cast<long long>(cardinality), &start_, &stop_);
+  } else if (IsStreamRangeCommand(argv)) {
+    type_ = STREAM_PAGER;
+    position_ = argv[2];
+    if (argv.size() == 6) {
+      long long count = 0;
+      if (!common::ConvertFromString(argv[5], &count) || count < 0) {
+        type_ = INVALID_PAGER;
+        return;
+      }
+      left_ = static_cast<size_t>(count);
+      done_ = left_ == 0;
+    }
+  }
+
+  if (type_ != INVALID_PAGER) {
+    for (char& c : argv_[0]) {
+      c = static_cast<char>(toupper(c));
+    }
+  }
+}
+
+bool QueryPager::IsValid() const {
+  return type_ != INVALID_PAGER;
+}
+
+bool QueryPager::IsDone() const {
+  return done_ || type_ == INVALID_PAGER;
+}
+
+bool QueryPager::IsScan() const {
+  return type_ == SCAN_PAGER;
+}
+
+size_t QueryPager::GetItemSize() const {
+  if (type_ == SCAN_PAGER && argv_[0] == "HGETALL") {
+    return 2;
+  }
+  return withscores_ ? 2 : 1;
+}
+
+commands_args_t QueryPager::GetPage() const {
+  const std::string count = common::ConvertToString(page_size_);
+  if (type_ == SCAN_PAGER) {
+    if (argv_[0] == "KEYS") {
+      return {"SCAN", position_, "MATCH", argv_[1], "COUNT", count};
+    }
+    return {argv_[0] == "HGETALL" ? "HSCAN" : "SSCAN", argv_[1], position_, "COUNT", count};
+  }
+
+  if (type_ == RANGE_PAGER) {
+    const long long stop = std::min(start_ + static_cast<long long>(page_size_) - 1, stop_);
+    commands_args_t page = {argv_[0], argv_[1], common::ConvertToString(start_), common::ConvertToString(stop)};
+    if (withscores_) {
+      page.push_back("WITHSCORES");
+    }
+    return page;
+  }
+
+  if (type_ == STREAM_PAGER) {
+    return {"XRANGE", argv_[1], position_, argv_[3], "COUNT", common::ConvertToString(std::min(page_size_, left_))};
+  }
+
+  return commands_args_t();
+}
+
+void QueryPager::NextPage(const std::string& position, size_t count) {
+  if (IsDone()) {
+    return;
+  }
+
+  if (type_ == SCAN_PAGER) {
+    position_ = position;
+    done_ = position_.empty() || position_ == "0";
+    return;
+  }
+
+  if (type_ == RANGE_PAGER) {
+    const long long page_stop = std::min(start_ + static_cast<long long>(page_size_) - 1, stop_);
+    const size_t requested = static_cast<size_t>(page_stop - start_ + 1);
+    start_ += static_cast<long long>(page_size_);
+    done_ = start_ > stop_ || count < requested;  // collection shrank meanwhile
+    return;
+  }
+
+  const size_t requested = std::min(page_size_, left_);
+  left_ -= std::min(count, left_);
+  done_ = count < requested || !left_ || !IncrementStreamId(position, &position_);
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,75 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>  // for string
+
+#include <common/macros.h>
+
+#include "core/types.h"  // for commands_args_t
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+// pre-flight of expensive reads: cheap O(1) probe tells cardinality behind command,
+// KEYS - DBSIZE, HGETALL - HLEN, SMEMBERS - SCARD, LRANGE - LLEN, ZRANGE/ZREVRANGE - ZCARD, XRANGE - XLEN;
+// false for other commands
+bool GetQueryCostProbe(const commands_args_t& argv, commands_args_t* probe) WARN_UNUSED_RESULT;
+
+// elements in reply of command knowing cardinality from probe, ranges are clamped to it
+size_t EstimateQueryCost(const commands_args_t& argv, long long cardinality);
+
+// next id of stream after id ("1526919030474-55" -> "1526919030474-56"), false for invalid id
+bool IncrementStreamId(const std::string& id, std::string* next) WARN_UNUSED_RESULT;
+
+// paged equivalent of expensive read: SCAN family for KEYS/HGETALL/SMEMBERS (replies are [cursor, items]),
+// index ranges for LRANGE/ZRANGE/ZREVRANGE and COUNT limited id ranges for XRANGE
+class QueryPager {
+ public:
+  QueryPager(const commands_args_t& argv, size_t cardinality, size_t page_size);
+
+  bool IsValid() const;  // command can be paged
+  bool IsDone() const;
+  bool IsScan() const;
+  size_t GetItemSize() const;  // reply elements per item: 2 for HSCAN pairs and WITHSCORES
+
+  commands_args_t GetPage() const;
+  // result of page from GetPage: position - cursor of SCAN family or last id of XRANGE, ignored for ranges;
+  // count - items in reply
+  void NextPage(const std::string& position, size_t count);
+
+ private:
+  enum PagerType { INVALID_PAGER = 0, SCAN_PAGER, RANGE_PAGER, STREAM_PAGER };
+
+  PagerType type_;
+  commands_args_t argv_;  // command name in upper case
+  size_t page_size_;
+  bool done_;
+  bool withscores_;
+
+  std::string position_;  // cursor or start id
+  long long start_;       // current index of ranges
+  long long stop_;
+  size_t left_;  // XRANGE COUNT
+};
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
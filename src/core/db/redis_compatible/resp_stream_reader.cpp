@@ -0,0 +1,291 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/resp_stream_reader.h"
+
+#include <string.h>  // for memchr
+
+#include <algorithm>  // for min
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+bool ParseInteger(const char* data, size_t size, long long* out) {
+  if (!size) {
+    return false;
+  }
+
+  bool negative = false;
+  size_t pos = 0;
+  if (data[0] == '-') {
+    negative = true;
+    pos = 1;
+    if (size == 1) {
+      return false;
+    }
+  }
+
+  if (size - pos > 19) {  // doesn't fit in long long
+    return false;
+  }
+
+  unsigned long long value = 0;
+  for (; pos < size; ++pos) {
+    char c = data[pos];
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + static_cast<unsigned long long>(c - '0');
+    if (value > 9223372036854775807ULL + (negative ? 1 : 0)) {
+      return false;
+    }
+  }
+
+  *out = negative ? static_cast<long long>(0 - value) : static_cast<long long>(value);
+  return true;
+}
+
+}  // namespace
+
+RespStreamReader::IObserver::~IObserver() {}
+
+RespStreamReader::RespStreamReader(IObserver* observer)
+    : observer_(observer),
+      line_(),
+      bulk_left_(0),
+      crlf_left_(0),
+      in_bulk_(false),
+      arrays_(),
+      declared_size_(0),
+      received_size_(0),
+      top_bulk_(false),
+      status_(NEED_MORE),
+      error_() {}
+
+RespStreamReader::Status RespStreamReader::Feed(const char* data, size_t size, size_t* consumed) {
+  if (!consumed) {
+    return PROTOCOL_ERROR;
+  }
+
+  *consumed = 0;
+  if (status_ != NEED_MORE) {
+    return status_;
+  }
+
+  size_t pos = 0;
+  while (pos < size) {
+    if (in_bulk_) {
+      if (bulk_left_) {
+        const size_t chunk = std::min(bulk_left_, size - pos);
+        observer_->OnBulkChunk(data + pos, chunk);
+        bulk_left_ -= chunk;
+        pos += chunk;
+        if (top_bulk_) {
+          received_size_ += chunk;
+        }
+        continue;
+      }
+
+      while (crlf_left_ && pos < size) {
+        const char expected = crlf_left_ == 2 ? '\r' : '\n';
+        if (data[pos] != expected) {
+          *consumed = pos;
+          return Fail("Protocol error, expected CRLF after bulk string");
+        }
+        crlf_left_--;
+        pos++;
+      }
+
+      if (crlf_left_) {
+        break;
+      }
+
+      in_bulk_ = false;
+      observer_->OnBulkEnd();
+      Status st = ValueDone();
+      if (st != NEED_MORE) {
+        *consumed = pos;
+        return st;
+      }
+      continue;
+    }
+
+    const char* nl = static_cast<const char*>(memchr(data + pos, '\n', size - pos));
+    if (!nl) {
+      line_.append(data + pos, size - pos);
+      pos = size;
+      break;
+    }
+
+    const size_t line_size = static_cast<size_t>(nl - (data + pos)) + 1;
+    Status st;
+    if (line_.empty()) {  // whole line in this chunk, no copy
+      if (line_size < 2 || data[pos + line_size - 2] != '\r') {
+        *consumed = pos + line_size;
+        return Fail("Protocol error, line without CR");
+      }
+      st = ProcessLine(data + pos, line_size - 2);
+    } else {
+      line_.append(data + pos, line_size);
+      if (line_.size() < 2 || line_[line_.size() - 2] != '\r') {
+        *consumed = pos + line_size;
+        return Fail("Protocol error, line without CR");
+      }
+      std::string line;
+      line.swap(line_);
+      st = ProcessLine(line.data(), line.size() - 2);
+    }
+    pos += line_size;
+    if (st != NEED_MORE) {
+      *consumed = pos;
+      return st;
+    }
+  }
+
+  *consumed = pos;
+  return NEED_MORE;
+}
+
+void RespStreamReader::Reset() {
+  line_.clear();
+  bulk_left_ = 0;
+  crlf_left_ = 0;
+  in_bulk_ = false;
+  arrays_.clear();
+  declared_size_ = 0;
+  received_size_ = 0;
+  top_bulk_ = false;
+  status_ = NEED_MORE;
+  error_.clear();
+}
+
+bool RespStreamReader::IsComplete() const {
+  return status_ == COMPLETE;
+}
+
+std::string RespStreamReader::GetError() const {
+  return error_;
+}
+
+size_t RespStreamReader::GetDeclaredSize() const {
+  return declared_size_;
+}
+
+size_t RespStreamReader::GetReceivedSize() const {
+  return received_size_;
+}
+
+RespStreamReader::Status RespStreamReader::ProcessLine(const char* line, size_t size) {
+  if (!size) {
+    return Fail("Protocol error, empty line");
+  }
+
+  const char type = line[0];
+  const char* body = line + 1;
+  const size_t body_size = size - 1;
+  switch (type) {
+    case '+':
+      observer_->OnStatus(body, body_size);
+      return ValueDone();
+    case '-':
+      observer_->OnError(body, body_size);
+      return ValueDone();
+    case ':': {
+      long long value = 0;
+      if (!ParseInteger(body, body_size, &value)) {
+        return Fail("Protocol error, invalid integer");
+      }
+      observer_->OnInteger(value);
+      return ValueDone();
+    }
+    case '$': {
+      long long len = 0;
+      if (!ParseInteger(body, body_size, &len) || len < -1) {
+        return Fail("Protocol error, invalid bulk length");
+      }
+      if (len == -1) {
+        observer_->OnNil();
+        return ValueDone();
+      }
+
+      if (arrays_.empty()) {
+        top_bulk_ = true;
+        declared_size_ = static_cast<size_t>(len);
+      }
+      observer_->OnBulkStart(static_cast<size_t>(len));
+      in_bulk_ = true;
+      bulk_left_ = static_cast<size_t>(len);
+      crlf_left_ = 2;
+      return NEED_MORE;
+    }
+    case '*': {
+      long long count = 0;
+      if (!ParseInteger(body, body_size, &count) || count < -1) {
+        return Fail("Protocol error, invalid multibulk length");
+      }
+      if (count == -1) {
+        observer_->OnNil();
+        return ValueDone();
+      }
+
+      if (arrays_.empty()) {
+        declared_size_ = static_cast<size_t>(count);
+      }
+      observer_->OnArrayStart(static_cast<size_t>(count));
+      if (!count) {
+        observer_->OnArrayEnd();
+        return ValueDone();
+      }
+      arrays_.push_back(static_cast<size_t>(count));
+      return NEED_MORE;
+    }
+    default:
+      return Fail(std::string("Protocol error, got \"") + type + "\" as reply type byte");
+  }
+}
+
+RespStreamReader::Status RespStreamReader::ValueDone() {
+  while (!arrays_.empty()) {
+    if (arrays_.size() == 1) {  // element of top level array
+      received_size_++;
+    }
+
+    if (--arrays_.back()) {
+      return NEED_MORE;
+    }
+
+    arrays_.pop_back();
+    observer_->OnArrayEnd();
+  }
+
+  status_ = COMPLETE;
+  return status_;
+}
+
+RespStreamReader::Status RespStreamReader::Fail(const std::string& error) {
+  error_ = error;
+  status_ = PROTOCOL_ERROR;
+  return status_;
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
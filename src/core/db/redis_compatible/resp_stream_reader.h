@@ -0,0 +1,88 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for int64_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/macros.h>
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+// push parser of one RESP reply, fed with socket chunks as they arrive:
+// values are reported as soon as they are parsed, bulk strings in chunks,
+// so reading of big replies can be observed and stopped between chunks
+class RespStreamReader {
+ public:
+  enum Status { NEED_MORE = 0, COMPLETE, PROTOCOL_ERROR };
+
+  class IObserver {
+   public:
+    virtual void OnArrayStart(size_t count) = 0;  // OnArrayEnd follows after count elements
+    virtual void OnArrayEnd() = 0;
+    virtual void OnBulkStart(size_t size) = 0;  // OnBulkChunk for every piece of payload, then OnBulkEnd
+    virtual void OnBulkChunk(const char* data, size_t size) = 0;
+    virtual void OnBulkEnd() = 0;
+    virtual void OnStatus(const char* data, size_t size) = 0;
+    virtual void OnError(const char* data, size_t size) = 0;
+    virtual void OnInteger(long long value) = 0;
+    virtual void OnNil() = 0;  // $-1 and *-1
+    virtual ~IObserver();
+  };
+
+  explicit RespStreamReader(IObserver* observer);
+
+  // parses up to the end of reply, *consumed - used bytes of data (rest belongs to next reply)
+  Status Feed(const char* data, size_t size, size_t* consumed) WARN_UNUSED_RESULT;
+  void Reset();
+
+  bool IsComplete() const;
+  std::string GetError() const;
+
+  // progress of top level value: elements of array or bytes of bulk string, declared 0 until header is read
+  size_t GetDeclaredSize() const;
+  size_t GetReceivedSize() const;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(RespStreamReader);
+
+  Status ProcessLine(const char* line, size_t size);
+  Status ValueDone();
+  Status Fail(const std::string& error);
+
+  IObserver* const observer_;
+  std::string line_;  // header line collected across chunks
+  size_t bulk_left_;  // payload bytes of current bulk string
+  size_t crlf_left_;  // bytes of "\r\n" after bulk payload
+  bool in_bulk_;
+  std::vector<size_t> arrays_;  // elements left in opened arrays
+  size_t declared_size_;
+  size_t received_size_;
+  bool top_bulk_;
+  Status status_;
+  std::string error_;
+};
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
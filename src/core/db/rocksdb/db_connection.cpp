@@ -26,6 +26,7 @@
 #include "core/db/rocksdb/command_translator.h"
 #include "core/db/rocksdb/database_info.h"
 #include "core/db/rocksdb/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 #define ROCKSDB_HEADER_STATS                               \
   "\n** Compaction Stats [default] **\n"                   \
@@ -81,6 +82,16 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         4,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Scan),
+                                          CommandHolder(DB_SEARCH_COMMAND,
+                                                        "<pattern> [COUNT count]",
+                                                        "Find keys which values match the given pattern, "
+                                                        "key space scanned in parallel",
+                                                        UNDEFINED_SINCE,
+                                                        UNDEFINED_EXAMPLE_STR,
+                                                        1,
+                                                        2,
+                                                        CommandInfo::Native,
+                                                        &CommandsApi::Search),
                                           CommandHolder(DB_JSONDUMP_COMMAND,
                                                         "<cursor> PATH absolute_path [MATCH pattern] [COUNT count]",
                                                         "Dump DB into json file by path.",
@@ -308,6 +319,13 @@ class rocksdb_handle {
     return db_->NewIterator(options, GetCurrentColumn());
   }
 
+  const ::rocksdb::Snapshot* GetSnapshot() { return db_->GetSnapshot(); }
+  void ReleaseSnapshot(const ::rocksdb::Snapshot* snapshot) { db_->ReleaseSnapshot(snapshot); }
+
+  void GetApproximateSizes(const ::rocksdb::Range* ranges, int n, uint64_t* sizes) {
+    db_->GetApproximateSizes(GetCurrentColumn(), ranges, n, sizes);
+  }
+
   ::rocksdb::ColumnFamilyHandle* GetCurrentColumn() const { return handles_[current_db_index_]; }
   std::string GetCurrentDBName() const {
     ::rocksdb::ColumnFamilyHandle* fam = GetCurrentColumn();
@@ -631,15 +649,37 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
                                      keys_limit_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      cursor_t* cursor_out) {
+  return ScanFilteredImpl(cursor_in, pattern, count_keys, KeysFilter(), keys_out, cursor_out);
+}
+
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsPlainStringsAllowed()) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   ::rocksdb::ReadOptions ro;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
+  const GlobPattern glob(pattern);
+  config_t conf = GetConfig();
+  const bool seek_prefix = conf && conf->comparator == COMP_BYTEWISE && !glob.GetPrefix().empty();
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+  for (seek_prefix ? it->Seek(glob.GetPrefix()) : it->SeekToFirst(); it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
+    if (seek_prefix && glob.IsPastPrefix(key)) {
+      break;
+    }
+
     if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
+      if (glob.Match(key) && filter.IsSizeAllowed(it->value().size())) {
         if (offset_pos == 0) {
           lkeys_out.push_back(key);
         } else {
@@ -688,26 +728,125 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
   return CheckResultCommand(DB_KEYS_COMMAND, st);
 }
 
-common::Error DBConnection::DBkcountImpl(size_t* size) {
+internal::key_ranges_t DBConnection::GetScanRanges(const ::rocksdb::Snapshot* snapshot) {
+  config_t conf = GetConfig();
+  if (!conf || conf->comparator != COMP_BYTEWISE) {
+    return {internal::KeyRange()};
+  }
+
   ::rocksdb::ReadOptions ro;
+  ro.snapshot = snapshot;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
-  size_t sz = 0;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    sz++;
+  it->SeekToFirst();
+  if (!it->Valid()) {
+    delete it;
+    return {internal::KeyRange()};
   }
 
-  auto st = it->status();
+  const std::string first_key = it->key().ToString();
+  it->SeekToLast();
+  const std::string last_key = it->Valid() ? it->key().ToString() : first_key;
   delete it;
 
-  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, st);
+  const internal::key_ranges_t ranges = internal::SplitKeyRange(first_key, last_key);
+  const std::string end_key = last_key + '\0';
+  std::vector<::rocksdb::Range> sizes_ranges;
+  for (const internal::KeyRange& range : ranges) {
+    sizes_ranges.push_back(::rocksdb::Range(range.start, range.limit.empty() ? end_key : range.limit));
+  }
+
+  std::vector<uint64_t> weights(ranges.size(), 0);
+  connection_.handle_->GetApproximateSizes(sizes_ranges.data(), static_cast<int>(sizes_ranges.size()),
+                                           weights.data());
+  return internal::MergeKeyRanges(ranges, weights, internal::GetScanThreadsCount() * 4);
+}
+
+common::Error DBConnection::DBkcountImpl(size_t* size) {
+  const ::rocksdb::Snapshot* snapshot = connection_.handle_->GetSnapshot();
+  const internal::key_ranges_t ranges = GetScanRanges(snapshot);
+  std::vector<size_t> counts(ranges.size(), 0);
+  common::Error err =
+      internal::ParallelFor(ranges.size(), internal::GetScanThreadsCount(), [&](size_t i) -> common::Error {
+        const internal::KeyRange& range = ranges[i];
+        ::rocksdb::ReadOptions ro;
+        ro.snapshot = snapshot;
+        ro.fill_cache = false;
+        ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
+        size_t sz = 0;
+        for (range.start.empty() ? it->SeekToFirst() : it->Seek(range.start); it->Valid(); it->Next()) {
+          const ::rocksdb::Slice key = it->key();
+          if (range.IsPastLimit(key.data(), key.size())) {
+            break;
+          }
+          sz++;
+        }
+
+        auto st = it->status();
+        delete it;
+        counts[i] = sz;
+        return CheckResultCommand(DB_DBKCOUNT_COMMAND, st);
+      });
+  connection_.handle_->ReleaseSnapshot(snapshot);
   if (err) {
     return err;
   }
 
+  size_t sz = 0;
+  for (size_t count : counts) {
+    sz += count;
+  }
+
   *size = sz;
   return common::Error();
 }
 
+common::Error DBConnection::SearchImpl(const std::string& pattern,
+                                       keys_limit_t limit,
+                                       std::vector<std::string>* keys_out) {
+  const GlobPattern glob(pattern);
+  const ::rocksdb::Snapshot* snapshot = connection_.handle_->GetSnapshot();
+  const internal::key_ranges_t ranges = GetScanRanges(snapshot);
+  std::vector<std::vector<std::string>> found(ranges.size());
+  common::Error err =
+      internal::ParallelFor(ranges.size(), internal::GetScanThreadsCount(), [&](size_t i) -> common::Error {
+        const internal::KeyRange& range = ranges[i];
+        ::rocksdb::ReadOptions ro;
+        ro.snapshot = snapshot;
+        ro.fill_cache = false;
+        ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
+        for (range.start.empty() ? it->SeekToFirst() : it->Seek(range.start); it->Valid() && found[i].size() < limit;
+             it->Next()) {
+          const ::rocksdb::Slice key = it->key();
+          if (range.IsPastLimit(key.data(), key.size())) {
+            break;
+          }
+
+          const ::rocksdb::Slice value = it->value();
+          if (glob.Match(value.data(), value.size())) {
+            found[i].push_back(key.ToString());
+          }
+        }
+
+        auto st = it->status();
+        delete it;
+        return CheckResultCommand(DB_SEARCH_COMMAND, st);
+      });
+  connection_.handle_->ReleaseSnapshot(snapshot);
+  if (err) {
+    return err;
+  }
+
+  std::vector<std::string> lkeys_out;  // partitions in key order
+  for (size_t i = 0; i < found.size() && lkeys_out.size() < limit; ++i) {
+    for (size_t j = 0; j < found[i].size() && lkeys_out.size() < limit; ++j) {
+      lkeys_out.push_back(found[i][j]);
+    }
+  }
+
+  *keys_out = lkeys_out;
+  return common::Error();
+}
+
 common::Error DBConnection::FlushDBImpl() {
   ::rocksdb::ReadOptions ro;
   ::rocksdb::WriteOptions wo;
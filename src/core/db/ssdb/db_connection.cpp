@@ -25,6 +25,7 @@
 #include "core/db/ssdb/command_translator.h"
 #include "core/db/ssdb/database_info.h"
 #include "core/db/ssdb/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 namespace fastonosql {
 namespace core {
@@ -1485,13 +1486,14 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
     return err;
   }
 
+  const GlobPattern glob(pattern);
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
   for (size_t i = 0; i < ret.size(); ++i) {
-    std::string key = ret[i];
+    const std::string& key = ret[i];
     if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
+      if (glob.Match(key)) {
         if (offset_pos == 0) {
           lkeys_out.push_back(key);
         } else {
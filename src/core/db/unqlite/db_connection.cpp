@@ -28,6 +28,7 @@ extern "C" {
 #include "core/db/unqlite/command_translator.h"
 #include "core/db/unqlite/database_info.h"
 #include "core/db/unqlite/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 namespace {
 
@@ -92,6 +93,14 @@ int unqlite_data_callback(const void* pData, unsigned int nDatalen, void* str) {
   return UNQLITE_OK;
 }
 
+size_t GetValueSize(unqlite_kv_cursor* cursor) {
+  unqlite_int64 size = 0;
+  if (unqlite_kv_cursor_data(cursor, NULL, &size) != UNQLITE_OK || size < 0) {
+    return 0;
+  }
+  return static_cast<size_t>(size);
+}
+
 }  // namespace
 
 namespace fastonosql {
@@ -367,6 +376,21 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
                                      keys_limit_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      cursor_t* cursor_out) {
+  return ScanFilteredImpl(cursor_in, pattern, count_keys, KeysFilter(), keys_out, cursor_out);
+}
+
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsPlainStringsAllowed()) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   unqlite_kv_cursor* pCur; /* Cursor handle */
   common::Error err = CheckResultCommand(DB_SCAN_COMMAND, unqlite_kv_cursor_init(connection_.handle_, &pCur));
   if (err) {
@@ -375,7 +399,8 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
   /* Point to the first record */
   unqlite_kv_cursor_first_entry(pCur);
 
-  /* Iterate over the entries */
+  /* Iterate over the entries, hash ordered storage so only prefix/suffix checks before matching */
+  const GlobPattern glob(pattern);
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
@@ -383,7 +408,7 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
     if (lkeys_out.size() < count_keys) {
       std::string skey;
       unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, &skey);
-      if (common::MatchPattern(skey, pattern)) {
+      if (glob.Match(skey) && filter.IsSizeAllowed(GetValueSize(pCur))) {
         if (offset_pos == 0) {
           lkeys_out.push_back(skey);
         } else {
@@ -50,6 +50,13 @@ Config ParseOptions(int argc, char** argv) {
       if (common::ConvertFromString(argv[++i], &dbnum)) {
         cfg.dbnum = dbnum;
       }
+    } else if (!strcmp(argv[i], "-t")) {
+      cfg.enable_transactions = true;
+    } else if (!strcmp(argv[i], "-b") && !lastarg) {
+      unsigned int write_batch_size;
+      if (common::ConvertFromString(argv[++i], &write_batch_size) && write_batch_size) {
+        cfg.write_batch_size = write_batch_size;
+      }
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -72,7 +79,9 @@ Config ParseOptions(int argc, char** argv) {
 Config::Config()
     : LocalConfig(common::file_system::prepare_path("~/test.upscaledb")),
       create_if_missing(false),
-      dbnum(default_db_num) {}
+      dbnum(default_db_num),
+      enable_transactions(false),
+      write_batch_size(default_write_batch_size) {}
 
 }  // namespace upscaledb
 }  // namespace core
@@ -92,6 +101,13 @@ std::string ConvertToString(const fastonosql::core::upscaledb::Config& conf) {
     argv.push_back(ConvertToString(conf.dbnum));
   }
 
+  if (conf.enable_transactions) {
+    argv.push_back("-t");
+  }
+
+  argv.push_back("-b");
+  argv.push_back(ConvertToString(conf.write_batch_size));
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -25,11 +25,13 @@ namespace core {
 namespace upscaledb {
 
 struct Config : public LocalConfig {
-  enum { default_db_num = 1 };
+  enum { default_db_num = 1, default_write_batch_size = 10000 };
   Config();
 
   bool create_if_missing;
   uint16_t dbnum;
+  bool enable_transactions;       // UPS_ENABLE_TRANSACTIONS, bulk writes are committed per batch
+  unsigned int write_batch_size;  // write operations per bulk call/transaction
 };
 
 }  // namespace upscaledb
@@ -20,24 +20,39 @@
 
 #include <ups/upscaledb.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <common/convert2string.h>
 #include <common/file_system/string_path_utils.h>
 
 #include "core/db/upscaledb/command_translator.h"
 #include "core/db/upscaledb/database_info.h"
 #include "core/db/upscaledb/internal/commands_api.h"
+#include "core/glob_pattern.h"
 
 namespace fastonosql {
 namespace core {
 namespace {
-ups_key_t ConvertToUpscaleDBSlice(const key_t& key) {
-  readable_string_t key_str = key.GetData();
+ups_key_t ConvertToUpscaleDBSlice(const readable_string_t& key_str) {
   ups_key_t dkey;
   memset(&dkey, 0, sizeof(dkey));
   dkey.size = key_str.size();
   dkey.data = const_cast<command_buffer_char_t*>(key_str.data());
   return dkey;
 }
+
+ups_key_t ConvertToUpscaleDBSlice(const key_t& key) {
+  return ConvertToUpscaleDBSlice(key.GetData());
+}
+
+ups_record_t ConvertToUpscaleDBRecord(const readable_string_t& value_str) {
+  ups_record_t rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.size = value_str.size();
+  rec.data = const_cast<command_buffer_char_t*>(value_str.data());
+  return rec;
+}
 }  // namespace
 namespace upscaledb {
 
@@ -45,6 +60,7 @@ struct upscaledb {
   ups_env_t* env;
   ups_db_t* db;
   uint16_t cur_db;
+  bool transactions;
 };
 
 namespace {
@@ -168,6 +184,16 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         INFINITE_COMMAND_ARGS,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Delete),
+                                          CommandHolder(UPSCALEDB_MSET_COMMAND,
+                                                        "<key> <value> [key value ...]",
+                                                        "Set multiple keys to multiple values, "
+                                                        "written in batches of write batch size",
+                                                        UNDEFINED_SINCE,
+                                                        UNDEFINED_EXAMPLE_STR,
+                                                        2,
+                                                        INFINITE_COMMAND_ARGS,
+                                                        CommandInfo::Native,
+                                                        &CommandsApi::Mset),
                                           CommandHolder(DB_QUIT_COMMAND,
                                                         "-",
                                                         "Close the connection",
@@ -200,7 +226,11 @@ int upscaledb_select(upscaledb* context, uint16_t num) {
   return UPS_SUCCESS;
 }
 
-ups_status_t upscaledb_open(upscaledb** context, const char* dbpath, uint16_t db, bool create_if_missing) {
+ups_status_t upscaledb_open(upscaledb** context,
+                            const char* dbpath,
+                            uint16_t db,
+                            bool create_if_missing,
+                            bool enable_transactions) {
   upscaledb* lcontext = reinterpret_cast<upscaledb*>(calloc(1, sizeof(upscaledb)));
   bool need_to_create = false;
   if (create_if_missing) {
@@ -210,8 +240,9 @@ ups_status_t upscaledb_open(upscaledb** context, const char* dbpath, uint16_t db
     }
   }
 
-  ups_status_t st =
-      need_to_create ? ups_env_create(&lcontext->env, dbpath, 0, 0664, 0) : ups_env_open(&lcontext->env, dbpath, 0, 0);
+  const uint32_t env_flags = enable_transactions ? UPS_ENABLE_TRANSACTIONS : 0;
+  ups_status_t st = need_to_create ? ups_env_create(&lcontext->env, dbpath, env_flags, 0664, 0)
+                                   : ups_env_open(&lcontext->env, dbpath, env_flags, 0);
   if (st != UPS_SUCCESS) {
     free(lcontext);
     return st;
@@ -220,15 +251,105 @@ ups_status_t upscaledb_open(upscaledb** context, const char* dbpath, uint16_t db
   st = need_to_create ? ups_env_create_db(lcontext->env, &lcontext->db, db, 0, NULL)
                       : ups_env_open_db(lcontext->env, &lcontext->db, db, 0, NULL);
   if (st != UPS_SUCCESS) {
+    ups_env_close(lcontext->env, 0);
     free(lcontext);
     return st;
   }
 
   lcontext->cur_db = db;
+  lcontext->transactions = enable_transactions;
   *context = lcontext;
   return UPS_SUCCESS;
 }
 
+ups_status_t upscaledb_txn_begin(upscaledb* context, ups_txn_t** txn) {
+  *txn = NULL;
+  if (!context->transactions) {  // without transactions every operation is applied immediately
+    return UPS_SUCCESS;
+  }
+
+  return ups_txn_begin(txn, context->env, NULL, NULL, 0);
+}
+
+ups_status_t upscaledb_txn_end(ups_txn_t* txn, ups_status_t st) {
+  if (!txn) {
+    return st;
+  }
+
+  if (st != UPS_SUCCESS) {
+    ups_txn_abort(txn, 0);
+    return st;
+  }
+
+  return ups_txn_commit(txn, 0);
+}
+
+// runs operations by ups_db_bulk_operations in chunks of batch_size, one transaction per chunk,
+// statuses of single operations are left in ops[i].result, missing keys are not an error
+ups_status_t upscaledb_bulk_operations(upscaledb* context, ups_operation_t* ops, size_t count, size_t batch_size) {
+  for (size_t offset = 0; offset < count; offset += batch_size) {
+    const size_t chunk = std::min(batch_size, count - offset);
+    ups_txn_t* txn = NULL;
+    ups_status_t st = upscaledb_txn_begin(context, &txn);
+    if (st != UPS_SUCCESS) {
+      return st;
+    }
+
+    st = ups_db_bulk_operations(context->db, txn, ops + offset, chunk, 0);
+    for (size_t i = offset; i < offset + chunk && st == UPS_SUCCESS; ++i) {
+      if (ops[i].result != UPS_SUCCESS && ops[i].result != UPS_KEY_NOT_FOUND) {
+        st = ops[i].result;
+      }
+    }
+
+    st = upscaledb_txn_end(txn, st);
+    if (st != UPS_SUCCESS) {
+      return st;
+    }
+  }
+
+  return UPS_SUCCESS;
+}
+
+// erases from the beginning of database, batch_size keys per transaction
+ups_status_t upscaledb_flush(upscaledb* context, size_t batch_size) {
+  ups_status_t st = UPS_SUCCESS;
+  while (true) {
+    ups_txn_t* txn = NULL;
+    st = upscaledb_txn_begin(context, &txn);
+    if (st != UPS_SUCCESS) {
+      return st;
+    }
+
+    ups_cursor_t* cursor = NULL;
+    st = ups_cursor_create(&cursor, context->db, txn, 0);
+    if (st != UPS_SUCCESS) {
+      return upscaledb_txn_end(txn, st);
+    }
+
+    size_t erased = 0;
+    while (erased < batch_size) {
+      st = ups_cursor_move(cursor, NULL, NULL, UPS_CURSOR_FIRST);
+      if (st != UPS_SUCCESS) {
+        break;
+      }
+
+      st = ups_cursor_erase(cursor, 0);
+      if (st != UPS_SUCCESS) {
+        break;
+      }
+      erased++;
+    }
+    ups_cursor_close(cursor);
+
+    const bool done = st == UPS_KEY_NOT_FOUND;
+    st = upscaledb_txn_end(txn, done ? UPS_SUCCESS : st);
+    if (st != UPS_SUCCESS || done) {
+      return st;
+    }
+  }
+}
+
 void upscaledb_close(upscaledb** context) {
   if (!context) {
     return;
@@ -316,7 +437,7 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
   }
 
   const char* dbname = db_path.empty() ? NULL : db_path.c_str();
-  int st = upscaledb_open(&lcontext, dbname, config.dbnum, config.create_if_missing);
+  int st = upscaledb_open(&lcontext, dbname, config.dbnum, config.create_if_missing, config.enable_transactions);
   if (st != UPS_SUCCESS) {
     std::string buff = common::MemSPrintf("Fail open database: %s", ups_strerror(st));
     return common::make_error(buff);
@@ -383,14 +504,51 @@ common::Error DBConnection::Info(const std::string& args, ServerInfo::Stats* sta
   return common::Error();
 }
 
+common::Error DBConnection::Mset(const NDbKValues& keys, NDbKValues* added_keys) {
+  if (!added_keys) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  std::vector<key_t> keys_str;
+  std::vector<value_t> values_str;
+  keys_str.reserve(keys.size());
+  values_str.reserve(keys.size());
+  std::vector<ups_operation_t> ops(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys_str.push_back(keys[i].GetKey().GetKey());
+    values_str.push_back(keys[i].GetValue().GetValue());
+    memset(&ops[i], 0, sizeof(ups_operation_t));
+    ops[i].type = UPS_OP_INSERT;
+    ops[i].key = ConvertToUpscaleDBSlice(keys_str[i]);
+    ops[i].record = ConvertToUpscaleDBRecord(values_str[i].GetData());
+    ops[i].flags = UPS_OVERWRITE;
+  }
+
+  auto conf = GetConfig();
+  err = CheckResultCommand(UPSCALEDB_MSET_COMMAND, upscaledb_bulk_operations(connection_.handle_, ops.data(),
+                                                                             ops.size(), conf->write_batch_size));
+  if (err) {
+    return err;
+  }
+
+  *added_keys = keys;
+  if (client_) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      client_->OnAddedKey(keys[i]);
+    }
+  }
+  return common::Error();
+}
+
 common::Error DBConnection::SetInner(const key_t& key, const value_t& value) {
   ups_key_t key_slice = ConvertToUpscaleDBSlice(key);
-  readable_string_t value_str = value.GetData();
-
-  ups_record_t rec;
-  memset(&rec, 0, sizeof(rec));
-  rec.data = const_cast<char*>(value_str.data());
-  rec.size = value_str.size();
+  ups_record_t rec = ConvertToUpscaleDBRecord(value.GetData());
   return CheckResultCommand(DB_SET_KEY_COMMAND,
                             ups_db_insert(connection_.handle_->db, 0, &key_slice, &rec, UPS_OVERWRITE));
 }
@@ -421,6 +579,21 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
                                      keys_limit_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      cursor_t* cursor_out) {
+  return ScanFilteredImpl(cursor_in, pattern, count_keys, KeysFilter(), keys_out, cursor_out);
+}
+
+common::Error DBConnection::ScanFilteredImpl(cursor_t cursor_in,
+                                             const std::string& pattern,
+                                             keys_limit_t count_keys,
+                                             const KeysFilter& filter,
+                                             std::vector<std::string>* keys_out,
+                                             cursor_t* cursor_out) {
+  if (!filter.IsPlainStringsAllowed()) {
+    keys_out->clear();
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   ups_cursor_t* cursor; /* upscaledb cursor object */
   ups_key_t key;
   ups_record_t rec;
@@ -434,7 +607,22 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
     return err;
   }
 
+  const GlobPattern glob(pattern);
+  const std::string prefix = glob.GetPrefix();
   ups_status_t st = UPS_SUCCESS;
+  bool found = false;  // cursor already placed on first key not less than prefix
+  if (!prefix.empty()) {
+    key.data = const_cast<char*>(prefix.data());
+    key.size = static_cast<uint16_t>(prefix.size());
+    st = ups_cursor_find(cursor, &key, &rec, UPS_FIND_GEQ_MATCH);
+    if (st != UPS_SUCCESS && st != UPS_KEY_NOT_FOUND) {
+      ups_cursor_close(cursor);
+      std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
+      return common::make_error(buff);
+    }
+    found = true;
+  }
+
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
@@ -442,10 +630,17 @@ common::Error DBConnection::ScanImpl(cursor_t cursor_in,
     if (lkeys_out.size() < count_keys) {
       /* fetch the next item, and repeat till we've reached the end
        * of the database */
-      st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+      if (!found) {
+        st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+      }
+      found = false;
       if (st == UPS_SUCCESS) {
         std::string skey(reinterpret_cast<const char*>(key.data), key.size);
-        if (common::MatchPattern(skey, pattern)) {
+        if (glob.IsPastPrefix(skey)) {
+          break;
+        }
+
+        if (glob.Match(skey) && filter.IsSizeAllowed(rec.size)) {
           if (offset_pos == 0) {
             lkeys_out.push_back(skey);
           } else {
@@ -518,35 +713,8 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  ups_cursor_t* cursor; /* upscaledb cursor object */
-  ups_key_t key;
-  ups_record_t rec;
-
-  memset(&key, 0, sizeof(key));
-  memset(&rec, 0, sizeof(rec));
-
-  /* create a new cursor */
-  common::Error err = CheckResultCommand(DB_FLUSHDB_COMMAND, ups_cursor_create(&cursor, connection_.handle_->db, 0, 0));
-  if (err) {
-    return err;
-  }
-
-  ups_status_t st;
-  do {
-    /* fetch the next item, and repeat till we've reached the end
-     * of the database */
-    st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT);
-    if (st == UPS_SUCCESS) {
-      ups_db_erase(connection_.handle_->db, 0, &key, 0);
-    } else if (st && st != UPS_KEY_NOT_FOUND) {
-      ups_cursor_close(cursor);
-      std::string buff = common::MemSPrintf("FLUSHDB function error: %s", ups_strerror(st));
-      return common::make_error(buff);
-    }
-  } while (st == UPS_SUCCESS);
-
-  ups_cursor_close(cursor);
-  return common::Error();
+  auto conf = GetConfig();
+  return CheckResultCommand(DB_FLUSHDB_COMMAND, upscaledb_flush(connection_.handle_, conf->write_batch_size));
 }
 
 common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo** info) {
@@ -596,15 +764,28 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  std::vector<key_t> keys_str;
+  keys_str.reserve(keys.size());
+  std::vector<ups_operation_t> ops(keys.size());
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
-      continue;
-    }
+    keys_str.push_back(keys[i].GetKey());
+    memset(&ops[i], 0, sizeof(ups_operation_t));
+    ops[i].type = UPS_OP_ERASE;
+    ops[i].key = ConvertToUpscaleDBSlice(keys_str[i]);
+  }
 
-    deleted_keys->push_back(key);
+  auto conf = GetConfig();
+  common::Error err =
+      CheckResultCommand(DB_DELETE_KEY_COMMAND, upscaledb_bulk_operations(connection_.handle_, ops.data(), ops.size(),
+                                                                          conf->write_batch_size));
+  if (err) {
+    return err;
+  }
+
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i].result == UPS_SUCCESS) {
+      deleted_keys->push_back(keys[i]);
+    }
   }
 
   return common::Error();
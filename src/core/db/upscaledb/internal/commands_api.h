@@ -20,6 +20,8 @@
 
 #include "core/internal/commands_api.h"  // for ApiTraits
 
+#define UPSCALEDB_MSET_COMMAND "MSET"
+
 namespace fastonosql {
 namespace core {
 namespace upscaledb {
@@ -21,9 +21,10 @@
 namespace fastonosql {
 namespace core {
 
-NDbPSChannel::NDbPSChannel() {}
+NDbPSChannel::NDbPSChannel() : name_(), number_of_subscribers_(0), messages_per_second_(0), bytes_per_second_(0) {}
 
-NDbPSChannel::NDbPSChannel(const std::string& name, size_t nos) : name_(name), number_of_subscribers_(nos) {}
+NDbPSChannel::NDbPSChannel(const std::string& name, size_t nos)
+    : name_(name), number_of_subscribers_(nos), messages_per_second_(0), bytes_per_second_(0) {}
 
 std::string NDbPSChannel::GetName() const {
   return name_;
@@ -41,5 +42,18 @@ void NDbPSChannel::SetNumberOfSubscribers(size_t nos) {
   number_of_subscribers_ = nos;
 }
 
+double NDbPSChannel::GetMessagesPerSecond() const {
+  return messages_per_second_;
+}
+
+double NDbPSChannel::GetBytesPerSecond() const {
+  return bytes_per_second_;
+}
+
+void NDbPSChannel::SetTraffic(double messages_per_second, double bytes_per_second) {
+  messages_per_second_ = messages_per_second;
+  bytes_per_second_ = bytes_per_second;
+}
+
 }  // namespace core
 }  // namespace fastonosql
@@ -34,9 +34,16 @@ class NDbPSChannel {
   size_t GetNumberOfSubscribers() const;
   void SetNumberOfSubscribers(size_t nos);
 
+  // traffic measured by sampling, zero if channel wasn't sampled
+  double GetMessagesPerSecond() const;
+  double GetBytesPerSecond() const;
+  void SetTraffic(double messages_per_second, double bytes_per_second);
+
  private:
   std::string name_;
   size_t number_of_subscribers_;
+  double messages_per_second_;
+  double bytes_per_second_;
 };
 
 }  // namespace core
@@ -0,0 +1,131 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/decoder_cache.h"
+
+#include <functional>  // for hash
+#include <iterator>    // for prev
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+size_t MakeHash(const std::string& decoder, const std::string& input) {
+  const size_t dhash = std::hash<std::string>()(decoder);
+  const size_t ihash = std::hash<std::string>()(input);
+  return dhash ^ (ihash + 0x9e3779b9 + (dhash << 6) + (dhash >> 2));
+}
+
+}  // namespace
+
+DecoderCache::DecoderCache(size_t max_bytes) : max_bytes_(max_bytes), bytes_(0), entries_(), index_(), lock_() {}
+
+bool DecoderCache::Find(const std::string& decoder, const std::string& input, std::string* out) {
+  if (!out) {
+    return false;
+  }
+
+  const size_t hash = MakeHash(decoder, input);
+  std::lock_guard<std::mutex> guard(lock_);
+  index_t::iterator it = FindIndex(hash, decoder, input);
+  if (it == index_.end()) {
+    return false;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it->second);
+  *out = it->second->output;
+  return true;
+}
+
+void DecoderCache::Insert(const std::string& decoder, const std::string& input, const std::string& output) {
+  Entry entry = {MakeHash(decoder, input), decoder, input, output};
+  const size_t entry_bytes = EntryBytes(entry);
+  if (entry_bytes > max_bytes_) {  // would evict everything
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  index_t::iterator it = FindIndex(entry.hash, decoder, input);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  entries_.push_front(entry);
+  index_.insert(std::make_pair(entry.hash, entries_.begin()));
+  bytes_ += entry_bytes;
+  Evict();
+}
+
+void DecoderCache::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  index_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+size_t DecoderCache::GetBytes() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return bytes_;
+}
+
+size_t DecoderCache::GetCount() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return entries_.size();
+}
+
+size_t DecoderCache::GetMaxBytes() const {
+  return max_bytes_;
+}
+
+size_t DecoderCache::EntryBytes(const Entry& entry) {
+  return entry.decoder.size() + entry.input.size() + entry.output.size();
+}
+
+DecoderCache::index_t::iterator DecoderCache::FindIndex(size_t hash,
+                                                        const std::string& decoder,
+                                                        const std::string& input) {
+  auto range = index_.equal_range(hash);
+  for (index_t::iterator it = range.first; it != range.second; ++it) {
+    const Entry& entry = *it->second;
+    if (entry.decoder == decoder && entry.input == input) {
+      return it;
+    }
+  }
+
+  return index_.end();
+}
+
+void DecoderCache::Evict() {
+  while (bytes_ > max_bytes_ && !entries_.empty()) {
+    entries_t::iterator last = std::prev(entries_.end());
+    auto range = index_.equal_range(last->hash);
+    for (index_t::iterator it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        index_.erase(it);
+        break;
+      }
+    }
+    bytes_ -= EntryBytes(*last);
+    entries_.erase(last);
+  }
+}
+
+}  // namespace core
+}  // namespace fastonosql
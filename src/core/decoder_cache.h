@@ -0,0 +1,65 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <list>           // for list
+#include <mutex>          // for mutex
+#include <string>         // for string
+#include <unordered_map>  // for unordered_multimap
+
+namespace fastonosql {
+namespace core {
+
+// thread safe LRU of decoded values, key is decoder name and whole input value,
+// size is limited by bytes of stored inputs and outputs
+class DecoderCache {
+ public:
+  explicit DecoderCache(size_t max_bytes);
+
+  bool Find(const std::string& decoder, const std::string& input, std::string* out);
+  void Insert(const std::string& decoder, const std::string& input, const std::string& output);
+  void Clear();
+
+  size_t GetBytes() const;
+  size_t GetCount() const;
+  size_t GetMaxBytes() const;
+
+ private:
+  struct Entry {
+    size_t hash;
+    std::string decoder;
+    std::string input;
+    std::string output;
+  };
+  typedef std::list<Entry> entries_t;  // most recently used first
+  typedef std::unordered_multimap<size_t, entries_t::iterator> index_t;
+
+  static size_t EntryBytes(const Entry& entry);
+  index_t::iterator FindIndex(size_t hash, const std::string& decoder, const std::string& input);
+  void Evict();
+
+  const size_t max_bytes_;
+  size_t bytes_;
+  entries_t entries_;
+  index_t index_;
+  mutable std::mutex lock_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
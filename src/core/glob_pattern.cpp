@@ -0,0 +1,262 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/glob_pattern.h"
+
+#include <string.h>  // for memchr, memcmp
+
+#include <algorithm>  // for swap
+
+#define GLOB_SPECIAL_CHARS "*?[\\"
+
+namespace fastonosql {
+namespace core {
+
+GlobPattern::Segment::Segment() : tokens(), length(0) {}
+
+bool GlobPattern::Segment::MatchAt(const char* key, size_t pos) const {
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const Token& token = tokens[i];
+    if (token.type == Token::LITERAL) {
+      if (memcmp(key + pos, token.literal.data(), token.literal.size()) != 0) {
+        return false;
+      }
+      pos += token.literal.size();
+      continue;
+    }
+
+    if (token.type == Token::CHAR_CLASS && !token.chars.test(static_cast<unsigned char>(key[pos]))) {
+      return false;
+    }
+    pos++;
+  }
+
+  return true;
+}
+
+bool GlobPattern::Segment::Find(const char* key, size_t size, size_t from, size_t* pos) const {
+  if (from > size || size - from < length) {
+    return false;
+  }
+
+  const size_t last = size - length;
+  if (tokens.empty() || tokens[0].type != Token::LITERAL) {
+    for (size_t cur = from; cur <= last; ++cur) {
+      if (MatchAt(key, cur)) {
+        *pos = cur;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // jump between candidates by first literal byte, memchr is vectorized by libc
+  const char first = tokens[0].literal[0];
+  size_t cur = from;
+  while (cur <= last) {
+    const void* found = memchr(key + cur, first, last - cur + 1);
+    if (!found) {
+      return false;
+    }
+
+    cur = static_cast<const char*>(found) - key;
+    if (MatchAt(key, cur)) {
+      *pos = cur;
+      return true;
+    }
+    cur++;
+  }
+
+  return false;
+}
+
+GlobPattern::GlobPattern(const std::string& pattern)
+    : pattern_(pattern),
+      prefix_(),
+      suffix_(),
+      literal_(false),
+      match_all_(pattern == "*"),
+      segments_(),
+      min_length_(0) {
+  const size_t prefix_end = pattern_.find_first_of(GLOB_SPECIAL_CHARS);
+  if (prefix_end == std::string::npos) {
+    prefix_ = pattern_;
+    suffix_ = pattern_;
+    literal_ = true;
+    return;
+  }
+
+  prefix_ = pattern_.substr(0, prefix_end);
+  Compile();
+
+  // literal tokens are merged, so suffix is the last token of last segment if it is a literal
+  const Segment& last = segments_.back();
+  if (!last.tokens.empty() && last.tokens.back().type == Token::LITERAL) {
+    suffix_ = last.tokens.back().literal;
+  }
+}
+
+void GlobPattern::Compile() {
+  segments_.push_back(Segment());
+  const size_t len = pattern_.size();
+  for (size_t i = 0; i < len; ++i) {
+    const char c = pattern_[i];
+    if (c == '*') {
+      while (i + 1 < len && pattern_[i + 1] == '*') {
+        i++;
+      }
+      segments_.push_back(Segment());
+      continue;
+    }
+
+    Segment& segment = segments_.back();
+    segment.length++;
+    if (c == '?') {
+      Token token;
+      token.type = Token::ANY_CHAR;
+      segment.tokens.push_back(token);
+      continue;
+    }
+
+    if (c == '[') {
+      Token token;
+      token.type = Token::CHAR_CLASS;
+      i++;
+      const bool negate = i < len && pattern_[i] == '^';
+      if (negate) {
+        i++;
+      }
+
+      // unterminated class lasts until the end of pattern
+      for (; i < len && pattern_[i] != ']'; ++i) {
+        if (pattern_[i] == '\\' && i + 1 < len) {
+          i++;
+          token.chars.set(static_cast<unsigned char>(pattern_[i]));
+        } else if (i + 2 < len && pattern_[i + 1] == '-' && pattern_[i + 2] != ']') {
+          unsigned char start = static_cast<unsigned char>(pattern_[i]);
+          unsigned char end = static_cast<unsigned char>(pattern_[i + 2]);
+          if (start > end) {
+            std::swap(start, end);
+          }
+          for (unsigned int ch = start; ch <= end; ++ch) {
+            token.chars.set(ch);
+          }
+          i += 2;
+        } else {
+          token.chars.set(static_cast<unsigned char>(pattern_[i]));
+        }
+      }
+
+      if (negate) {
+        token.chars.flip();
+      }
+      segment.tokens.push_back(token);
+      continue;
+    }
+
+    char literal = c;
+    if (c == '\\' && i + 1 < len) {
+      i++;
+      literal = pattern_[i];
+    }
+
+    if (segment.tokens.empty() || segment.tokens.back().type != Token::LITERAL) {
+      Token token;
+      token.type = Token::LITERAL;
+      segment.tokens.push_back(token);
+    }
+    segment.tokens.back().literal += literal;
+  }
+
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    min_length_ += segments_[i].length;
+  }
+}
+
+const std::string& GlobPattern::GetPattern() const {
+  return pattern_;
+}
+
+const std::string& GlobPattern::GetPrefix() const {
+  return prefix_;
+}
+
+const std::string& GlobPattern::GetSuffix() const {
+  return suffix_;
+}
+
+bool GlobPattern::IsMatchAll() const {
+  return match_all_;
+}
+
+bool GlobPattern::Match(const std::string& key) const {
+  return Match(key.data(), key.size());
+}
+
+bool GlobPattern::Match(const char* key, size_t size) const {
+  if (match_all_) {
+    return true;
+  }
+
+  if (literal_) {
+    return size == pattern_.size() && memcmp(key, pattern_.data(), size) == 0;
+  }
+
+  if (size < min_length_) {
+    return false;
+  }
+
+  const Segment& first = segments_.front();
+  if (segments_.size() == 1) {
+    return size == first.length && first.MatchAt(key, 0);
+  }
+
+  // prefix and suffix parts are fixed, stars in between take any bytes,
+  // so leftmost placement of each middle segment never loses a match
+  const Segment& last = segments_.back();
+  const size_t end = size - last.length;
+  if (!first.MatchAt(key, 0) || !last.MatchAt(key, end)) {
+    return false;
+  }
+
+  size_t pos = first.length;
+  for (size_t i = 1; i + 1 < segments_.size(); ++i) {
+    size_t found = 0;
+    if (!segments_[i].Find(key, end, pos, &found)) {
+      return false;
+    }
+    pos = found + segments_[i].length;
+  }
+
+  return pos <= end;
+}
+
+bool GlobPattern::IsPastPrefix(const std::string& key) const {
+  if (prefix_.empty()) {
+    return false;
+  }
+
+  if (literal_) {
+    return key.compare(pattern_) > 0;
+  }
+
+  return key.compare(0, prefix_.size(), prefix_) > 0;
+}
+
+}  // namespace core
+}  // namespace fastonosql
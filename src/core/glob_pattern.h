@@ -0,0 +1,80 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <bitset>  // for bitset
+#include <string>  // for string
+#include <vector>  // for vector
+
+namespace fastonosql {
+namespace core {
+
+// glob prepared once per scan: literal prefix and suffix checked before full match,
+// ordered engines seek iterator to prefix and stop when keys leave it
+// syntax: * any sequence, ? any byte, [abc] [^a-z] classes, \ escapes next char
+// compiled into star separated segments, matched without recursion or backtracking
+class GlobPattern {
+ public:
+  explicit GlobPattern(const std::string& pattern);
+
+  const std::string& GetPattern() const;
+  const std::string& GetPrefix() const;  // every matched key starts with it
+  const std::string& GetSuffix() const;  // every matched key ends with it
+  bool IsMatchAll() const;
+
+  bool Match(const std::string& key) const;
+  bool Match(const char* key, size_t size) const;
+
+  // keys in bytewise order started from prefix: true if this and all next keys can't match
+  bool IsPastPrefix(const std::string& key) const;
+
+ private:
+  struct Token {
+    enum Type { LITERAL, ANY_CHAR, CHAR_CLASS };
+
+    Type type;
+    std::string literal;
+    std::bitset<256> chars;
+  };
+
+  // tokens between stars, matches fixed count of bytes
+  struct Segment {
+    Segment();
+
+    bool MatchAt(const char* key, size_t pos) const;
+    bool Find(const char* key, size_t size, size_t from, size_t* pos) const;
+
+    std::vector<Token> tokens;
+    size_t length;
+  };
+
+  void Compile();
+
+  const std::string pattern_;
+  std::string prefix_;
+  std::string suffix_;
+  bool literal_;
+  bool match_all_;
+
+  std::vector<Segment> segments_;  // first is anchored to key start, last to key end
+  size_t min_length_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
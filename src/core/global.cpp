@@ -18,6 +18,9 @@
 
 #include "core/global.h"
 
+#include <common/file_system/file.h>  // for ANSIFile
+
+#include "core/object_arena.h"
 #include "core/value.h"
 
 namespace fastonosql {
@@ -26,15 +29,39 @@ namespace core {
 FastoObject::IFastoObjectObserver::~IFastoObjectObserver() {}
 
 FastoObject::FastoObject(FastoObject* parent, common::Value* val, const std::string& delimiter)
-    : observer_(nullptr), value_(val), parent_(parent), childrens_(), delimiter_(delimiter) {
+    : observer_(nullptr),
+      value_(val),
+      encoding_(VALUE_ENCODING_TEXT),
+      parent_(parent),
+      childrens_(),
+      delimiter_(delimiter),
+      childrens_limit_(0),
+      ring_head_(0),
+      childrens_total_(0),
+      spill_path_(),
+      spill_file_(nullptr) {
   DCHECK(value_);
   if (parent_) {
     observer_ = parent_->observer_;
   }
+  DetectEncoding();
+}
+
+void* FastoObject::operator new(size_t size) {
+  return ObjectArena::Allocate(size);
+}
+
+void FastoObject::operator delete(void* ptr) {
+  ObjectArena::Free(ptr);
 }
 
 FastoObject::~FastoObject() {
   Clear();
+  if (spill_file_) {
+    spill_file_->Close();
+    delete spill_file_;
+    spill_file_ = nullptr;
+  }
 }
 
 common::Value::Type FastoObject::GetType() const {
@@ -56,7 +83,13 @@ FastoObject* FastoObject::CreateRoot(const command_buffer_t& text, IFastoObjectO
 }
 
 FastoObject::childs_t FastoObject::GetChildrens() const {
-  return childrens_;
+  if (ring_head_ == 0) {
+    return childrens_;
+  }
+
+  childs_t ordered(childrens_.begin() + ring_head_, childrens_.end());
+  ordered.insert(ordered.end(), childrens_.begin(), childrens_.begin() + ring_head_);
+  return ordered;
 }
 
 void FastoObject::AddChildren(child_t child) {
@@ -65,18 +98,74 @@ void FastoObject::AddChildren(child_t child) {
   }
 
   CHECK(child->parent_ == this);
-  childrens_.push_back(child);
+  childrens_total_++;
+  if (childrens_limit_ && childrens_.size() >= childrens_limit_) {
+    // overwrite oldest one, no shifting of stored childrens
+    SpillChildren(childrens_[ring_head_]);
+    childrens_[ring_head_] = child;
+    ring_head_ = (ring_head_ + 1) % childrens_.size();
+  } else {
+    childrens_.push_back(child);
+  }
+
   if (observer_) {
     observer_->ChildrenAdded(child);
   }
 }
 
+void FastoObject::SetChildrensLimit(size_t limit, const std::string& spill_path) {
+  if (ring_head_ != 0) {
+    childrens_ = GetChildrens();
+    ring_head_ = 0;
+  }
+
+  childrens_limit_ = limit;
+  spill_path_ = spill_path;
+  while (childrens_limit_ && childrens_.size() > childrens_limit_) {
+    SpillChildren(childrens_.front());
+    childrens_.erase(childrens_.begin());
+  }
+}
+
+size_t FastoObject::GetChildrensLimit() const {
+  return childrens_limit_;
+}
+
+size_t FastoObject::GetChildrensTotal() const {
+  return childrens_total_;
+}
+
+std::string FastoObject::GetSpillPath() const {
+  return spill_path_;
+}
+
+void FastoObject::SpillChildren(child_t child) {
+  if (spill_path_.empty()) {
+    return;
+  }
+
+  if (!spill_file_) {
+    spill_file_ = new common::file_system::ANSIFile;
+  }
+
+  if (!spill_file_->IsOpen()) {
+    common::ErrnoError err = spill_file_->Open(spill_path_, "ab+");
+    if (err) {
+      spill_path_.clear();  // don't try on each children
+      return;
+    }
+  }
+
+  spill_file_->Write(child->ToString() + "\n");
+}
+
 FastoObject* FastoObject::GetParent() const {
   return parent_;
 }
 
 void FastoObject::Clear() {
   childrens_.clear();
+  ring_head_ = 0;
 }
 
 std::string FastoObject::GetDelimiter() const {
@@ -89,17 +178,37 @@ FastoObject::value_t FastoObject::GetValue() const {
 
 void FastoObject::SetValue(value_t val) {
   value_ = val;
+  DetectEncoding();
   if (observer_) {
     observer_->Updated(this, val);
   }
 }
 
+ValueEncoding FastoObject::GetValueEncoding() const {
+  return encoding_;
+}
+
+void FastoObject::DetectEncoding() {
+  // called on driver thread, so gui gets already classified values
+  encoding_ = DetectValueEncoding(value_.get());
+}
+
 FastoObjectCommand::FastoObjectCommand(FastoObject* parent,
                                        common::StringValue* cmd,
                                        CmdLoggingType ct,
                                        const std::string& delimiter,
                                        core::connectionTypes type)
-    : FastoObject(parent, cmd, delimiter), type_(type), ct_(ct) {}
+    : FastoObject(parent, cmd, delimiter), type_(type), ct_(ct), args_() {}
+
+FastoObjectCommand::FastoObjectCommand(FastoObject* parent,
+                                       const TypedCommand& cmd,
+                                       CmdLoggingType ct,
+                                       const std::string& delimiter,
+                                       core::connectionTypes type)
+    : FastoObject(parent, common::Value::CreateStringValue(cmd.GetCommandLine()), delimiter),
+      type_(type),
+      ct_(ct),
+      args_(cmd.GetArgv()) {}
 
 FastoObjectCommand::~FastoObjectCommand() {}
 
@@ -120,6 +229,10 @@ command_buffer_t FastoObjectCommand::GetInputCommand() const {
   return command_buffer_t();
 }
 
+commands_args_t FastoObjectCommand::GetInputArgs() const {
+  return args_;
+}
+
 CmdLoggingType FastoObjectCommand::GetCommandLoggingType() const {
   return ct_;
 }
@@ -23,6 +23,13 @@
 
 #include "core/connection_types.h"
 #include "core/types.h"
+#include "core/value_encoding.h"
+
+namespace common {
+namespace file_system {
+class ANSIFile;
+}
+}  // namespace common
 
 namespace fastonosql {
 namespace core {
@@ -56,19 +63,31 @@ class FastoObject : public common::intrusive_ptr_base<FastoObject> {
   FastoObject(FastoObject* parent, common::Value* val, const std::string& delimiter);  // val take ownerships
   virtual ~FastoObject();
 
+  // nodes created while command executes come from its ObjectArena
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   common::Value::Type GetType() const;
   virtual std::string ToString() const;
 
   static FastoObject* CreateRoot(const command_buffer_t& text, IFastoObjectObserver* observer = nullptr);
 
-  childs_t GetChildrens() const;
+  childs_t GetChildrens() const;  // in order of adding
   void AddChildren(child_t child);
   FastoObject* GetParent() const;
   void Clear();
   std::string GetDelimiter() const;
 
+  // streaming output: keeps only last limit childrens in ring buffer (0 - unlimited),
+  // evicted childrens are appended to spill_path if it is not empty
+  void SetChildrensLimit(size_t limit, const std::string& spill_path = std::string());
+  size_t GetChildrensLimit() const;
+  size_t GetChildrensTotal() const;  // added since creation, evicted included
+  std::string GetSpillPath() const;
+
   value_t GetValue() const;
   void SetValue(value_t val);
+  ValueEncoding GetValueEncoding() const;  // detected from sample while value is set, text for non string values
 
  protected:
   IFastoObjectObserver* observer_;
@@ -77,9 +96,19 @@ class FastoObject : public common::intrusive_ptr_base<FastoObject> {
  private:
   DISALLOW_COPY_AND_ASSIGN(FastoObject);
 
+  void SpillChildren(child_t child);
+  void DetectEncoding();
+
+  ValueEncoding encoding_;
   FastoObject* const parent_;
   childs_t childrens_;
   const std::string delimiter_;
+
+  size_t childrens_limit_;
+  size_t ring_head_;  // oldest children when ring is full
+  size_t childrens_total_;
+  std::string spill_path_;
+  common::file_system::ANSIFile* spill_file_;
 };
 
 class FastoObjectCommand : public FastoObject {
@@ -90,6 +119,7 @@ class FastoObjectCommand : public FastoObject {
   core::connectionTypes GetConnectionType() const;
 
   command_buffer_t GetInputCommand() const;
+  commands_args_t GetInputArgs() const;  // empty if command created from text
   CmdLoggingType GetCommandLoggingType() const;
 
  protected:
@@ -98,12 +128,18 @@ class FastoObjectCommand : public FastoObject {
                      CmdLoggingType ct,
                      const std::string& delimiter,
                      core::connectionTypes type);
+  FastoObjectCommand(FastoObject* parent,
+                     const TypedCommand& cmd,
+                     CmdLoggingType ct,
+                     const std::string& delimiter,
+                     core::connectionTypes type);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(FastoObjectCommand);
 
   const core::connectionTypes type_;
   const CmdLoggingType ct_;
+  const commands_args_t args_;
 };
 
 }  // namespace core
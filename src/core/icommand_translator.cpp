@@ -24,6 +24,7 @@ extern "C" {
 
 #include <common/convert2string.h>
 #include <common/sprintf.h>
+#include <common/string_util.h>  // for FullEqualsASCII
 
 namespace fastonosql {
 namespace core {
@@ -52,6 +53,41 @@ common::Error ParseCommands(const command_buffer_t& cmd, std::vector<command_buf
   return common::Error();
 }
 
+bool IsStreamingCommand(const command_buffer_t& command) {
+  const size_t start = command.find_first_not_of(' ');
+  if (start == command_buffer_t::npos) {
+    return false;
+  }
+
+  const size_t end = command.find(' ', start);
+  const command_buffer_t name = command.substr(start, end == command_buffer_t::npos ? end : end - start);
+  static const command_buffer_t streaming_commands[] = {DB_MONITOR_COMMAND, DB_SUBSCRIBE_COMMAND,
+                                                        DB_PSUBSCRIBE_COMMAND, DB_SYNC_COMMAND};
+  for (const command_buffer_t& streaming : streaming_commands) {
+    if (common::FullEqualsASCII(name, streaming, false)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool HasStreamingCommand(const command_buffer_t& input) {
+  std::vector<command_buffer_t> commands;
+  common::Error err = ParseCommands(input, &commands);
+  if (err) {
+    return false;
+  }
+
+  for (const command_buffer_t& command : commands) {
+    if (IsStreamingCommand(command)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 ICommandTranslator::ICommandTranslator(const std::vector<CommandHolder>& commands) : commands_(commands) {}
 
 ICommandTranslator::~ICommandTranslator() {}
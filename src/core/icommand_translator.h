@@ -39,6 +39,9 @@
 
 #define DB_PUBLISH_COMMAND "PUBLISH"
 #define DB_SUBSCRIBE_COMMAND "SUBSCRIBE"
+#define DB_PSUBSCRIBE_COMMAND "PSUBSCRIBE"
+#define DB_MONITOR_COMMAND "MONITOR"
+#define DB_SYNC_COMMAND "SYNC"
 
 #define DB_GET_KEY_COMMAND "GET"        // exist for all
 #define DB_SET_KEY_COMMAND "SET"        // exist for all
@@ -46,6 +49,7 @@
 #define DB_RENAME_KEY_COMMAND "RENAME"  // exist for all
 #define DB_KEYS_COMMAND "KEYS"          // exist for all
 #define DB_SCAN_COMMAND "SCAN"          // exist for all
+#define DB_SEARCH_COMMAND "SEARCH"
 
 #define DB_GET_CONFIG_COMMAND "CONFIG GET"
 #define DB_GET_DATABASES_COMMAND DB_GET_CONFIG_COMMAND " databases"
@@ -57,6 +61,11 @@ namespace core {
 // should return vector of 2 commands {{"GET","alex"}, {"SET", "alex"}}
 common::Error ParseCommands(const command_buffer_t& cmd, std::vector<command_buffer_t>* cmds);
 
+// MONITOR, SUBSCRIBE, PSUBSCRIBE, SYNC: replies keep coming until interrupted
+bool IsStreamingCommand(const command_buffer_t& command);
+// input of several commands, true if one of them streams
+bool HasStreamingCommand(const command_buffer_t& input);
+
 class ICommandTranslator {
  public:
   explicit ICommandTranslator(const std::vector<CommandHolder>& commands);
@@ -27,6 +27,7 @@
 #include "core/internal/db_connection.h"    // for DBConnection
 
 #include "core/database/idatabase_info.h"
+#include "core/keys_filter.h"
 
 namespace fastonosql {
 namespace core {
@@ -65,6 +66,12 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
                      keys_limit_t count_keys,
                      std::vector<std::string>* keys_out,
                      cursor_t* cursor_out) WARN_UNUSED_RESULT;  // nvi
+  common::Error ScanFiltered(cursor_t cursor_in,
+                             const std::string& pattern,
+                             keys_limit_t count_keys,
+                             const KeysFilter& filter,
+                             std::vector<std::string>* keys_out,
+                             cursor_t* cursor_out) WARN_UNUSED_RESULT;  // nvi
   common::Error Keys(const std::string& key_start,
                      const std::string& key_end,
                      keys_limit_t limit,
@@ -89,6 +96,9 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
                          keys_limit_t limit,
                          const common::file_system::ascii_file_string_path& path,
                          cursor_t* cursor_out) WARN_UNUSED_RESULT;  // nvi
+  common::Error Search(const std::string& pattern,
+                       keys_limit_t limit,
+                       std::vector<std::string>* keys_out) WARN_UNUSED_RESULT;  // nvi, keys which values match
 
  protected:
   common::Error GenerateError(const std::string& cmd, const std::string& descr) WARN_UNUSED_RESULT {
@@ -103,6 +113,12 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
                                  keys_limit_t count_keys,
                                  std::vector<std::string>* keys_out,
                                  cursor_t* cursor_out) = 0;
+  virtual common::Error ScanFilteredImpl(cursor_t cursor_in,
+                                         const std::string& pattern,
+                                         keys_limit_t count_keys,
+                                         const KeysFilter& filter,
+                                         std::vector<std::string>* keys_out,
+                                         cursor_t* cursor_out);  // optional, by default checks keys page by page
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  keys_limit_t limit,
@@ -129,6 +145,9 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
                                      keys_limit_t limit,
                                      const common::file_system::ascii_file_string_path& path,
                                      cursor_t* cursor_out);  // optional;
+  virtual common::Error SearchImpl(const std::string& pattern,
+                                   keys_limit_t limit,
+                                   std::vector<std::string>* keys_out);  // optional
 };
 
 template <typename NConnection, typename Config, connectionTypes ContType>
@@ -207,6 +226,35 @@ common::Error CDBConnection<NConnection, Config, ContType>::Scan(cursor_t cursor
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ScanFiltered(cursor_t cursor_in,
+                                                                         const std::string& pattern,
+                                                                         keys_limit_t count_keys,
+                                                                         const KeysFilter& filter,
+                                                                         std::vector<std::string>* keys_out,
+                                                                         cursor_t* cursor_out) {
+  if (!keys_out || !cursor_out) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = CDBConnection<NConnection, Config, ContType>::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  if (filter.IsEmpty()) {
+    return ScanImpl(cursor_in, pattern, count_keys, keys_out, cursor_out);
+  }
+
+  err = ScanFilteredImpl(cursor_in, pattern, count_keys, filter, keys_out, cursor_out);
+  if (err) {
+    return err;
+  }
+
+  return common::Error();
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Keys(const std::string& key_start,
                                                                  const std::string& key_end,
@@ -616,6 +664,98 @@ common::Error CDBConnection<NConnection, Config, ContType>::GetTTLImpl(const NKe
   return common::make_error(error_msg);
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ScanFilteredImpl(cursor_t cursor_in,
+                                                                             const std::string& pattern,
+                                                                             keys_limit_t count_keys,
+                                                                             const KeysFilter& filter,
+                                                                             std::vector<std::string>* keys_out,
+                                                                             cursor_t* cursor_out) {
+  // cursor of ScanImpl, pages scanned until count_keys matched keys or end, like SCAN page may exceed count_keys
+  const bool check_value = !filter.types.empty() || filter.HasSizeRange();
+  const bool check_ttl = filter.HasTTLRange();
+  cursor_t lcursor = cursor_in;
+  std::vector<std::string> lkeys_out;
+  do {
+    if (db_base_class::IsInterrupted()) {
+      return common::make_error(common::COMMON_EINTR);
+    }
+
+    std::vector<std::string> page;
+    common::Error err = ScanImpl(lcursor, pattern, count_keys, &page, &lcursor);
+    if (err) {
+      return err;
+    }
+
+    for (size_t i = 0; i < page.size(); ++i) {
+      NKey key(page[i]);
+      if (check_value) {
+        NDbKValue loaded_key;
+        if (GetImpl(key, &loaded_key)) {  // removed while iterating
+          continue;
+        }
+
+        if (!filter.IsTypeAllowed(loaded_key.GetType()) ||
+            !filter.IsSizeAllowed(loaded_key.GetValue().GetValue().GetData().size())) {
+          continue;
+        }
+      }
+
+      if (check_ttl) {
+        ttl_t ttl = NO_TTL;
+        if (GetTTLImpl(key, &ttl)) {  // engine without expiration
+          ttl = NO_TTL;
+        }
+
+        if (!filter.IsTTLAllowed(ttl)) {
+          continue;
+        }
+      }
+
+      lkeys_out.push_back(page[i]);
+    }
+  } while (lcursor != 0 && lkeys_out.size() < count_keys);
+
+  *keys_out = lkeys_out;
+  *cursor_out = lcursor;
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::Search(const std::string& pattern,
+                                                                  keys_limit_t limit,
+                                                                  std::vector<std::string>* keys_out) {
+  if (!keys_out) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = CDBConnection<NConnection, Config, ContType>::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  err = SearchImpl(pattern, limit, keys_out);
+  if (err) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::SearchImpl(const std::string& pattern,
+                                                                      keys_limit_t limit,
+                                                                      std::vector<std::string>* keys_out) {
+  UNUSED(pattern);
+  UNUSED(limit);
+  UNUSED(keys_out);
+  const std::string error_msg =
+      common::MemSPrintf("Sorry, but now " PROJECT_NAME_TITLE " for %s not supported " DB_SEARCH_COMMAND " commands.",
+                         connection_traits_class::GetDBName());
+  return common::make_error(error_msg);
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::ModuleLoadImpl(const ModuleInfo& module) {
   UNUSED(module);
@@ -26,6 +26,8 @@ namespace core {
 
 class IDataBaseInfo;
 
+enum QueryCostAction { QUERY_COST_PAGE = 0, QUERY_COST_REJECT };
+
 class CDBConnectionClient {
  public:
   virtual void OnCreatedDB(IDataBaseInfo* info) = 0;
@@ -46,6 +48,13 @@ class CDBConnectionClient {
 
   virtual void OnQuited() = 0;
 
+  // reading of big reply: received of declared elements (arrays) or bytes (bulk strings)
+  virtual void OnReplyProgress(size_t received, size_t declared) = 0;
+
+  // expensive reads: elements in reply above which OnQueryCostExceeded is asked, 0 - no pre-flight
+  virtual size_t GetQueryCostThreshold() const = 0;
+  virtual QueryCostAction OnQueryCostExceeded(const command_buffer_t& command, size_t estimated) = 0;
+
   virtual ~CDBConnectionClient();
 };
 
@@ -28,7 +28,9 @@ namespace fastonosql {
 namespace core {
 namespace internal {
 
-CommandHandler::CommandHandler(ICommandTranslator* translator) : translator_(translator) {}
+CommandHandler::CommandHandler(ICommandTranslator* translator) : translator_(translator), paged_cardinality_(0) {}
+
+CommandHandler::~CommandHandler() {}
 
 common::Error CommandHandler::Execute(const command_buffer_t& command, FastoObject* out) {
   command_buffer_t stabled_command = StableCommand(command);
@@ -60,11 +62,29 @@ common::Error CommandHandler::Execute(commands_args_t argv, FastoObject* out) {
     return err;
   }
 
+  size_t paged_cardinality = 0;
+  err = PreflightCommand(argv, out, &paged_cardinality);
+  if (err) {
+    return err;
+  }
+
   commands_args_t stabled;
   for (size_t i = off; i < argv.size(); ++i) {
     stabled.push_back(argv[i]);
   }
-  return cmd->func_(this, stabled, out);
+  paged_cardinality_ = paged_cardinality;
+  err = cmd->func_(this, stabled, out);
+  paged_cardinality_ = 0;
+  return err;
+}
+
+common::Error CommandHandler::PreflightCommand(const commands_args_t& argv,
+                                               FastoObject* out,
+                                               size_t* paged_cardinality) {
+  UNUSED(argv);
+  UNUSED(out);
+  *paged_cardinality = 0;
+  return common::Error();
 }
 
 }  // namespace internal
@@ -30,12 +30,24 @@ namespace internal {
 class CommandHandler {
  public:
   explicit CommandHandler(ICommandTranslator* translator);  // take ownerships
+  virtual ~CommandHandler();
+
   common::Error Execute(const command_buffer_t& command, FastoObject* out) WARN_UNUSED_RESULT;
   common::Error Execute(commands_args_t argv, FastoObject* out) WARN_UNUSED_RESULT;
 
   translator_t GetTranslator() const { return translator_; }
 
+  // during execution of command
+  bool IsPagedCommand() const { return paged_cardinality_ != 0; }
+  size_t GetPagedCardinality() const { return paged_cardinality_; }
+
  protected:
+  // called with whole command line before its execution, can reject expensive command
+  // or ask to read its reply page by page: paged_cardinality - probed size of data behind it, 0 - read as is
+  virtual common::Error PreflightCommand(const commands_args_t& argv,
+                                         FastoObject* out,
+                                         size_t* paged_cardinality) WARN_UNUSED_RESULT;
+
   template <typename T>
   std::shared_ptr<T> GetSpecificTranslator() const {
     return std::static_pointer_cast<T>(translator_);
@@ -43,6 +55,7 @@ class CommandHandler {
 
  private:
   translator_t translator_;
+  size_t paged_cardinality_;
 };
 
 }  // namespace internal
@@ -20,6 +20,7 @@
 
 #include <common/convert2string.h>
 #include <common/file_system/path.h>
+#include <common/string_util.h>  // for FullEqualsASCII
 
 #include "core/global.h"
 
@@ -53,6 +54,9 @@ struct ApiTraits {
   static common::Error Quit(CommandHandler* handler, commands_args_t argv, FastoObject* out);
   static common::Error ConfigGet(internal::CommandHandler* handler, commands_args_t argv, FastoObject* out);
   static common::Error JsonDump(CommandHandler* handler, commands_args_t argv, FastoObject* out);
+  static common::Error Search(CommandHandler* handler, commands_args_t argv, FastoObject* out);
+  // <key> <value> [key value ...], for connections with batched Mset
+  static common::Error Mset(CommandHandler* handler, commands_args_t argv, FastoObject* out);
 };
 
 template <class CDBConnection>
@@ -246,6 +250,34 @@ common::Error ApiTraits<CDBConnection>::Set(internal::CommandHandler* handler, c
   return common::Error();
 }
 
+template <class CDBConnection>
+common::Error ApiTraits<CDBConnection>::Mset(internal::CommandHandler* handler,
+                                             commands_args_t argv,
+                                             FastoObject* out) {
+  if (argv.size() % 2 != 0) {
+    return common::make_error_inval();
+  }
+
+  NDbKValues keys;
+  keys.reserve(argv.size() / 2);
+  for (size_t i = 0; i < argv.size(); i += 2) {
+    NValue value(common::Value::CreateStringValue(argv[i + 1]));
+    keys.push_back(NDbKValue(NKey(key_t(argv[i])), value));
+  }
+
+  CDBConnection* cdb = static_cast<CDBConnection*>(handler);
+  NDbKValues added_keys;
+  common::Error err = cdb->Mset(keys, &added_keys);
+  if (err) {
+    return err;
+  }
+
+  common::StringValue* val = common::Value::CreateStringValue("OK");
+  FastoObject* child = new FastoObject(out, val, cdb->GetDelimiter());
+  out->AddChildren(child);
+  return common::Error();
+}
+
 template <class CDBConnection>
 common::Error ApiTraits<CDBConnection>::Get(internal::CommandHandler* handler, commands_args_t argv, FastoObject* out) {
   key_t raw_key(argv[0]);
@@ -459,6 +491,33 @@ common::Error ApiTraits<CDBConnection>::JsonDump(CommandHandler* handler, comman
   return common::Error();
 }
 
+template <class CDBConnection>
+common::Error ApiTraits<CDBConnection>::Search(CommandHandler* handler, commands_args_t argv, FastoObject* out) {
+  const size_t argc = argv.size();
+  keys_limit_t count_keys = NO_KEYS_LIMIT;
+  if (argc > 1 && (argc != 3 || !common::FullEqualsASCII(argv[1], "COUNT", false) ||
+                   !common::ConvertFromString(argv[2], &count_keys))) {
+    return common::make_error_inval();
+  }
+
+  std::vector<std::string> keys_out;
+  CDBConnection* cdb = static_cast<CDBConnection*>(handler);
+  common::Error err = cdb->Search(argv[0], count_keys, &keys_out);
+  if (err) {
+    return err;
+  }
+
+  common::ArrayValue* ar = common::Value::CreateArrayValue();
+  for (size_t i = 0; i < keys_out.size(); ++i) {
+    common::StringValue* val = common::Value::CreateStringValue(keys_out[i]);
+    ar->Append(val);
+  }
+
+  FastoObject* child = new FastoObject(out, ar, cdb->GetDelimiter());
+  out->AddChildren(child);
+  return common::Error();
+}
+
 }  // namespace internal
 }  // namespace core
 }  // namespace fastonosql
@@ -67,7 +67,7 @@ class DBConnection {
     return common::Error();
   }
 
-  void SetInterrupted(bool interrupted) { interrupted_ = interrupted; }
+  virtual void SetInterrupted(bool interrupted) { interrupted_ = interrupted; }
 
   bool IsInterrupted() const { return interrupted_; }
 
@@ -0,0 +1,158 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/internal/parallel_scan.h"
+
+#include <algorithm>  // for min
+#include <atomic>     // for atomic
+#include <mutex>      // for mutex, lock_guard
+#include <thread>     // for thread
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+KeyRange::KeyRange() : start(), limit() {}
+
+KeyRange::KeyRange(const std::string& start, const std::string& limit) : start(start), limit(limit) {}
+
+bool KeyRange::IsPastLimit(const std::string& key) const {
+  return IsPastLimit(key.data(), key.size());
+}
+
+bool KeyRange::IsPastLimit(const char* key, size_t size) const {
+  return !limit.empty() && limit.compare(0, limit.size(), key, size) <= 0;
+}
+
+key_ranges_t SplitKeyRange(const std::string& first_key, const std::string& last_key) {
+  size_t prefix_len = 0;
+  const size_t max_prefix_len = std::min(first_key.size(), last_key.size());
+  while (prefix_len < max_prefix_len && first_key[prefix_len] == last_key[prefix_len]) {
+    prefix_len++;
+  }
+
+  if (prefix_len == last_key.size()) {  // one key or last not greater than first
+    return {KeyRange()};
+  }
+
+  const std::string prefix = last_key.substr(0, prefix_len);
+  const int first_byte = prefix_len < first_key.size() ? static_cast<uint8_t>(first_key[prefix_len]) : -1;
+  const int last_byte = static_cast<uint8_t>(last_key[prefix_len]);
+
+  key_ranges_t ranges;
+  std::string start;
+  for (int byte = first_byte + 1; byte <= last_byte; ++byte) {
+    std::string limit = prefix + static_cast<char>(byte);
+    ranges.push_back(KeyRange(start, limit));
+    start = limit;
+  }
+  ranges.push_back(KeyRange(start, std::string()));
+  return ranges;
+}
+
+key_ranges_t MergeKeyRanges(const key_ranges_t& ranges, const std::vector<uint64_t>& weights, size_t count) {
+  if (ranges.size() != weights.size() || ranges.size() <= count || count == 0) {
+    return ranges;
+  }
+
+  uint64_t total = 0;
+  for (uint64_t weight : weights) {
+    total += weight;
+  }
+
+  if (total == 0) {  // sizes unknown (data in memtable), keep fine grained tasks
+    return ranges;
+  }
+
+  const uint64_t part = total / count + 1;
+  key_ranges_t merged;
+  KeyRange current = ranges[0];
+  uint64_t current_weight = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    current.limit = ranges[i].limit;
+    current_weight += weights[i];
+    if (current_weight >= part && i != ranges.size() - 1) {
+      merged.push_back(current);
+      current = KeyRange(ranges[i].limit, std::string());
+      current_weight = 0;
+    }
+  }
+  merged.push_back(current);
+  return merged;
+}
+
+size_t GetScanThreadsCount() {
+  const unsigned int cores = std::thread::hardware_concurrency();
+  return cores == 0 ? 1 : cores;
+}
+
+common::Error ParallelFor(size_t tasks_count,
+                          size_t threads_count,
+                          std::function<common::Error(size_t task)> func) {
+  if (!func) {
+    return common::make_error_inval();
+  }
+
+  threads_count = std::min(threads_count, tasks_count);
+  if (threads_count <= 1) {
+    for (size_t i = 0; i < tasks_count; ++i) {
+      common::Error err = func(i);
+      if (err) {
+        return err;
+      }
+    }
+    return common::Error();
+  }
+
+  std::atomic<size_t> next_task(0);
+  std::atomic<bool> failed(false);
+  std::mutex err_mutex;
+  common::Error first_err;
+  auto worker = [&]() {
+    while (!failed) {
+      const size_t task = next_task++;
+      if (task >= tasks_count) {
+        return;
+      }
+
+      common::Error err = func(task);
+      if (err) {
+        std::lock_guard<std::mutex> lock(err_mutex);
+        if (!first_err) {
+          first_err = err;
+        }
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < threads_count; ++i) {
+    workers.push_back(std::thread(worker));
+  }
+  worker();  // caller thread works too
+  for (std::thread& thread : workers) {
+    thread.join();
+  }
+
+  return first_err;
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
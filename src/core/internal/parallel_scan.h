@@ -0,0 +1,61 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <common/error.h>  // for Error
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+struct KeyRange {  // [start, limit), empty limit means up to end of key space, bytewise order
+  KeyRange();
+  KeyRange(const std::string& start, const std::string& limit);
+
+  bool IsPastLimit(const std::string& key) const;
+  bool IsPastLimit(const char* key, size_t size) const;
+
+  std::string start;
+  std::string limit;
+};
+
+typedef std::vector<KeyRange> key_ranges_t;
+
+// one range per byte after common prefix of first and last key, whole key space covered
+key_ranges_t SplitKeyRange(const std::string& first_key, const std::string& last_key);
+// joins neighbours into about count partitions of near equal weight, weights by GetApproximateSizes
+key_ranges_t MergeKeyRanges(const key_ranges_t& ranges, const std::vector<uint64_t>& weights, size_t count);
+
+size_t GetScanThreadsCount();
+
+// calls func for every task index on threads_count workers, free worker takes next task,
+// after first error not started tasks skipped
+common::Error ParallelFor(size_t tasks_count,
+                          size_t threads_count,
+                          std::function<common::Error(size_t task)> func) WARN_UNUSED_RESULT;
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,197 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>  // for atomic
+#include <chrono>  // for steady_clock
+#include <memory>  // for unique_ptr
+#include <mutex>   // for mutex
+#include <random>  // for uniform_real_distribution
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include "core/internal/cdb_connection.h"
+#include "core/workload.h"
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+class WorkloadWorker {
+ public:
+  typedef std::chrono::steady_clock clock_t;
+
+  WorkloadWorker(const WorkloadConfig& config, size_t operations, uint64_t seed, std::atomic<uint64_t>* next_insert)
+      : config_(config),
+        operations_(operations),
+        next_insert_(next_insert),
+        keys_(config.distribution, config.record_count, seed),
+        engine_(seed),
+        value_(config.value_size, 'v'),
+        histograms_(),
+        errors_() {}
+
+  // lock is not null for engines which handles can't be shared between threads
+  template <typename NConnection, typename Config, connectionTypes ContType>
+  void Run(CDBConnection<NConnection, Config, ContType>* db, std::mutex* lock) {
+    std::uniform_real_distribution<double> choice(0.0, 1.0);
+    for (size_t i = 0; i < operations_; ++i) {
+      const WorkloadOperation operation = ChooseOperation(choice(engine_));
+      const clock_t::time_point start = clock_t::now();
+      common::Error err;
+      if (lock) {
+        std::lock_guard<std::mutex> guard(*lock);
+        err = Execute(db, operation);
+      } else {
+        err = Execute(db, operation);
+      }
+      const clock_t::duration elapsed = clock_t::now() - start;
+      histograms_[operation].Add(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+      if (err) {
+        errors_[operation]++;
+      }
+    }
+  }
+
+  LatencyHistogram* GetHistogram(WorkloadOperation operation) { return &histograms_[operation]; }
+  size_t GetErrors(WorkloadOperation operation) const { return errors_[operation]; }
+
+ private:
+  WorkloadOperation ChooseOperation(double value) const {
+    double total = 0;
+    for (size_t i = 0; i < WORKLOAD_OPERATIONS_COUNT; ++i) {
+      total += config_.proportions[i];
+      if (value < total) {
+        return static_cast<WorkloadOperation>(i);
+      }
+    }
+    return WORKLOAD_READ;
+  }
+
+  template <typename NConnection, typename Config, connectionTypes ContType>
+  common::Error Execute(CDBConnection<NConnection, Config, ContType>* db, WorkloadOperation operation) {
+    if (operation == WORKLOAD_READ) {
+      NDbKValue loaded;
+      return db->Get(NKey(key_t(MakeWorkloadKey(NextKey()))), &loaded);
+    } else if (operation == WORKLOAD_UPDATE) {
+      NDbKValue added;
+      return db->Set(MakeRecord(NextKey()), &added);
+    } else if (operation == WORKLOAD_INSERT) {
+      NDbKValue added;
+      return db->Set(MakeRecord((*next_insert_)++), &added);
+    } else if (operation == WORKLOAD_SCAN) {
+      std::vector<std::string> keys;
+      return db->Keys(MakeWorkloadKey(NextKey()), MakeWorkloadKeyEnd(), config_.scan_length, &keys);
+    }
+
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  uint64_t NextKey() { return keys_.Next(next_insert_->load()); }  // inserted records are chosen too
+
+  NDbKValue MakeRecord(uint64_t index) const {
+    NValue val(common::Value::CreateStringValue(value_));
+    return NDbKValue(NKey(key_t(MakeWorkloadKey(index))), val);
+  }
+
+  const WorkloadConfig config_;
+  const size_t operations_;
+  std::atomic<uint64_t>* next_insert_;  // records count
+  KeyGenerator keys_;
+  std::mt19937_64 engine_;
+  const std::string value_;
+  LatencyHistogram histograms_[WORKLOAD_OPERATIONS_COUNT];
+  size_t errors_[WORKLOAD_OPERATIONS_COUNT];
+};
+
+// load phase inserts record_count keys, run phase replays operation mix from config.threads threads
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error RunWorkload(CDBConnection<NConnection, Config, ContType>* db,
+                          const WorkloadConfig& config,
+                          bool thread_safe,
+                          WorkloadResult* result) {
+  if (!db || !config.IsValid() || !result) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  typedef std::chrono::steady_clock clock_t;
+  WorkloadResult res;
+  res.type = ContType;
+
+  const std::string value(config.value_size, 'v');
+  clock_t::time_point start = clock_t::now();
+  for (size_t i = 0; i < config.record_count; ++i) {
+    NValue val(common::Value::CreateStringValue(value));
+    NDbKValue added;
+    common::Error err = db->Set(NDbKValue(NKey(key_t(MakeWorkloadKey(i))), val), &added);
+    if (err) {
+      return err;
+    }
+  }
+  res.load_msec = std::chrono::duration_cast<std::chrono::milliseconds>(clock_t::now() - start).count();
+
+  std::atomic<uint64_t> next_insert(config.record_count);
+  std::mutex lock;
+  std::vector<std::unique_ptr<WorkloadWorker>> workers;
+  for (size_t i = 0; i < config.threads; ++i) {
+    size_t operations = config.operation_count / config.threads;
+    if (i < config.operation_count % config.threads) {
+      operations++;
+    }
+    workers.push_back(std::unique_ptr<WorkloadWorker>(new WorkloadWorker(config, operations, i + 1, &next_insert)));
+  }
+
+  start = clock_t::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < workers.size(); ++i) {
+    threads.push_back(std::thread(&WorkloadWorker::Run<NConnection, Config, ContType>, workers[i].get(), db,
+                                  thread_safe ? nullptr : &lock));
+  }
+  workers[0]->Run(db, thread_safe ? nullptr : &lock);
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  res.run_msec = std::chrono::duration_cast<std::chrono::milliseconds>(clock_t::now() - start).count();
+  res.throughput = res.run_msec ? config.operation_count * 1000.0 / res.run_msec : 0;
+
+  for (size_t op = 0; op < WORKLOAD_OPERATIONS_COUNT; ++op) {
+    const WorkloadOperation operation = static_cast<WorkloadOperation>(op);
+    LatencyHistogram histogram;
+    WorkloadOperationStats* stats = &res.operations[op];
+    for (size_t i = 0; i < workers.size(); ++i) {
+      histogram.Merge(*workers[i]->GetHistogram(operation));
+      stats->errors += workers[i]->GetErrors(operation);
+    }
+    stats->count = histogram.GetCount();
+    stats->average_usec = histogram.GetAverage();
+    stats->p50_usec = histogram.GetPercentile(50);
+    stats->p95_usec = histogram.GetPercentile(95);
+    stats->p99_usec = histogram.GetPercentile(99);
+    stats->max_usec = histogram.GetMax();
+  }
+
+  *result = res;
+  return common::Error();
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,279 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/json_pretty_printer.h"
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+bool IsJsonSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsTokenChar(char c) {
+  return IsDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-' || c == '+' || c == '.';
+}
+
+// -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool IsJsonNumber(const std::string& token) {
+  size_t pos = 0;
+  const size_t size = token.size();
+  if (pos < size && token[pos] == '-') {
+    pos++;
+  }
+
+  if (pos < size && token[pos] == '0') {
+    pos++;
+  } else if (pos < size && IsDigit(token[pos])) {
+    while (pos < size && IsDigit(token[pos])) {
+      pos++;
+    }
+  } else {
+    return false;
+  }
+
+  if (pos < size && token[pos] == '.') {
+    pos++;
+    if (pos == size || !IsDigit(token[pos])) {
+      return false;
+    }
+    while (pos < size && IsDigit(token[pos])) {
+      pos++;
+    }
+  }
+
+  if (pos < size && (token[pos] == 'e' || token[pos] == 'E')) {
+    pos++;
+    if (pos < size && (token[pos] == '+' || token[pos] == '-')) {
+      pos++;
+    }
+    if (pos == size || !IsDigit(token[pos])) {
+      return false;
+    }
+    while (pos < size && IsDigit(token[pos])) {
+      pos++;
+    }
+  }
+
+  return pos == size;
+}
+
+}  // namespace
+
+JsonPrettyPrinter::JsonPrettyPrinter(std::string* out, size_t indent)
+    : out_(out),
+      indent_(indent),
+      stack_(),
+      state_(EXPECT_VALUE),
+      in_string_(false),
+      string_is_key_(false),
+      escape_(false),
+      pending_break_(false),
+      token_(),
+      valid_(true) {}
+
+bool JsonPrettyPrinter::Write(const char* data, size_t size) {
+  for (size_t i = 0; i < size && valid_; ++i) {
+    valid_ = Put(data[i]);
+  }
+
+  return valid_;
+}
+
+bool JsonPrettyPrinter::Write(const std::string& data) {
+  return Write(data.data(), data.size());
+}
+
+bool JsonPrettyPrinter::Finish() {
+  if (valid_ && !token_.empty()) {
+    valid_ = FlushToken();
+  }
+
+  return valid_ && !in_string_ && state_ == DONE;
+}
+
+bool JsonPrettyPrinter::Put(char c) {
+  if (in_string_) {
+    if (escape_) {
+      escape_ = false;
+    } else if (c == '\\') {
+      escape_ = true;
+    } else if (c == '"') {
+      in_string_ = false;
+    } else if (static_cast<unsigned char>(c) < 0x20) {  // control characters must be escaped
+      return false;
+    }
+
+    out_->push_back(c);
+    if (!in_string_) {
+      if (string_is_key_) {
+        state_ = EXPECT_COLON;
+      } else {
+        EndValue();
+      }
+    }
+    return true;
+  }
+
+  if (!token_.empty()) {
+    if (IsTokenChar(c)) {
+      token_.push_back(c);
+      return true;
+    }
+
+    if (!FlushToken()) {
+      return false;
+    }
+  }
+
+  if (IsJsonSpace(c)) {
+    return true;
+  }
+
+  switch (state_) {
+    case EXPECT_VALUE_OR_CLOSE:
+      if (c == ']') {
+        return Close(c);
+      }
+      return StartValue(c);
+    case EXPECT_VALUE:
+      return StartValue(c);
+    case EXPECT_KEY_OR_CLOSE:
+      if (c == '}') {
+        return Close(c);
+      }
+    // fall through
+    case EXPECT_KEY:
+      if (c != '"') {
+        return false;
+      }
+      BreakIfPending();
+      out_->push_back(c);
+      in_string_ = true;
+      string_is_key_ = true;
+      return true;
+    case EXPECT_COLON:
+      if (c != ':') {
+        return false;
+      }
+      out_->append(": ");
+      state_ = EXPECT_VALUE;
+      return true;
+    case EXPECT_NEXT:
+      if (c == ',') {
+        out_->push_back(c);
+        NewLine(stack_.size());
+        state_ = stack_.back() == '{' ? EXPECT_KEY : EXPECT_VALUE;
+        return true;
+      }
+      return Close(c);
+    case DONE:
+      return false;
+  }
+
+  return false;
+}
+
+bool JsonPrettyPrinter::StartValue(char c) {
+  if (c == '{' || c == '[') {
+    BreakIfPending();
+    return Open(c);
+  }
+
+  if (c == '"') {
+    BreakIfPending();
+    out_->push_back(c);
+    in_string_ = true;
+    string_is_key_ = false;
+    return true;
+  }
+
+  if (IsTokenChar(c)) {
+    BreakIfPending();
+    token_.push_back(c);
+    return true;
+  }
+
+  return false;
+}
+
+bool JsonPrettyPrinter::Open(char c) {
+  out_->push_back(c);
+  stack_.push_back(c);
+  state_ = c == '{' ? EXPECT_KEY_OR_CLOSE : EXPECT_VALUE_OR_CLOSE;
+  pending_break_ = true;
+  return true;
+}
+
+bool JsonPrettyPrinter::Close(char c) {
+  if (stack_.empty()) {
+    return false;
+  }
+
+  const char open = stack_.back();
+  if ((open == '{' && c != '}') || (open == '[' && c != ']')) {
+    return false;
+  }
+
+  stack_.pop_back();
+  if (pending_break_) {  // empty container stays on one line
+    pending_break_ = false;
+  } else {
+    NewLine(stack_.size());
+  }
+  out_->push_back(c);
+  EndValue();
+  return true;
+}
+
+bool JsonPrettyPrinter::FlushToken() {
+  const bool valid = token_ == "true" || token_ == "false" || token_ == "null" || IsJsonNumber(token_);
+  if (!valid) {
+    return false;
+  }
+
+  out_->append(token_);
+  token_.clear();
+  EndValue();
+  return true;
+}
+
+void JsonPrettyPrinter::EndValue() {
+  state_ = stack_.empty() ? DONE : EXPECT_NEXT;
+}
+
+void JsonPrettyPrinter::BreakIfPending() {
+  if (pending_break_) {
+    NewLine(stack_.size());
+    pending_break_ = false;
+  }
+}
+
+void JsonPrettyPrinter::NewLine(size_t depth) {
+  out_->push_back('\n');
+  out_->append(depth * indent_, ' ');
+}
+
+}  // namespace core
+}  // namespace fastonosql
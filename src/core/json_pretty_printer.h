@@ -0,0 +1,63 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+namespace fastonosql {
+namespace core {
+
+// reindents json text as it arrives, without building a document tree,
+// input may be split at any byte, output is appended to out on every Write
+// syntax is checked on the fly: Write and Finish return false on malformed input
+class JsonPrettyPrinter {
+ public:
+  explicit JsonPrettyPrinter(std::string* out, size_t indent = 2);
+
+  bool Write(const char* data, size_t size);
+  bool Write(const std::string& data);
+  bool Finish();  // true if input was exactly one complete json value
+
+ private:
+  enum State { EXPECT_VALUE, EXPECT_VALUE_OR_CLOSE, EXPECT_KEY, EXPECT_KEY_OR_CLOSE, EXPECT_COLON, EXPECT_NEXT, DONE };
+
+  bool Put(char c);
+  bool StartValue(char c);
+  bool Open(char c);
+  bool Close(char c);
+  bool FlushToken();
+  void EndValue();
+  void BreakIfPending();
+  void NewLine(size_t depth);
+
+  std::string* const out_;
+  const size_t indent_;
+  std::vector<char> stack_;  // open brackets
+  State state_;
+  bool in_string_;
+  bool string_is_key_;
+  bool escape_;
+  bool pending_break_;  // container just opened, line break is written with first element
+  std::string token_;   // number or literal being read
+  bool valid_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
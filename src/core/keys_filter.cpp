@@ -0,0 +1,69 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/keys_filter.h"
+
+#include <algorithm>  // for find
+#include <limits>     // for numeric_limits
+
+namespace fastonosql {
+namespace core {
+
+KeysFilter::KeysFilter()
+    : types(),
+      no_ttl(true),
+      with_ttl(true),
+      min_ttl(0),
+      max_ttl(std::numeric_limits<ttl_t>::max()),
+      min_size(0),
+      max_size(std::numeric_limits<size_t>::max()) {}
+
+bool KeysFilter::IsEmpty() const {
+  return types.empty() && !HasTTLRange() && !HasSizeRange();
+}
+
+bool KeysFilter::HasTTLRange() const {
+  return !no_ttl || !with_ttl || min_ttl > 0 || max_ttl != std::numeric_limits<ttl_t>::max();
+}
+
+bool KeysFilter::HasSizeRange() const {
+  return min_size != 0 || max_size != std::numeric_limits<size_t>::max();
+}
+
+bool KeysFilter::IsPlainStringsAllowed() const {
+  return IsTypeAllowed(common::Value::TYPE_STRING) && IsTTLAllowed(NO_TTL);
+}
+
+bool KeysFilter::IsTypeAllowed(common::Value::Type type) const {
+  return types.empty() || std::find(types.begin(), types.end(), type) != types.end();
+}
+
+bool KeysFilter::IsTTLAllowed(ttl_t ttl) const {
+  if (ttl == NO_TTL) {
+    return no_ttl;
+  }
+
+  return with_ttl && ttl >= min_ttl && ttl <= max_ttl;
+}
+
+bool KeysFilter::IsSizeAllowed(size_t size) const {
+  return size >= min_size && size <= max_size;
+}
+
+}  // namespace core
+}  // namespace fastonosql
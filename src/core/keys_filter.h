@@ -0,0 +1,53 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>  // for vector
+
+#include <common/value.h>  // for Value::Type
+
+#include "core/db_key.h"  // for ttl_t
+
+namespace fastonosql {
+namespace core {
+
+// content load filter evaluated by drivers as close to data as possible, default passes every key
+struct KeysFilter {
+  KeysFilter();
+
+  bool IsEmpty() const;
+  bool HasTTLRange() const;
+  bool HasSizeRange() const;
+  bool IsPlainStringsAllowed() const;  // string values without expiration, as embedded engines store
+
+  bool IsTypeAllowed(common::Value::Type type) const;
+  bool IsTTLAllowed(ttl_t ttl) const;
+  bool IsSizeAllowed(size_t size) const;  // approximate value size in bytes
+
+  std::vector<common::Value::Type> types;  // empty means any type
+  bool no_ttl;                             // keys without expiration
+  bool with_ttl;                           // keys with expiration in [min_ttl, max_ttl] seconds
+  ttl_t min_ttl;
+  ttl_t max_ttl;
+  size_t min_size;
+  size_t max_size;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,152 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/object_arena.h"
+
+#include <new>  // for operator new
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+thread_local ObjectArena* current_arena = nullptr;
+}  // namespace
+
+// keeps nodes aligned as operator new does
+struct alignas(16) ObjectArena::Header {
+  ObjectArena* arena;  // nullptr for heap nodes
+  size_t node_size;
+};
+
+ObjectArena* ObjectArena::Create(size_t block_size) {
+  return new ObjectArena(block_size);
+}
+
+void ObjectArena::Release() {
+  bool last = false;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    last = --refs_ == 0;
+  }
+
+  if (last) {
+    delete this;
+  }
+}
+
+void* ObjectArena::Allocate(size_t size) {
+  const size_t node_size = (sizeof(Header) + size + size_step - 1) / size_step * size_step;
+  ObjectArena* arena = current_arena;
+  Header* header = nullptr;
+  if (arena && node_size <= max_object_size) {
+    header = static_cast<Header*>(arena->AllocateNode(node_size));
+  } else {
+    arena = nullptr;
+    header = static_cast<Header*>(::operator new(node_size));
+  }
+
+  header->arena = arena;
+  header->node_size = node_size;
+  return header + 1;
+}
+
+void ObjectArena::Free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+
+  Header* header = static_cast<Header*>(ptr) - 1;
+  ObjectArena* arena = header->arena;
+  if (!arena) {
+    ::operator delete(header);
+    return;
+  }
+
+  if (arena->ReleaseNode(header, header->node_size)) {
+    delete arena;
+  }
+}
+
+ObjectArena* ObjectArena::GetCurrent() {
+  return current_arena;
+}
+
+ObjectArena* ObjectArena::SetCurrent(ObjectArena* arena) {
+  ObjectArena* previous = current_arena;
+  current_arena = arena;
+  return previous;
+}
+
+size_t ObjectArena::GetLiveCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return refs_ - 1;
+}
+
+size_t ObjectArena::GetBlocksCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return blocks_.size();
+}
+
+ObjectArena::ObjectArena(size_t block_size)
+    : block_size_(block_size < max_object_size ? static_cast<size_t>(max_object_size) : block_size),
+      blocks_(),
+      current_(nullptr),
+      left_(0),
+      free_lists_(),
+      refs_(1),
+      lock_() {}
+
+ObjectArena::~ObjectArena() {
+  for (char* block : blocks_) {
+    ::operator delete(block);
+  }
+}
+
+void* ObjectArena::AllocateNode(size_t node_size) {
+  std::lock_guard<std::mutex> lock(lock_);
+  refs_++;
+  FreeListNode*& free_list = free_lists_[node_size / size_step - 1];
+  if (free_list) {
+    FreeListNode* node = free_list;
+    free_list = node->next;
+    return node;
+  }
+
+  if (left_ < node_size) {
+    current_ = static_cast<char*>(::operator new(block_size_));
+    left_ = block_size_;
+    blocks_.push_back(current_);
+  }
+
+  void* node = current_;
+  current_ += node_size;
+  left_ -= node_size;
+  return node;
+}
+
+bool ObjectArena::ReleaseNode(void* node, size_t node_size) {
+  std::lock_guard<std::mutex> lock(lock_);
+  FreeListNode* free_node = static_cast<FreeListNode*>(node);
+  FreeListNode*& free_list = free_lists_[node_size / size_step - 1];
+  free_node->next = free_list;
+  free_list = free_node;
+  return --refs_ == 0;
+}
+
+}  // namespace core
+}  // namespace fastonosql
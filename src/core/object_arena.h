@@ -0,0 +1,76 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include <mutex>   // for mutex
+#include <vector>  // for vector
+
+#include <common/macros.h>
+
+namespace fastonosql {
+namespace core {
+
+// memory for nodes of one command tree: nodes are carved from big blocks, freed nodes are
+// reused by next nodes of the same size, blocks are released at once with the last node,
+// nodes may be freed from any thread
+class ObjectArena {
+ public:
+  enum { default_block_size = 64 * 1024, max_object_size = 512 };
+
+  static ObjectArena* Create(size_t block_size = default_block_size);
+  void Release();  // drops creator reference
+
+  // from arena current for this thread, or from heap if there is none
+  static void* Allocate(size_t size);
+  static void Free(void* ptr);
+
+  static ObjectArena* GetCurrent();
+  static ObjectArena* SetCurrent(ObjectArena* arena);  // returns previous
+
+  size_t GetLiveCount() const;
+  size_t GetBlocksCount() const;
+
+ private:
+  struct Header;
+  struct FreeListNode {
+    FreeListNode* next;
+  };
+  enum { size_step = 16, size_classes = max_object_size / size_step };
+
+  explicit ObjectArena(size_t block_size);
+  ~ObjectArena();
+
+  void* AllocateNode(size_t node_size);
+  bool ReleaseNode(void* node, size_t node_size);  // true if arena should be deleted
+
+  const size_t block_size_;
+  std::vector<char*> blocks_;
+  char* current_;
+  size_t left_;
+  FreeListNode* free_lists_[size_classes];
+  size_t refs_;  // live nodes and creator
+  mutable std::mutex lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectArena);
+};
+
+}  // namespace core
+}  // namespace fastonosql
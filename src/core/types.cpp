@@ -18,7 +18,11 @@
 
 #include "core/types.h"
 
+#include <stdint.h>  // for uint64_t
+#include <string.h>  // for memcpy
+
 #include <algorithm>
+#include <mutex>  // for call_once
 
 #include <common/string_util.h>
 
@@ -61,6 +65,66 @@ std::string hex_string_impl(const T& value) {
   return wr.str();
 }
 
+bool is_control_byte(unsigned char c) {
+  return c < 0x20 || c == 0x7f;
+}
+
+// quotes argument so that StableCommand + sdssplitargslong read back same bytes:
+// double quotes take everything but '"', '\' and control bytes, single quotes everything but '\'' and '\',
+// otherwise these bytes are \xHH inside double quotes, like a space before them or before another space,
+// as StableCommand splits line by spaces and quotes \xHH tokens
+std::string quote_command_line_arg(const std::string& arg) {
+  bool plain = !arg.empty();
+  bool have_dquote = false, have_squote = false, need_hex = false;
+  for (size_t i = 0; i < arg.size(); ++i) {
+    const unsigned char c = arg[i];
+    if (c == '"') {
+      have_dquote = true;
+    } else if (c == '\'') {
+      have_squote = true;
+    } else if (c == '\\' || is_control_byte(c) || (c == ' ' && i + 1 < arg.size() && arg[i + 1] == ' ')) {
+      need_hex = true;
+    }
+
+    if (c == ' ' || c == '"' || c == '\'' || c == '\\' || c == '{' || is_control_byte(c)) {
+      plain = false;
+    }
+  }
+
+  if (plain) {
+    return arg;
+  }
+
+  if (!need_hex && !have_dquote) {
+    return "\"" + arg + "\"";
+  }
+
+  if (!need_hex && !have_squote) {
+    return "'" + arg + "'";
+  }
+
+  static const char hex_digits[] = "0123456789abcdef";
+  std::string quoted = "\"";
+  for (size_t i = 0; i < arg.size(); ++i) {
+    const unsigned char c = arg[i];
+    bool escape = c == '"' || c == '\\' || is_control_byte(c);
+    if (c == ' ' && i + 1 < arg.size()) {
+      const unsigned char next = arg[i + 1];
+      escape = next == ' ' || next == '"' || next == '\\' || is_control_byte(next);
+    }
+
+    if (escape) {
+      quoted += "\\x";
+      quoted += hex_digits[c >> 4];
+      quoted += hex_digits[c & 0x0f];
+    } else {
+      quoted += static_cast<char>(c);
+    }
+  }
+  quoted += "\"";
+  return quoted;
+}
+
 }  // namespace
 
 namespace fastonosql {
@@ -100,9 +164,23 @@ command_buffer_t StableCommand(const command_buffer_t& command) {
   return stabled_command;
 }
 
-ReadableString::ReadableString() : data_(), type_(TEXT_DATA) {}
+struct ReadableString::SharedData {
+  SharedData(const readable_string_t& data, DataType type)
+      : data(data), type(type), human_once(), command_line_once(), human(), command_line() {}
 
-ReadableString::ReadableString(const readable_string_t& data) : data_(), type_(TEXT_DATA) {
+  const readable_string_t data;
+  const DataType type;
+
+  // forms computed on first request, copies in other threads can ask concurrently
+  std::once_flag human_once;
+  std::once_flag command_line_once;
+  readable_string_t human;
+  readable_string_t command_line;
+};
+
+ReadableString::ReadableString() : data_(), shared_(), type_(TEXT_DATA) {}
+
+ReadableString::ReadableString(const readable_string_t& data) : data_(), shared_(), type_(TEXT_DATA) {
   SetData(data);
 }
 
@@ -110,43 +188,115 @@ ReadableString::DataType ReadableString::GetType() const {
   return type_;
 }
 
-readable_string_t ReadableString::GetData() const {
-  return data_;
+const readable_string_t& ReadableString::GetData() const {
+  return shared_ ? shared_->data : data_;
 }
 
-readable_string_t ReadableString::GetHumanReadable() const {
-  if (type_ == BINARY_DATA) {
-    return detail::hex_string(data_);
+const readable_string_t& ReadableString::GetHumanReadable() const {
+  if (!shared_ || type_ != BINARY_DATA) {
+    return GetData();
   }
 
-  return data_;
+  SharedData* shared = shared_.get();
+  std::call_once(shared->human_once, [shared]() { shared->human = detail::hex_string(shared->data); });
+  return shared->human;
 }
 
-readable_string_t ReadableString::GetForCommandLine() const {
-  if (type_ == BINARY_DATA) {
-    command_buffer_writer_t wr;
-    wr << "\"" << detail::hex_string(data_) << "\"";
-    return wr.str();
-  }
-
-  if (detail::is_json(data_)) {
+const readable_string_t& ReadableString::GetForCommandLine() const {
+  if (!shared_) {
     return data_;
   }
 
-  if (detail::have_space(data_)) {
-    return "\"" + data_ + "\"";
-  }
-
-  return data_;
+  SharedData* shared = shared_.get();
+  std::call_once(shared->command_line_once, [shared]() {
+    if (shared->type == BINARY_DATA) {
+      shared->command_line = "\"" + detail::hex_string(shared->data) + "\"";
+    } else if (!detail::is_json(shared->data) && detail::have_space(shared->data)) {
+      shared->command_line = "\"" + shared->data + "\"";
+    } else {
+      shared->command_line = shared->data;
+    }
+  });
+  return shared->command_line;
 }
 
 void ReadableString::SetData(const readable_string_t& data) {
-  data_ = data;
   type_ = detail::is_binary_data(data) ? BINARY_DATA : TEXT_DATA;
+  if (type_ == TEXT_DATA && data.size() <= max_inline_size && !detail::have_space(data)) {
+    // all forms are the data itself
+    data_ = data;
+    shared_.reset();
+    return;
+  }
+
+  data_.clear();
+  shared_ = std::make_shared<SharedData>(data, type_);
 }
 
 bool ReadableString::Equals(const ReadableString& other) const {
-  return type_ == other.type_ && data_ == other.data_;
+  if (type_ != other.type_) {
+    return false;
+  }
+
+  if (shared_ && shared_ == other.shared_) {
+    return true;
+  }
+
+  return GetData() == other.GetData();
+}
+
+TypedCommand::TypedCommand() : argv_() {}
+
+TypedCommand::TypedCommand(const command_buffer_t& name) : argv_() {
+  std::vector<command_buffer_t> tokens;
+  size_t tok = common::Tokenize(name, " ", &tokens);
+  for (size_t i = 0; i < tok; ++i) {
+    argv_.push_back(tokens[i]);
+  }
+}
+
+TypedCommand::TypedCommand(const commands_args_t& argv) : argv_(argv) {}
+
+TypedCommand& TypedCommand::operator<<(const command_buffer_t& arg) {
+  argv_.push_back(arg);
+  return *this;
+}
+
+TypedCommand& TypedCommand::operator<<(const char* arg) {
+  argv_.push_back(arg);
+  return *this;
+}
+
+TypedCommand& TypedCommand::operator<<(const ReadableString& arg) {
+  argv_.push_back(arg.GetData());
+  return *this;
+}
+
+bool TypedCommand::IsEmpty() const {
+  return argv_.empty();
+}
+
+size_t TypedCommand::GetArgc() const {
+  return argv_.size();
+}
+
+const commands_args_t& TypedCommand::GetArgv() const {
+  return argv_;
+}
+
+command_buffer_t TypedCommand::GetCommandLine() const {
+  command_buffer_writer_t wr;
+  for (size_t i = 0; i < argv_.size(); ++i) {
+    if (i != 0) {
+      wr << " ";
+    }
+    if (detail::is_binary_data(argv_[i])) {
+      wr << "\"" << detail::hex_string(argv_[i]) << "\"";
+    } else {
+      wr << quote_command_line_arg(argv_[i]);
+    }
+  }
+  return wr.str();
 }
 
 namespace detail {
@@ -212,8 +362,20 @@ bool have_space(const std::string& data) {
 }
 
 bool is_binary_data(const command_buffer_t& data) {
-  for (size_t i = 0; i < data.size(); ++i) {
-    unsigned char c = static_cast<unsigned char>(data[i]);
+  const char* ptr = data.data();
+  const size_t size = data.size();
+  size_t i = 0;
+  // 8 bytes per step: (x - 0x20..) & ~x & 0x80.. is not zero only if some byte is less than 0x20
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, ptr + i, sizeof(word));
+    if ((word - 0x2020202020202020ULL) & ~word & 0x8080808080808080ULL) {
+      return true;
+    }
+  }
+
+  for (; i < size; ++i) {
+    unsigned char c = static_cast<unsigned char>(ptr[i]);
     if (c < ' ') {  // should be hexed symbol
       return true;
     }
@@ -19,7 +19,11 @@
 #pragma once
 
 #include <deque>
+#include <memory>
 #include <string>
+#include <type_traits>
+
+#include <common/convert2string.h>
 
 #define DEFAULT_DELIMITER " "
 
@@ -45,24 +49,30 @@ std::string unicode_string(const std::string& value);
 std::string string_from_unicode(const std::string& value);
 }  // namespace detail
 
+// classified once, short plain text kept inline (std::string SSO, no allocation),
+// other data in buffer shared by copies with lazily cached hex/escaped forms
 class ReadableString {
  public:
   enum DataType { TEXT_DATA = 0, BINARY_DATA };
+  enum { max_inline_size = 15 };
 
   ReadableString();
   ReadableString(const readable_string_t& data);
 
   DataType GetType() const;
 
-  readable_string_t GetData() const;            // for direct bytes call
-  readable_string_t GetHumanReadable() const;   // for diplaying
-  readable_string_t GetForCommandLine() const;  // escape if hex, or double quoted if text with space
+  const readable_string_t& GetData() const;            // for direct bytes call
+  const readable_string_t& GetHumanReadable() const;   // for diplaying
+  const readable_string_t& GetForCommandLine() const;  // escape if hex, or double quoted if text with space
   void SetData(const readable_string_t& data);
 
   bool Equals(const ReadableString& other) const;
 
  private:
-  readable_string_t data_;
+  struct SharedData;
+
+  readable_string_t data_;  // used if shared_ is null
+  std::shared_ptr<SharedData> shared_;
   DataType type_;
 };
 
@@ -74,5 +84,32 @@ inline bool operator!=(const ReadableString& r, const ReadableString& l) {
   return !(r == l);
 }
 
+// binary safe command: argv[0..n] raw bytes, passed to native api as is,
+// text form only for displaying and history
+class TypedCommand {
+ public:
+  TypedCommand();
+  explicit TypedCommand(const command_buffer_t& name);  // name can be compound, like "CONFIG GET"
+  explicit TypedCommand(const commands_args_t& argv);
+
+  TypedCommand& operator<<(const command_buffer_t& arg);
+  TypedCommand& operator<<(const char* arg);
+  TypedCommand& operator<<(const ReadableString& arg);
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, TypedCommand&>::type operator<<(T arg) {
+    argv_.push_back(common::ConvertToString(arg));
+    return *this;
+  }
+
+  bool IsEmpty() const;
+  size_t GetArgc() const;
+  const commands_args_t& GetArgv() const;
+  command_buffer_t GetCommandLine() const;  // quoted and escaped, parses back to same argv
+
+ private:
+  commands_args_t argv_;
+};
+
 }  // namespace core
 }  // namespace fastonosql
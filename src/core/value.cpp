@@ -19,14 +19,121 @@
 #include "core/value.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include <json-c/json_tokener.h>
 
 #include <common/convert2string.h>
 
+#include "core/types.h"  // for detail::is_binary_data
+
 namespace fastonosql {
 namespace core {
 namespace {
+const char kPreviewEllipsis[] = "\xE2\x80\xA6";
+const size_t kHexedByteSize = 4;  // \xNN
+
+std::string MakePreviewMarker(size_t more, const char* units) {
+  return kPreviewEllipsis + std::string("(") + common::ConvertToString(more) + " more" + units + ")";
+}
+
+// raw bytes of string values, without copying them
+bool GetValueBuffer(common::Value* value, const char** data, size_t* size) {
+  const std::string* str = nullptr;
+  const common::Value::Type t = value->GetType();
+  if (t == common::Value::TYPE_STRING) {
+    str = &static_cast<common::StringValue*>(value)->GetString();
+  } else if (t == JsonValue::TYPE_JSON) {
+    str = &static_cast<JsonValue*>(value)->GetString();
+  } else {
+    return false;
+  }
+
+  *data = str->data();
+  *size = str->size();
+  return true;
+}
+
+// displayable form of the data prefix, binary prefix is hexed before the marker is appended
+std::string TruncatePreview(const char* data, size_t size, size_t max_size) {
+  size_t cut = std::min(size, max_size);
+  if (detail::is_binary_data(command_buffer_t(data, cut))) {
+    cut = std::min(cut, max_size / kHexedByteSize);
+    const std::string hexed = detail::hex_string(std::string(data, cut));
+    return cut == size ? hexed : hexed + MakePreviewMarker(size - cut, " bytes");
+  }
+
+  if (cut == size) {
+    return std::string(data, size);
+  }
+
+  for (size_t i = 0; i < 3 && cut > 0 && (static_cast<unsigned char>(data[cut]) & 0xC0) == 0x80; ++i) {
+    cut--;  // don't split utf-8 sequence
+  }
+
+  return std::string(data, cut) + MakePreviewMarker(size - cut, " bytes");
+}
+
+std::string TruncatePreview(const std::string& text, size_t max_size) {
+  return TruncatePreview(text.data(), text.size(), max_size);
+}
+
+// key takes at most half of the budget, value gets the rest
+size_t PairValueBudget(const std::string& key_str, size_t max_size) {
+  return max_size - std::min(key_str.size() + 1, max_size / 2);
+}
+
+std::string ConvertPairPreview(common::Value* key,
+                               common::Value* value,
+                               const std::string& delimiter,
+                               size_t max_size) {
+  const std::string key_str = ConvertValuePreview(key, delimiter, max_size / 2);
+  if (key_str.empty()) {
+    return std::string();
+  }
+
+  const std::string value_str = ConvertValuePreview(value, delimiter, PairValueBudget(key_str, max_size));
+  if (value_str.empty()) {
+    return std::string();
+  }
+
+  return key_str + " " + value_str;
+}
+
+std::string ConvertPairPreview(const std::string& key, const std::string& value, size_t max_size) {
+  const std::string key_str = TruncatePreview(key, max_size / 2);
+  return key_str + " " + TruncatePreview(value, PairValueBudget(key_str, max_size));
+}
+
+// converts elements until max_size is reached, the rest of elements is only counted
+template <typename It, typename Convert>
+std::string ConvertRangePreview(It begin,
+                                It end,
+                                size_t count,  // of range, so rest is counted without walking it
+                                const std::string& delimiter,
+                                size_t max_size,
+                                Convert convert) {
+  std::string result;
+  size_t index = 0;
+  for (It it = begin; it != end; ++it, ++index) {
+    if (result.size() >= max_size) {
+      result += MakePreviewMarker(count - index, "");
+      break;
+    }
+
+    std::string val = convert(it, max_size - result.size());
+    if (val.empty()) {
+      continue;
+    }
+
+    result += val;
+    if (std::next(it) != end) {
+      result += delimiter;
+    }
+  }
+  return result;
+}
+
 const char* string_types[] = {"TYPE_NULL",
                               "TYPE_BOOLEAN",
                               "TYPE_INTEGER",
@@ -65,7 +172,7 @@ bool StreamValue::Equals(const Value* other) const {
   return GetAsString(&lhs) && other->GetAsString(&rhs) && lhs == rhs;
 }
 
-StreamValue::streams_t StreamValue::GetStreams() const {
+const StreamValue::streams_t& StreamValue::GetStreams() const {
   return streams_;
 }
 
@@ -77,6 +184,10 @@ JsonValue::JsonValue(const std::string& json_value) : Value(TYPE_JSON), value_(j
 
 JsonValue::~JsonValue() {}
 
+const std::string& JsonValue::GetString() const {
+  return value_;
+}
+
 bool JsonValue::GetAsString(std::string* out_value) const {
   if (out_value) {
     *out_value = value_;
@@ -168,6 +279,83 @@ bool SearchValue::Equals(const Value* other) const {
 
 SearchValue::SearchValue(common::Value::Type type) : Value(type) {}
 
+CompactArrayValue::CompactArrayValue() : Value(TYPE_COMPACT_ARRAY), data_(), ends_() {}
+
+CompactArrayValue::~CompactArrayValue() {}
+
+void CompactArrayValue::Reserve(size_t count, size_t bytes) {
+  ends_.reserve(count);
+  data_.reserve(bytes);
+}
+
+void CompactArrayValue::Append(const char* data, size_t size) {
+  data_.append(data, size);
+  ends_.push_back(data_.size());
+}
+
+void CompactArrayValue::Append(const std::string& str) {
+  Append(str.data(), str.size());
+}
+
+size_t CompactArrayValue::GetSize() const {
+  return ends_.size();
+}
+
+bool CompactArrayValue::Get(size_t index, const char** data, size_t* size) const {
+  if (index >= ends_.size() || !data || !size) {
+    return false;
+  }
+
+  const size_t start = index == 0 ? 0 : ends_[index - 1];
+  *data = data_.data() + start;
+  *size = ends_[index] - start;
+  return true;
+}
+
+bool CompactArrayValue::GetString(size_t index, std::string* out_value) const {
+  const char* data = nullptr;
+  size_t size = 0;
+  if (!Get(index, &data, &size)) {
+    return false;
+  }
+
+  if (out_value) {
+    out_value->assign(data, size);
+  }
+  return true;
+}
+
+size_t CompactArrayValue::GetBytesUsed() const {
+  return data_.capacity() + ends_.capacity() * sizeof(size_t);
+}
+
+common::ArrayValue* CompactArrayValue::ToArrayValue() const {
+  common::ArrayValue* arr = common::Value::CreateArrayValue();
+  for (size_t i = 0; i < ends_.size(); ++i) {
+    std::string str;
+    if (GetString(i, &str)) {
+      arr->Append(common::Value::CreateStringValue(str));
+    }
+  }
+  return arr;
+}
+
+CompactArrayValue* CompactArrayValue::DeepCopy() const {
+  CompactArrayValue* copy = new CompactArrayValue;
+  copy->data_ = data_;
+  copy->ends_ = ends_;
+  return copy;
+}
+
+bool CompactArrayValue::Equals(const Value* other) const {
+  if (other->GetType() != GetType()) {
+    return false;
+  }
+
+  const CompactArrayValue* other_array = static_cast<const CompactArrayValue*>(other);
+  return ends_ == other_array->ends_ && data_ == other_array->data_;
+}
+
 common::Value* CreateEmptyValueFromType(common::Value::Type value_type) {
   const uint8_t cvalue_type = value_type;
   switch (cvalue_type) {
@@ -235,6 +423,9 @@ common::Value* CreateEmptyValueFromType(common::Value::Type value_type) {
     case SearchValue::TYPE_FT_TERM: {
       return SearchValue::CreateSearchDocument();
     }
+    case CompactArrayValue::TYPE_COMPACT_ARRAY: {
+      return new CompactArrayValue;
+    }
   }
 
   return nullptr;
@@ -255,6 +446,8 @@ const char* GetTypeName(common::Value::Type value_type) {
     return "TYPE_FT_INDEX";
   } else if (value_type == SearchValue::TYPE_FT_TERM) {
     return "TYPE_FT_TERM";
+  } else if (value_type == CompactArrayValue::TYPE_COMPACT_ARRAY) {
+    return "TYPE_ARRAY";  // storage detail, shown as ordinary array
   }
 
   DNOTREACHED();
@@ -313,6 +506,8 @@ std::string ConvertValue(common::Value* value, const std::string& delimiter) {
     return ConvertValue(static_cast<SearchValue*>(value), delimiter);
   } else if (t == SearchValue::TYPE_FT_TERM) {
     return ConvertValue(static_cast<SearchValue*>(value), delimiter);
+  } else if (t == CompactArrayValue::TYPE_COMPACT_ARRAY) {
+    return ConvertValue(static_cast<CompactArrayValue*>(value), delimiter);
   }
 
   DNOTREACHED();
@@ -511,7 +706,7 @@ std::string ConvertValue(StreamValue* value, const std::string& delimiter) {
 
     wr << streams[i].id_;
     for (size_t j = 0; j < cur_str.entries_.size(); ++j) {
-      wr << " " << cur_str.entries_[i].name << " " << cur_str.entries_[i].value;
+      wr << " " << cur_str.entries_[j].name << " " << cur_str.entries_[j].value;
     }
   }
 
@@ -550,5 +745,117 @@ std::string ConvertValue(SearchValue* value, const std::string& delimiter) {
   return std::string();
 }
 
+std::string ConvertValue(CompactArrayValue* array, const std::string& delimiter) {
+  if (!array) {
+    return std::string();
+  }
+
+  std::string result;
+  for (size_t i = 0; i < array->GetSize(); ++i) {
+    const char* data = nullptr;
+    size_t size = 0;
+    if (!array->Get(i, &data, &size) || size == 0) {
+      continue;
+    }
+
+    result.append(data, size);
+    if (i != array->GetSize() - 1) {
+      result += delimiter;
+    }
+  }
+
+  return result;
+}
+
+std::string ConvertValuePreview(common::Value* value, const std::string& delimiter, size_t max_size) {
+  if (!value) {
+    return std::string();
+  }
+
+  const common::Value::Type t = value->GetType();
+  if (t == common::Value::TYPE_ARRAY) {
+    common::ArrayValue* array = static_cast<common::ArrayValue*>(value);
+    return ConvertRangePreview(array->begin(), array->end(), array->GetSize(), delimiter, max_size,
+                               [&delimiter](decltype(array->begin()) it, size_t left) {
+                                 return ConvertValuePreview(*it, delimiter, left);
+                               });
+  } else if (t == common::Value::TYPE_SET) {
+    common::SetValue* set = static_cast<common::SetValue*>(value);
+    return ConvertRangePreview(set->begin(), set->end(), set->GetSize(), delimiter, max_size,
+                               [&delimiter](decltype(set->begin()) it, size_t left) {
+                                 return ConvertValuePreview(*it, delimiter, left);
+                               });
+  } else if (t == common::Value::TYPE_ZSET) {
+    common::ZSetValue* zset = static_cast<common::ZSetValue*>(value);
+    return ConvertRangePreview(zset->begin(), zset->end(), zset->GetSize(), delimiter, max_size,
+                               [&delimiter](decltype(zset->begin()) it, size_t left) {
+                                 return ConvertPairPreview(it->first, it->second, delimiter, left);
+                               });
+  } else if (t == common::Value::TYPE_HASH) {
+    common::HashValue* hash = static_cast<common::HashValue*>(value);
+    return ConvertRangePreview(hash->begin(), hash->end(), hash->GetSize(), delimiter, max_size,
+                               [&delimiter](decltype(hash->begin()) it, size_t left) {
+                                 return ConvertPairPreview(it->first, it->second, delimiter, left);
+                               });
+  } else if (t == CompactArrayValue::TYPE_COMPACT_ARRAY) {
+    CompactArrayValue* array = static_cast<CompactArrayValue*>(value);
+    std::string result;
+    for (size_t i = 0; i < array->GetSize(); ++i) {
+      if (result.size() >= max_size) {
+        result += MakePreviewMarker(array->GetSize() - i, "");
+        break;
+      }
+
+      const char* data = nullptr;
+      size_t size = 0;
+      if (!array->Get(i, &data, &size) || size == 0) {
+        continue;
+      }
+
+      result += TruncatePreview(data, size, max_size - result.size());
+      if (i != array->GetSize() - 1) {
+        result += delimiter;
+      }
+    }
+    return result;
+  } else if (t == StreamValue::TYPE_STREAM) {
+    const StreamValue::streams_t& streams = static_cast<StreamValue*>(value)->GetStreams();
+    typedef StreamValue::streams_t::const_iterator stream_it;
+    auto convert_stream = [](stream_it it, size_t left) -> std::string {
+      const std::string id = TruncatePreview(it->id_, left);
+      if (id.size() >= left) {
+        return id;
+      }
+
+      typedef std::vector<StreamValue::Entry>::const_iterator entry_it;
+      const std::vector<StreamValue::Entry>& entries = it->entries_;
+      return id + " " + ConvertRangePreview(entries.begin(), entries.end(), entries.size(), " ", left - id.size() - 1,
+                                            [](entry_it eit, size_t eleft) {
+                                              return ConvertPairPreview(eit->name, eit->value, eleft);
+                                            });
+    };
+    return ConvertRangePreview(streams.begin(), streams.end(), streams.size(), delimiter, max_size, convert_stream);
+  }
+
+  const char* data = nullptr;
+  size_t size = 0;
+  if (GetValueBuffer(value, &data, &size)) {
+    return TruncatePreview(data, size, max_size);
+  }
+
+  // scalars, their text is short
+  return TruncatePreview(ConvertValue(value, delimiter), max_size);
+}
+
+ValueEncoding DetectValueEncoding(common::Value* value) {
+  const char* data = nullptr;
+  size_t size = 0;
+  if (!value || !GetValueBuffer(value, &data, &size)) {
+    return VALUE_ENCODING_TEXT;
+  }
+
+  return DetectValueEncoding(data, size);
+}
+
 }  // namespace core
 }  // namespace fastonosql
@@ -20,6 +20,8 @@
 
 #include <common/value.h>  // for ArrayValue (ptr only), etc
 
+#include "core/value_encoding.h"
+
 namespace fastonosql {
 namespace core {
 
@@ -43,7 +45,7 @@ class StreamValue : public common::Value {
   virtual StreamValue* DeepCopy() const override;
   virtual bool Equals(const Value* other) const override;
 
-  streams_t GetStreams() const;
+  const streams_t& GetStreams() const;
   void SetStreams(const streams_t& streams);
 
  private:
@@ -61,6 +63,8 @@ class JsonValue : public common::Value {  // simple json class value, only save
   virtual JsonValue* DeepCopy() const override;
   virtual bool Equals(const Value* other) const override;
 
+  const std::string& GetString() const;
+
   static bool IsValidJson(const std::string& json);
 
  private:
@@ -112,6 +116,34 @@ class SearchValue : public common::Value {
   DISALLOW_COPY_AND_ASSIGN(SearchValue);
 };
 
+// read only array of strings kept in one buffer, for big replies which are only displayed:
+// element costs its bytes and one offset instead of separate heap string value
+class CompactArrayValue : public common::Value {
+ public:
+  static const common::Value::Type TYPE_COMPACT_ARRAY =
+      static_cast<common::Value::Type>(common::Value::USER_TYPES + 7);
+  CompactArrayValue();
+  virtual ~CompactArrayValue();
+
+  void Reserve(size_t count, size_t bytes);
+  void Append(const char* data, size_t size);
+  void Append(const std::string& str);
+
+  size_t GetSize() const;
+  bool Get(size_t index, const char** data, size_t* size) const;  // points to internal buffer
+  bool GetString(size_t index, std::string* out_value) const;
+  size_t GetBytesUsed() const;
+
+  common::ArrayValue* ToArrayValue() const;  // for code which needs common::ArrayValue, caller owns result
+  virtual CompactArrayValue* DeepCopy() const override;
+  virtual bool Equals(const Value* other) const override;
+
+ private:
+  std::string data_;
+  std::vector<size_t> ends_;
+  DISALLOW_COPY_AND_ASSIGN(CompactArrayValue);
+};
+
 common::Value* CreateEmptyValueFromType(common::Value::Type value_type);
 const char* GetTypeName(common::Value::Type value_type);
 
@@ -129,5 +161,14 @@ std::string ConvertValue(JsonValue* value, const std::string& delimiter);
 std::string ConvertValue(GraphValue* value, const std::string& delimiter);
 std::string ConvertValue(BloomValue* value, const std::string& delimiter);
 std::string ConvertValue(SearchValue* value, const std::string& delimiter);
+std::string ConvertValue(CompactArrayValue* array, const std::string& delimiter);
+
+// displayable text of value (binary strings hexed), stops after max_size bytes and
+// appends "…(N more)" with the number of skipped elements (or bytes for strings),
+// cost depends on max_size rather than on size of value
+std::string ConvertValuePreview(common::Value* value, const std::string& delimiter, size_t max_size);
+
+// encoding of string values, text for others
+ValueEncoding DetectValueEncoding(common::Value* value);
 }  // namespace core
 }  // namespace fastonosql
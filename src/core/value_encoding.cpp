@@ -0,0 +1,435 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/value_encoding.h"
+
+#include <math.h>    // for log2
+#include <string.h>  // for memcpy
+
+#include <stdint.h>  // for uint64_t
+
+namespace fastonosql {
+namespace core {
+
+const char* const value_encoding_text[VALUE_ENCODING_COUNT] = {"Text",   "JSON",    "XML",    "GZIP",  "LZ4",
+                                                               "BZIP2",  "Snappy",  "MsgPack", "Binary"};
+
+namespace {
+
+const size_t kSampleSize = 4096;
+const size_t kMinEntropySample = 256;
+const double kRandomEntropy = 7.8;  // compressed by snappy text is below, encrypted or random data above
+const int kMaxMsgPackDepth = 32;
+
+bool HasPrefix(const unsigned char* data, size_t size, const char* prefix, size_t prefix_size) {
+  return size >= prefix_size && memcmp(data, prefix, prefix_size) == 0;
+}
+
+bool IsGzip(const unsigned char* data, size_t size) {
+  return size >= 3 && data[0] == 0x1f && data[1] == 0x8b && data[2] == 0x08;
+}
+
+bool IsZlib(const unsigned char* data, size_t size) {
+  // deflate method, window up to 32K, header check bits
+  return size >= 2 && (data[0] & 0x0f) == 8 && (data[0] >> 4) <= 7 && ((data[0] << 8) | data[1]) % 31 == 0;
+}
+
+bool IsBZip2(const unsigned char* data, size_t size) {
+  if (size < 10 || !HasPrefix(data, size, "BZh", 3) || data[3] < '1' || data[3] > '9') {
+    return false;
+  }
+
+  // block header is pi, end of stream is sqrt(pi)
+  return memcmp(data + 4, "\x31\x41\x59\x26\x53\x59", 6) == 0 || memcmp(data + 4, "\x17\x72\x45\x38\x50\x90", 6) == 0;
+}
+
+bool IsLZ4Frame(const unsigned char* data, size_t size) {
+  return HasPrefix(data, size, "\x04\x22\x4d\x18", 4) || HasPrefix(data, size, "\x02\x21\x4c\x18", 4);
+}
+
+bool IsSnappyFramed(const unsigned char* data, size_t size) {
+  return HasPrefix(data, size, "\xff\x06\x00\x00sNaPpY", 10);
+}
+
+// uncompressed length varint, then first element must be literal
+bool IsSnappyRaw(const unsigned char* data, size_t sample_size, size_t size) {
+  uint64_t length = 0;
+  size_t pos = 0;
+  for (int shift = 0; pos < sample_size && shift <= 28; shift += 7) {
+    const unsigned char c = data[pos++];
+    length |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      break;
+    }
+    if (shift == 28) {
+      return false;
+    }
+  }
+
+  if (pos >= sample_size || length == 0) {
+    return false;
+  }
+
+  const uint64_t compressed = size - pos;
+  if (compressed > 32 + length + length / 6 || length > compressed * 24 + 64) {
+    return false;
+  }
+
+  const unsigned char tag = data[pos++];
+  if ((tag & 0x03) != 0) {
+    return false;
+  }
+
+  uint64_t literal = (tag >> 2) + 1;
+  if ((tag >> 2) >= 60) {
+    const size_t extra = (tag >> 2) - 59;
+    if (pos + extra > sample_size) {
+      return false;
+    }
+
+    literal = 0;
+    for (size_t i = 0; i < extra; ++i) {
+      literal |= static_cast<uint64_t>(data[pos + i]) << (8 * i);
+    }
+    literal++;
+    pos += extra;
+  }
+
+  return literal <= length && pos + literal <= size;
+}
+
+enum MsgPackResult { MSGPACK_OK, MSGPACK_TRUNCATED, MSGPACK_INVALID };
+
+uint64_t ReadBigEndian(const unsigned char* data, size_t bytes) {
+  uint64_t result = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    result = (result << 8) | data[i];
+  }
+  return result;
+}
+
+MsgPackResult SkipMsgPack(const unsigned char** pos, const unsigned char* end, int depth) {
+  if (depth > kMaxMsgPackDepth) {
+    return MSGPACK_INVALID;
+  }
+
+  const unsigned char* p = *pos;
+  if (p >= end) {
+    return MSGPACK_TRUNCATED;
+  }
+
+  const unsigned char c = *p++;
+  uint64_t skip = 0;     // payload bytes
+  uint64_t items = 0;    // nested objects
+  size_t len_bytes = 0;  // size of length field
+  if (c <= 0x7f || c >= 0xe0 || c == 0xc0 || c == 0xc2 || c == 0xc3) {
+  } else if (c <= 0x8f) {
+    items = 2 * (c & 0x0f);
+  } else if (c <= 0x9f) {
+    items = c & 0x0f;
+  } else if (c <= 0xbf) {
+    skip = c & 0x1f;
+  } else if (c == 0xc1) {
+    return MSGPACK_INVALID;
+  } else if (c >= 0xc4 && c <= 0xc6) {  // bin
+    len_bytes = 1 << (c - 0xc4);
+  } else if (c >= 0xc7 && c <= 0xc9) {  // ext
+    len_bytes = 1 << (c - 0xc7);
+    skip = 1;
+  } else if (c == 0xca || c == 0xcb) {
+    skip = c == 0xca ? 4 : 8;
+  } else if (c >= 0xcc && c <= 0xd3) {  // uint, int
+    skip = 1 << ((c - 0xcc) % 4);
+  } else if (c >= 0xd4 && c <= 0xd8) {  // fixext
+    skip = 1 + (1 << (c - 0xd4));
+  } else if (c >= 0xd9 && c <= 0xdb) {  // str
+    len_bytes = 1 << (c - 0xd9);
+  } else if (c == 0xdc || c == 0xdd) {
+    if (static_cast<size_t>(end - p) < (c == 0xdc ? 2u : 4u)) {
+      return MSGPACK_TRUNCATED;
+    }
+    items = ReadBigEndian(p, c == 0xdc ? 2 : 4);
+    p += c == 0xdc ? 2 : 4;
+  } else if (c == 0xde || c == 0xdf) {
+    if (static_cast<size_t>(end - p) < (c == 0xde ? 2u : 4u)) {
+      return MSGPACK_TRUNCATED;
+    }
+    items = 2 * ReadBigEndian(p, c == 0xde ? 2 : 4);
+    p += c == 0xde ? 2 : 4;
+  }
+
+  if (len_bytes) {
+    if (static_cast<size_t>(end - p) < len_bytes) {
+      return MSGPACK_TRUNCATED;
+    }
+    skip += ReadBigEndian(p, len_bytes);
+    p += len_bytes;
+  }
+
+  if (skip > static_cast<uint64_t>(end - p)) {
+    return MSGPACK_TRUNCATED;
+  }
+  p += skip;
+
+  for (uint64_t i = 0; i < items; ++i) {
+    MsgPackResult res = SkipMsgPack(&p, end, depth + 1);
+    if (res != MSGPACK_OK) {
+      return res;
+    }
+  }
+
+  *pos = p;
+  return MSGPACK_OK;
+}
+
+bool IsMsgPack(const unsigned char* data, size_t sample_size, size_t size) {
+  const unsigned char c = data[0];
+  const bool container = (c >= 0x80 && c <= 0x9f) || (c >= 0xdc && c <= 0xdf);
+  if (!container) {
+    return false;
+  }
+
+  const unsigned char* p = data;
+  MsgPackResult res = SkipMsgPack(&p, data + sample_size, 0);
+  if (res == MSGPACK_TRUNCATED) {
+    return sample_size < size;
+  }
+
+  return res == MSGPACK_OK && p == data + size;
+}
+
+bool IsSpace(unsigned char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+unsigned char FirstNonSpace(const unsigned char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    if (!IsSpace(data[i])) {
+      return data[i];
+    }
+  }
+  return 0;
+}
+
+unsigned char LastNonSpace(const unsigned char* data, size_t size) {
+  for (size_t i = size; i > 0; --i) {
+    if (!IsSpace(data[i - 1])) {
+      return data[i - 1];
+    }
+  }
+  return 0;
+}
+
+// structural characters only: strings skipped, brackets balanced, values are literals or numbers
+bool IsJsonStructure(const unsigned char* data, size_t sample_size, bool whole) {
+  int depth = 0;
+  bool in_string = false;
+  bool escaped = false;
+  for (size_t i = 0; i < sample_size; ++i) {
+    const unsigned char c = data[i];
+    if (in_string) {
+      if (escaped) {
+        escaped = false;
+      } else if (c == '\\') {
+        escaped = true;
+      } else if (c == '"') {
+        in_string = false;
+      } else if (c < 0x20) {
+        return false;
+      }
+      continue;
+    }
+
+    if (c == '"') {
+      in_string = true;
+    } else if (c == '{' || c == '[') {
+      depth++;
+    } else if (c == '}' || c == ']') {
+      if (--depth < 0) {
+        return false;
+      }
+    } else if (!IsSpace(c) && c != ':' && c != ',' && c != '-' && c != '+' && c != '.' && !(c >= '0' && c <= '9') &&
+               !(c >= 'a' && c <= 'z') && !(c >= 'A' && c <= 'Z')) {
+      return false;
+    }
+  }
+
+  return !whole || (depth == 0 && !in_string);
+}
+
+// for text, control characters except tabs and line breaks
+size_t CountControl(const unsigned char* data, size_t size) {
+  size_t count = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const unsigned char c = data[i];
+    if (c < 0x20 && c != '\t' && c != '\n' && c != '\r') {
+      count++;
+    }
+  }
+  return count;
+}
+
+ValueEncoding DetectTextEncoding(const unsigned char* data, size_t sample_size, size_t size) {
+  const unsigned char first = FirstNonSpace(data, sample_size);
+  const unsigned char last = LastNonSpace(data, size);
+  if ((first == '{' && last == '}') || (first == '[' && last == ']')) {
+    if (IsJsonStructure(data, sample_size, sample_size == size)) {
+      return VALUE_ENCODING_JSON;
+    }
+  }
+
+  if (first == '<' && last == '>') {
+    return VALUE_ENCODING_XML;
+  }
+
+  return VALUE_ENCODING_TEXT;
+}
+
+}  // namespace
+
+namespace detail {
+
+bool is_valid_utf8(const unsigned char* data, size_t size, bool allow_truncated_end) {
+  size_t i = 0;
+  while (i < size) {
+    // 8 ascii bytes at once
+    if (i + 8 <= size) {
+      uint64_t word;
+      memcpy(&word, data + i, sizeof(word));
+      if ((word & UINT64_C(0x8080808080808080)) == 0) {
+        i += 8;
+        continue;
+      }
+    }
+
+    const unsigned char c = data[i];
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+
+    size_t need = 0;
+    uint32_t min_code = 0;
+    uint32_t code = 0;
+    if ((c & 0xe0) == 0xc0) {
+      need = 1;
+      min_code = 0x80;
+      code = c & 0x1f;
+    } else if ((c & 0xf0) == 0xe0) {
+      need = 2;
+      min_code = 0x800;
+      code = c & 0x0f;
+    } else if ((c & 0xf8) == 0xf0) {
+      need = 3;
+      min_code = 0x10000;
+      code = c & 0x07;
+    } else {
+      return false;
+    }
+
+    if (i + need >= size + (allow_truncated_end ? need : 0)) {
+      return false;
+    }
+
+    size_t j = 1;
+    for (; j <= need && i + j < size; ++j) {
+      const unsigned char cc = data[i + j];
+      if ((cc & 0xc0) != 0x80) {
+        return false;
+      }
+      code = (code << 6) | (cc & 0x3f);
+    }
+
+    if (j > need && (code < min_code || code > 0x10ffff || (code >= 0xd800 && code <= 0xdfff))) {
+      return false;
+    }
+    i += need + 1;
+  }
+
+  return true;
+}
+
+double bytes_entropy(const unsigned char* data, size_t size) {
+  if (size == 0) {
+    return 0.0;
+  }
+
+  size_t counts[256] = {0};
+  for (size_t i = 0; i < size; ++i) {
+    counts[data[i]]++;
+  }
+
+  double entropy = 0.0;
+  for (size_t i = 0; i < 256; ++i) {
+    if (counts[i]) {
+      const double p = static_cast<double>(counts[i]) / size;
+      entropy -= p * log2(p);
+    }
+  }
+  return entropy;
+}
+
+}  // namespace detail
+
+ValueEncoding DetectValueEncoding(const char* raw, size_t size) {
+  if (!raw || size == 0) {
+    return VALUE_ENCODING_TEXT;
+  }
+
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(raw);
+  const size_t sample_size = size < kSampleSize ? size : kSampleSize;
+  if (IsGzip(data, size)) {
+    return VALUE_ENCODING_GZIP;
+  }
+  if (IsBZip2(data, size)) {
+    return VALUE_ENCODING_BZIP2;
+  }
+  if (IsLZ4Frame(data, size)) {
+    return VALUE_ENCODING_LZ4;
+  }
+  if (IsSnappyFramed(data, size)) {
+    return VALUE_ENCODING_SNAPPY;
+  }
+
+  const bool utf8 = detail::is_valid_utf8(data, sample_size, sample_size < size);
+  if (utf8 && CountControl(data, sample_size) * 100 <= sample_size) {
+    return DetectTextEncoding(data, sample_size, size);
+  }
+
+  // weak signatures, only for non text data
+  if (IsZlib(data, size)) {
+    return VALUE_ENCODING_GZIP;
+  }
+  if (IsMsgPack(data, sample_size, size)) {
+    return VALUE_ENCODING_MSGPACK;
+  }
+
+  const bool random = sample_size >= kMinEntropySample && detail::bytes_entropy(data, sample_size) > kRandomEntropy;
+  if (!random && IsSnappyRaw(data, sample_size, size)) {
+    return VALUE_ENCODING_SNAPPY;
+  }
+
+  return VALUE_ENCODING_BINARY;
+}
+
+ValueEncoding DetectValueEncoding(const std::string& data) {
+  return DetectValueEncoding(data.data(), data.size());
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,55 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include <string>  // for string
+
+namespace fastonosql {
+namespace core {
+
+// likely encoding of stored value, detected by sample of raw bytes
+enum ValueEncoding {
+  VALUE_ENCODING_TEXT = 0,
+  VALUE_ENCODING_JSON,
+  VALUE_ENCODING_XML,
+  VALUE_ENCODING_GZIP,  // gzip or zlib stream
+  VALUE_ENCODING_LZ4,
+  VALUE_ENCODING_BZIP2,
+  VALUE_ENCODING_SNAPPY,
+  VALUE_ENCODING_MSGPACK,
+  VALUE_ENCODING_BINARY,  // unknown binary
+  VALUE_ENCODING_COUNT
+};
+
+extern const char* const value_encoding_text[VALUE_ENCODING_COUNT];
+
+// magic bytes, UTF-8 and structure checks of first sample_size bytes (and last bytes for text formats),
+// doesn't decode or parse whole value
+ValueEncoding DetectValueEncoding(const char* data, size_t size);
+ValueEncoding DetectValueEncoding(const std::string& data);
+
+namespace detail {
+bool is_valid_utf8(const unsigned char* data, size_t size, bool allow_truncated_end);
+double bytes_entropy(const unsigned char* data, size_t size);  // bits per byte, 0..8
+}  // namespace detail
+
+}  // namespace core
+}  // namespace fastonosql
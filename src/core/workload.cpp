@@ -0,0 +1,367 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/workload.h"
+
+#include <math.h>  // for pow
+
+#include <algorithm>  // for sort
+
+#include <common/file_system/file_system.h>
+#include <common/macros.h>  // for SIZEOFMASS
+#include <common/sprintf.h>
+
+#include "core/internal/workload_runner.h"
+
+#ifdef BUILD_WITH_FORESTDB
+#include "core/db/forestdb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_LEVELDB
+#include "core/db/leveldb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_LMDB
+#include "core/db/lmdb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_ROCKSDB
+#include "core/db/rocksdb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_UNQLITE
+#include "core/db/unqlite/db_connection.h"
+#endif
+#ifdef BUILD_WITH_UPSCALEDB
+#include "core/db/upscaledb/db_connection.h"
+#endif
+
+#define WORKLOAD_KEY_PREFIX "user:"
+#define WORKLOAD_KEY_END "user;"  // ';' follows ':' in bytewise order
+#define ZIPFIAN_CONSTANT 0.99
+
+namespace {
+const char* operations_names[] = {"READ", "UPDATE", "INSERT", "SCAN"};
+const std::string distributions_names[] = {"uniform", "zipfian"};
+
+uint64_t FNVHash64(uint64_t val) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= val & 0xff;
+    hash *= 1099511628211ULL;
+    val >>= 8;
+  }
+  return hash;
+}
+
+// zeta of n items continued from zeta of first items
+double Zeta(uint64_t first, double first_zeta, uint64_t n, double theta) {
+  double sum = first_zeta;
+  for (uint64_t i = first; i < n; ++i) {
+    sum += 1 / pow(i + 1, theta);
+  }
+  return sum;
+}
+
+double Zeta(uint64_t n, double theta) {
+  return Zeta(0, 0, n, theta);
+}
+
+template <typename NConnection, typename Config, fastonosql::core::connectionTypes ContType>
+common::Error RunOnConnection(fastonosql::core::internal::CDBConnection<NConnection, Config, ContType>* db,
+                              const Config& db_config,
+                              const fastonosql::core::WorkloadConfig& config,
+                              bool thread_safe,
+                              fastonosql::core::WorkloadResult* result) {
+  common::Error err = db->Connect(db_config);
+  if (err) {
+    return err;
+  }
+
+  err = fastonosql::core::internal::RunWorkload(db, config, thread_safe, result);
+  common::Error derr = db->Disconnect();
+  if (err) {
+    return err;
+  }
+  return derr;
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace core {
+
+WorkloadConfig::WorkloadConfig()
+    : record_count(100000),
+      operation_count(100000),
+      proportions{0.5, 0.5, 0, 0},
+      distribution(ZIPFIAN_DISTRIBUTION),
+      value_size(100),
+      scan_length(100),
+      threads(1) {}
+
+bool WorkloadConfig::IsValid() const {
+  double total = 0;
+  for (size_t i = 0; i < WORKLOAD_OPERATIONS_COUNT; ++i) {
+    if (proportions[i] < 0) {
+      return false;
+    }
+    total += proportions[i];
+  }
+
+  return record_count != 0 && threads != 0 && total > 0.999 && total < 1.001;
+}
+
+KeyGenerator::KeyGenerator(KeyDistribution distribution, uint64_t items, uint64_t seed)
+    : distribution_(distribution),
+      items_(items),
+      engine_(seed),
+      theta_(ZIPFIAN_CONSTANT),
+      zetan_(0),
+      alpha_(0),
+      eta_(0) {
+  if (distribution_ == ZIPFIAN_DISTRIBUTION) {
+    // Gray et al. "Quickly generating billion-record synthetic databases", as YCSB ZipfianGenerator
+    zetan_ = Zeta(items_, theta_);
+    alpha_ = 1.0 / (1.0 - theta_);
+    eta_ = (1 - pow(2.0 / items_, 1 - theta_)) / (1 - Zeta(2, theta_) / zetan_);
+  }
+}
+
+uint64_t KeyGenerator::Next(uint64_t items) {
+  Grow(items);
+  return Next();
+}
+
+void KeyGenerator::Grow(uint64_t items) {
+  if (items <= items_) {
+    return;
+  }
+
+  if (distribution_ == ZIPFIAN_DISTRIBUTION) {  // only new items summed
+    zetan_ = Zeta(items_, zetan_, items, theta_);
+    eta_ = (1 - pow(2.0 / items, 1 - theta_)) / (1 - Zeta(2, theta_) / zetan_);
+  }
+  items_ = items;
+}
+
+uint64_t KeyGenerator::Next() {
+  if (distribution_ == UNIFORM_DISTRIBUTION) {
+    return engine_() % items_;
+  }
+
+  const double u = NextDouble();
+  const double uz = u * zetan_;
+  uint64_t rank = 0;
+  if (uz < 1.0) {
+    rank = 0;
+  } else if (uz < 1.0 + pow(0.5, theta_)) {
+    rank = 1;
+  } else {
+    rank = static_cast<uint64_t>(items_ * pow(eta_ * u - eta_ + 1, alpha_));
+  }
+
+  // scrambled, otherwise the most popular records are the first inserted ones
+  return FNVHash64(rank) % items_;
+}
+
+double KeyGenerator::NextDouble() {
+  return std::uniform_real_distribution<double>(0.0, 1.0)(engine_);
+}
+
+std::string MakeWorkloadKey(uint64_t index) {
+  return common::MemSPrintf(WORKLOAD_KEY_PREFIX "%020llu", static_cast<unsigned long long>(FNVHash64(index)));
+}
+
+std::string MakeWorkloadKeyEnd() {
+  return WORKLOAD_KEY_END;
+}
+
+LatencyHistogram::LatencyHistogram() : samples_(), total_(0), sorted_(true) {}
+
+void LatencyHistogram::Add(uint64_t usec) {
+  samples_.push_back(usec);
+  total_ += usec;
+  sorted_ = false;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+  total_ += other.total_;
+  sorted_ = false;
+}
+
+size_t LatencyHistogram::GetCount() const {
+  return samples_.size();
+}
+
+double LatencyHistogram::GetAverage() const {
+  return samples_.empty() ? 0 : static_cast<double>(total_) / samples_.size();
+}
+
+uint64_t LatencyHistogram::GetMax() const {
+  return samples_.empty() ? 0 : *std::max_element(samples_.begin(), samples_.end());
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percent) {
+  if (samples_.empty()) {
+    return 0;
+  }
+
+  if (!sorted_) {
+    std::sort(samples_.begin(), samples_.end());
+    sorted_ = true;
+  }
+
+  size_t pos = static_cast<size_t>(percent / 100 * samples_.size());
+  if (pos >= samples_.size()) {
+    pos = samples_.size() - 1;
+  }
+  return samples_[pos];
+}
+
+WorkloadOperationStats::WorkloadOperationStats()
+    : count(0), errors(0), average_usec(0), p50_usec(0), p95_usec(0), p99_usec(0), max_usec(0) {}
+
+WorkloadResult::WorkloadResult() : type(LEVELDB), load_msec(0), run_msec(0), throughput(0), operations() {}
+
+std::string WorkloadResult::ToString() const {
+  std::string result = common::MemSPrintf("%s: load %lld msec, run %lld msec, throughput %.2f ops/sec\n",
+                                          ConnectionTypeToString(type), load_msec, run_msec, throughput);
+  for (size_t i = 0; i < WORKLOAD_OPERATIONS_COUNT; ++i) {
+    const WorkloadOperationStats& stats = operations[i];
+    if (!stats.count) {
+      continue;
+    }
+
+    result += common::MemSPrintf(
+        "  %-6s count %zu, errors %zu, avg %.2f us, p50 %llu us, p95 %llu us, p99 %llu us, max %llu us\n",
+        WorkloadOperationToString(static_cast<WorkloadOperation>(i)), stats.count, stats.errors, stats.average_usec,
+        static_cast<unsigned long long>(stats.p50_usec), static_cast<unsigned long long>(stats.p95_usec),
+        static_cast<unsigned long long>(stats.p99_usec), static_cast<unsigned long long>(stats.max_usec));
+  }
+  return result;
+}
+
+const char* WorkloadOperationToString(WorkloadOperation operation) {
+  return operations_names[operation];
+}
+
+common::Error RunLocalWorkload(connectionTypes type,
+                               const std::string& directory,
+                               const WorkloadConfig& config,
+                               WorkloadResult* result) {
+  if (directory.empty() || !config.IsValid() || !result) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::ErrnoError errn = common::file_system::create_directory(directory, true);
+  if (errn) {
+    return common::make_error_from_errno(errn);
+  }
+
+  const std::string db_path = directory + "/" + common::ConvertToString(type);
+  common::Error err = common::make_error(
+      common::MemSPrintf("Workload not supported for %s, only local databases", ConnectionTypeToString(type)));
+#ifdef BUILD_WITH_LEVELDB
+  if (type == LEVELDB) {
+    leveldb::DBConnection db(nullptr);
+    leveldb::Config db_config;
+    db_config.db_path = db_path;
+    db_config.create_if_missing = true;
+    err = RunOnConnection(&db, db_config, config, true, result);
+    errn = common::file_system::remove_directory(db_path, true);
+  }
+#endif
+#ifdef BUILD_WITH_ROCKSDB
+  if (type == ROCKSDB) {
+    rocksdb::DBConnection db(nullptr);
+    rocksdb::Config db_config;
+    db_config.db_path = db_path;
+    db_config.create_if_missing = true;
+    err = RunOnConnection(&db, db_config, config, true, result);
+    errn = common::file_system::remove_directory(db_path, true);
+  }
+#endif
+#ifdef BUILD_WITH_LMDB
+  if (type == LMDB) {
+    lmdb::DBConnection db(nullptr);
+    lmdb::Config db_config;
+    db_config.db_path = db_path;
+    db_config.SetReadOnlyDB(false);
+    err = RunOnConnection(&db, db_config, config, true, result);
+    errn = common::file_system::remove_file(db_path);
+    common::ErrnoError lock_errn = common::file_system::remove_file(db_path + "-lock");
+    UNUSED(lock_errn);
+  }
+#endif
+#ifdef BUILD_WITH_UNQLITE
+  if (type == UNQLITE) {
+    unqlite::DBConnection db(nullptr);
+    unqlite::Config db_config;
+    db_config.db_path = db_path;
+    db_config.SetCreateIfMissingDB(true);
+    err = RunOnConnection(&db, db_config, config, false, result);
+    errn = common::file_system::remove_file(db_path);
+  }
+#endif
+#ifdef BUILD_WITH_UPSCALEDB
+  if (type == UPSCALEDB) {
+    upscaledb::DBConnection db(nullptr);
+    upscaledb::Config db_config;
+    db_config.db_path = db_path;
+    db_config.create_if_missing = true;
+    err = RunOnConnection(&db, db_config, config, false, result);
+    errn = common::file_system::remove_file(db_path);
+  }
+#endif
+#ifdef BUILD_WITH_FORESTDB
+  if (type == FORESTDB) {
+    forestdb::DBConnection db(nullptr);
+    forestdb::Config db_config;
+    db_config.db_path = db_path;
+    err = RunOnConnection(&db, db_config, config, false, result);
+    errn = common::file_system::remove_file(db_path);
+  }
+#endif
+  UNUSED(errn);  // temporary files, nothing to do if already removed
+  return err;
+}
+
+}  // namespace core
+}  // namespace fastonosql
+
+namespace common {
+
+std::string ConvertToString(fastonosql::core::KeyDistribution distribution) {
+  return distributions_names[distribution];
+}
+
+bool ConvertFromString(const std::string& from, fastonosql::core::KeyDistribution* out) {
+  if (!out) {
+    return false;
+  }
+
+  for (size_t i = 0; i < SIZEOFMASS(distributions_names); ++i) {
+    if (from == distributions_names[i]) {
+      *out = static_cast<fastonosql::core::KeyDistribution>(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace common
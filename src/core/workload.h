@@ -0,0 +1,141 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <random>  // for mt19937_64
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>
+#include <common/types.h>  // for time64_t
+
+#include "core/connection_types.h"  // for connectionTypes
+
+namespace fastonosql {
+namespace core {
+
+enum WorkloadOperation {
+  WORKLOAD_READ = 0,
+  WORKLOAD_UPDATE,
+  WORKLOAD_INSERT,
+  WORKLOAD_SCAN,
+  WORKLOAD_OPERATIONS_COUNT
+};
+enum KeyDistribution { UNIFORM_DISTRIBUTION = 0, ZIPFIAN_DISTRIBUTION };
+
+// YCSB style workload, defaults are core workload A: 50% reads, 50% updates, zipfian keys
+struct WorkloadConfig {
+  WorkloadConfig();
+
+  bool IsValid() const;
+
+  size_t record_count;     // keys inserted in load phase
+  size_t operation_count;  // operations in run phase, split between threads
+  double proportions[WORKLOAD_OPERATIONS_COUNT];
+  KeyDistribution distribution;
+  size_t value_size;   // bytes
+  size_t scan_length;  // keys per scan
+  size_t threads;
+};
+
+// index of existing record, one generator per thread
+class KeyGenerator {
+ public:
+  KeyGenerator(KeyDistribution distribution, uint64_t items, uint64_t seed);
+
+  uint64_t Next();
+  // items grown by inserts, zipfian zeta extended incrementally as in YCSB ScrambledZipfianGenerator
+  uint64_t Next(uint64_t items);
+
+ private:
+  void Grow(uint64_t items);
+  double NextDouble();
+
+  const KeyDistribution distribution_;
+  uint64_t items_;
+  std::mt19937_64 engine_;
+
+  // zipfian constants, theta 0.99 as in YCSB
+  double theta_;
+  double zetan_;
+  double alpha_;
+  double eta_;
+};
+
+// hashed like YCSB so popular indexes are spread over key space
+std::string MakeWorkloadKey(uint64_t index);
+std::string MakeWorkloadKeyEnd();  // upper bound of all workload keys
+
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  void Add(uint64_t usec);
+  void Merge(const LatencyHistogram& other);
+
+  size_t GetCount() const;
+  double GetAverage() const;
+  uint64_t GetMax() const;
+  uint64_t GetPercentile(double percent);  // sorts samples on first call
+
+ private:
+  std::vector<uint64_t> samples_;
+  uint64_t total_;
+  bool sorted_;
+};
+
+struct WorkloadOperationStats {
+  WorkloadOperationStats();
+
+  size_t count;
+  size_t errors;
+  double average_usec;
+  uint64_t p50_usec;
+  uint64_t p95_usec;
+  uint64_t p99_usec;
+  uint64_t max_usec;
+};
+
+struct WorkloadResult {
+  WorkloadResult();
+
+  std::string ToString() const;
+
+  connectionTypes type;
+  common::time64_t load_msec;
+  common::time64_t run_msec;
+  double throughput;  // operations per second in run phase
+  WorkloadOperationStats operations[WORKLOAD_OPERATIONS_COUNT];
+};
+
+const char* WorkloadOperationToString(WorkloadOperation operation);
+
+// runs workload on a fresh local database created inside directory and removed afterwards
+common::Error RunLocalWorkload(connectionTypes type,
+                               const std::string& directory,
+                               const WorkloadConfig& config,
+                               WorkloadResult* result) WARN_UNUSED_RESULT;
+
+}  // namespace core
+}  // namespace fastonosql
+
+namespace common {
+std::string ConvertToString(fastonosql::core::KeyDistribution distribution);
+bool ConvertFromString(const std::string& from, fastonosql::core::KeyDistribution* out);
+}  // namespace common
@@ -46,6 +46,14 @@ size_t ChannelTableItem::GetNumberOfSubscribers() const {
   return channel_.GetNumberOfSubscribers();
 }
 
+double ChannelTableItem::GetMessagesPerSecond() const {
+  return channel_.GetMessagesPerSecond();
+}
+
+double ChannelTableItem::GetBytesPerSecond() const {
+  return channel_.GetBytesPerSecond();
+}
+
 ChannelsTableModel::ChannelsTableModel(QObject* parent) : TableModel(parent) {}
 
 ChannelsTableModel::~ChannelsTableModel() {}
@@ -71,6 +79,10 @@ QVariant ChannelsTableModel::data(const QModelIndex& index, int role) const {
       result = node->GetName();
     } else if (col == ChannelTableItem::kNOS) {
       result.setValue(node->GetNumberOfSubscribers());
+    } else if (col == ChannelTableItem::kMessagesPerSecond) {
+      result.setValue(node->GetMessagesPerSecond());
+    } else if (col == ChannelTableItem::kBytesPerSecond) {
+      result.setValue(node->GetBytesPerSecond());
     }
   }
 
@@ -87,6 +99,10 @@ QVariant ChannelsTableModel::headerData(int section, Qt::Orientation orientation
       return translations::trName;
     } else if (section == ChannelTableItem::kNOS) {
       return translations::trNumberOfSubscribers;
+    } else if (section == ChannelTableItem::kMessagesPerSecond) {
+      return translations::trMessagesPerSecond;
+    } else if (section == ChannelTableItem::kBytesPerSecond) {
+      return translations::trBytesPerSecond;
     }
   }
 
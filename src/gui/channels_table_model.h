@@ -30,13 +30,15 @@ namespace gui {
 
 class ChannelTableItem : public common::qt::gui::TableItem {
  public:
-  enum eColumn { kName = 0, kNOS = 1, kCountColumns = 2 };
+  enum eColumn { kName = 0, kNOS = 1, kMessagesPerSecond = 2, kBytesPerSecond = 3, kCountColumns = 4 };
 
   explicit ChannelTableItem(const core::NDbPSChannel& chan);
 
   core::NDbPSChannel GetChannel() const;
   QString GetName() const;
   size_t GetNumberOfSubscribers() const;
+  double GetMessagesPerSecond() const;
+  double GetBytesPerSecond() const;
 
  private:
   core::NDbPSChannel channel_;
@@ -18,14 +18,21 @@
 
 #include "gui/db/forestdb/connection_widget.h"
 
+#include <QCheckBox>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
+#include <QSpinBox>
 
 #include <common/qt/convert2string.h>
 
 #include "proxy/db/forestdb/connection_settings.h"
 
+namespace {
+const QString trWriteBatchSize = QObject::tr("Write operations per commit:");
+const QString trWalFlushBeforeCommit = QObject::tr("Flush WAL before commit");
+}
+
 namespace fastonosql {
 namespace gui {
 namespace forestdb {
@@ -38,6 +45,17 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
   db_name_edit_ = new QLineEdit;
   name_layout->addWidget(db_name_edit_);
   addLayout(name_layout);
+
+  QHBoxLayout* write_batch_size_layout = new QHBoxLayout;
+  write_batch_size_label_ = new QLabel;
+  write_batch_size_layout->addWidget(write_batch_size_label_);
+  write_batch_size_edit_ = new QSpinBox;
+  write_batch_size_edit_->setRange(1, INT32_MAX);
+  write_batch_size_layout->addWidget(write_batch_size_edit_);
+  addLayout(write_batch_size_layout);
+
+  wal_flush_before_commit_ = new QCheckBox;
+  addWidget(wal_flush_before_commit_);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -48,12 +66,16 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
     if (common::ConvertFromString(config.db_name, &qdb_name)) {
       db_name_edit_->setText(qdb_name);
     }
+    write_batch_size_edit_->setValue(config.write_batch_size);
+    wal_flush_before_commit_->setChecked(config.wal_flush_before_commit);
   }
   ConnectionLocalWidget::syncControls(forestdb);
 }
 
 void ConnectionWidget::retranslateUi() {
   db_name_label_->setText(trDBName);
+  write_batch_size_label_->setText(trWriteBatchSize);
+  wal_flush_before_commit_->setText(trWalFlushBeforeCommit);
   ConnectionLocalWidget::retranslateUi();
 }
 
@@ -62,6 +84,8 @@ proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
   proxy::forestdb::ConnectionSettings* conn = new proxy::forestdb::ConnectionSettings(path);
   core::forestdb::Config config = conn->GetInfo();
   config.db_name = common::ConvertToString(db_name_edit_->text());
+  config.write_batch_size = write_batch_size_edit_->value();
+  config.wal_flush_before_commit = wal_flush_before_commit_->isChecked();
   conn->SetInfo(config);
   return conn;
 }
@@ -38,6 +38,10 @@ class ConnectionWidget : public ConnectionLocalWidgetFilePath {
 
   QLabel* db_name_label_;
   QLineEdit* db_name_edit_;
+
+  QLabel* write_batch_size_label_;
+  QSpinBox* write_batch_size_edit_;
+  QCheckBox* wal_flush_before_commit_;
 };
 
 }  // namespace forestdb
@@ -35,6 +35,12 @@
 
 namespace {
 const QString trMaxDBSCount = QObject::tr("Max database count:");
+const QString trMapSize = QObject::tr("Map size (MB, 0 - default, grows if full):");
+const QString trMaxReaders = QObject::tr("Max readers (0 - default):");
+const QString trWriteBatchSize = QObject::tr("Write operations per transaction:");
+const QString trReadAhead = QObject::tr("OS readahead");
+const QString trSyncOnCommit = QObject::tr("Sync on commit");
+const QString trNoLock = QObject::tr("Without lock file (only for copies nobody writes to)");
 }
 
 namespace fastonosql {
@@ -79,8 +85,41 @@ ConnectionWidget::ConnectionWidget(QWidget* parent) : base_class(parent) {
   max_dbs_layout->addWidget(max_dbs_count_edit_);
   addLayout(max_dbs_layout);
 
+  QHBoxLayout* map_size_layout = new QHBoxLayout;
+  map_size_label_ = new QLabel;
+  map_size_layout->addWidget(map_size_label_);
+  map_size_edit_ = new QSpinBox;
+  map_size_edit_->setRange(0, INT32_MAX);
+  map_size_layout->addWidget(map_size_edit_);
+  addLayout(map_size_layout);
+
+  QHBoxLayout* max_readers_layout = new QHBoxLayout;
+  max_readers_label_ = new QLabel;
+  max_readers_layout->addWidget(max_readers_label_);
+  max_readers_edit_ = new QSpinBox;
+  max_readers_edit_->setRange(0, INT32_MAX);
+  max_readers_layout->addWidget(max_readers_edit_);
+  addLayout(max_readers_layout);
+
+  QHBoxLayout* write_batch_size_layout = new QHBoxLayout;
+  write_batch_size_label_ = new QLabel;
+  write_batch_size_layout->addWidget(write_batch_size_label_);
+  write_batch_size_edit_ = new QSpinBox;
+  write_batch_size_edit_->setRange(1, INT32_MAX);
+  write_batch_size_layout->addWidget(write_batch_size_edit_);
+  addLayout(write_batch_size_layout);
+
+  read_ahead_db_ = new QCheckBox;
+  addWidget(read_ahead_db_);
+  sync_db_ = new QCheckBox;
+  addWidget(sync_db_);
+
   read_only_db_ = new QCheckBox;
+  VERIFY(connect(read_only_db_, &QCheckBox::toggled, this, &ConnectionWidget::readOnlyDBChange));
   addWidget(read_only_db_);
+  no_lock_db_ = new QCheckBox;
+  no_lock_db_->setEnabled(false);
+  addWidget(no_lock_db_);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -88,6 +127,9 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
   if (lmdb) {
     core::lmdb::Config config = lmdb->GetInfo();
     read_only_db_->setChecked(config.ReadOnlyDB());
+    no_lock_db_->setChecked(config.IsNoLockDB());
+    read_ahead_db_->setChecked(config.IsReadAheadDB());
+    sync_db_->setChecked(config.IsSyncDB());
     bool is_file_path = config.IsSingleFileDB();
     QString db_path;
     common::ConvertFromString(lmdb->GetDBPath(), &db_path);
@@ -104,6 +146,9 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
       db_name_edit_->setText(qdb_name);
     }
     max_dbs_count_edit_->setValue(config.max_dbs);
+    map_size_edit_->setValue(config.map_size_mb);
+    max_readers_edit_->setValue(config.max_readers);
+    write_batch_size_edit_->setValue(config.write_batch_size);
   }
   base_class::syncControls(lmdb);
 }
@@ -115,6 +160,12 @@ void ConnectionWidget::retranslateUi() {
   read_only_db_->setText(trReadOnlyDB);
   db_name_label_->setText(trDBName);
   max_dbs_count_label_->setText(trMaxDBSCount);
+  map_size_label_->setText(trMapSize);
+  max_readers_label_->setText(trMaxReaders);
+  write_batch_size_label_->setText(trWriteBatchSize);
+  read_ahead_db_->setText(trReadAhead);
+  sync_db_->setText(trSyncOnCommit);
+  no_lock_db_->setText(trNoLock);
   base_class::retranslateUi();
 }
 
@@ -143,6 +194,13 @@ void ConnectionWidget::selectDirectoryPathDB(bool checked) {
   file_path_widget_->setEnabled(!checked);
 }
 
+void ConnectionWidget::readOnlyDBChange(bool checked) {
+  no_lock_db_->setEnabled(checked);
+  if (!checked) {
+    no_lock_db_->setChecked(false);
+  }
+}
+
 proxy::IConnectionSettingsBase* ConnectionWidget::createConnectionImpl(const proxy::connection_path_t& path) const {
   proxy::lmdb::ConnectionSettings* conn = new proxy::lmdb::ConnectionSettings(path);
   core::lmdb::Config config = conn->GetInfo();
@@ -156,6 +214,12 @@ proxy::IConnectionSettingsBase* ConnectionWidget::createConnectionImpl(const pro
   config.db_name = common::ConvertToString(db_name_edit_->text());
   config.SetSingleFileDB(is_file_path);
   config.max_dbs = max_dbs_count_edit_->value();
+  config.map_size_mb = map_size_edit_->value();
+  config.max_readers = max_readers_edit_->value();
+  config.write_batch_size = write_batch_size_edit_->value();
+  config.SetReadAheadDB(read_ahead_db_->isChecked());
+  config.SetSyncDB(sync_db_->isChecked());
+  config.SetNoLockDB(read_only_db_->isChecked() && no_lock_db_->isChecked());
   conn->SetInfo(config);
   return conn;
 }
@@ -41,6 +41,7 @@ class ConnectionWidget : public ConnectionBaseWidget {
  private Q_SLOTS:
   void selectFilePathDB(bool checked);
   void selectDirectoryPathDB(bool checked);
+  void readOnlyDBChange(bool checked);
 
  private:
   virtual proxy::IConnectionSettingsBase* createConnectionImpl(const proxy::connection_path_t& path) const override;
@@ -58,6 +59,17 @@ class ConnectionWidget : public ConnectionBaseWidget {
 
   QLabel* max_dbs_count_label_;
   QSpinBox* max_dbs_count_edit_;
+
+  QLabel* map_size_label_;
+  QSpinBox* map_size_edit_;
+  QLabel* max_readers_label_;
+  QSpinBox* max_readers_edit_;
+  QLabel* write_batch_size_label_;
+  QSpinBox* write_batch_size_edit_;
+
+  QCheckBox* read_ahead_db_;
+  QCheckBox* sync_db_;
+  QCheckBox* no_lock_db_;
 };
 
 }  // namespace lmdb
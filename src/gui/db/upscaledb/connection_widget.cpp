@@ -27,6 +27,11 @@
 
 #include "proxy/connection_settings/iconnection_settings_local.h"
 
+namespace {
+const QString trEnableTransactions = QObject::tr("Transactions (bulk writes are committed per batch)");
+const QString trWriteBatchSize = QObject::tr("Write operations per batch:");
+}
+
 namespace fastonosql {
 namespace gui {
 namespace upscaledb {
@@ -44,6 +49,17 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
   def_layout->addWidget(default_db_label_);
   def_layout->addWidget(default_db_num_);
   addLayout(def_layout);
+
+  enable_transactions_ = new QCheckBox;
+  addWidget(enable_transactions_);
+
+  QHBoxLayout* write_batch_size_layout = new QHBoxLayout;
+  write_batch_size_label_ = new QLabel;
+  write_batch_size_layout->addWidget(write_batch_size_label_);
+  write_batch_size_edit_ = new QSpinBox;
+  write_batch_size_edit_->setRange(1, INT32_MAX);
+  write_batch_size_layout->addWidget(write_batch_size_edit_);
+  addLayout(write_batch_size_layout);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -52,6 +68,8 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
     core::upscaledb::Config config = ups->GetInfo();
     create_db_if_missing_->setChecked(config.create_if_missing);
     default_db_num_->setValue(config.dbnum);
+    enable_transactions_->setChecked(config.enable_transactions);
+    write_batch_size_edit_->setValue(config.write_batch_size);
   }
   ConnectionLocalWidget::syncControls(ups);
 }
@@ -59,6 +77,8 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
 void ConnectionWidget::retranslateUi() {
   create_db_if_missing_->setText(trCreateDBIfMissing);
   default_db_label_->setText(trDefaultDb);
+  enable_transactions_->setText(trEnableTransactions);
+  write_batch_size_label_->setText(trWriteBatchSize);
   ConnectionLocalWidget::retranslateUi();
 }
 
@@ -68,6 +88,8 @@ proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
   core::upscaledb::Config config = conn->GetInfo();
   config.create_if_missing = create_db_if_missing_->isChecked();
   config.dbnum = default_db_num_->value();
+  config.enable_transactions = enable_transactions_->isChecked();
+  config.write_batch_size = write_batch_size_edit_->value();
   conn->SetInfo(config);
   return conn;
 }
@@ -40,6 +40,10 @@ class ConnectionWidget : public ConnectionLocalWidgetFilePath {
 
   QLabel* default_db_label_;
   QSpinBox* default_db_num_;
+
+  QCheckBox* enable_transactions_;
+  QLabel* write_batch_size_label_;
+  QSpinBox* write_batch_size_edit_;
 };
 
 }  // namespace upscaledb
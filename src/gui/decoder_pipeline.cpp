@@ -0,0 +1,174 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/decoder_pipeline.h"
+
+#include <QCoreApplication>
+#include <QRunnable>
+
+#include <common/qt/convert2string.h>                      // for ConvertFromString
+#include <common/text_decoders/compress_bzip2_edcoder.h>   // for CompressBZip2EDcoder
+#include <common/text_decoders/compress_lz4_edcoder.h>     // for CompressLZ4EDcoder
+#include <common/text_decoders/compress_snappy_edcoder.h>  // for CompressSnappyEDcoder
+#include <common/text_decoders/compress_zlib_edcoder.h>    // for CompressZlibEDcoder
+#include <common/text_decoders/hex_edcoder.h>              // for HexEDcoder
+#include <common/text_decoders/iedcoder_factory.h>         // for CreateEDCoder
+#include <common/text_decoders/msgpack_edcoder.h>          // for MsgPackEDcoder
+
+#define ENCODE_SUFFIX "/encode"
+
+namespace fastonosql {
+namespace gui {
+namespace {
+
+template <typename T>
+common::IEDcoder* CreateDecoder() {
+  return new T;
+}
+
+class DecodeTask : public QRunnable {
+ public:
+  DecodeTask(DecoderPipeline* pipeline,
+             DecoderPipeline::request_t request,
+             const std::string& name,
+             bool encode,
+             const std::string& input)
+      : pipeline_(pipeline), request_(request), name_(name), encode_(encode), input_(input) {}
+
+  virtual void run() override {
+    std::string out;
+    common::Error err = pipeline_->decode(name_, encode_, input_, &out);
+    QString qout;
+    if (!err) {
+      common::ConvertFromString(out, &qout);
+    }
+    emit pipeline_->decoded(request_, !err, qout);
+  }
+
+ private:
+  DecoderPipeline* const pipeline_;
+  const DecoderPipeline::request_t request_;
+  const std::string name_;
+  const bool encode_;
+  const std::string input_;
+};
+
+}  // namespace
+
+DecoderPipeline::DecoderPipeline()
+    : QObject(), decoders_(), decoders_lock_(), cache_(cache_size), pool_(), last_request_(0) {
+  // can be created first by worker, signals are for widgets
+  QCoreApplication* app = QCoreApplication::instance();
+  if (app) {
+    moveToThread(app->thread());
+  }
+
+  // names of output views
+  registerDecoder("zlib", &CreateDecoder<common::CompressZlibEDcoder>);
+  registerDecoder("lz4", &CreateDecoder<common::CompressLZ4EDcoder>);
+  registerDecoder("bzip2", &CreateDecoder<common::CompressBZip2EDcoder>);
+  registerDecoder("snappy", &CreateDecoder<common::CompressSnappyEDcoder>);
+  registerDecoder("msgpack", &CreateDecoder<common::MsgPackEDcoder>);
+  registerDecoder("hex", &CreateDecoder<common::HexEDcoder>);
+
+  for (size_t i = 0; i < common::ENCODER_DECODER_NUM_TYPES; ++i) {
+    const char* estr = common::edecoder_types[i];
+    common::EDType etype;
+    if (common::ConvertFromString(estr, &etype)) {
+      std::lock_guard<std::mutex> lock(decoders_lock_);
+      decoders_.insert(std::make_pair(estr, [etype]() { return common::CreateEDCoder(etype); }));
+    }
+  }
+}
+
+DecoderPipeline::~DecoderPipeline() {
+  pool_.waitForDone();
+}
+
+void DecoderPipeline::registerDecoder(const std::string& name, decoder_factory_t factory) {
+  if (name.empty() || !factory) {
+    DNOTREACHED();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(decoders_lock_);
+  decoders_[name] = factory;
+}
+
+std::vector<std::string> DecoderPipeline::decoders() const {
+  std::vector<std::string> names;
+  std::lock_guard<std::mutex> lock(decoders_lock_);
+  for (auto it = decoders_.begin(); it != decoders_.end(); ++it) {
+    names.push_back(it->first);
+  }
+  return names;
+}
+
+common::Error DecoderPipeline::decode(const std::string& name,
+                                      bool encode,
+                                      const std::string& input,
+                                      std::string* out) {
+  if (!out) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  const std::string cache_name = encode ? name + ENCODE_SUFFIX : name;
+  if (cache_.Find(cache_name, input, out)) {
+    return common::Error();
+  }
+
+  decoder_factory_t factory;
+  {
+    std::lock_guard<std::mutex> lock(decoders_lock_);
+    auto it = decoders_.find(name);
+    if (it == decoders_.end()) {
+      return common::make_error("Unknown decoder: " + name);
+    }
+    factory = it->second;
+  }
+
+  common::IEDcoder* coder = factory();
+  if (!coder) {
+    return common::make_error("Can't create decoder: " + name);
+  }
+
+  common::Error err = encode ? coder->Encode(input, out) : coder->Decode(input, out);
+  delete coder;
+  if (err) {
+    return err;
+  }
+
+  cache_.Insert(cache_name, input, *out);
+  return common::Error();
+}
+
+DecoderPipeline::request_t DecoderPipeline::decodeAsync(const std::string& name,
+                                                        bool encode,
+                                                        const std::string& input) {
+  const request_t request = ++last_request_;
+  pool_.start(new DecodeTask(this, request, name, encode, input));
+  return request;
+}
+
+core::DecoderCache* DecoderPipeline::cache() {
+  return &cache_;
+}
+
+}  // namespace gui
+}  // namespace fastonosql
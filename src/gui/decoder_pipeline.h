@@ -0,0 +1,79 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>  // for function
+#include <map>         // for map
+#include <mutex>       // for mutex
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <QObject>
+#include <QThreadPool>
+
+#include <common/error.h>                       // for Error
+#include <common/patterns/singleton_pattern.h>  // for LazySingleton
+
+#include "core/decoder_cache.h"
+
+namespace common {
+class IEDcoder;
+}
+
+namespace fastonosql {
+namespace gui {
+
+// decodes values on thread pool, results are cached by decoder and input value,
+// object lives in GUI thread so decoded is delivered queued to widgets
+class DecoderPipeline : public QObject, public common::patterns::LazySingleton<DecoderPipeline> {
+  Q_OBJECT
+ public:
+  friend class common::patterns::LazySingleton<DecoderPipeline>;
+  typedef std::function<common::IEDcoder*()> decoder_factory_t;
+  typedef quint64 request_t;
+  enum { cache_size = 32 * 1024 * 1024 };
+
+  // other decoders (e.g. protobuf by descriptor) are plugged in by name
+  void registerDecoder(const std::string& name, decoder_factory_t factory);
+  std::vector<std::string> decoders() const;
+
+  // for callers already out of GUI thread
+  common::Error decode(const std::string& name, bool encode, const std::string& input, std::string* out)
+      WARN_UNUSED_RESULT;
+  // result is sent by decoded signal with returned request
+  request_t decodeAsync(const std::string& name, bool encode, const std::string& input);
+
+  core::DecoderCache* cache();
+
+ Q_SIGNALS:
+  void decoded(quint64 request, bool success, const QString& output);
+
+ private:
+  DecoderPipeline();
+  ~DecoderPipeline();
+
+  std::map<std::string, decoder_factory_t> decoders_;
+  mutable std::mutex decoders_lock_;
+  core::DecoderCache cache_;
+  QThreadPool pool_;
+  request_t last_request_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -28,7 +28,6 @@
 #include <QVBoxLayout>
 
 #include <common/qt/convert2string.h>  // for ConvertToString
-#include <common/text_decoders/iedcoder_factory.h>
 
 #include "gui/editor/fasto_editor.h"  // for FastoEditor
 #include "gui/gui_factory.h"          // for GuiFactory
@@ -38,7 +37,7 @@
 namespace fastonosql {
 namespace gui {
 
-EncodeDecodeDialog::EncodeDecodeDialog(QWidget* parent) : QDialog(parent) {
+EncodeDecodeDialog::EncodeDecodeDialog(QWidget* parent) : QDialog(parent), request_(0) {
   setWindowIcon(GuiFactory::GetInstance().GetEncodeDecodeIcon());
   setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
                                                                      // button (?)
@@ -55,13 +54,14 @@ EncodeDecodeDialog::EncodeDecodeDialog(QWidget* parent) : QDialog(parent) {
   VERIFY(connect(decode, &QToolButton::clicked, this, &EncodeDecodeDialog::decodeOrEncode));
 
   decoders_ = new QComboBox;
-  for (size_t i = 0; i < common::ENCODER_DECODER_NUM_TYPES; ++i) {
-    const char* estr = common::edecoder_types[i];
-    common::EDType etype;
-    if (common::ConvertFromString(estr, &etype)) {
-      decoders_->addItem(estr, etype);
+  std::vector<std::string> decoders = DecoderPipeline::GetInstance().decoders();
+  for (size_t i = 0; i < decoders.size(); ++i) {
+    QString qname;
+    if (common::ConvertFromString(decoders[i], &qname)) {
+      decoders_->addItem(qname);
     }
   }
+  VERIFY(connect(&DecoderPipeline::GetInstance(), &DecoderPipeline::decoded, this, &EncodeDecodeDialog::decodeFinish));
 
   QHBoxLayout* toolBarLayout = new QHBoxLayout;
   toolBarLayout->addWidget(decode);
@@ -102,26 +102,18 @@ void EncodeDecodeDialog::decodeOrEncode() {
   }
 
   output_->clear();
-  QVariant var = decoders_->currentData();
-  common::EDType currentType = static_cast<common::EDType>(qvariant_cast<unsigned char>(var));
-  common::IEDcoder* dec = common::CreateEDCoder(currentType);
-  if (!dec) {
-    return;
-  }
+  const std::string name = common::ConvertToString(decoders_->currentText());
+  request_ = DecoderPipeline::GetInstance().decodeAsync(name, encode_button_->isChecked(), common::ConvertToString(in));
+}
 
-  std::string sin = common::ConvertToString(in);
-  std::string out;
-  common::Error err = encode_button_->isChecked() ? dec->Encode(sin, &out) : dec->Decode(sin, &out);
-  if (err) {
-    delete dec;
+void EncodeDecodeDialog::decodeFinish(quint64 request, bool success, const QString& output) {
+  if (request != request_) {  // other dialog or outdated request
     return;
   }
 
-  QString qout;
-  if (common::ConvertFromString(out, &qout)) {
-    output_->setText(qout);
+  if (success) {
+    output_->setText(output);
   }
-  delete dec;
 }
 
 void EncodeDecodeDialog::retranslateUi() {
@@ -20,6 +20,8 @@
 
 #include <QDialog>
 
+#include "gui/decoder_pipeline.h"  // for DecoderPipeline::request_t
+
 class QComboBox;     // lines 23-23
 class QRadioButton;  // lines 24-24
 
@@ -40,6 +42,7 @@ class EncodeDecodeDialog : public QDialog {
 
  private Q_SLOTS:
   void decodeOrEncode();
+  void decodeFinish(quint64 request, bool success, const QString& output);
 
  private:
   void retranslateUi();
@@ -49,6 +52,7 @@ class EncodeDecodeDialog : public QDialog {
   QComboBox* decoders_;
   QRadioButton* encode_button_;
   QRadioButton* decode_button_;
+  DecoderPipeline::request_t request_;
 };
 
 }  // namespace gui
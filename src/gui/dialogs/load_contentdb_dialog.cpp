@@ -18,6 +18,7 @@
 
 #include "gui/dialogs/load_contentdb_dialog.h"
 
+#include <QComboBox>
 #include <QDialogButtonBox>
 #include <QLabel>
 #include <QLineEdit>
@@ -25,6 +26,9 @@
 #include <QSpinBox>
 #include <QVBoxLayout>
 
+#include "core/db_traits.h"  // for GetSupportedValueTypes
+#include "core/value.h"      // for GetTypeName
+
 #include "gui/gui_factory.h"  // for GuiFactory
 
 #include "translations/global.h"  // for trError
@@ -33,6 +37,16 @@ namespace {
 const QString trInvalidPattern = QObject::tr("Invalid pattern!");
 const QString trKeysCount = QObject::tr("Keys count");
 const QString trPattern = QObject::tr("Pattern");
+const QString trType = QObject::tr("Type");
+const QString trAnyType = QObject::tr("Any type");
+const QString trTTL = QObject::tr("TTL");
+const QString trAnyTTL = QObject::tr("Any TTL");
+const QString trWithoutTTL = QObject::tr("Without expiration");
+const QString trWithTTL = QObject::tr("Expiring, sec");
+const QString trSize = QObject::tr("Value size, bytes");
+const QString trUnlimited = QObject::tr("Unlimited");
+const QString trInvalidTTLRange = QObject::tr("Invalid TTL range!");
+const QString trInvalidSizeRange = QObject::tr("Invalid size range!");
 const char* g_default_pattern = ALL_KEYS_PATTERNS;
 }  // namespace
 
@@ -66,12 +80,56 @@ LoadContentDbDialog::LoadContentDbDialog(const QString& title, core::connectionT
   pattern_edit_->setText(g_default_pattern);
   pattern_layout->addWidget(pattern_edit_);
 
+  QHBoxLayout* type_layout = new QHBoxLayout;
+  type_layout->addWidget(new QLabel(trType + ":"));
+  types_combo_box_ = new QComboBox;
+  types_combo_box_->addItem(trAnyType, -1);
+  std::vector<common::Value::Type> types = core::GetSupportedValueTypes(type_);
+  for (size_t i = 0; i < types.size(); ++i) {
+    common::Value::Type t = types[i];
+    types_combo_box_->addItem(GuiFactory::GetInstance().GetIcon(t), core::GetTypeName(t), t);
+  }
+  type_layout->addWidget(types_combo_box_);
+
+  QHBoxLayout* ttl_layout = new QHBoxLayout;
+  ttl_layout->addWidget(new QLabel(trTTL + ":"));
+  ttl_combo_box_ = new QComboBox;
+  ttl_combo_box_->addItem(trAnyTTL, ANY_TTL);
+  ttl_combo_box_->addItem(trWithoutTTL, WITHOUT_TTL);
+  ttl_combo_box_->addItem(trWithTTL, WITH_TTL);
+  typedef void (QComboBox::*ind)(int);
+  VERIFY(connect(ttl_combo_box_, static_cast<ind>(&QComboBox::currentIndexChanged), this,
+                 &LoadContentDbDialog::changeTTLMode));
+  ttl_layout->addWidget(ttl_combo_box_);
+  min_ttl_spin_edit_ = new QSpinBox;
+  min_ttl_spin_edit_->setRange(0, INT32_MAX);
+  ttl_layout->addWidget(min_ttl_spin_edit_);
+  max_ttl_spin_edit_ = new QSpinBox;
+  max_ttl_spin_edit_->setRange(0, INT32_MAX);
+  max_ttl_spin_edit_->setSpecialValueText(trUnlimited);
+  ttl_layout->addWidget(max_ttl_spin_edit_);
+
+  QHBoxLayout* size_layout = new QHBoxLayout;
+  size_layout->addWidget(new QLabel(trSize + ":"));
+  min_size_spin_edit_ = new QSpinBox;
+  min_size_spin_edit_->setRange(0, INT32_MAX);
+  size_layout->addWidget(min_size_spin_edit_);
+  max_size_spin_edit_ = new QSpinBox;
+  max_size_spin_edit_->setRange(0, INT32_MAX);
+  max_size_spin_edit_->setSpecialValueText(trUnlimited);
+  size_layout->addWidget(max_size_spin_edit_);
+
   QVBoxLayout* main_layout = new QVBoxLayout;
   main_layout->addLayout(count_layout);
   main_layout->addLayout(pattern_layout);
+  main_layout->addLayout(type_layout);
+  main_layout->addLayout(ttl_layout);
+  main_layout->addLayout(size_layout);
   main_layout->addWidget(button_box);
   main_layout->setSizeConstraint(QLayout::SetFixedSize);
   setLayout(main_layout);
+
+  changeTTLMode(ttl_combo_box_->currentIndex());
 }
 
 int LoadContentDbDialog::count() const {
@@ -82,6 +140,37 @@ QString LoadContentDbDialog::pattern() const {
   return pattern_edit_->text();
 }
 
+core::KeysFilter LoadContentDbDialog::filter() const {
+  core::KeysFilter filter;
+  int type = types_combo_box_->currentData().toInt();
+  if (type >= 0) {
+    filter.types.push_back(static_cast<common::Value::Type>(type));
+  }
+
+  int ttl_mode = ttl_combo_box_->currentData().toInt();
+  if (ttl_mode == WITHOUT_TTL) {
+    filter.with_ttl = false;
+  } else if (ttl_mode == WITH_TTL) {
+    filter.no_ttl = false;
+    filter.min_ttl = min_ttl_spin_edit_->value();
+    if (max_ttl_spin_edit_->value() != 0) {
+      filter.max_ttl = max_ttl_spin_edit_->value();
+    }
+  }
+
+  filter.min_size = min_size_spin_edit_->value();
+  if (max_size_spin_edit_->value() != 0) {
+    filter.max_size = max_size_spin_edit_->value();
+  }
+  return filter;
+}
+
+void LoadContentDbDialog::changeTTLMode(int index) {
+  bool with_ttl = ttl_combo_box_->itemData(index).toInt() == WITH_TTL;
+  min_ttl_spin_edit_->setEnabled(with_ttl);
+  max_ttl_spin_edit_->setEnabled(with_ttl);
+}
+
 void LoadContentDbDialog::accept() {
   QString pattern = pattern_edit_->text();
   if (pattern.isEmpty()) {
@@ -90,6 +179,20 @@ void LoadContentDbDialog::accept() {
     return;
   }
 
+  int max_ttl = max_ttl_spin_edit_->value();
+  if (min_ttl_spin_edit_->isEnabled() && max_ttl != 0 && max_ttl < min_ttl_spin_edit_->value()) {
+    QMessageBox::warning(this, translations::trError, trInvalidTTLRange);
+    max_ttl_spin_edit_->setFocus();
+    return;
+  }
+
+  int max_size = max_size_spin_edit_->value();
+  if (max_size != 0 && max_size < min_size_spin_edit_->value()) {
+    QMessageBox::warning(this, translations::trError, trInvalidSizeRange);
+    max_size_spin_edit_->setFocus();
+    return;
+  }
+
   QDialog::accept();
 }
 
@@ -21,7 +21,9 @@
 #include <QDialog>
 
 #include "core/connection_types.h"  // for connectionTypes
+#include "core/keys_filter.h"       // for KeysFilter
 
+class QComboBox;
 class QLineEdit;  // lines 25-25
 class QSpinBox;   // lines 26-26
 
@@ -41,15 +43,27 @@ class LoadContentDbDialog : public QDialog {
   explicit LoadContentDbDialog(const QString& title, core::connectionTypes type, QWidget* parent = Q_NULLPTR);
   int count() const;
   QString pattern() const;
+  core::KeysFilter filter() const;
 
  public Q_SLOTS:
   virtual void accept() override;
 
+ private Q_SLOTS:
+  void changeTTLMode(int index);
+
  private:
+  enum TTLMode { ANY_TTL = 0, WITHOUT_TTL, WITH_TTL };
+
   const core::connectionTypes type_;
 
   QLineEdit* pattern_edit_;
   QSpinBox* count_spin_edit_;
+  QComboBox* types_combo_box_;
+  QComboBox* ttl_combo_box_;
+  QSpinBox* min_ttl_spin_edit_;
+  QSpinBox* max_ttl_spin_edit_;  // 0 is unlimited
+  QSpinBox* min_size_spin_edit_;
+  QSpinBox* max_size_spin_edit_;  // 0 is unlimited
 };
 
 }  // namespace gui
@@ -18,6 +18,8 @@
 
 #include "gui/dialogs/preferences_dialog.h"
 
+#include <limits>
+
 #include <QCheckBox>
 #include <QComboBox>
 #include <QDialogButtonBox>
@@ -55,6 +57,10 @@ const QString trSupportedUiStyles = QObject::tr("Supported UI styles:");
 const QString trSupportedFonts = QObject::tr("Supported fonts:");
 const QString trDefaultViews = QObject::tr("Default views:");
 const QString trHistoryDirectory = QObject::tr("History directory:");
+const QString trOutputRingSize = QObject::tr("Streaming output results (0 - unlimited):");
+const QString trOutputSpill = QObject::tr("Save older streaming results to history directory");
+const QString trQueryCostThreshold = QObject::tr("Page reads of more elements than (0 - never):");
+const QString trQueryCostConfirm = QObject::tr("Confirm such reads typed in console");
 const QString trGeneral = QObject::tr("General");
 const QString trExternal = QObject::tr("External");
 
@@ -113,6 +119,10 @@ void PreferencesDialog::accept() {
   proxy::SettingsManager::GetInstance()->SetAutoOpenConsole(auto_open_console_->isChecked());
   proxy::SettingsManager::GetInstance()->SetAutoConnectDB(auto_connect_db_->isChecked());
   proxy::SettingsManager::GetInstance()->SetFastViewKeys(fast_view_keys_->isChecked());
+  proxy::SettingsManager::GetInstance()->SetOutputRingSize(output_ring_size_->value());
+  proxy::SettingsManager::GetInstance()->SetOutputSpill(output_spill_->isChecked());
+  proxy::SettingsManager::GetInstance()->SetQueryCostThreshold(query_cost_threshold_->value());
+  proxy::SettingsManager::GetInstance()->SetQueryCostConfirm(query_cost_confirm_->isChecked());
   proxy::SettingsManager::GetInstance()->SetPythonPath(python_path_widget_->path());
 
   return QDialog::accept();
@@ -134,6 +144,10 @@ void PreferencesDialog::syncWithSettings() {
   auto_open_console_->setChecked(proxy::SettingsManager::GetInstance()->AutoOpenConsole());
   auto_connect_db_->setChecked(proxy::SettingsManager::GetInstance()->GetAutoConnectDB());
   fast_view_keys_->setChecked(proxy::SettingsManager::GetInstance()->GetFastViewKeys());
+  output_ring_size_->setValue(proxy::SettingsManager::GetInstance()->GetOutputRingSize());
+  output_spill_->setChecked(proxy::SettingsManager::GetInstance()->GetOutputSpill());
+  query_cost_threshold_->setValue(proxy::SettingsManager::GetInstance()->GetQueryCostThreshold());
+  query_cost_confirm_->setChecked(proxy::SettingsManager::GetInstance()->GetQueryCostConfirm());
   QString python_path = proxy::SettingsManager::GetInstance()->GetPythonPath();
   python_path_widget_->setPath(python_path);
 }
@@ -242,6 +256,22 @@ QWidget* PreferencesDialog::createMainTab() {
   log_dir_label_ = new QLabel;
   generalLayout->addWidget(log_dir_label_, 7, 0);
   generalLayout->addWidget(log_dir_path_, 7, 1);
+
+  output_ring_size_label_ = new QLabel;
+  output_ring_size_ = new QSpinBox;
+  output_ring_size_->setRange(0, std::numeric_limits<int>::max());
+  generalLayout->addWidget(output_ring_size_label_, 8, 0);
+  generalLayout->addWidget(output_ring_size_, 8, 1);
+  output_spill_ = new QCheckBox;
+  generalLayout->addWidget(output_spill_, 9, 0, 1, 2);
+
+  query_cost_threshold_label_ = new QLabel;
+  query_cost_threshold_ = new QSpinBox;
+  query_cost_threshold_->setRange(0, std::numeric_limits<int>::max());
+  generalLayout->addWidget(query_cost_threshold_label_, 10, 0);
+  generalLayout->addWidget(query_cost_threshold_, 10, 1);
+  query_cost_confirm_ = new QCheckBox;
+  generalLayout->addWidget(query_cost_confirm_, 11, 0, 1, 2);
   general_box_->setLayout(generalLayout);
 
   // main layout
@@ -287,6 +317,10 @@ void PreferencesDialog::retranslateUi() {
   font_label_->setText(trSupportedFonts);
   default_view_label_->setText(trDefaultViews);
   log_dir_label_->setText(trHistoryDirectory);
+  output_ring_size_label_->setText(trOutputRingSize);
+  output_spill_->setText(trOutputSpill);
+  query_cost_threshold_label_->setText(trQueryCostThreshold);
+  query_cost_confirm_->setText(trQueryCostConfirm);
 }
 
 }  // namespace gui
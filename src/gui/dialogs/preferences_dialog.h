@@ -82,6 +82,12 @@ class PreferencesDialog : public QDialog {
   QCheckBox* auto_open_console_;
   QCheckBox* auto_connect_db_;
   QCheckBox* fast_view_keys_;
+  QLabel* output_ring_size_label_;
+  QSpinBox* output_ring_size_;
+  QCheckBox* output_spill_;
+  QLabel* query_cost_threshold_label_;
+  QSpinBox* query_cost_threshold_;
+  QCheckBox* query_cost_confirm_;
 
   QGroupBox* external_box_;
   IPathWidget* python_path_widget_;
@@ -20,10 +20,12 @@
 
 #include <QDialogButtonBox>
 #include <QInputDialog>
+#include <QLabel>
 #include <QLineEdit>
 #include <QMenu>
 #include <QPushButton>
 #include <QSortFilterProxyModel>
+#include <QSpinBox>
 #include <QVBoxLayout>
 
 #include <common/qt/convert2string.h>
@@ -41,6 +43,10 @@ namespace {
 const QString trPublishToChannel_1S = QObject::tr("Publish to channel %1");
 const QString trEnterWhatYoWantToSend = QObject::tr("Enter what you want to send:");
 const QString trSubscribeInNewConsole = QObject::tr("Subscribe in new console");
+const QString trSampleTraffic = QObject::tr("Sample traffic:");
+const QString trSampleOff = QObject::tr("Off");
+const QString trSecondsSuffix = QObject::tr(" sec");
+const int kMaxSampleSeconds = 60;
 }  // namespace
 
 namespace fastonosql {
@@ -49,6 +55,8 @@ namespace gui {
 PubSubDialog::PubSubDialog(const QString& title, proxy::IServerSPtr server, QWidget* parent)
     : QDialog(parent),
       search_box_(nullptr),
+      sample_label_(nullptr),
+      sample_seconds_(nullptr),
       search_button_(nullptr),
       channels_table_(nullptr),
       channels_model_(nullptr),
@@ -72,6 +80,12 @@ PubSubDialog::PubSubDialog(const QString& title, proxy::IServerSPtr server, QWid
   VERIFY(connect(search_box_, &QLineEdit::textChanged, this, &PubSubDialog::searchLineChanged));
   searchLayout->addWidget(search_box_);
 
+  sample_label_ = new QLabel;
+  searchLayout->addWidget(sample_label_);
+  sample_seconds_ = new QSpinBox;
+  sample_seconds_->setRange(0, kMaxSampleSeconds);
+  searchLayout->addWidget(sample_seconds_);
+
   search_button_ = new QPushButton;
   VERIFY(connect(search_button_, &QPushButton::clicked, this, &PubSubDialog::searchClicked));
   searchLayout->addWidget(search_button_);
@@ -141,7 +155,7 @@ void PubSubDialog::searchClicked() {
     return;
   }
 
-  proxy::events_info::LoadServerChannelsRequest req(this, common::ConvertToString(pattern));
+  proxy::events_info::LoadServerChannelsRequest req(this, common::ConvertToString(pattern), sample_seconds_->value());
   server_->LoadChannels(req);
 }
 
@@ -245,6 +259,9 @@ void PubSubDialog::changeEvent(QEvent* e) {
 
 void PubSubDialog::retranslateUi() {
   search_button_->setText(translations::trSearch);
+  sample_label_->setText(trSampleTraffic);
+  sample_seconds_->setSpecialValueText(trSampleOff);
+  sample_seconds_->setSuffix(trSecondsSuffix);
 }
 
 }  // namespace gui
@@ -24,6 +24,8 @@
 
 class QLabel;     // lines 30-30
 class QLineEdit;  // lines 28-28
+class QPushButton;
+class QSpinBox;
 class QSortFilterProxyModel;
 
 namespace fastonosql {
@@ -68,6 +70,8 @@ class PubSubDialog : public QDialog {
   void retranslateUi();
 
   QLineEdit* search_box_;
+  QLabel* sample_label_;
+  QSpinBox* sample_seconds_;
   QPushButton* search_button_;
 
   FastoTableView* channels_table_;
@@ -0,0 +1,52 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/run_workload.h"
+
+#include <common/qt/convert2string.h>  // for ConvertFromString
+
+namespace fastonosql {
+namespace gui {
+
+RunWorkload::RunWorkload(const std::vector<core::connectionTypes>& types,
+                         const core::WorkloadConfig& config,
+                         const QString& directory,
+                         QObject* parent)
+    : QObject(parent), types_(types), config_(config), directory_(directory) {}
+
+void RunWorkload::routine() {
+  const std::string directory = common::ConvertToString(directory_);
+  for (core::connectionTypes type : types_) {
+    core::WorkloadResult result;
+    common::Error err = core::RunLocalWorkload(type, directory, config_, &result);
+    QString text;
+    if (err) {
+      common::ConvertFromString(std::string(core::ConnectionTypeToString(type)) + ": " + err->GetDescription(), &text);
+      emit workloadResult(false, text);
+      continue;
+    }
+
+    common::ConvertFromString(result.ToString(), &text);
+    emit workloadResult(true, text);
+  }
+
+  emit workloadFinished();
+}
+
+}  // namespace gui
+}  // namespace fastonosql
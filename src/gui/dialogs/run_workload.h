@@ -0,0 +1,52 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <QObject>
+
+#include "core/workload.h"
+
+namespace fastonosql {
+namespace gui {
+
+class RunWorkload : public QObject {
+  Q_OBJECT
+ public:
+  RunWorkload(const std::vector<core::connectionTypes>& types,
+              const core::WorkloadConfig& config,
+              const QString& directory,
+              QObject* parent = Q_NULLPTR);
+
+ Q_SIGNALS:
+  void workloadResult(bool suc, const QString& resultText);  // per engine
+  void workloadFinished();
+
+ public Q_SLOTS:
+  void routine();
+
+ private:
+  const std::vector<core::connectionTypes> types_;
+  const core::WorkloadConfig config_;
+  const QString directory_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
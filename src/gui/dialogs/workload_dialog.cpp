@@ -0,0 +1,196 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/workload_dialog.h"
+
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QDir>
+#include <QDoubleSpinBox>
+#include <QGridLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QThread>
+#include <QVBoxLayout>
+
+#include <utility>  // for pair
+
+#include <common/qt/convert2string.h>  // for ConvertFromString
+
+#include "gui/dialogs/run_workload.h"  // for RunWorkload
+#include "gui/gui_factory.h"           // for GuiFactory
+
+#include "translations/global.h"  // for trError, trWorkload
+
+namespace {
+const QString trAllEngines = QObject::tr("All local databases");
+const QString trEngine = QObject::tr("Database");
+const QString trRecords = QObject::tr("Records");
+const QString trOperations = QObject::tr("Operations");
+const QString trRead = QObject::tr("Read");
+const QString trUpdate = QObject::tr("Update");
+const QString trInsert = QObject::tr("Insert");
+const QString trScan = QObject::tr("Scan");
+const QString trDistribution = QObject::tr("Key distribution");
+const QString trValueSize = QObject::tr("Value size (bytes)");
+const QString trScanLength = QObject::tr("Scan length");
+const QString trThreads = QObject::tr("Threads");
+const QString trRun = QObject::tr("Run");
+const QString trInvalidWorkload =
+    QObject::tr("Invalid workload, operations proportions should be in sum 1 and records count not zero!");
+const char* g_workload_directory = "fastonosql_workload";
+const int g_all_engines = -1;
+
+QDoubleSpinBox* CreateProportionEdit(double value) {
+  QDoubleSpinBox* edit = new QDoubleSpinBox;
+  edit->setRange(0, 1);
+  edit->setSingleStep(0.05);
+  edit->setValue(value);
+  return edit;
+}
+
+QSpinBox* CreateCountEdit(int min, int max, size_t value) {
+  QSpinBox* edit = new QSpinBox;
+  edit->setRange(min, max);
+  edit->setValue(static_cast<int>(value));
+  return edit;
+}
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+WorkloadDialog::WorkloadDialog(QWidget* parent) : QDialog(parent) {
+  setWindowTitle(translations::trWorkload);
+  setWindowIcon(GuiFactory::GetInstance().GetExecuteIcon());
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  const core::WorkloadConfig defaults;
+  engines_ = new QComboBox;
+  engines_->addItem(trAllEngines, g_all_engines);
+  for (core::connectionTypes type : core::g_compiled_types) {
+    if (core::IsLocalType(type)) {
+      engines_->addItem(GuiFactory::GetInstance().GetIcon(type), core::ConnectionTypeToString(type), type);
+    }
+  }
+
+  records_ = CreateCountEdit(1, 100000000, defaults.record_count);
+  operations_ = CreateCountEdit(0, 100000000, defaults.operation_count);
+  read_ = CreateProportionEdit(defaults.proportions[core::WORKLOAD_READ]);
+  update_ = CreateProportionEdit(defaults.proportions[core::WORKLOAD_UPDATE]);
+  insert_ = CreateProportionEdit(defaults.proportions[core::WORKLOAD_INSERT]);
+  scan_ = CreateProportionEdit(defaults.proportions[core::WORKLOAD_SCAN]);
+  distribution_ = new QComboBox;
+  for (core::KeyDistribution distribution : {core::UNIFORM_DISTRIBUTION, core::ZIPFIAN_DISTRIBUTION}) {
+    QString name;
+    common::ConvertFromString(common::ConvertToString(distribution), &name);
+    distribution_->addItem(name, distribution);
+  }
+  distribution_->setCurrentIndex(defaults.distribution);
+  value_size_ = CreateCountEdit(1, 64 * 1024 * 1024, defaults.value_size);
+  scan_length_ = CreateCountEdit(1, 100000, defaults.scan_length);
+  threads_ = CreateCountEdit(1, 256, defaults.threads);
+
+  QGridLayout* settings_layout = new QGridLayout;
+  const std::pair<QString, QWidget*> settings[] = {
+      {trEngine, engines_},     {trRecords, records_},         {trOperations, operations_},
+      {trRead, read_},          {trUpdate, update_},           {trInsert, insert_},
+      {trScan, scan_},          {trDistribution, distribution_}, {trValueSize, value_size_},
+      {trScanLength, scan_length_}, {trThreads, threads_}};
+  int row = 0;
+  for (const auto& setting : settings) {
+    settings_layout->addWidget(new QLabel(setting.first + ":"), row, 0);
+    settings_layout->addWidget(setting.second, row, 1);
+    row++;
+  }
+
+  run_button_ = new QPushButton(trRun);
+  run_button_->setIcon(GuiFactory::GetInstance().GetExecuteIcon());
+  VERIFY(connect(run_button_, &QPushButton::clicked, this, &WorkloadDialog::startWorkload));
+
+  output_ = new QPlainTextEdit;
+  output_->setReadOnly(true);
+
+  QDialogButtonBox* button_box = new QDialogButtonBox(QDialogButtonBox::Close);
+  button_box->setOrientation(Qt::Horizontal);
+  VERIFY(connect(button_box, &QDialogButtonBox::rejected, this, &WorkloadDialog::reject));
+
+  QVBoxLayout* main_layout = new QVBoxLayout;
+  main_layout->addLayout(settings_layout);
+  main_layout->addWidget(run_button_);
+  main_layout->addWidget(output_);
+  main_layout->addWidget(button_box);
+  setMinimumSize(QSize(min_width, min_height));
+  setLayout(main_layout);
+}
+
+void WorkloadDialog::startWorkload() {
+  core::WorkloadConfig config;
+  config.record_count = records_->value();
+  config.operation_count = operations_->value();
+  config.proportions[core::WORKLOAD_READ] = read_->value();
+  config.proportions[core::WORKLOAD_UPDATE] = update_->value();
+  config.proportions[core::WORKLOAD_INSERT] = insert_->value();
+  config.proportions[core::WORKLOAD_SCAN] = scan_->value();
+  config.distribution = static_cast<core::KeyDistribution>(qvariant_cast<int>(distribution_->currentData()));
+  config.value_size = value_size_->value();
+  config.scan_length = scan_length_->value();
+  config.threads = threads_->value();
+  if (!config.IsValid()) {
+    QMessageBox::warning(this, translations::trError, trInvalidWorkload);
+    return;
+  }
+
+  std::vector<core::connectionTypes> types;
+  const int engine = qvariant_cast<int>(engines_->currentData());
+  for (core::connectionTypes type : core::g_compiled_types) {
+    if (core::IsLocalType(type) && (engine == g_all_engines || engine == type)) {
+      types.push_back(type);
+    }
+  }
+
+  run_button_->setEnabled(false);
+  output_->clear();
+
+  QThread* th = new QThread;
+  RunWorkload* runner = new RunWorkload(types, config, QDir(QDir::tempPath()).filePath(g_workload_directory));
+  runner->moveToThread(th);
+  VERIFY(connect(th, &QThread::started, runner, &RunWorkload::routine));
+  VERIFY(connect(runner, &RunWorkload::workloadResult, this, &WorkloadDialog::workloadResult));
+  VERIFY(connect(runner, &RunWorkload::workloadFinished, this, &WorkloadDialog::workloadFinished));
+  VERIFY(connect(runner, &RunWorkload::workloadFinished, th, &QThread::quit));
+  VERIFY(connect(th, &QThread::finished, runner, &RunWorkload::deleteLater));
+  VERIFY(connect(th, &QThread::finished, th, &QThread::deleteLater));
+  th->start();
+}
+
+void WorkloadDialog::workloadResult(bool suc, const QString& resultText) {
+  UNUSED(suc);
+  output_->appendPlainText(resultText);
+}
+
+void WorkloadDialog::workloadFinished() {
+  run_button_->setEnabled(true);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,62 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+
+class QComboBox;       // lines 23-23
+class QDoubleSpinBox;  // lines 24-24
+class QPlainTextEdit;  // lines 25-25
+class QPushButton;     // lines 26-26
+class QSpinBox;        // lines 27-27
+
+namespace fastonosql {
+namespace gui {
+
+// YCSB style workload on temporary local databases, compares engines on the same operations mix
+class WorkloadDialog : public QDialog {
+  Q_OBJECT
+ public:
+  explicit WorkloadDialog(QWidget* parent = Q_NULLPTR);
+
+  enum { min_width = 640, min_height = 480 };
+
+ private Q_SLOTS:
+  void startWorkload();
+  void workloadResult(bool suc, const QString& resultText);
+  void workloadFinished();
+
+ private:
+  QComboBox* engines_;
+  QSpinBox* records_;
+  QSpinBox* operations_;
+  QDoubleSpinBox* read_;
+  QDoubleSpinBox* update_;
+  QDoubleSpinBox* insert_;
+  QDoubleSpinBox* scan_;
+  QComboBox* distribution_;
+  QSpinBox* value_size_;
+  QSpinBox* scan_length_;
+  QSpinBox* threads_;
+  QPushButton* run_button_;
+  QPlainTextEdit* output_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
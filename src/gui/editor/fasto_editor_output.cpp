@@ -19,6 +19,7 @@
 #include "gui/editor/fasto_editor_output.h"
 
 #include <QHBoxLayout>
+#include <QThread>
 
 #include <Qsci/qscilexerjson.h>
 #include <Qsci/qscilexerxml.h>
@@ -26,7 +27,8 @@
 #include <common/qt/convert2string.h>
 #include <common/qt/utils_qt.h>  // for item
 
-#include "gui/fasto_common_item.h"  // for FastoCommonItem, toRaw, etc
+#include "gui/editor/output_renderer.h"
+#include "gui/fasto_common_item.h"  // for FastoCommonItem
 
 #include "translations/global.h"
 
@@ -34,8 +36,34 @@
 
 namespace fastonosql {
 namespace gui {
+namespace {
 
-FastoEditorOutput::FastoEditorOutput(QWidget* parent) : QWidget(parent), model_(nullptr), view_method_(JSON_VIEW) {
+// values are only referenced here, text is produced by OutputRenderer on worker thread
+void CollectRenderParts(FastoCommonItem* item, OutputRenderer::parts_t* parts) {
+  if (!item->childrenCount()) {
+    OutputRenderer::Part part = {item->nvalue(), item->delimiter(), false};
+    parts->push_back(part);
+    return;
+  }
+
+  for (size_t i = 0; i < item->childrenCount(); ++i) {
+    FastoCommonItem* child = dynamic_cast<FastoCommonItem*>(item->child(i));  // +
+    if (!child) {
+      DNOTREACHED();
+      continue;
+    }
+
+    CollectRenderParts(child, parts);
+    if (i != item->childrenCount() - 1 && !parts->empty()) {
+      parts->back().csv_separator = true;
+    }
+  }
+}
+
+}  // namespace
+
+FastoEditorOutput::FastoEditorOutput(QWidget* parent)
+    : QWidget(parent), model_(nullptr), view_method_(JSON_VIEW), renderer_(nullptr) {
   text_json_editor_ = new FastoEditor;
   json_lexer_ = new QsciLexerJSON;
   xml_lexer_ = new QsciLexerXML;
@@ -50,6 +78,7 @@ FastoEditorOutput::FastoEditorOutput(QWidget* parent) : QWidget(parent), model_(
 }
 
 FastoEditorOutput::~FastoEditorOutput() {
+  stopRender();
   delete json_lexer_;
   delete xml_lexer_;
 }
@@ -211,6 +240,86 @@ bool FastoEditorOutput::isReadOnly() const {
   return text_json_editor_->isReadOnly();
 }
 
+bool FastoEditorOutput::isRendering() const {
+  return renderer_ != nullptr;
+}
+
+void FastoEditorOutput::stopRender() {
+  if (!renderer_) {
+    return;
+  }
+
+  renderer_->stop();  // finishes and deletes itself on worker thread
+  renderer_ = nullptr;
+  emit renderFinished();
+}
+
+void FastoEditorOutput::appendRenderedChunk(const QString& text) {
+  if (sender() != renderer_) {  // chunk of stopped render
+    return;
+  }
+
+  text_json_editor_->append(text);
+}
+
+void FastoEditorOutput::finishRender(bool empty) {
+  if (sender() != renderer_) {
+    return;
+  }
+
+  renderer_ = nullptr;
+  if (empty) {
+    QString methodText;
+    if (view_method_ == JSON_VIEW) {
+      methodText = translations::trJson;
+    } else if (view_method_ == CSV_VIEW) {
+      methodText = translations::trCsv;
+    } else if (view_method_ == RAW_VIEW) {
+      methodText = translations::trRawText;
+    } else if (view_method_ == HEX_VIEW) {
+      methodText = translations::trHex;
+    } else if (view_method_ == UNICODE_VIEW) {
+      methodText = translations::trUnicode;
+    } else if (view_method_ == MSGPACK_VIEW) {
+      methodText = translations::trMsgPack;
+    } else if (view_method_ == GZIP_VIEW) {
+      methodText = translations::trGzip;
+    } else if (view_method_ == LZ4_VIEW) {
+      methodText = translations::trLZ4;
+    } else if (view_method_ == BZIP2_VIEW) {
+      methodText = translations::trBZip2;
+    } else if (view_method_ == SNAPPY_VIEW) {
+      methodText = translations::trSnappy;
+    } else if (view_method_ == XML_VIEW) {
+      methodText = translations::trXml;
+    } else {
+      NOTREACHED();
+    }
+
+    text_json_editor_->setReadOnly(true);
+    text_json_editor_->setText(translations::trCannotConvertPattern1ArgsS.arg(methodText));
+  }
+  emit renderFinished();
+}
+
+core::ValueEncoding FastoEditorOutput::firstValueEncoding() const {
+  if (!model_) {
+    return core::VALUE_ENCODING_TEXT;
+  }
+
+  QModelIndex index = model_->index(0, 0);
+  if (!index.isValid()) {
+    return core::VALUE_ENCODING_TEXT;
+  }
+
+  FastoCommonItem* item = common::qt::item<common::qt::gui::TreeItem*, FastoCommonItem*>(index);
+  while (item && item->childrenCount()) {
+    item = dynamic_cast<FastoCommonItem*>(item->child(0));  // +
+  }
+
+  return item ? item->encoding() : core::VALUE_ENCODING_TEXT;
+}
+
 int FastoEditorOutput::childCount() const {
   if (!model_) {
     return 0;
@@ -222,6 +331,7 @@ int FastoEditorOutput::childCount() const {
 
 void FastoEditorOutput::layoutChanged() {
   SyncEditors();
+  stopRender();
 
   if (!model_) {
     return;
@@ -242,34 +352,7 @@ void FastoEditorOutput::layoutChanged() {
     return;
   }
 
-  QString methodText;
-  if (view_method_ == JSON_VIEW) {
-    methodText = translations::trJson;
-  } else if (view_method_ == CSV_VIEW) {
-    methodText = translations::trCsv;
-  } else if (view_method_ == RAW_VIEW) {
-    methodText = translations::trRawText;
-  } else if (view_method_ == HEX_VIEW) {
-    methodText = translations::trHex;
-  } else if (view_method_ == UNICODE_VIEW) {
-    methodText = translations::trUnicode;
-  } else if (view_method_ == MSGPACK_VIEW) {
-    methodText = translations::trMsgPack;
-  } else if (view_method_ == GZIP_VIEW) {
-    methodText = translations::trGzip;
-  } else if (view_method_ == LZ4_VIEW) {
-    methodText = translations::trLZ4;
-  } else if (view_method_ == BZIP2_VIEW) {
-    methodText = translations::trBZip2;
-  } else if (view_method_ == SNAPPY_VIEW) {
-    methodText = translations::trSnappy;
-  } else if (view_method_ == XML_VIEW) {
-    methodText = translations::trXml;
-  } else {
-    NOTREACHED();
-  }
-
-  QString result;
+  OutputRenderer::parts_t parts;
   for (size_t i = 0; i < root->childrenCount(); ++i) {
     FastoCommonItem* child = dynamic_cast<FastoCommonItem*>(root->child(i));  // +
     if (!child) {
@@ -277,55 +360,21 @@ void FastoEditorOutput::layoutChanged() {
       continue;
     }
 
-    if (view_method_ == JSON_VIEW) {
-      QString json = toJson(child);
-      result += common::EscapedText(json);
-    } else if (view_method_ == CSV_VIEW) {
-      QString csv = toCsv(child);
-      result += common::EscapedText(csv);
-    } else if (view_method_ == RAW_VIEW) {
-      QString raw = toRaw(child);
-      result += common::EscapedText(raw);
-    } else if (view_method_ == HEX_VIEW) {
-      QString raw = toRaw(child);
-      std::string str_raw = common::ConvertToString(raw);
-      std::string hexed = core::detail::hex_string(str_raw);
-      QString qhexed;
-      common::ConvertFromString(hexed, &qhexed);
-      result += qhexed;
-    } else if (view_method_ == UNICODE_VIEW) {
-      QString raw = toRaw(child);
-      std::string str_raw = common::ConvertToString(raw);
-      std::string unicoded = core::detail::unicode_string(str_raw);
-      QString qunicoded;
-      common::ConvertFromString(unicoded, &qunicoded);
-      result += qunicoded;
-    } else if (view_method_ == MSGPACK_VIEW) {
-      QString msgp = fromHexMsgPack(child);
-      result += common::EscapedText(msgp);
-    } else if (view_method_ == GZIP_VIEW) {
-      QString gzip = fromGzip(child);
-      result += common::EscapedText(gzip);
-    } else if (view_method_ == LZ4_VIEW) {
-      QString lz4 = fromLZ4(child);
-      result += common::EscapedText(lz4);
-    } else if (view_method_ == BZIP2_VIEW) {
-      QString bzip2 = fromBZip2(child);
-      result += common::EscapedText(bzip2);
-    } else if (view_method_ == SNAPPY_VIEW) {
-      QString snap = fromSnappy(child);
-      result += common::EscapedText(snap);
-    } else if (view_method_ == XML_VIEW) {
-      QString raw = toRaw(child);
-      result += common::EscapedText(raw);
-    }
+    CollectRenderParts(child, &parts);
   }
 
-  if (result.isEmpty()) {
-    result = translations::trCannotConvertPattern1ArgsS.arg(methodText);
-    text_json_editor_->setReadOnly(true);
-  }
-  text_json_editor_->setText(result);
+  text_json_editor_->clear();
+  QThread* th = new QThread;
+  renderer_ = new OutputRenderer(parts, view_method_);
+  renderer_->moveToThread(th);
+  VERIFY(connect(th, &QThread::started, renderer_, &OutputRenderer::routine));
+  VERIFY(connect(renderer_, &OutputRenderer::chunkRendered, this, &FastoEditorOutput::appendRenderedChunk));
+  VERIFY(connect(renderer_, &OutputRenderer::renderFinished, this, &FastoEditorOutput::finishRender));
+  VERIFY(connect(renderer_, &OutputRenderer::renderFinished, th, &QThread::quit));
+  VERIFY(connect(th, &QThread::finished, renderer_, &OutputRenderer::deleteLater));
+  VERIFY(connect(th, &QThread::finished, th, &QThread::deleteLater));
+  th->start();
+  emit renderStarted();
 }
 
 }  // namespace gui
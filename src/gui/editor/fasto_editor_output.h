@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include "core/value_encoding.h"  // for ValueEncoding
+
 #include "gui/editor/fasto_editor.h"
 
 #define JSON_VIEW 0
@@ -35,6 +37,7 @@
 namespace fastonosql {
 namespace gui {
 class FastoHexEdit;
+class OutputRenderer;
 
 class FastoEditorOutput : public QWidget {
   Q_OBJECT
@@ -50,14 +53,19 @@ class FastoEditorOutput : public QWidget {
   QString text() const;
   bool isReadOnly() const;
   int childCount() const;
+  bool isRendering() const;
+  core::ValueEncoding firstValueEncoding() const;  // detected encoding of first shown value
 
  Q_SIGNALS:
   void textChanged();
   void readOnlyChanged();
+  void renderStarted();
+  void renderFinished();
 
  public Q_SLOTS:
   void setReadOnly(bool ro);
   void viewChange(int viewMethod);
+  void stopRender();
 
  private Q_SLOTS:
   void modelDestroyed();
@@ -72,6 +80,9 @@ class FastoEditorOutput : public QWidget {
   void reset();
   void layoutChanged();
 
+  void appendRenderedChunk(const QString& text);
+  void finishRender(bool empty);
+
  private:
   void SyncEditors();
 
@@ -81,6 +92,7 @@ class FastoEditorOutput : public QWidget {
 
   QAbstractItemModel* model_;
   int view_method_;
+  OutputRenderer* renderer_;
 };
 
 }  // namespace gui
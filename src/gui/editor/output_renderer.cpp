@@ -0,0 +1,157 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/editor/output_renderer.h"
+
+#include <common/qt/convert2string.h>  // for EscapedText
+
+#include "core/json_pretty_printer.h"
+#include "core/types.h"  // for hex_string
+
+#include "gui/decoder_pipeline.h"            // for DecoderPipeline
+#include "gui/editor/fasto_editor_output.h"  // for JSON_VIEW, etc
+
+#define CSV_SEPARATOR ","
+#define RENDER_CHUNK_SIZE (16 * 1024)
+
+namespace fastonosql {
+namespace gui {
+
+namespace {
+
+QString EscapedString(const std::string& text) {
+  QString qtext;
+  common::ConvertFromString(text, &qtext);
+  return common::EscapedText(qtext);
+}
+
+// cached, views switching or rendering the same values again doesn't decode them again
+QString Decoded(const std::string& decoder, const std::string& text) {
+  std::string out;
+  common::Error err = DecoderPipeline::GetInstance().decode(decoder, false, text, &out);
+  if (err) {
+    return QString();
+  }
+
+  return EscapedString(out);
+}
+
+// doesn't split surrogate pair between chunks
+int ChunkEnd(const QString& text, int pos) {
+  if (pos > 0 && pos < text.size() && text.at(pos - 1).isHighSurrogate()) {
+    return pos - 1;
+  }
+
+  return pos;
+}
+
+}  // namespace
+
+OutputRenderer::OutputRenderer(const parts_t& parts, int view_method, QObject* parent)
+    : QObject(parent), parts_(parts), view_method_(view_method), stop_(false), chunk_(), empty_(true) {}
+
+void OutputRenderer::stop() {
+  stop_ = true;
+}
+
+void OutputRenderer::routine() {
+  for (size_t i = 0; i < parts_.size() && !stop_; ++i) {
+    sendText(renderPart(parts_[i]));
+  }
+
+  if (!stop_ && !chunk_.isEmpty()) {
+    emit chunkRendered(chunk_);
+  }
+  chunk_.clear();
+  emit renderFinished(empty_);
+}
+
+QString OutputRenderer::renderPart(const Part& part) const {
+  const core::value_t value_str = part.value.GetValue(part.delimiter);
+  const std::string& raw = value_str.GetHumanReadable();
+  if (view_method_ == JSON_VIEW) {
+    std::string json;
+    core::JsonPrettyPrinter printer(&json);
+    if (!printer.Write(raw) || !printer.Finish()) {
+      return QString();
+    }
+
+    return EscapedString(json);
+  } else if (view_method_ == CSV_VIEW) {
+    QString csv;
+    common::ConvertFromString(raw, &csv);
+    csv = common::EscapedText(csv.replace(part.delimiter.c_str(), CSV_SEPARATOR));
+    if (part.csv_separator) {
+      csv += CSV_SEPARATOR;
+    }
+    return csv;
+  } else if (view_method_ == RAW_VIEW || view_method_ == XML_VIEW) {
+    return EscapedString(raw);
+  } else if (view_method_ == HEX_VIEW) {
+    QString qhexed;
+    common::ConvertFromString(core::detail::hex_string(raw), &qhexed);
+    return qhexed;
+  } else if (view_method_ == UNICODE_VIEW) {
+    QString qunicoded;
+    common::ConvertFromString(core::detail::unicode_string(raw), &qunicoded);
+    return qunicoded;
+  }
+
+  // binary formats are decoded from stored bytes, not from escaped text
+  const std::string& data = value_str.GetData();
+  if (view_method_ == MSGPACK_VIEW) {
+    return Decoded("msgpack", data);
+  } else if (view_method_ == GZIP_VIEW) {
+    return Decoded("zlib", data);
+  } else if (view_method_ == LZ4_VIEW) {
+    return Decoded("lz4", data);
+  } else if (view_method_ == BZIP2_VIEW) {
+    return Decoded("bzip2", data);
+  } else if (view_method_ == SNAPPY_VIEW) {
+    return Decoded("snappy", data);
+  }
+
+  NOTREACHED();
+  return QString();
+}
+
+void OutputRenderer::sendText(const QString& text) {
+  if (text.isEmpty()) {
+    return;
+  }
+
+  empty_ = false;
+  if (chunk_.size() + text.size() < RENDER_CHUNK_SIZE) {
+    chunk_ += text;
+    return;
+  }
+
+  // big values are split too, editor appends them piece by piece between other events
+  int pos = ChunkEnd(text, RENDER_CHUNK_SIZE - chunk_.size());
+  chunk_ += text.midRef(0, pos);
+  emit chunkRendered(chunk_);
+  while (text.size() - pos >= RENDER_CHUNK_SIZE && !stop_) {
+    const int end = ChunkEnd(text, pos + RENDER_CHUNK_SIZE);
+    emit chunkRendered(text.mid(pos, end - pos));
+    pos = end;
+  }
+  chunk_ = text.mid(pos);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,67 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <QObject>
+
+#include "core/db_key.h"  // for NValue
+
+namespace fastonosql {
+namespace gui {
+
+// converts output values into text of one view on a worker thread,
+// text is sent in chunks so the first screens are shown before everything is converted
+class OutputRenderer : public QObject {
+  Q_OBJECT
+ public:
+  struct Part {
+    core::NValue value;
+    std::string delimiter;
+    bool csv_separator;  // value has next sibling
+  };
+  typedef std::vector<Part> parts_t;
+
+  OutputRenderer(const parts_t& parts, int view_method, QObject* parent = Q_NULLPTR);
+
+  void stop();  // can be called from any thread
+
+ Q_SIGNALS:
+  void chunkRendered(const QString& text);
+  void renderFinished(bool empty);
+
+ public Q_SLOTS:
+  void routine();
+
+ private:
+  QString renderPart(const Part& part) const;
+  void sendText(const QString& text);
+
+  const parts_t parts_;
+  const int view_method_;
+  std::atomic<bool> stop_;
+  QString chunk_;
+  bool empty_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
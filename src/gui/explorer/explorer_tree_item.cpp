@@ -109,7 +109,7 @@ proxy::ISentinelSPtr ExplorerSentinelItem::sentinel() const {
 }
 
 ExplorerClusterItem::ExplorerClusterItem(proxy::IClusterSPtr cluster, TreeItem* parent)
-    : IExplorerTreeItem(parent, eCluster), cluster_(cluster) {
+    : IExplorerTreeItem(parent, eCluster), cluster_(cluster), total_keys_count_(0) {
   auto nodes = cluster_->GetNodes();
   for (size_t i = 0; i < nodes.size(); ++i) {
     ExplorerServerItem* ser = new ExplorerServerItem(nodes[i], this);
@@ -127,6 +127,14 @@ proxy::IClusterSPtr ExplorerClusterItem::cluster() const {
   return cluster_;
 }
 
+size_t ExplorerClusterItem::totalKeysCount() const {
+  return total_keys_count_;
+}
+
+void ExplorerClusterItem::setTotalKeysCount(size_t count) {
+  total_keys_count_ = count;
+}
+
 ExplorerDatabaseItem::ExplorerDatabaseItem(proxy::IDatabaseSPtr db, ExplorerServerItem* parent)
     : IExplorerTreeItem(parent, eDatabase), db_(db) {
   DCHECK(db_);
@@ -169,10 +177,19 @@ proxy::IDatabaseSPtr ExplorerDatabaseItem::db() const {
   return db_;
 }
 
-void ExplorerDatabaseItem::loadContent(const std::string& pattern, uint32_t countKeys) {
+void ExplorerDatabaseItem::loadContent(const std::string& pattern,
+                                       uint32_t countKeys,
+                                       const core::KeysFilter& filter) {
   proxy::IDatabaseSPtr dbs = db();
   CHECK(dbs);
+  proxy::ICluster* cluster = dbs->GetServer()->GetCluster();
+  if (cluster) {  // keys of all masters, each node adds own ones
+    cluster->LoadContent(pattern, countKeys, filter, true);
+    return;
+  }
+
   proxy::events_info::LoadDatabaseContentRequest req(this, dbs->GetInfo(), pattern, countKeys);
+  req.filter = filter;
   dbs->LoadContent(req);
 }
 
@@ -24,6 +24,7 @@
 
 #include "core/database/idatabase_info.h"
 #include "core/display_strategy.h"
+#include "core/keys_filter.h"
 
 #include "proxy/proxy_fwd.h"  // for IServerSPtr, IClusterSPtr, etc
 
@@ -80,8 +81,12 @@ class ExplorerClusterItem : public IExplorerTreeItem {
 
   proxy::IClusterSPtr cluster() const;
 
+  size_t totalKeysCount() const;  // of all masters, from last content loading
+  void setTotalKeysCount(size_t count);
+
  private:
   const proxy::IClusterSPtr cluster_;
+  size_t total_keys_count_;
 };
 
 class ExplorerDatabaseItem : public IExplorerTreeItem {
@@ -96,7 +101,7 @@ class ExplorerDatabaseItem : public IExplorerTreeItem {
   proxy::IServerSPtr server() const;
   proxy::IDatabaseSPtr db() const;
 
-  void loadContent(const std::string& pattern, uint32_t countKeys);
+  void loadContent(const std::string& pattern, uint32_t countKeys, const core::KeysFilter& filter);
   void setDefault();
   void removeDb();
 
@@ -91,6 +91,9 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
         common::ConvertFromString(lserver->GetPath(), &spath);
         return trLocalServerToolTipTemplate_2S.arg(sname, spath);
       }
+    } else if (type == IExplorerTreeItem::eCluster) {
+      ExplorerClusterItem* cluster = static_cast<ExplorerClusterItem*>(node);
+      return trDbToolTipTemplate_1S.arg(cluster->totalKeysCount());
     } else if (type == IExplorerTreeItem::eDatabase) {
       ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
       if (db->isDefault()) {
@@ -223,6 +226,19 @@ void ExplorerTreeModel::removeCluster(proxy::IClusterSPtr cluster) {
   }
 }
 
+void ExplorerTreeModel::updateCluster(proxy::ICluster* cluster, size_t total_keys_count) {
+  ExplorerClusterItem* cl = findClusterItem(cluster);
+  if (!cl) {
+    return;
+  }
+
+  cl->setTotalKeysCount(total_keys_count);
+  int index_cl = root_->indexOf(cl);
+  QModelIndex cl_index1 = createIndex(index_cl, ExplorerClusterItem::eName, cl);
+  QModelIndex cl_index2 = createIndex(index_cl, ExplorerClusterItem::eCountColumns, cl);
+  updateItem(cl_index1, cl_index2);
+}
+
 void ExplorerTreeModel::addServer(proxy::IServerSPtr server) {
   if (!server) {
     return;
@@ -451,6 +467,10 @@ void ExplorerTreeModel::removeAllKeys(proxy::IServer* server, core::IDataBaseInf
 }
 
 ExplorerClusterItem* ExplorerTreeModel::findClusterItem(proxy::IClusterSPtr cl) {
+  return findClusterItem(cl.get());
+}
+
+ExplorerClusterItem* ExplorerTreeModel::findClusterItem(proxy::ICluster* cl) {
   common::qt::gui::TreeItem* parent = root_;
   if (!parent) {
     return nullptr;
@@ -462,7 +482,7 @@ ExplorerClusterItem* ExplorerTreeModel::findClusterItem(proxy::IClusterSPtr cl)
       continue;
     }
 
-    if (cluster_item && cluster_item->cluster() == cl) {
+    if (cluster_item && cluster_item->cluster().get() == cl) {
       return cluster_item;
     }
   }
@@ -49,6 +49,7 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
 
   void addCluster(proxy::IClusterSPtr cluster);
   void removeCluster(proxy::IClusterSPtr cluster);
+  void updateCluster(proxy::ICluster* cluster, size_t total_keys_count);
 
   void addServer(proxy::IServerSPtr server);
   void removeServer(proxy::IServerSPtr server);
@@ -76,6 +77,7 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
 
  private:
   ExplorerClusterItem* findClusterItem(proxy::IClusterSPtr cl);
+  ExplorerClusterItem* findClusterItem(proxy::ICluster* cl);
   ExplorerSentinelItem* findSentinelItem(proxy::ISentinelSPtr sentinel);
   ExplorerServerItem* findServerItem(proxy::IServer* server) const;
   ExplorerDatabaseItem* findDatabaseItem(ExplorerServerItem* server, core::IDataBaseInfoSPtr db) const;
@@ -25,6 +25,7 @@
 #include <QMessageBox>
 
 #include <common/qt/convert2string.h>  // for ConvertToString
+#include <common/qt/logger.h>          // for LOG_ERROR
 #include <common/qt/utils_qt.h>        // for item
 
 #include <common/qt/gui/regexp_input_dialog.h>
@@ -163,6 +164,7 @@ void ExplorerTreeView::addCluster(proxy::IClusterSPtr cluster) {
     syncWithServer(nodes[i].get());
   }
 
+  VERIFY(connect(cluster.get(), &proxy::ICluster::ContentLoaded, this, &ExplorerTreeView::finishLoadClusterContent));
   source_model_->addCluster(cluster);
 }
 
@@ -177,6 +179,9 @@ void ExplorerTreeView::removeCluster(proxy::IClusterSPtr cluster) {
     unsyncWithServer(nodes[i].get());
   }
 
+  VERIFY(disconnect(cluster.get(), &proxy::ICluster::ContentLoaded, this,
+                    &ExplorerTreeView::finishLoadClusterContent));
+
   source_model_->removeCluster(cluster);
   emit clusterClosed(cluster);
 }
@@ -706,7 +711,7 @@ void ExplorerTreeView::loadContentDb() {
     LoadContentDbDialog loadDb(trLoadContentTemplate_1S.arg(node->name()), node->server()->GetType(), this);
     int result = loadDb.exec();
     if (result == QDialog::Accepted) {
-      node->loadContent(common::ConvertToString(loadDb.pattern()), loadDb.count());
+      node->loadContent(common::ConvertToString(loadDb.pattern()), loadDb.count(), loadDb.filter());
     }
   }
 }
@@ -984,6 +989,17 @@ void ExplorerTreeView::finishLoadDatabaseContent(const proxy::events_info::LoadD
   source_model_->updateDb(serv, res.inf);
 }
 
+void ExplorerTreeView::finishLoadClusterContent(const proxy::ICluster::ContentInfo& content) {
+  proxy::ICluster* cluster = qobject_cast<proxy::ICluster*>(sender());
+  CHECK(cluster);
+
+  // keys added to databases of nodes by their own responces
+  if (content.err) {
+    LOG_ERROR(content.err, common::logging::LOG_LEVEL_ERR, true);
+  }
+  source_model_->updateCluster(cluster, content.db_keys_count);
+}
+
 void ExplorerTreeView::startExecuteCommand(const proxy::events_info::ExecuteInfoRequest& req) {
   UNUSED(req);
 }
@@ -21,7 +21,8 @@
 #include <QTreeView>
 
 #include "proxy/events/events_info.h"
-#include "proxy/proxy_fwd.h"  // for IServerSPtr, IClusterSPtr, etc
+#include "proxy/cluster/icluster.h"  // for ICluster::ContentInfo
+#include "proxy/proxy_fwd.h"         // for IServerSPtr, IClusterSPtr, etc
 
 class QAction;  // lines 23-23
 class QPoint;
@@ -95,6 +96,7 @@ class ExplorerTreeView : public QTreeView {
 
   void startLoadDatabaseContent(const proxy::events_info::LoadDatabaseContentRequest& req);
   void finishLoadDatabaseContent(const proxy::events_info::LoadDatabaseContentResponce& res);
+  void finishLoadClusterContent(const proxy::ICluster::ContentInfo& content);
 
   void startExecuteCommand(const proxy::events_info::ExecuteInfoRequest& req);
   void finishExecuteCommand(const proxy::events_info::ExecuteInfoResponce& res);
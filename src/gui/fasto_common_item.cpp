@@ -18,17 +18,11 @@
 
 #include "gui/fasto_common_item.h"
 
-#include <common/qt/convert2string.h>                      // for ConvertToString
-#include <common/text_decoders/compress_bzip2_edcoder.h>   // for CompressEDcoder
-#include <common/text_decoders/compress_lz4_edcoder.h>     // for CompressEDcoder
-#include <common/text_decoders/compress_snappy_edcoder.h>  // for CompressEDcoder
-#include <common/text_decoders/compress_zlib_edcoder.h>    // for CompressEDcoder
-#include <common/text_decoders/hex_edcoder.h>              // for HexEDcoder
-#include <common/text_decoders/msgpack_edcoder.h>          // for MsgPackEDcoder
+#include <common/qt/convert2string.h>  // for ConvertToString
 
-#include <json-c/json_tokener.h>
+#include "core/value.h"  // for ConvertValuePreview
 
-#define CSV_SEPARATOR ","
+#define MAX_DISPLAY_VALUE_SIZE 1024
 
 namespace fastonosql {
 namespace gui {
@@ -37,8 +31,15 @@ FastoCommonItem::FastoCommonItem(const core::NDbKValue& key,
                                  const std::string& delimiter,
                                  bool isReadOnly,
                                  TreeItem* parent,
-                                 void* internalPointer)
-    : TreeItem(parent, internalPointer), key_(key), delimiter_(delimiter), read_only_(isReadOnly) {}
+                                 void* internalPointer,
+                                 core::ValueEncoding encoding)
+    : TreeItem(parent, internalPointer),
+      key_(key),
+      delimiter_(delimiter),
+      read_only_(isReadOnly),
+      encoding_(encoding),
+      display_value_(),
+      display_value_cached_(false) {}
 
 QString FastoCommonItem::key() const {
   QString qkey;
@@ -49,10 +50,14 @@ QString FastoCommonItem::key() const {
 }
 
 QString FastoCommonItem::value() const {
-  std::string valstr = basicStringValue();
-  QString qvalstr;
-  common::ConvertFromString(valstr, &qvalstr);
-  return qvalstr;
+  if (!display_value_cached_) {
+    core::NValue nval = key_.GetValue();
+    const std::string preview = core::ConvertValuePreview(nval.get(), delimiter_, MAX_DISPLAY_VALUE_SIZE);
+    common::ConvertFromString(preview, &display_value_);
+    display_value_cached_ = true;
+  }
+
+  return display_value_;
 }
 
 std::string FastoCommonItem::basicStringValue() const {
@@ -61,8 +66,11 @@ std::string FastoCommonItem::basicStringValue() const {
   return value_str.GetHumanReadable();
 }
 
-void FastoCommonItem::setValue(core::NValue val) {
+void FastoCommonItem::setValue(core::NValue val, core::ValueEncoding encoding) {
   key_.SetValue(val);
+  encoding_ = encoding;
+  display_value_cached_ = false;
+  display_value_.clear();
 }
 
 core::NValue FastoCommonItem::nvalue() const {
@@ -82,228 +90,12 @@ common::Value::Type FastoCommonItem::type() const {
   QString qvalstr;
 }
 
-bool FastoCommonItem::isReadOnly() const {
-  return read_only_;
-}
-
-QString toJson(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    std::string json = common::ConvertToString(item->value());
-    json_object* obj = json_tokener_parse(json.c_str());
-    if (!obj) {
-      return QString();
-    }
-
-    std::string jstring = json_object_to_json_string_ext(obj, JSON_C_TO_STRING_PRETTY);
-    QString result;
-    common::ConvertFromString(jstring, &result);
-    json_object_put(obj);
-    return result;
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += toJson(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
-}
-
-QString toRaw(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    return item->value();
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += toRaw(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
-}
-
-QString toCsv(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    QString val = item->value();
-    return val.replace(item->delimiter(), ",");
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += toCsv(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-    if (i != item->childrenCount() - 1) {
-      value += CSV_SEPARATOR;
-    }
-  }
-
-  return value;
-}
-
-QString fromSnappy(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    QString val = item->value();
-    std::string sval = common::ConvertToString(val);
-    std::string out;
-    common::CompressSnappyEDcoder enc;
-    common::Error err = enc.Decode(sval, &out);
-    if (err) {
-      return QString();
-    }
-
-    QString qout;
-    common::ConvertFromString(out, &qout);
-    return qout;
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += fromSnappy(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
+core::ValueEncoding FastoCommonItem::encoding() const {
+  return encoding_;
 }
 
-QString fromGzip(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    QString val = item->value();
-    std::string sval = common::ConvertToString(val);
-    std::string out;
-    common::CompressZlibEDcoder enc;
-    common::Error err = enc.Decode(sval, &out);
-    if (err) {
-      return QString();
-    }
-
-    QString qout;
-    common::ConvertFromString(out, &qout);
-    return qout;
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += fromGzip(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
-}
-
-QString fromLZ4(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    QString val = item->value();
-    std::string sval = common::ConvertToString(val);
-    std::string out;
-    common::CompressLZ4EDcoder enc;
-    common::Error err = enc.Decode(sval, &out);
-    if (err) {
-      return QString();
-    }
-
-    QString qout;
-    common::ConvertFromString(out, &qout);
-    return qout;
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += fromLZ4(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
-}
-
-QString fromBZip2(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    QString val = item->value();
-    std::string sval = common::ConvertToString(val);
-    std::string out;
-    common::CompressBZip2EDcoder enc;
-    common::Error err = enc.Decode(sval, &out);
-    if (err) {
-      return QString();
-    }
-
-    QString qout;
-    common::ConvertFromString(out, &qout);
-    return qout;
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += fromBZip2(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
-}
-
-QString fromHexMsgPack(FastoCommonItem* item) {
-  if (!item) {
-    DNOTREACHED() << "Invalid input.";
-    return QString();
-  }
-
-  if (!item->childrenCount()) {
-    std::string sval = common::ConvertToString(item->value());
-
-    common::HexEDcoder hex;
-    std::string hexstr;
-    common::Error err = hex.Decode(sval, &hexstr);
-    if (err) {
-      return QString();
-    }
-
-    common::MsgPackEDcoder msg;
-    std::string upack;
-    err = msg.Decode(hexstr, &upack);
-    if (err) {
-      return QString();
-    }
-
-    QString qupack;
-    common::ConvertFromString(upack, &qupack);
-    return qupack;
-  }
-
-  QString value;
-  for (size_t i = 0; i < item->childrenCount(); ++i) {
-    value += fromHexMsgPack(dynamic_cast<FastoCommonItem*>(item->child(i)));  // +
-  }
-
-  return value;
+bool FastoCommonItem::isReadOnly() const {
+  return read_only_;
 }
 
 }  // namespace gui
@@ -24,7 +24,8 @@
 
 #include <common/qt/gui/base/tree_item.h>  // for TreeItem
 
-#include "core/db_key.h"  // for NDbKValue, NValue
+#include "core/db_key.h"         // for NDbKValue, NValue
+#include "core/value_encoding.h"  // for ValueEncoding
 
 namespace fastonosql {
 namespace gui {
@@ -36,35 +37,30 @@ class FastoCommonItem : public common::qt::gui::TreeItem {
                   const std::string& delimiter,
                   bool isReadOnly,
                   TreeItem* parent,
-                  void* internalPointer);
+                  void* internalPointer,
+                  core::ValueEncoding encoding);
 
   QString key() const;
-  QString value() const;
+  QString value() const;  // bounded preview for cells, cached until setValue
   std::string basicStringValue() const;
 
   common::Value::Type type() const;
+  core::ValueEncoding encoding() const;
   core::NValue nvalue() const;
   core::NDbKValue dbv() const;
   const char* delimiter() const;
 
   bool isReadOnly() const;
-  void setValue(core::NValue val);
+  void setValue(core::NValue val, core::ValueEncoding encoding);
 
  private:
   core::NDbKValue key_;
   const std::string delimiter_;
   const bool read_only_;
+  core::ValueEncoding encoding_;
+  mutable QString display_value_;
+  mutable bool display_value_cached_;
 };
 
-QString toJson(FastoCommonItem* item);
-QString toRaw(FastoCommonItem* item);
-QString toCsv(FastoCommonItem* item);
-
-QString fromGzip(FastoCommonItem* item);
-QString fromLZ4(FastoCommonItem* item);
-QString fromBZip2(FastoCommonItem* item);
-QString fromSnappy(FastoCommonItem* item);
-QString fromHexMsgPack(FastoCommonItem* item);
-
 }  // namespace gui
 }  // namespace fastonosql
@@ -19,6 +19,7 @@
 #include "gui/fasto_common_model.h"
 
 #include <QIcon>
+#include <QTimer>
 
 #include <common/qt/convert2string.h>  // for ConvertToString
 #include <common/qt/utils_qt.h>        // for item
@@ -35,7 +36,17 @@ Q_DECLARE_METATYPE(fastonosql::core::NValue)
 namespace fastonosql {
 namespace gui {
 
-FastoCommonModel::FastoCommonModel(QObject* parent) : TreeModel(parent) {}
+FastoCommonModel::FastoCommonModel(QObject* parent)
+    : TreeModel(parent),
+      items_(),
+      pending_parent_(nullptr),
+      pending_items_(),
+      root_children_limit_(0),
+      removed_root_rows_(0) {}
+
+FastoCommonModel::~FastoCommonModel() {
+  clearPendingItems();
+}
 
 QVariant FastoCommonModel::data(const QModelIndex& index, int role) const {
   QVariant result;
@@ -71,6 +82,10 @@ QVariant FastoCommonModel::data(const QModelIndex& index, int role) const {
       result = node->value();
     } else if (col == FastoCommonItem::eType) {
       QString qtype = core::GetTypeName(node->type());
+      const core::ValueEncoding encoding = node->encoding();
+      if (encoding != core::VALUE_ENCODING_TEXT) {
+        qtype += QString(" (%1)").arg(core::value_encoding_text[encoding]);
+      }
       result = qtype;
     }
   }
@@ -144,6 +159,7 @@ int FastoCommonModel::columnCount(const QModelIndex& parent) const {
 }
 
 void FastoCommonModel::changeValue(const core::NDbKValue& value) {
+  flushPendingItems();  // key could be in not yet inserted rows
   QModelIndex ind = index(0, 0, QModelIndex());
   if (!ind.isValid()) {
     return;
@@ -170,12 +186,142 @@ void FastoCommonModel::changeValue(const core::NDbKValue& value) {
     }
 
     if (child->key() == key) {  // optimize easy
-      child->setValue(value.GetValue());
+      core::NValue nval = value.GetValue();
+      child->setValue(nval, core::DetectValueEncoding(nval.get()));
       updateItem(index(i, FastoCommonItem::eValue, QModelIndex()), index(i, FastoCommonItem::eType, QModelIndex()));
       break;
     }
   }
 }
 
+void FastoCommonModel::setRootItem(FastoCommonItem* root) {
+  clearPendingItems();
+  items_.clear();
+  removed_root_rows_ = 0;
+  if (root) {
+    items_[root->internalPointer()] = {root, 0};
+  }
+  setRoot(root);
+}
+
+FastoCommonItem* FastoCommonModel::findObjectItem(void* internal_pointer) const {
+  items_t::const_iterator it = items_.find(internal_pointer);
+  if (it == items_.end()) {
+    return nullptr;
+  }
+
+  return it->second.item;
+}
+
+QModelIndex FastoCommonModel::objectIndex(void* internal_pointer, int column) const {
+  items_t::const_iterator it = items_.find(internal_pointer);
+  if (it == items_.end() || it->second.item == root_) {
+    return QModelIndex();
+  }
+
+  common::qt::gui::TreeItem* parent = it->second.item->parent();
+  int row = it->second.row;
+  if (parent == root_) {
+    row -= removed_root_rows_;
+  }
+  if (!parent || row >= static_cast<int>(parent->childrenCount())) {  // pending, row is not inserted yet
+    return QModelIndex();
+  }
+  return createIndex(row, column, it->second.item);
+}
+
+void FastoCommonModel::appendItem(FastoCommonItem* parent, FastoCommonItem* child) {
+  if (!parent || !child) {
+    DNOTREACHED();
+    return;
+  }
+
+  // consecutive children of the same parent are inserted by one beginInsertRows
+  if (pending_parent_ != parent) {
+    flushPendingItems();
+    pending_parent_ = parent;
+  }
+
+  if (pending_items_.empty()) {
+    QTimer::singleShot(0, this, &FastoCommonModel::flushPendingItems);
+  }
+
+  int row = static_cast<int>(parent->childrenCount() + pending_items_.size());
+  if (parent == root_) {
+    row += removed_root_rows_;
+  }
+  items_[child->internalPointer()] = {child, row};
+  pending_items_.push_back(child);
+}
+
+void FastoCommonModel::updateObjectItem(void* internal_pointer) {
+  flushPendingItems();
+  QModelIndex index = objectIndex(internal_pointer, FastoCommonItem::eKey);
+  if (!index.isValid()) {
+    return;
+  }
+
+  updateItem(index, objectIndex(internal_pointer, FastoCommonItem::eType));
+}
+
+void FastoCommonModel::flushPendingItems() {
+  if (pending_items_.empty()) {
+    return;
+  }
+
+  FastoCommonItem* parent = pending_parent_;
+  const int first = static_cast<int>(parent->childrenCount());
+  const int last = first + static_cast<int>(pending_items_.size()) - 1;
+  QModelIndex parent_index = objectIndex(parent->internalPointer());
+  beginInsertRows(parent_index, first, last);
+  for (FastoCommonItem* child : pending_items_) {
+    parent->addChildren(child);
+  }
+  endInsertRows();
+
+  pending_items_.clear();
+  pending_parent_ = nullptr;
+  if (parent == root_) {
+    trimRootChildren();
+  }
+}
+
+void FastoCommonModel::setRootChildrenLimit(size_t limit) {
+  root_children_limit_ = limit;
+}
+
+void FastoCommonModel::trimRootChildren() {
+  if (!root_ || !root_children_limit_ || root_->childrenCount() <= root_children_limit_) {
+    return;
+  }
+
+  const size_t extra = root_->childrenCount() - root_children_limit_;
+  for (size_t i = 0; i < extra; ++i) {
+    common::qt::gui::TreeItem* oldest = root_->child(0);
+    forgetItem(oldest);
+    removeItem(QModelIndex(), oldest);
+  }
+  removed_root_rows_ += static_cast<int>(extra);
+}
+
+void FastoCommonModel::forgetItem(common::qt::gui::TreeItem* item) {
+  for (size_t i = 0; i < item->childrenCount(); ++i) {
+    forgetItem(item->child(i));
+  }
+
+  items_t::iterator it = items_.find(item->internalPointer());
+  if (it != items_.end() && it->second.item == item) {  // pointer could be reused by newer object
+    items_.erase(it);
+  }
+}
+
+void FastoCommonModel::clearPendingItems() {
+  for (FastoCommonItem* child : pending_items_) {
+    delete child;
+  }
+  pending_items_.clear();
+  pending_parent_ = nullptr;
+}
+
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include <common/qt/gui/base/tree_model.h>  // for TreeModel
 
 namespace fastonosql {
@@ -25,11 +28,13 @@ namespace core {
 class NDbKValue;
 }
 namespace gui {
+class FastoCommonItem;
 
 class FastoCommonModel : public common::qt::gui::TreeModel {
   Q_OBJECT
  public:
   explicit FastoCommonModel(QObject* parent = Q_NULLPTR);
+  virtual ~FastoCommonModel();
 
   virtual QVariant data(const QModelIndex& index, int role) const override;
   virtual bool setData(const QModelIndex& index, const QVariant& value, int role) override;
@@ -40,8 +45,39 @@ class FastoCommonModel : public common::qt::gui::TreeModel {
 
   void changeValue(const core::NDbKValue& value);
 
+  // items indexed by internal pointer (FastoObject), output items are only appended;
+  // appended items are found before their rows are inserted, but have no index until flushPendingItems
+  void setRootItem(FastoCommonItem* root);
+  FastoCommonItem* findObjectItem(void* internal_pointer) const;
+  QModelIndex objectIndex(void* internal_pointer, int column = 0) const;
+  void appendItem(FastoCommonItem* parent, FastoCommonItem* child);
+  void updateObjectItem(void* internal_pointer);
+
+  // rolling window for streaming output: oldest top level items are removed, 0 - unlimited
+  void setRootChildrenLimit(size_t limit);
+
  Q_SIGNALS:
   void changedValue(const core::NDbKValue& value);
+
+ public Q_SLOTS:
+  void flushPendingItems();
+
+ private:
+  struct ItemInfo {
+    FastoCommonItem* item;
+    int row;  // row hint, stable while items are only appended
+  };
+  typedef std::unordered_map<void*, ItemInfo> items_t;
+
+  void clearPendingItems();
+  void trimRootChildren();
+  void forgetItem(common::qt::gui::TreeItem* item);
+
+  items_t items_;
+  FastoCommonItem* pending_parent_;
+  std::vector<FastoCommonItem*> pending_items_;
+  size_t root_children_limit_;
+  int removed_root_rows_;  // row hints of top level items are shifted by it
 };
 
 }  // namespace gui
@@ -18,6 +18,7 @@
 
 #include "gui/fasto_text_view.h"
 
+#include <QAbstractItemModel>
 #include <QComboBox>
 #include <QEvent>
 #include <QLabel>
@@ -38,8 +39,35 @@ Q_DECLARE_METATYPE(fastonosql::core::NValue)
 
 namespace fastonosql {
 namespace gui {
+namespace {
+
+int ViewForEncoding(core::ValueEncoding encoding) {
+  switch (encoding) {
+    case core::VALUE_ENCODING_JSON:
+      return JSON_VIEW;
+    case core::VALUE_ENCODING_XML:
+      return XML_VIEW;
+    case core::VALUE_ENCODING_GZIP:
+      return GZIP_VIEW;
+    case core::VALUE_ENCODING_LZ4:
+      return LZ4_VIEW;
+    case core::VALUE_ENCODING_BZIP2:
+      return BZIP2_VIEW;
+    case core::VALUE_ENCODING_SNAPPY:
+      return SNAPPY_VIEW;
+    case core::VALUE_ENCODING_MSGPACK:
+      return MSGPACK_VIEW;
+    case core::VALUE_ENCODING_BINARY:
+      return HEX_VIEW;
+    default:
+      return RAW_VIEW;
+  }
+}
 
-FastoTextView::FastoTextView(QWidget* parent) : QWidget(parent) {
+}  // namespace
+
+FastoTextView::FastoTextView(QWidget* parent)
+    : QWidget(parent), text_dirty_(false), render_stopped_(false), view_detected_(false) {
   QVBoxLayout* mainL = new QVBoxLayout;
 
   editor_ = new FastoEditorOutput;
@@ -61,18 +89,25 @@ FastoTextView::FastoTextView(QWidget* parent) : QWidget(parent) {
   save_change_button_->setIcon(GuiFactory::GetInstance().GetSaveIcon());
   save_change_button_->setEnabled(false);
 
+  cancel_render_button_ = new QPushButton;
+  cancel_render_button_->setEnabled(false);
+
   typedef void (QComboBox::*ind)(int);
   VERIFY(
       connect(views_combo_box_, static_cast<ind>(&QComboBox::currentIndexChanged), this, &FastoTextView::viewChange));
 
   VERIFY(connect(save_change_button_, &QPushButton::clicked, this, &FastoTextView::saveChanges));
-  VERIFY(connect(editor_, &FastoEditorOutput::textChanged, this, &FastoTextView::textChange));
+  VERIFY(connect(cancel_render_button_, &QPushButton::clicked, this, &FastoTextView::cancelRender));
+  VERIFY(connect(editor_, &FastoEditorOutput::textChanged, this, &FastoTextView::textEdit));
   VERIFY(connect(editor_, &FastoEditorOutput::readOnlyChanged, this, &FastoTextView::textChange));
+  VERIFY(connect(editor_, &FastoEditorOutput::renderStarted, this, &FastoTextView::startRender));
+  VERIFY(connect(editor_, &FastoEditorOutput::renderFinished, this, &FastoTextView::finishRender));
 
   mainL->addWidget(editor_);
   mainL->setContentsMargins(0, 0, 0, 0);
   QHBoxLayout* hlayout = new QHBoxLayout;
   hlayout->addWidget(save_change_button_);
+  hlayout->addWidget(cancel_render_button_);
   QSplitter* spliter_save_and_view = new QSplitter(Qt::Horizontal);
   hlayout->addWidget(spliter_save_and_view);
   hlayout->addWidget(views_label_);
@@ -85,9 +120,27 @@ FastoTextView::FastoTextView(QWidget* parent) : QWidget(parent) {
 }
 
 void FastoTextView::setModel(QAbstractItemModel* model) {
+  VERIFY(connect(model, &QAbstractItemModel::modelReset, this, &FastoTextView::resetDetectedView));
   editor_->setModel(model);
 }
 
+void FastoTextView::resetDetectedView() {
+  view_detected_ = false;
+}
+
+void FastoTextView::selectDetectedView() {
+  if (view_detected_ || !editor_->childCount()) {
+    return;
+  }
+
+  // only once per results, view chosen by user afterwards stays
+  view_detected_ = true;
+  const int index = views_combo_box_->findData(ViewForEncoding(editor_->firstValueEncoding()));
+  if (index != -1) {
+    views_combo_box_->setCurrentIndex(index);
+  }
+}
+
 void FastoTextView::saveChanges() {
   QModelIndex index = editor_->selectedItem(1);  // eValue
   QString qsimplif = editor_->text().simplified();
@@ -99,18 +152,49 @@ void FastoTextView::saveChanges() {
 }
 
 void FastoTextView::textChange() {
-  if (editor_->childCount() != 1) {
+  if (editor_->isRendering()) {
+    return;
+  }
+
+  // partially rendered text must not be saved over the value
+  if (editor_->childCount() != 1 || render_stopped_) {
     save_change_button_->setEnabled(false);
     return;
   }
 
+  // model keeps only preview of the value, so compare against rendered text via dirty flag
   QModelIndex index = editor_->selectedItem(1);  // eValue
-  bool isEnabled = !editor_->isReadOnly() && index.isValid() && (index.flags() & Qt::ItemIsEditable) &&
-                   index.data() != editor_->text().simplified();
+  bool isEnabled = !editor_->isReadOnly() && index.isValid() && (index.flags() & Qt::ItemIsEditable) && text_dirty_;
 
   save_change_button_->setEnabled(isEnabled);
 }
 
+void FastoTextView::textEdit() {
+  if (!editor_->isRendering()) {
+    text_dirty_ = true;
+  }
+  textChange();
+}
+
+void FastoTextView::cancelRender() {
+  render_stopped_ = true;
+  editor_->stopRender();
+}
+
+void FastoTextView::startRender() {
+  text_dirty_ = false;
+  render_stopped_ = false;
+  save_change_button_->setEnabled(false);
+  cancel_render_button_->setEnabled(true);
+  selectDetectedView();
+}
+
+void FastoTextView::finishRender() {
+  text_dirty_ = false;
+  cancel_render_button_->setEnabled(false);
+  textChange();
+}
+
 void FastoTextView::viewChange(int index) {
   QVariant var = views_combo_box_->itemData(index);
   unsigned char view = qvariant_cast<unsigned char>(var);
@@ -127,6 +211,7 @@ void FastoTextView::changeEvent(QEvent* ev) {
 
 void FastoTextView::retranslateUi() {
   save_change_button_->setText(translations::trSaveChanges);
+  cancel_render_button_->setText(translations::trStop);
   views_label_->setText(translations::trViews + ":");
 }
 
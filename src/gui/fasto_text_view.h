@@ -39,18 +39,28 @@ class FastoTextView : public QWidget {
  private Q_SLOTS:
   void viewChange(int index);
   void textChange();
+  void textEdit();
   void saveChanges();
+  void cancelRender();
+  void startRender();
+  void finishRender();
+  void resetDetectedView();
 
  protected:
   virtual void changeEvent(QEvent* ev) override;
 
  private:
   void retranslateUi();
+  void selectDetectedView();
 
   FastoEditorOutput* editor_;
   QLabel* views_label_;
   QComboBox* views_combo_box_;
   QPushButton* save_change_button_;
+  QPushButton* cancel_render_button_;
+  bool text_dirty_;
+  bool render_stopped_;
+  bool view_detected_;  // view was chosen by encoding of current results
 };
 
 }  // namespace gui
@@ -209,7 +209,8 @@ const QIcon& GuiFactory::GetIcon(common::Value::Type type) const {
       return by;
     }
     case common::Value::TYPE_SET:
-    case common::Value::TYPE_ARRAY: {
+    case common::Value::TYPE_ARRAY:
+    case core::CompactArrayValue::TYPE_COMPACT_ARRAY: {
       static QIcon a(":" PROJECT_NAME_LOWERCASE "/images/64x64/array.png");
       return a;
     }
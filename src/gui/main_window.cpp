@@ -58,6 +58,7 @@
 #include "gui/dialogs/about_dialog.h"          // for AboutDialog
 #include "gui/dialogs/connections_dialog.h"    // for ConnectionsDialog
 #include "gui/dialogs/encode_decode_dialog.h"  // for EncodeDecodeDialog
+#include "gui/dialogs/workload_dialog.h"       // for WorkloadDialog
 #include "gui/dialogs/how_to_use_dialog.h"
 #include "gui/dialogs/preferences_dialog.h"     // for PreferencesDialog
 #include "gui/explorer/explorer_tree_widget.h"  // for ExplorerTreeWidget
@@ -185,6 +186,11 @@ MainWindow::MainWindow() : QMainWindow() {
   VERIFY(connect(encode_decode_dialog_action_, &QAction::triggered, this, &MainWindow::openEncodeDecodeDialog));
   tools->addAction(encode_decode_dialog_action_);
 
+  workload_dialog_action_ = new QAction(this);
+  workload_dialog_action_->setIcon(GuiFactory::GetInstance().GetExecuteIcon());
+  VERIFY(connect(workload_dialog_action_, &QAction::triggered, this, &MainWindow::openWorkloadDialog));
+  tools->addAction(workload_dialog_action_);
+
   // window menu
   QMenu* window = new QMenu(this);
   window_action_ = menuBar()->addMenu(window);
@@ -373,6 +379,11 @@ void MainWindow::openEncodeDecodeDialog() {
   dlg.exec();
 }
 
+void MainWindow::openWorkloadDialog() {
+  WorkloadDialog dlg(this);
+  dlg.exec();
+}
+
 void MainWindow::openRecentConnection() {
   QAction* action = qobject_cast<QAction*>(sender());
   if (!action) {
@@ -655,6 +666,7 @@ void MainWindow::retranslateUi() {
   file_action_->setText(translations::trFile);
   tools_action_->setText(translations::trTools);
   encode_decode_dialog_action_->setText(translations::trEncodeDecode);
+  workload_dialog_action_->setText(translations::trWorkload + "...");
   preferences_action_->setText(translations::trPreferences);
   check_update_action_->setText(translations::trCheckUpdate);
   edit_action_->setText(translations::trEdit);
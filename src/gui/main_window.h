@@ -61,6 +61,7 @@ class MainWindow : public QMainWindow {
   void reportBug();
   void enterLeaveFullScreen();
   void openEncodeDecodeDialog();
+  void openWorkloadDialog();
   void openRecentConnection();
 
   void loadConnection();
@@ -109,6 +110,7 @@ class MainWindow : public QMainWindow {
   QAction* check_update_action_;
   QAction* tools_action_;
   QAction* encode_decode_dialog_action_;
+  QAction* workload_dialog_action_;
   QAction* help_action_;
   QAction* explorer_action_;
   QAction* logs_action_;
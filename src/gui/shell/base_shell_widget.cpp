@@ -60,6 +60,9 @@ const QString trAdvancedOptions = QObject::tr("Advanced options");
 const QString trIntervalMsec = QObject::tr("Interval msec:");
 const QString trRepeat = QObject::tr("Repeat:");
 const QString trBasedOn_2S = QObject::tr("Based on <b>%1</b> version: <b>%2</b>");
+const QString trExpensiveQuery = QObject::tr("Expensive query");
+const QString trExecuteExpensiveTemplate_1S =
+    QObject::tr("%1\nContinue from this command (reply will be read page by page)?");
 
 }  // namespace
 
@@ -381,6 +384,7 @@ void BaseShellWidget::execute() {
 void BaseShellWidget::executeArgs(const QString& text, int repeat, int interval, bool history) {
   core::command_buffer_t text_cmd = common::ConvertToString(text);
   proxy::events_info::ExecuteInfoRequest req(this, text_cmd, repeat, interval, history);
+  req.check_cost = true;
   server_->Execute(req);
 }
 
@@ -578,13 +582,28 @@ void BaseShellWidget::startExecute(const proxy::events_info::ExecuteInfoRequest&
   stop_action_->setEnabled(true);
 }
 void BaseShellWidget::finishExecute(const proxy::events_info::ExecuteInfoResponce& res) {
-  UNUSED(res);
-
   repeat_count_->setEnabled(true);
   interval_msec_->setEnabled(true);
   history_call_->setEnabled(true);
   execute_action_->setEnabled(true);
   stop_action_->setEnabled(false);
+
+  if (res.initiator() != this || !res.cost_confirmation_required) {
+    return;
+  }
+
+  common::Error err = res.errorInfo();
+  QString qerr;
+  common::ConvertFromString(err ? err->GetDescription() : std::string(), &qerr);
+  int answer = QMessageBox::question(this, trExpensiveQuery, trExecuteExpensiveTemplate_1S.arg(qerr), QMessageBox::Yes,
+                                     QMessageBox::No, QMessageBox::NoButton);
+  if (answer != QMessageBox::Yes) {
+    return;
+  }
+
+  proxy::events_info::ExecuteInfoRequest req(this, res.text, res.resume_repeat, res.msec_repeat_interval, res.history);
+  req.first_command = res.resume_command;
+  server_->Execute(req);
 }
 
 void BaseShellWidget::serverConnect() {
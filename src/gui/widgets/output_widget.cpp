@@ -20,6 +20,7 @@
 
 #include <QHBoxLayout>
 #include <QHeaderView>
+#include <QLabel>
 #include <QPushButton>
 #include <QSplitter>
 
@@ -27,6 +28,9 @@
 #include <common/qt/convert2string.h>
 #include <common/qt/gui/icon_label.h>  // for IconLabel
 #include <common/qt/logger.h>
+#include <common/time.h>  // for current_mstime
+
+#include "core/icommand_translator.h"  // for HasStreamingCommand
 
 #include "proxy/server/iserver.h"    // for IServer
 #include "proxy/settings_manager.h"  // for SettingsManager
@@ -39,6 +43,13 @@
 #include "gui/gui_factory.h"         // for GuiFactory
 #include "gui/widgets/type_delegate.h"
 
+#define RESULTS_LABEL_UPDATE_MSEC 500
+
+namespace {
+const QString trResultsTotal = QObject::tr("Results: %1, %2/sec");
+const QString trResultsWindow = QObject::tr("Results: %1 (last %2 shown), %3/sec");
+}
+
 namespace fastonosql {
 namespace gui {
 namespace {
@@ -63,7 +74,7 @@ FastoCommonItem* CreateItem(common::qt::gui::TreeItem* parent,
   core::NValue value = item->GetValue();
   core::key_t raw_key(key);
   core::NDbKValue nkey(core::NKey(raw_key), value);
-  return new FastoCommonItem(nkey, item->GetDelimiter(), readOnly, parent, item);
+  return new FastoCommonItem(nkey, item->GetDelimiter(), readOnly, parent, item, item->GetValueEncoding());
 }
 
 FastoCommonItem* CreateRootItem(core::FastoObject* item) {
@@ -71,12 +82,18 @@ FastoCommonItem* CreateRootItem(core::FastoObject* item) {
   core::key_t raw_key;
   core::NKey nk(raw_key);
   core::NDbKValue nkey(nk, value);
-  return new FastoCommonItem(nkey, item->GetDelimiter(), true, nullptr, item);
+  return new FastoCommonItem(nkey, item->GetDelimiter(), true, nullptr, item, item->GetValueEncoding());
 }
 
 }  // namespace
 
-OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget(parent), server_(server) {
+OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent)
+    : QWidget(parent),
+      results_total_(0),
+      results_limit_(0),
+      results_start_ts_(0),
+      results_label_ts_(0),
+      server_(server) {
   CHECK(server_);
 
   common_model_ = new FastoCommonModel(this);
@@ -114,6 +131,8 @@ OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget
   text_view_->setModel(common_model_);
 
   time_label_ = new common::qt::gui::IconLabel(GuiFactory::GetInstance().GetTimeIcon(), QSize(32, 32), "0");
+  results_label_ = new QLabel;
+  results_label_->setVisible(false);
 
   QVBoxLayout* mainL = new QVBoxLayout;
   QHBoxLayout* topL = new QHBoxLayout;
@@ -132,6 +151,7 @@ OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget
   topL->addWidget(table_button_);
   topL->addWidget(text_button_);
   topL->addWidget(new QSplitter(Qt::Horizontal));
+  topL->addWidget(results_label_);
   topL->addWidget(time_label_);
 
   mainL->addLayout(topL);
@@ -145,10 +165,21 @@ OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget
 void OutputWidget::rootCreate(const proxy::events_info::CommandRootCreatedInfo& res) {
   core::FastoObject* root_obj = res.root.get();
   fastonosql::gui::FastoCommonItem* root = CreateRootItem(root_obj);
-  common_model_->setRoot(root);
+  // only streaming commands are windowed, other replies are shown whole
+  std::string input;
+  const bool streaming = root_obj->GetValue()->GetAsString(&input) && core::HasStreamingCommand(input);
+  results_limit_ = streaming ? proxy::SettingsManager::GetInstance()->GetOutputRingSize() : 0;
+  results_total_ = 0;
+  results_start_ts_ = common::time::current_mstime();
+  results_label_ts_ = results_start_ts_;
+  results_label_->setVisible(false);
+  common_model_->setRootChildrenLimit(results_limit_);
+  common_model_->setRootItem(root);
 }
 
 void OutputWidget::rootCompleate(const proxy::events_info::CommandRootCompleatedInfo& res) {
+  common_model_->flushPendingItems();
+  updateResultsLabel(true);
   updateTimeLabel(res);
 }
 
@@ -187,46 +218,18 @@ void OutputWidget::addChild(core::FastoObjectIPtr child) {
   core::FastoObject* arr = dynamic_cast<core::FastoObject*>(child->GetParent());  // +
   CHECK(arr);
 
-  QModelIndex parent;
-  bool isFound = common_model_->findItem(arr, &parent);
-  if (!isFound) {
-    return;
-  }
-
-  fastonosql::gui::FastoCommonItem* par = nullptr;
-  if (!parent.isValid()) {
-    par = static_cast<fastonosql::gui::FastoCommonItem*>(common_model_->root());
-  } else {
-    par = common::qt::item<common::qt::gui::TreeItem*, fastonosql::gui::FastoCommonItem*>(parent);
-  }
-
+  fastonosql::gui::FastoCommonItem* par = common_model_->findObjectItem(arr);
   if (!par) {
-    DNOTREACHED();
     return;
   }
 
   fastonosql::gui::FastoCommonItem* comChild = CreateItem(par, core::command_buffer_t(), true, child.get());
-  common_model_->insertItem(parent, comChild);
+  common_model_->appendItem(par, comChild);
 }
 
 void OutputWidget::addCommand(core::FastoObjectCommand* command, core::FastoObject* child) {
-  void* parentinner = command->GetParent();
-
-  QModelIndex parent;
-  bool isFound = common_model_->findItem(parentinner, &parent);
-  if (!isFound) {
-    return;
-  }
-
-  fastonosql::gui::FastoCommonItem* par = nullptr;
-  if (!parent.isValid()) {
-    par = static_cast<fastonosql::gui::FastoCommonItem*>(common_model_->root());
-  } else {
-    par = common::qt::item<common::qt::gui::TreeItem*, fastonosql::gui::FastoCommonItem*>(parent);
-  }
-
+  fastonosql::gui::FastoCommonItem* par = common_model_->findObjectItem(command->GetParent());
   if (!par) {
-    DNOTREACHED();
     return;
   }
 
@@ -239,24 +242,20 @@ void OutputWidget::addCommand(core::FastoObjectCommand* command, core::FastoObje
   } else {
     common_child = CreateItem(par, input_cmd, true, child);
   }
-  common_model_->insertItem(parent, common_child);
+  common_model_->appendItem(par, common_child);
+  results_total_++;
+  updateResultsLabel(false);
 }
 
 void OutputWidget::updateItem(core::FastoObject* item, common::ValueSPtr newValue) {
-  QModelIndex index;
-  bool isFound = common_model_->findItem(item, &index);
-  if (!isFound) {
-    return;
-  }
-
-  FastoCommonItem* it = common::qt::item<common::qt::gui::TreeItem*, FastoCommonItem*>(index);
+  FastoCommonItem* it = common_model_->findObjectItem(item);
   if (!it) {
     return;
   }
 
   core::NValue nval = newValue;
-  it->setValue(nval);
-  common_model_->updateItem(index.parent(), index);
+  it->setValue(nval, item->GetValueEncoding());
+  common_model_->updateObjectItem(item);
 }
 
 void OutputWidget::createKey(const core::NDbKValue& dbv) {
@@ -308,5 +307,28 @@ void OutputWidget::updateTimeLabel(const proxy::events_info::EventInfoBase& evin
   time_label_->setText(msec_template.arg(evinfo.ElapsedTime()));
 }
 
+void OutputWidget::updateResultsLabel(bool force) {
+  // shown only for streaming output, label is throttled for fast streams
+  if (results_total_ <= 1) {
+    return;
+  }
+
+  const common::time64_t cur_ts = common::time::current_mstime();
+  if (!force && cur_ts - results_label_ts_ < RESULTS_LABEL_UPDATE_MSEC) {
+    return;
+  }
+
+  results_label_ts_ = cur_ts;
+  const common::time64_t elapsed = cur_ts - results_start_ts_;
+  const double rate = elapsed > 0 ? results_total_ * 1000.0 / elapsed : 0.0;
+  const QString qrate = QString::number(rate, 'f', 1);
+  if (results_limit_ && results_total_ > results_limit_) {
+    results_label_->setText(trResultsWindow.arg(results_total_).arg(results_limit_).arg(qrate));
+  } else {
+    results_label_->setText(trResultsTotal.arg(results_total_).arg(qrate));
+  }
+  results_label_->setVisible(true);
+}
+
 }  // namespace gui
 }  // namespace fastonosql
@@ -25,6 +25,7 @@
 
 #include "core/global.h"  // for FastoObject, etc
 
+class QLabel;
 class QPushButton;  // lines 27-27
 class QTreeView;
 class QTableView;
@@ -80,7 +81,14 @@ class OutputWidget : public QWidget {
  private:
   void syncWithSettings();
   void updateTimeLabel(const proxy::events_info::EventInfoBase& evinfo);
+  void updateResultsLabel(bool force);
+
   common::qt::gui::IconLabel* time_label_;
+  QLabel* results_label_;
+  size_t results_total_;
+  size_t results_limit_;
+  common::time64_t results_start_ts_;
+  common::time64_t results_label_ts_;
   QPushButton* tree_button_;
   QPushButton* table_button_;
   QPushButton* text_button_;
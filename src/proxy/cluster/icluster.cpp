@@ -31,7 +31,17 @@
 namespace fastonosql {
 namespace proxy {
 
-ICluster::ICluster(const std::string& name) : name_(name) {}
+ICluster::ContentInfo::ContentInfo() : keys(), db_keys_count(0), finished(false), err() {}
+
+ICluster::NodeScanState::NodeScanState(node_t node) : node(node), cursor(0), db_keys_count(0), finished(false) {}
+
+ICluster::ICluster(const std::string& name) : name_(name), nodes_(), scan_states_(), scan_waiting_(0), content_() {}
+
+ICluster::~ICluster() {
+  for (auto node : nodes_) {
+    node->cluster_ = nullptr;
+  }
+}
 
 std::string ICluster::GetName() const {
   return name_;
@@ -43,6 +53,9 @@ ICluster::nodes_t ICluster::GetNodes() const {
 
 void ICluster::AddServer(node_t serv) {
   VERIFY(QObject::connect(serv.get(), &IServer::RedirectRequested, this, &ICluster::RedirectRequest));
+  VERIFY(QObject::connect(serv.get(), &IServer::ExecuteFinished, this, &ICluster::FinishExecute));
+  VERIFY(QObject::connect(serv.get(), &IServer::LoadDatabaseContentFinished, this, &ICluster::FinishLoadNodeContent));
+  serv->cluster_ = this;
   nodes_.push_back(serv);
 }
 
@@ -58,24 +71,167 @@ ICluster::node_t ICluster::GetRoot() const {
   return node_t();
 }
 
-void ICluster::RedirectRequest(const common::net::HostAndPortAndSlot& host,
-                               const events_info::ExecuteInfoRequest& req) {
+void ICluster::LoadContent(const std::string& pattern,
+                           size_t count_keys,
+                           const core::KeysFilter& filter,
+                           bool from_start) {
+  if (IsContentLoading()) {
+    return;
+  }
+
+  if (from_start || scan_states_.empty()) {
+    scan_states_.clear();
+    for (auto node : nodes_) {
+      IServerRemote* rserver = dynamic_cast<IServerRemote*>(node.get());  // +
+      if (rserver && rserver->GetRole() == core::MASTER && rserver->IsConnected()) {
+        scan_states_.push_back(NodeScanState(node));
+      }
+    }
+  }
+
+  content_ = ContentInfo();
+  for (NodeScanState& state : scan_states_) {
+    if (state.finished) {
+      continue;
+    }
+
+    IServer::database_t db = state.node->GetCurrentDatabaseInfo();
+    if (!db) {
+      state.finished = true;
+      continue;
+    }
+
+    scan_waiting_++;
+    events_info::LoadDatabaseContentRequest req(this, db, pattern, count_keys, state.cursor);
+    req.filter = filter;
+    state.node->LoadDatabaseContent(req);
+  }
+
+  if (scan_waiting_ == 0) {
+    FinishLoadContent();
+  }
+}
+
+bool ICluster::IsContentLoading() const {
+  return scan_waiting_ != 0;
+}
+
+ICluster::node_t ICluster::FindNode(const common::net::HostAndPort& host) const {
   for (auto node : nodes_) {
     IServerRemote* rserver = dynamic_cast<IServerRemote*>(node.get());  // +
-    if (!rserver) {
+    if (rserver && rserver->GetHost() == host) {
+      return node;
+    }
+  }
+
+  return node_t();
+}
+
+ICluster::node_t ICluster::FindNode(IServer* server) const {
+  for (auto node : nodes_) {
+    if (node.get() == server) {
+      return node;
+    }
+  }
+
+  return node_t();
+}
+
+bool ICluster::RouteExecute(IServer* node, const events_info::ExecuteInfoRequest& req) {
+  UNUSED(node);
+  UNUSED(req);
+  return false;
+}
+
+void ICluster::StopExecute(IServer* node) {
+  UNUSED(node);
+}
+
+void ICluster::HandleRedirect(const common::net::HostAndPortAndSlot& host) {
+  UNUSED(host);
+}
+
+void ICluster::HandleExecuteFinished(IServer* node, const events_info::ExecuteInfoResponce& res) {
+  UNUSED(node);
+  UNUSED(res);
+}
+
+void ICluster::ExecuteDirect(IServer* node, const events_info::ExecuteInfoRequest& req) {
+  node->ExecuteDirect(req);
+}
+
+void ICluster::FinishExecute(const events_info::ExecuteInfoResponce& res) {
+  if (res.initiator() != this) {
+    return;
+  }
+
+  IServer* node = qobject_cast<IServer*>(sender());
+  if (node) {
+    HandleExecuteFinished(node, res);
+  }
+}
+
+void ICluster::FinishLoadNodeContent(const events_info::LoadDatabaseContentResponce& res) {
+  if (res.initiator() != this || scan_waiting_ == 0) {
+    return;
+  }
+
+  QObject* node = sender();
+  for (NodeScanState& state : scan_states_) {
+    if (state.node.get() != node) {
       continue;
     }
 
-    common::net::HostAndPort server_host = rserver->GetHost();
-    if (server_host == host) {
-      proxy::events_info::ConnectInfoRequest connect_req(this);
-      rserver->Connect(connect_req);
-      events_info::ExecuteInfoRequest exec_req(req.initiator(), req.text, req.repeat, req.msec_repeat_interval,
-                                               req.history, req.silence, req.logtype);
-      rserver->Execute(exec_req);
-      return;
+    common::Error err = res.errorInfo();
+    if (err) {
+      if (!content_.err) {
+        content_.err = err;
+      }
+      state.finished = true;
+    } else {
+      content_.keys.insert(content_.keys.end(), res.keys.begin(), res.keys.end());
+      state.cursor = res.cursor_out;
+      state.db_keys_count = res.db_keys_count;
+      state.finished = res.cursor_out == 0;
+    }
+    break;
+  }
+
+  if (--scan_waiting_ == 0) {
+    FinishLoadContent();
+  }
+}
+
+void ICluster::FinishLoadContent() {
+  content_.finished = true;
+  for (const NodeScanState& state : scan_states_) {
+    content_.db_keys_count += state.db_keys_count;
+    if (!state.finished) {
+      content_.finished = false;
     }
   }
+
+  emit ContentLoaded(content_);
+}
+
+void ICluster::RedirectRequest(const common::net::HostAndPortAndSlot& host,
+                               const events_info::ExecuteInfoRequest& req) {
+  node_t node = FindNode(host);
+  if (!node) {
+    return;
+  }
+
+  HandleRedirect(host);
+  if (req.initiator() == this) {
+    return;  // routed part, resent by cluster
+  }
+  proxy::events_info::ConnectInfoRequest connect_req(this);
+  node->Connect(connect_req);
+  events_info::ExecuteInfoRequest exec_req(req.initiator(), req.text, req.repeat, req.msec_repeat_interval,
+                                           req.history, req.silence, req.logtype);
+  exec_req.check_cost = req.check_cost;
+  exec_req.first_command = req.first_command;
+  node->Execute(exec_req);
 }
 
 }  // namespace proxy
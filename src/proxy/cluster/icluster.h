@@ -28,25 +28,76 @@ namespace fastonosql {
 namespace proxy {
 
 class ICluster : public IServerBase {
+  Q_OBJECT
  public:
   typedef IServerSPtr node_t;
   typedef std::vector<node_t> nodes_t;
 
+  struct ContentInfo {  // merged page of all masters
+    ContentInfo();
+
+    std::vector<core::NDbKValue> keys;
+    size_t db_keys_count;  // sum of masters DBSIZE
+    bool finished;         // all masters cursors returned to zero
+    common::Error err;     // first node error
+  };
+
+  virtual ~ICluster();
+
   virtual std::string GetName() const override;
   nodes_t GetNodes() const;
   void AddServer(node_t serv);
 
   node_t GetRoot() const;
 
+  // called by node before executing request of user, true if cluster took request over
+  virtual bool RouteExecute(IServer* node, const events_info::ExecuteInfoRequest& req);
+  virtual void StopExecute(IServer* node);  // stop routed requests of node
+
+  // SCAN fan out to every connected master, each node scanned by own driver thread,
+  // per node cursors kept between pages
+  void LoadContent(const std::string& pattern,
+                   size_t count_keys,
+                   const core::KeysFilter& filter,
+                   bool from_start);  // signals: ContentLoaded
+  bool IsContentLoading() const;
+
+ Q_SIGNALS:
+  void ContentLoaded(const ICluster::ContentInfo& content);
+
  private Q_SLOTS:
   void RedirectRequest(const common::net::HostAndPortAndSlot& host, const events_info::ExecuteInfoRequest& req);
+  void FinishExecute(const events_info::ExecuteInfoResponce& res);
+  void FinishLoadNodeContent(const events_info::LoadDatabaseContentResponce& res);
 
  protected:
   explicit ICluster(const std::string& name);
 
+  node_t FindNode(const common::net::HostAndPort& host) const;
+  node_t FindNode(IServer* server) const;
+  virtual void HandleRedirect(const common::net::HostAndPortAndSlot& host);  // before request reexecuted on host
+  // requests of cluster executed by node
+  virtual void HandleExecuteFinished(IServer* node, const events_info::ExecuteInfoResponce& res);
+  void ExecuteDirect(IServer* node, const events_info::ExecuteInfoRequest& req);  // without routing
+
  private:
+  struct NodeScanState {
+    explicit NodeScanState(node_t node);
+
+    node_t node;
+    uint64_t cursor;
+    size_t db_keys_count;
+    bool finished;
+  };
+
+  void FinishLoadContent();
+
   const std::string name_;
   nodes_t nodes_;
+
+  std::vector<NodeScanState> scan_states_;
+  size_t scan_waiting_;
+  ContentInfo content_;
 };
 
 }  // namespace proxy
@@ -56,5 +56,15 @@ core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& inp
   return new Command(nullptr, cmd, ct, std::string());
 }
 
+template <typename Command>
+core::FastoObjectCommandIPtr CreateCommandFast(const core::TypedCommand& input, core::CmdLoggingType ct) {
+  if (input.IsEmpty()) {
+    DNOTREACHED();
+    return nullptr;
+  }
+
+  return new Command(nullptr, input, ct, std::string());
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
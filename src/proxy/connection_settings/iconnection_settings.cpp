@@ -28,6 +28,8 @@
 
 #include "proxy/settings_manager.h"
 
+#define OUTPUT_SPILL_FILE_EXTENSION ".output"
+
 #ifdef BUILD_WITH_REDIS
 #define LOGGING_REDIS_FILE_EXTENSION ".red"
 #endif
@@ -227,6 +229,10 @@ std::string IConnectionSettingsBase::GetLoggingPath() const {
   return std::string();
 }
 
+std::string IConnectionSettingsBase::GetOutputSpillPath() const {
+  return GetLoggingPath() + OUTPUT_SPILL_FILE_EXTENSION;
+}
+
 std::string IConnectionSettingsBase::ToString() const {
   return IConnectionSettings::ToString() + setting_value_delemitr + GetCommandLine();
 }
@@ -95,6 +95,7 @@ class IConnectionSettingsBase : public IConnectionSettings {
   std::string GetHash() const;
 
   std::string GetLoggingPath() const;
+  std::string GetOutputSpillPath() const;  // evicted streaming output
 
   void SetConnectionPathAndUpdateHash(const connection_path_t& name);
 
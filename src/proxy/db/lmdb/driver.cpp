@@ -131,6 +131,19 @@ common::Error Driver::GetCurrentDataBaseInfo(core::IDataBaseInfo** info) {
   return impl_->Select(impl_->GetCurrentDBName(), info);
 }
 
+common::Error Driver::ScanFilteredKeys(const events_info::LoadDatabaseContentRequest& req,
+                                       std::vector<std::string>* keys_out,
+                                       uint64_t* cursor_out,
+                                       size_t* db_keys_count) {
+  common::Error err =
+      impl_->ScanFiltered(req.cursor_in, req.pattern, req.count_keys, req.filter, keys_out, cursor_out);
+  if (err) {
+    return err;
+  }
+
+  return impl_->DBkcount(db_keys_count);
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
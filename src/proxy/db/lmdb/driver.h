@@ -68,6 +68,10 @@ class Driver : public IDriverLocal {
   virtual common::Error GetServerLoadedModules(std::vector<core::ModuleInfo>* modules) override;
   virtual common::Error GetCurrentDataBaseInfo(core::IDataBaseInfo** info) override;
 
+  virtual common::Error ScanFilteredKeys(const events_info::LoadDatabaseContentRequest& req,
+                                         std::vector<std::string>* keys_out,
+                                         uint64_t* cursor_out,
+                                         size_t* db_keys_count) override;
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
 
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override;
@@ -28,6 +28,12 @@ Command::Command(core::FastoObject* parent,
                  const std::string& delimiter)
     : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::PIKA) {}
 
+Command::Command(core::FastoObject* parent,
+                 const core::TypedCommand& cmd,
+                 core::CmdLoggingType ct,
+                 const std::string& delimiter)
+    : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::PIKA) {}
+
 }  // namespace pika
 }  // namespace proxy
 }  // namespace fastonosql
@@ -27,6 +27,10 @@ namespace pika {
 class Command : public core::FastoObjectCommand {
  public:
   Command(core::FastoObject* parent, common::StringValue* cmd, core::CmdLoggingType ct, const std::string& delimiter);
+  Command(core::FastoObject* parent,
+          const core::TypedCommand& cmd,
+          core::CmdLoggingType ct,
+          const std::string& delimiter);
 };
 
 }  // namespace pika
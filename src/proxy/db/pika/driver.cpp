@@ -18,6 +18,8 @@
 
 #include "proxy/db/pika/driver.h"
 
+#include <algorithm>  // for min
+
 #include <common/convert2string.h>           // for ConvertFromString, etc
 #include <common/file_system/file_system.h>  // for copy_file
 
@@ -31,7 +33,6 @@
 #include "proxy/db/pika/command.h"              // for Command
 #include "proxy/db/pika/connection_settings.h"  // for ConnectionSettings
 
-#define REDIS_TYPE_COMMAND "TYPE"
 #define REDIS_SHUTDOWN_COMMAND "SHUTDOWN"
 #define REDIS_BACKUP_COMMAND "SAVE"
 #define REDIS_SET_PASSWORD_COMMAND "CONFIG SET requirepass"
@@ -39,6 +40,7 @@
 #define REDIS_GET_PROPERTY_SERVER_COMMAND "CONFIG GET *"
 #define REDIS_PUBSUB_CHANNELS_COMMAND "PUBSUB CHANNELS"
 #define REDIS_PUBSUB_NUMSUB_COMMAND "PUBSUB NUMSUB"
+#define REDIS_NUMSUB_CHANNELS_PER_COMMAND 512
 
 #define REDIS_SET_DEFAULT_DATABASE_COMMAND_1ARGS_S "SELECT %s"
 
@@ -116,6 +118,10 @@ core::FastoObjectCommandIPtr Driver::CreateCommandFast(const core::command_buffe
   return proxy::CreateCommandFast<Command>(input, ct);
 }
 
+core::FastoObjectCommandIPtr Driver::CreateCommandFast(const core::TypedCommand& input, core::CmdLoggingType ct) {
+  return proxy::CreateCommandFast<Command>(input, ct);
+}
+
 core::IDataBaseInfoSPtr Driver::CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) {
   return std::make_shared<core::redis_compatible::DataBaseInfo>(name, is_default, size);
 }
@@ -134,6 +140,10 @@ common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::F
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) {
+  return impl_->Execute(argv, out);
+}
+
 common::Error Driver::GetCurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(DB_INFO_COMMAND, core::C_INNER);
   common::Error err = Execute(cmd.get());
@@ -210,15 +220,21 @@ void Driver::HandleRestoreEvent(events::RestoreRequestEvent* ev) {
   NotifyProgress(sender, 100);
 }
 
+void Driver::HandleLoadFilteredDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
+  HandleLoadDatabaseContentEvent(ev);  // type and TTL of every scanned key are loaded anyway, filter applied to them
+}
+
 void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
-  const core::command_buffer_t pattern_result =
-      core::internal::GetKeysPattern(res.cursor_in, res.pattern, res.count_keys);
-  core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
+  auto tran = std::static_pointer_cast<core::redis_compatible::CommandTranslator>(impl_->GetTranslator());
+  core::TypedCommand scan_cmd;
+  common::Error err = tran->Scan(res.cursor_in, res.pattern, res.count_keys, &scan_cmd);
+  DCHECK(!err);
+  core::FastoObjectCommandIPtr cmd = CreateCommandFast(scan_cmd, core::C_INNER);
   NotifyProgress(sender, 50);
-  common::Error err = Execute(cmd);
+  err = Execute(cmd);
   if (err) {
     res.setErrorInfo(err);
   } else {
@@ -260,13 +276,15 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
           core::key_t key_str(key);
           core::NKey k(key_str);
           core::NDbKValue dbv(k, core::NValue());
-          core::command_buffer_writer_t wr_type;
-          wr_type << REDIS_TYPE_COMMAND " " << key_str.GetForCommandLine();
-          cmds.push_back(CreateCommandFast(wr_type.str(), core::C_INNER));
-
-          core::command_buffer_writer_t wr_ttl;
-          wr_ttl << DB_GET_TTL_COMMAND " " << key_str.GetForCommandLine();
-          cmds.push_back(CreateCommandFast(wr_ttl.str(), core::C_INNER));
+          core::TypedCommand type_cmd;
+          err = tran->Type(k, &type_cmd);
+          DCHECK(!err);
+          cmds.push_back(CreateCommandFast(type_cmd, core::C_INNER));
+
+          core::TypedCommand ttl_cmd;
+          err = tran->TTL(k, &ttl_cmd);
+          DCHECK(!err);
+          cmds.push_back(CreateCommandFast(ttl_cmd, core::C_INNER));
           res.keys.push_back(dbv);
         }
       }
@@ -276,6 +294,9 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
         goto done;
       }
 
+      // pika has neither SCAN TYPE nor MEMORY USAGE, so only type and TTL filters are applied here
+      const core::KeysFilter& filter = res.filter;
+      events::LoadDatabaseContentResponceEvent::value_type::keys_container_t filtered_keys;
       for (size_t i = 0; i < res.keys.size(); ++i) {
         core::FastoObjectIPtr cmdType = cmds[i * 2];
         core::FastoObject::childs_t tchildrens = cmdType->GetChildrens();
@@ -303,6 +324,16 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
             }
           }
         }
+
+        const core::NDbKValue& dbv = res.keys[i];
+        core::NValue val = dbv.GetValue();
+        if (val && filter.IsTypeAllowed(val->GetType()) && filter.IsTTLAllowed(dbv.GetKey().GetTTL())) {
+          filtered_keys.push_back(dbv);
+        }
+      }
+
+      if (!filter.IsEmpty()) {
+        res.keys = filtered_keys;
       }
 
       err = impl_->DBkcount(&res.db_keys_count);
@@ -385,62 +416,72 @@ void Driver::HandleLoadServerChannelsRequestEvent(events::LoadServerChannelsRequ
       auto array_value = array->GetValue();
       common::ArrayValue* arm = nullptr;
       if (!array_value->GetAsList(&arm) || !arm->GetSize()) {
-        goto done;
+        goto sample;  // channels may appear while sampling
       }
 
-      std::vector<core::FastoObjectCommandIPtr> cmds;
-      cmds.reserve(arm->GetSize());
       for (size_t i = 0; i < arm->GetSize(); ++i) {
         std::string channel;
         bool isok = arm->GetString(i, &channel);
         if (isok) {
-          core::command_buffer_writer_t wr2;
-          wr2 << REDIS_PUBSUB_NUMSUB_COMMAND " " << channel;
-          core::NDbPSChannel c(channel, 0);
-          cmds.push_back(CreateCommandFast(wr2.str(), core::C_INNER));
-          res.channels.push_back(c);
+          res.channels.push_back(core::NDbPSChannel(channel, 0));
         }
       }
 
+      // many channels per NUMSUB, all chunks in one pipeline
+      std::vector<core::FastoObjectCommandIPtr> cmds;
+      for (size_t i = 0; i < res.channels.size(); i += REDIS_NUMSUB_CHANNELS_PER_COMMAND) {
+        const size_t end = std::min<size_t>(res.channels.size(), i + REDIS_NUMSUB_CHANNELS_PER_COMMAND);
+        core::TypedCommand numsub_cmd(REDIS_PUBSUB_NUMSUB_COMMAND);
+        for (size_t j = i; j < end; ++j) {
+          numsub_cmd << res.channels[j].GetName();
+        }
+        cmds.push_back(CreateCommandFast(numsub_cmd, core::C_INNER));
+      }
+
       err = impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
       if (err) {
         res.setErrorInfo(err);
         goto done;
       }
 
-      for (size_t i = 0; i < res.channels.size(); ++i) {
-        core::FastoObjectIPtr subCount = cmds[i];
-        core::FastoObject::childs_t tchildrens = subCount->GetChildrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            core::FastoObject* array_sub = tchildrens[0].get();
-            auto arr_value = array_sub->GetValue();
-            common::ArrayValue* array_sub_inner = nullptr;
-            if (arr_value->GetAsList(&array_sub_inner)) {
-              common::Value* fund_sub = nullptr;
-              if (array_sub_inner->Get(1, &fund_sub)) {
-                common::Value::Type t = fund_sub->GetType();
-                if (t == common::Value::TYPE_LONG_LONG_INTEGER) {
-                  long long lsub;
-                  if (fund_sub->GetAsLongLongInteger(&lsub)) {
-                    res.channels[i].SetNumberOfSubscribers(lsub);
-                  }
-                } else if (t == common::Value::TYPE_STRING) {
-                  std::string lsub_str;
-                  long long lsub;
-                  if (fund_sub->GetAsString(&lsub_str) && common::ConvertFromString(lsub_str, &lsub)) {
-                    res.channels[i].SetNumberOfSubscribers(lsub);
-                  }
-                }
-              }
-            }
+      for (size_t i = 0; i < cmds.size(); ++i) {
+        core::FastoObject::childs_t tchildrens = cmds[i]->GetChildrens();
+        if (tchildrens.size() != 1) {
+          continue;
+        }
+
+        auto arr_value = tchildrens[0]->GetValue();
+        common::ArrayValue* array_sub_inner = nullptr;
+        if (!arr_value->GetAsList(&array_sub_inner)) {
+          continue;
+        }
+
+        // channel1 count1 channel2 count2 ...
+        const size_t offset = i * REDIS_NUMSUB_CHANNELS_PER_COMMAND;
+        for (size_t j = 0; j * 2 + 1 < array_sub_inner->GetSize() && offset + j < res.channels.size(); ++j) {
+          common::Value* fund_sub = nullptr;
+          long long lsub;
+          if (array_sub_inner->Get(j * 2 + 1, &fund_sub) &&
+              core::redis_compatible::GetNumberOfSubscribers(fund_sub, &lsub)) {
+            res.channels[offset + j].SetNumberOfSubscribers(lsub);
           }
         }
       }
     }
   }
 
+sample:
+  if (res.sample_seconds) {  // on this connection, so interrupt of driver stops it
+    core::redis_compatible::channels_traffic_t traffic;
+    err = impl_->SampleChannels(res.pattern, res.sample_seconds, &traffic);
+    if (err) {
+      res.setErrorInfo(err);
+      goto done;
+    }
+
+    core::redis_compatible::SetChannelsTraffic(traffic, res.sample_seconds, &res.channels);
+  }
+
 done:
   NotifyProgress(sender, 75);
   Reply(sender, new events::LoadServerChannelsResponceEvent(this, res));
@@ -56,6 +56,7 @@ class Driver : public IDriverRemote {
 
   virtual core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& input,
                                                          core::CmdLoggingType ct) override;
+  core::FastoObjectCommandIPtr CreateCommandFast(const core::TypedCommand& input, core::CmdLoggingType ct);
 
   virtual core::IDataBaseInfoSPtr CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) override;
 
@@ -63,6 +64,7 @@ class Driver : public IDriverRemote {
   virtual common::Error SyncDisconnect() override WARN_UNUSED_RESULT;
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) override;
+  virtual common::Error ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) override;
 
   virtual common::Error GetCurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error GetServerCommands(std::vector<const core::CommandInfo*>* commands) override;
@@ -76,6 +78,7 @@ class Driver : public IDriverRemote {
   virtual void HandleRestoreEvent(events::RestoreRequestEvent* ev) override;
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
+  virtual void HandleLoadFilteredDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
 
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override;
 
@@ -28,6 +28,12 @@ Command::Command(core::FastoObject* parent,
                  const std::string& delimiter)
     : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::REDIS) {}
 
+Command::Command(core::FastoObject* parent,
+                 const core::TypedCommand& cmd,
+                 core::CmdLoggingType ct,
+                 const std::string& delimiter)
+    : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::REDIS) {}
+
 }  // namespace redis
 }  // namespace proxy
 }  // namespace fastonosql
@@ -34,7 +34,9 @@ namespace proxy {
 namespace redis {
 
 Server::Server(IConnectionSettingsBaseSPtr settings)
-    : IServerRemote(new Driver(settings)), role_(core::MASTER), mode_(core::STANDALONE) {
+    : IServerRemote(new Driver(settings), new Driver(settings), new Driver(settings), new Driver(settings)),
+      role_(core::MASTER),
+      mode_(core::STANDALONE) {
   StartCheckKeyExistTimer();
 }
 
@@ -18,12 +18,294 @@
 
 #include "proxy/db/redis_compatible/cluster.h"
 
+#include <common/error.h>  // for make_error
+
+#include "proxy/server/iserver.h"  // for IServer
+
+#define CLUSTER_SLOTS "CLUSTER SLOTS"
+#define MAX_REDIRECTS 16
+
 namespace fastonosql {
 namespace proxy {
 namespace redis_compatible {
 
-Cluster::Cluster(const std::string& name) : ICluster(name) {}
+namespace {
+
+core::FastoObject::value_t GetReply(core::FastoObjectCommandIPtr command) {
+  core::FastoObject::childs_t childrens = command->GetChildrens();
+  if (childrens.empty()) {
+    return core::FastoObject::value_t(common::Value::CreateNullValue());
+  }
+
+  return childrens[0]->GetValue();
+}
+
+}  // namespace
+
+Cluster::RoutedRequest::RoutedRequest(node_t origin, const events_info::ExecuteInfoRequest& req)
+    : origin(origin),
+      req(req),
+      commands(),
+      command(0),
+      part(0),
+      executing(),
+      sent(0),
+      redirects(0),
+      stopped(false) {}
+
+Cluster::Cluster(const std::string& name)
+    : ICluster(name), slots_(), slots_loading_(false), slots_loaded_(false), requests_() {}
+
+bool Cluster::RouteExecute(IServer* node, const events_info::ExecuteInfoRequest& req) {
+  node_t origin = FindNode(node);
+  if (!origin || req.repeat != 0) {  // repeats keep order on one node
+    return false;
+  }
+
+  std::vector<core::command_buffer_t> commands;
+  common::Error err = core::ParseCommands(req.text, &commands);
+  core::translator_t tran = origin->GetTranslator();
+  if (err || !tran) {  // errors reported by node
+    return false;
+  }
+
+  RoutedRequest request(origin, req);
+  for (size_t i = req.first_command; i < commands.size(); ++i) {
+    RoutedCommand routed;
+    err = core::redis_compatible::SplitCommandBySlots(tran.get(), commands[i], &routed.parts);
+    if (err) {
+      routed.parts.assign(1, core::redis_compatible::SlotCommand());
+      routed.parts[0].command = commands[i];
+    }
+    request.commands.push_back(routed);
+  }
+
+  if (requests_.empty() && slots_loaded_ && IsLocal(request)) {
+    return false;
+  }
+
+  requests_.push_back(request);
+  if (!slots_loaded_) {
+    LoadSlots(origin);
+    return true;
+  }
+
+  if (requests_.size() == 1) {
+    RunRequests();
+  }
+  return true;
+}
+
+void Cluster::StopExecute(IServer* node) {
+  for (RoutedRequest& request : requests_) {
+    if (request.origin.get() != node || request.stopped) {
+      continue;
+    }
+
+    request.stopped = true;
+    if (request.executing) {
+      request.executing->StopCurrentEvent();
+    }
+  }
+
+  if (!requests_.empty() && requests_.front().stopped && !requests_.front().executing && slots_loaded_) {
+    FinishRequest(common::make_error(common::COMMON_EINTR));
+  }
+}
+
+void Cluster::HandleRedirect(const common::net::HostAndPortAndSlot& host) {
+  slots_.SetSlotOwner(host.GetSlot(), host);
+}
+
+void Cluster::HandleExecuteFinished(IServer* node, const events_info::ExecuteInfoResponce& res) {
+  common::Error err = res.errorInfo();
+  if (slots_loading_ && res.text == CLUSTER_SLOTS) {
+    slots_loading_ = false;
+    slots_loaded_ = true;
+    common::ArrayValue* reply = nullptr;
+    if (!err && !res.executed.empty()) {
+      core::FastoObject::value_t value = GetReply(res.executed[0]);
+      if (value && value->GetAsList(&reply)) {
+        core::redis_compatible::SlotMap slots;
+        common::Error parse_err = core::redis_compatible::ParseClusterSlots(reply, &slots);
+        if (!parse_err) {
+          slots_ = slots;
+        }
+      }
+    }
+    RunRequests();  // without slots requests stay on their nodes
+    return;
+  }
+
+  if (requests_.empty() || requests_.front().executing.get() != node) {
+    return;
+  }
+
+  RoutedRequest& request = requests_.front();
+  for (size_t i = 0; i < res.executed.size() && i < request.sent; ++i) {
+    RoutedCommand& routed = request.commands[request.command];
+    routed.replies.push_back(GetReply(res.executed[i]));
+    if (++request.part == routed.parts.size()) {
+      request.command++;
+      request.part = 0;
+    }
+  }
+  request.executing.reset();
+  request.sent = 0;
+
+  if (request.stopped) {
+    FinishRequest(common::make_error(common::COMMON_EINTR));
+    return;
+  }
+
+  if (err) {
+    if (err->GetErrorCode() != common::COMMON_EINTR || !err->GetPayload()) {
+      FinishRequest(err);
+      return;
+    }
+
+    if (++request.redirects > MAX_REDIRECTS) {  // owner of slot already updated by HandleRedirect
+      FinishRequest(common::make_error("Too many cluster redirects"));
+      return;
+    }
+
+    node_t root = GetRoot();
+    if (root) {
+      LoadSlots(root);  // resharding moves ranges of slots
+    }
+  }
+
+  SendParts();
+}
+
+Cluster::node_t Cluster::GetPartNode(const core::redis_compatible::SlotCommand& part, node_t origin) const {
+  common::net::HostAndPort owner;
+  if (!part.keyed || !slots_.GetSlotOwner(part.slot, &owner)) {
+    return origin;
+  }
+
+  node_t node = FindNode(owner);
+  return node ? node : origin;
+}
+
+bool Cluster::IsLocal(const RoutedRequest& request) const {
+  for (const RoutedCommand& routed : request.commands) {
+    if (routed.parts.size() != 1 || GetPartNode(routed.parts[0], request.origin) != request.origin) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Cluster::LoadSlots(node_t node) {
+  if (slots_loading_) {
+    return;
+  }
+
+  slots_loading_ = true;
+  if (!node->IsConnected()) {
+    events_info::ConnectInfoRequest connect_req(this);
+    node->Connect(connect_req);
+  }
+  events_info::ExecuteInfoRequest exec_req(this, CLUSTER_SLOTS, 0, 0, false, true, core::C_INNER);
+  node->Execute(exec_req);
+}
+
+void Cluster::RunRequests() {
+  while (!requests_.empty()) {
+    RoutedRequest& request = requests_.front();
+    if (request.executing) {
+      return;
+    }
+
+    if (request.stopped) {
+      FinishRequest(common::make_error(common::COMMON_EINTR));
+      return;
+    }
+
+    bool started = request.command != 0 || request.part != 0;
+    if (started || !IsLocal(request)) {
+      SendParts();
+      return;
+    }
+
+    ExecuteDirect(request.origin.get(), request.req);  // executed by node in order after requests before
+    requests_.pop_front();
+  }
+}
+
+void Cluster::SendParts() {
+  RoutedRequest& request = requests_.front();
+  if (request.command == request.commands.size()) {
+    FinishRequest(common::Error());
+    return;
+  }
+
+  // consecutive parts of one node as one pipeline
+  node_t node;
+  core::command_buffer_t text;
+  size_t command = request.command;
+  size_t part = request.part;
+  while (command < request.commands.size()) {
+    const core::redis_compatible::SlotCommand& slot_command = request.commands[command].parts[part];
+    node_t part_node = GetPartNode(slot_command, request.origin);
+    if (node && part_node != node) {
+      break;
+    }
+
+    node = part_node;
+    text += request.sent ? "\n" + slot_command.command : slot_command.command;
+    request.sent++;
+    if (++part == request.commands[command].parts.size()) {
+      command++;
+      part = 0;
+    }
+  }
+
+  if (!node->IsConnected()) {
+    events_info::ConnectInfoRequest connect_req(this);
+    node->Connect(connect_req);
+  }
+  request.executing = node;
+  events_info::ExecuteInfoRequest exec_req(this, text, 0, 0, false, true, core::C_INNER);
+  node->Execute(exec_req);
+}
+
+void Cluster::FinishRequest(common::Error err) {
+  RoutedRequest request = requests_.front();
+  requests_.pop_front();
+
+  std::vector<core::FastoObject::value_t> replies;
+  for (size_t i = 0; i < request.command; ++i) {
+    const RoutedCommand& routed = request.commands[i];
+    if (routed.parts.size() == 1) {
+      replies.push_back(routed.replies[0]);
+      continue;
+    }
+
+    std::vector<common::Value*> parts_replies;
+    for (auto reply : routed.replies) {
+      parts_replies.push_back(reply.get());
+    }
+    common::Value* merged = nullptr;
+    common::Error merge_err = core::redis_compatible::MergeSlotReplies(routed.parts, parts_replies, &merged);
+    if (merge_err) {
+      err = merge_err;
+      break;
+    }
+    replies.push_back(core::FastoObject::value_t(merged));
+  }
+
+  events_info::ExecuteInfoRequest replay(request.req.initiator(), request.req.text, 0, request.req.msec_repeat_interval,
+                                         request.req.history, request.req.silence, request.req.logtype, err);
+  replay.first_command = request.req.first_command;
+  replay.routed = true;
+  replay.replies = replies;
+  ExecuteDirect(request.origin.get(), replay);
+  RunRequests();
+}
 
-}  // namespace pika
+}  // namespace redis_compatible
 }  // namespace proxy
 }  // namespace fastonosql
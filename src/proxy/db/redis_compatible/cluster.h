@@ -18,18 +18,65 @@
 
 #pragma once
 
+#include <deque>   // for deque
+#include <vector>  // for vector
+
+#include "core/db/redis_compatible/cluster_slots.h"
+
 #include "proxy/cluster/icluster.h"
 
 namespace fastonosql {
 namespace proxy {
 namespace redis_compatible {
 
+// every command of node sent to owner of its key slot, multi key commands (MGET, DEL, UNLINK) split by slot
+// and their replies merged; consecutive commands of one node executed as one pipeline, in order of script,
+// replies shown by node which got request; keyless commands and unknown slots stay on that node
 class Cluster : public ICluster {
   Q_OBJECT
  public:
   explicit Cluster(const std::string& name);
+
+  virtual bool RouteExecute(IServer* node, const events_info::ExecuteInfoRequest& req) override;
+  virtual void StopExecute(IServer* node) override;
+
+ protected:
+  virtual void HandleRedirect(const common::net::HostAndPortAndSlot& host) override;
+  virtual void HandleExecuteFinished(IServer* node, const events_info::ExecuteInfoResponce& res) override;
+
+ private:
+  struct RoutedCommand {
+    std::vector<core::redis_compatible::SlotCommand> parts;
+    std::vector<core::FastoObject::value_t> replies;  // of executed parts
+  };
+
+  struct RoutedRequest {
+    RoutedRequest(node_t origin, const events_info::ExecuteInfoRequest& req);
+
+    node_t origin;
+    events_info::ExecuteInfoRequest req;
+    std::vector<RoutedCommand> commands;  // from first_command of request
+    size_t command;                       // next part to send
+    size_t part;
+    node_t executing;  // node of sent pipeline
+    size_t sent;       // parts in sent pipeline
+    size_t redirects;
+    bool stopped;
+  };
+
+  node_t GetPartNode(const core::redis_compatible::SlotCommand& part, node_t origin) const;
+  bool IsLocal(const RoutedRequest& request) const;
+  void LoadSlots(node_t node);
+  void RunRequests();
+  void SendParts();
+  void FinishRequest(common::Error err);
+
+  core::redis_compatible::SlotMap slots_;
+  bool slots_loading_;
+  bool slots_loaded_;
+  std::deque<RoutedRequest> requests_;  // front is executing, others wait to keep order
 };
 
-}  // namespace pika
+}  // namespace redis_compatible
 }  // namespace proxy
 }  // namespace fastonosql
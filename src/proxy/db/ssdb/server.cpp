@@ -25,7 +25,8 @@ namespace fastonosql {
 namespace proxy {
 namespace ssdb {
 
-Server::Server(IConnectionSettingsBaseSPtr settings) : IServerRemote(new Driver(settings)) {
+Server::Server(IConnectionSettingsBaseSPtr settings)
+    : IServerRemote(new Driver(settings), new Driver(settings), new Driver(settings), nullptr) {
   StartCheckKeyExistTimer();
 }
 
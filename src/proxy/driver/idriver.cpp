@@ -31,6 +31,7 @@
 
 #include "proxy/command/command_logger.h"  // for LOG_COMMAND
 #include "proxy/driver/first_child_update_root_locker.h"
+#include "proxy/settings_manager.h"  // for SettingsManager
 
 namespace {
 
@@ -106,7 +107,17 @@ void ReplyNotImplementedYet(IDriver* sender, event_request_type* ev, const char*
 }  // namespace
 
 IDriver::IDriver(IConnectionSettingsBaseSPtr settings)
-    : settings_(settings), thread_(nullptr), timer_info_id_(0), log_file_(nullptr) {
+    : settings_(settings),
+      thread_(nullptr),
+      server_info_history_enabled_(true),
+      timer_info_id_(0),
+      log_file_(nullptr),
+      progress_reciver_(nullptr),
+      progress_start_(0),
+      progress_step_(0),
+      progress_value_(0),
+      check_cost_(false),
+      cost_rejected_(false) {
   thread_ = new QThread(this);
   moveToThread(thread_);
 
@@ -128,10 +139,19 @@ common::Error IDriver::Execute(core::FastoObjectCommandIPtr cmd) {
   }
 
   LOG_COMMAND(cmd);
+  const core::commands_args_t argv = cmd->GetInputArgs();
+  if (!argv.empty()) {
+    return ExecuteImpl(argv, cmd.get());
+  }
+
   common::Error err = ExecuteImpl(cmd->GetInputCommand(), cmd.get());
   return err;
 }
 
+common::Error IDriver::ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) {
+  return ExecuteImpl(core::TypedCommand(argv).GetCommandLine(), out);
+}
+
 void IDriver::Reply(QObject* reciver, QEvent* ev) {
   qApp->postEvent(reciver, ev);
 }
@@ -160,6 +180,10 @@ std::string IDriver::GetNsSeparator() const {
   return settings_->GetNsSeparator();
 }
 
+void IDriver::SetServerInfoHistoryEnabled(bool enabled) {
+  server_info_history_enabled_ = enabled;
+}
+
 void IDriver::Start() {
   thread_->start();
 }
@@ -174,7 +198,7 @@ void IDriver::Interrupt() {
 }
 
 void IDriver::Init() {
-  if (settings_->IsHistoryEnabled()) {
+  if (server_info_history_enabled_ && settings_->IsHistoryEnabled()) {
     int interval = settings_->GetLoggingMsTimeInterval();
     timer_info_id_ = startTimer(interval);
     DCHECK(timer_info_id_ != 0);
@@ -237,7 +261,11 @@ void IDriver::customEvent(QEvent* event) {
     HandleRestoreEvent(ev);  // ni
   } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseContentRequestEvent::EventType)) {
     events::LoadDatabaseContentRequestEvent* ev = static_cast<events::LoadDatabaseContentRequestEvent*>(event);
-    HandleLoadDatabaseContentEvent(ev);
+    if (ev->value().filter.IsEmpty()) {
+      HandleLoadDatabaseContentEvent(ev);
+    } else {
+      HandleLoadFilteredDatabaseContentEvent(ev);
+    }
   } else if (type == static_cast<QEvent::Type>(events::DiscoveryInfoRequestEvent::EventType)) {
     events::DiscoveryInfoRequestEvent* ev = static_cast<events::DiscoveryInfoRequestEvent*>(event);
     HandleDiscoveryInfoEvent(ev);  //
@@ -340,27 +368,68 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   const bool history = res.history;
   const common::time64_t msec_repeat_interval = res.msec_repeat_interval;
   const core::CmdLoggingType log_type = res.logtype;
+  // streaming commands keep only last messages, others keep whole reply
+  const size_t output_limit = SettingsManager::GetInstance()->GetOutputRingSize();
+  std::string spill_path;
+  if (output_limit && SettingsManager::GetInstance()->GetOutputSpill() && core::HasStreamingCommand(input_line)) {
+    spill_path = settings_->GetOutputSpillPath();
+    const std::string dir = common::file_system::get_dir_path(spill_path);
+    common::ErrnoError err = common::file_system::create_directory(dir, true);
+    if (err && common::file_system::is_directory(dir) != common::SUCCESS) {
+      spill_path.clear();
+    }
+  }
+
   RootLocker* lock = history ? new RootLocker(this, sender, input_line, silence)
                              : new FirstChildUpdateRootLocker(this, sender, input_line, silence, commands);
   core::FastoObjectIPtr obj = lock->Root();
   const double step = 99.0 / double(commands.size() * (repeat + 1));
   double cur_progress = 0.0;
+  progress_reciver_ = sender;
+  progress_step_ = step;
+  check_cost_ = res.check_cost;
+  cost_rejected_ = false;
   for (size_t r = 0; r < repeat + 1; ++r) {
     common::time64_t start_ts = common::time::current_mstime();
-    for (size_t i = 0; i < commands.size(); ++i) {
+    for (size_t i = r ? 0 : res.first_command; i < commands.size(); ++i) {
       if (IsInterrupted()) {
         res.setErrorInfo(common::make_error(common::COMMON_EINTR));
         goto done;
       }
 
-      cur_progress += step;
+      // big replies move progress inside [cur_progress, cur_progress + step)
       NotifyProgress(sender, static_cast<int>(cur_progress));
+      progress_start_ = cur_progress;
+      progress_value_ = static_cast<int>(cur_progress);
+      cur_progress += step;
 
       core::command_buffer_t command = commands[i];
       core::FastoObjectCommandIPtr cmd =
           silence ? CreateCommandFast(command, log_type) : CreateCommand(obj.get(), command, log_type);  //
+      if (core::IsStreamingCommand(command)) {
+        cmd->SetChildrensLimit(output_limit, spill_path);
+      }
+      if (res.routed) {  // replies start from first_command
+        if (i - res.first_command >= res.replies.size()) {
+          goto done;
+        }
+
+        core::FastoObject::value_t reply = res.replies[i - res.first_command];
+        if (reply) {
+          cmd->AddChildren(new core::FastoObject(cmd.get(), reply->DeepCopy(), cmd->GetDelimiter()));
+        }
+        continue;
+      }
+
       common::Error err = Execute(cmd);
+      if (silence && !err) {
+        res.executed.push_back(cmd);
+      }
       if (err) {
+        if (cost_rejected_) {  // commands before it are already executed
+          res.resume_command = i;
+          res.resume_repeat = repeat - r;
+        }
         res.setErrorInfo(err);
         goto done;
       }
@@ -375,11 +444,47 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   }
 
 done:
+  progress_reciver_ = nullptr;
+  check_cost_ = false;
+  res.cost_confirmation_required = cost_rejected_;
   Reply(sender, new events::ExecuteResponceEvent(this, res));
   NotifyProgress(sender, 100);
   delete lock;
 }
 
+void IDriver::HandleLoadFilteredDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+  NotifyProgress(sender, 50);
+  std::vector<std::string> keys;
+  common::Error err = ScanFilteredKeys(res, &keys, &res.cursor_out, &res.db_keys_count);
+  if (err) {
+    res.setErrorInfo(err);
+  } else {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      core::key_t key(keys[i]);
+      core::NKey k(key);
+      core::NValue empty_val(core::CreateEmptyValueFromType(common::Value::TYPE_STRING));
+      res.keys.push_back(core::NDbKValue(k, empty_val));
+    }
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+common::Error IDriver::ScanFilteredKeys(const events_info::LoadDatabaseContentRequest& req,
+                                        std::vector<std::string>* keys_out,
+                                        uint64_t* cursor_out,
+                                        size_t* db_keys_count) {
+  UNUSED(req);
+  UNUSED(keys_out);
+  UNUSED(cursor_out);
+  UNUSED(db_keys_count);
+  return common::make_error("Filtered content loading not supported");
+}
+
 void IDriver::HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev) {
   ReplyNotImplementedYet<events::ServerPropertyInfoRequestEvent, events::ServerPropertyInfoResponceEvent>(
       this, ev, "server property");
@@ -704,5 +809,33 @@ void IDriver::OnQuited() {
   emit Disconnected();
 }
 
+void IDriver::OnReplyProgress(size_t received, size_t declared) {
+  if (!progress_reciver_ || !declared) {
+    return;
+  }
+
+  const int value = static_cast<int>(progress_start_ + progress_step_ * double(received) / double(declared));
+  if (value != progress_value_) {  // one event per percent
+    progress_value_ = value;
+    NotifyProgress(progress_reciver_, value);
+  }
+}
+
+size_t IDriver::GetQueryCostThreshold() const {
+  return SettingsManager::GetInstance()->GetQueryCostThreshold();
+}
+
+core::QueryCostAction IDriver::OnQueryCostExceeded(const core::command_buffer_t& command, size_t estimated) {
+  UNUSED(command);
+  UNUSED(estimated);
+  // only commands typed in shell are confirmed, others (and confirmed ones) are read page by page
+  if (check_cost_ && SettingsManager::GetInstance()->GetQueryCostConfirm()) {
+    cost_rejected_ = true;
+    return core::QUERY_COST_REJECT;
+  }
+
+  return core::QUERY_COST_PAGE;
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
@@ -57,6 +57,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
 
   virtual core::translator_t GetTranslator() const = 0;
 
+  void SetServerInfoHistoryEnabled(bool enabled);  // call before Start
   void Start();
   void Stop();
 
@@ -108,6 +109,8 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void HandleExecuteEvent(events::ExecuteRequestEvent* ev);
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) = 0;
+  // filters have no command line form, by default keys scanned directly on connection by ScanFilteredKeys
+  virtual void HandleLoadFilteredDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev);
 
   virtual void HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev);
   virtual void HandleServerPropertyChangeEvent(events::ChangeServerPropertyInfoRequestEvent* ev);
@@ -140,6 +143,11 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   void HandleClearServerHistoryEvent(events::ClearServerHistoryRequestEvent* ev);
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) = 0;
+  virtual common::Error ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out);
+  virtual common::Error ScanFilteredKeys(const events_info::LoadDatabaseContentRequest& req,
+                                         std::vector<std::string>* keys_out,
+                                         uint64_t* cursor_out,
+                                         size_t* db_keys_count);
 
   virtual void OnCreatedDB(core::IDataBaseInfo* info) override;
   virtual void OnRemovedDB(core::IDataBaseInfo* info) override;
@@ -156,6 +164,9 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void OnUnLoadedModule(const core::ModuleInfo& module) override;
   virtual void OnLoadedModule(const core::ModuleInfo& module) override;
   virtual void OnQuited() override;
+  virtual void OnReplyProgress(size_t received, size_t declared) override;
+  virtual size_t GetQueryCostThreshold() const override;
+  virtual core::QueryCostAction OnQueryCostExceeded(const core::command_buffer_t& command, size_t estimated) override;
 
  private:
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) = 0;
@@ -173,8 +184,18 @@ class IDriver : public QObject, public core::CDBConnectionClient {
 
   const IConnectionSettingsBaseSPtr settings_;
   QThread* thread_;
+  bool server_info_history_enabled_;
   int timer_info_id_;
   common::file_system::ANSIFile* log_file_;
+
+  // execute request in progress, reply progress of its commands is reported to progress_reciver_
+  QObject* progress_reciver_;
+  double progress_start_;
+  double progress_step_;
+  int progress_value_;
+
+  bool check_cost_;     // expensive reads of execute request in progress wait for confirmation
+  bool cost_rejected_;  // some of them was rejected
 };
 
 }  // namespace proxy
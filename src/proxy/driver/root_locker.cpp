@@ -30,6 +30,9 @@ namespace proxy {
 
 RootLocker::RootLocker(IDriver* parent, QObject* receiver, const core::command_buffer_t& text, bool silence)
     : core::FastoObject::IFastoObjectObserver(),
+      arena_(core::ObjectArena::Create()),
+      previous_arena_(core::ObjectArena::SetCurrent(arena_)),
+      root_(),
       parent_(parent),
       receiver_(receiver),
       tstart_(common::time::current_mstime()),
@@ -48,6 +51,9 @@ RootLocker::~RootLocker() {
     events::CommandRootCompleatedEvent::value_type res(parent_, tstart_, root_);
     IDriver::Reply(receiver_, new events::CommandRootCompleatedEvent(parent_, res));
   }
+
+  core::ObjectArena::SetCurrent(previous_arena_);
+  arena_->Release();
 }
 
 core::FastoObjectIPtr RootLocker::Root() const {
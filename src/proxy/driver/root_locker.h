@@ -18,7 +18,8 @@
 
 #pragma once
 
-#include "core/global.h"  // for FastoObjectIPtr, etc
+#include "core/global.h"        // for FastoObjectIPtr, etc
+#include "core/object_arena.h"  // for ObjectArena
 
 class QObject;
 
@@ -39,6 +40,10 @@ class RootLocker : core::FastoObject::IFastoObjectObserver {
   virtual void Updated(core::FastoObject* item, core::FastoObject::value_t val) override;
 
  private:
+  // nodes of this execution are allocated from own arena, which is current for
+  // driver thread while locker exists and freed with the last node
+  core::ObjectArena* arena_;
+  core::ObjectArena* previous_arena_;
   core::FastoObjectIPtr root_;
   IDriver* parent_;
   QObject* receiver_;
@@ -88,9 +88,14 @@ ExecuteInfoRequest::ExecuteInfoRequest(initiator_type sender,
       msec_repeat_interval(msec_repeat_interval),
       history(history),
       silence(silence),
-      logtype(logtype) {}
+      logtype(logtype),
+      check_cost(false),
+      first_command(0),
+      routed(false),
+      replies() {}
 
-ExecuteInfoResponce::ExecuteInfoResponce(const base_class& request) : base_class(request) {}
+ExecuteInfoResponce::ExecuteInfoResponce(const base_class& request)
+    : base_class(request), cost_confirmation_required(false), resume_command(0), resume_repeat(0), executed() {}
 
 LoadDatabasesInfoRequest::LoadDatabasesInfoRequest(initiator_type sender, error_type er) : base_class(sender, er) {}
 
@@ -102,13 +107,16 @@ LoadDatabaseContentRequest::LoadDatabaseContentRequest(initiator_type sender,
                                                        size_t countKeys,
                                                        uint64_t cursor,
                                                        error_type er)
-    : base_class(sender, er), inf(inf), pattern(pattern), count_keys(countKeys), cursor_in(cursor) {}
+    : base_class(sender, er), inf(inf), pattern(pattern), count_keys(countKeys), cursor_in(cursor), filter() {}
 
 LoadDatabaseContentResponce::LoadDatabaseContentResponce(const base_class& request)
     : base_class(request), keys(), cursor_out(0), db_keys_count(0) {}
 
-LoadServerChannelsRequest::LoadServerChannelsRequest(initiator_type sender, const std::string& pattern, error_type er)
-    : base_class(sender, er), pattern(pattern) {}
+LoadServerChannelsRequest::LoadServerChannelsRequest(initiator_type sender,
+                                                     const std::string& pattern,
+                                                     uint32_t sample_seconds,
+                                                     error_type er)
+    : base_class(sender, er), pattern(pattern), sample_seconds(sample_seconds) {}
 
 LoadServerChannelsResponce::LoadServerChannelsResponce(const base_class& request) : base_class(request), channels() {}
 
@@ -24,6 +24,7 @@
 #include "core/database/idatabase_info.h"
 #include "core/db_key.h"  // for NDbKValue
 #include "core/db_ps_channel.h"
+#include "core/keys_filter.h"
 #include "core/module_info.h"
 #include "core/server/iserver_info.h"   // for IDataBaseInfoSPtr, IServerInf...
 #include "core/server_property_info.h"  // for property_t, ServerPropertiesInfo
@@ -148,11 +149,24 @@ struct ExecuteInfoRequest : public EventInfoBase {
   const bool history;
   const bool silence;
   const core::CmdLoggingType logtype;
+  bool check_cost;      // expensive reads need confirmation
+  size_t first_command;  // of first repeat, to resume execution
+  // executed by cluster nodes: replies are shown as output of first commands instead of executing them,
+  // error of request stops the output
+  bool routed;
+  std::vector<core::FastoObject::value_t> replies;
 };
 
 struct ExecuteInfoResponce : ExecuteInfoRequest {
   typedef ExecuteInfoRequest base_class;
   explicit ExecuteInfoResponce(const base_class& request);
+
+  // execution stopped on expensive read, resume it without check_cost
+  // from resume_command with resume_repeat repeats left
+  bool cost_confirmation_required;
+  size_t resume_command;
+  size_t resume_repeat;
+  std::vector<core::FastoObjectCommandIPtr> executed;  // commands of silent request with their replies
 };
 
 struct LoadDatabasesInfoRequest : public EventInfoBase {
@@ -181,6 +195,7 @@ struct LoadDatabaseContentRequest : public EventInfoBase {
   const std::string pattern;
   size_t count_keys;
   const uint64_t cursor_in;
+  core::KeysFilter filter;
 };
 
 struct LoadDatabaseContentResponce : LoadDatabaseContentRequest {
@@ -195,9 +210,13 @@ struct LoadDatabaseContentResponce : LoadDatabaseContentRequest {
 
 struct LoadServerChannelsRequest : public EventInfoBase {
   typedef EventInfoBase base_class;
-  LoadServerChannelsRequest(initiator_type sender, const std::string& pattern, error_type er = error_type());
+  LoadServerChannelsRequest(initiator_type sender,
+                            const std::string& pattern,
+                            uint32_t sample_seconds = 0,
+                            error_type er = error_type());
 
   const std::string pattern;
+  const uint32_t sample_seconds;  // if not zero, traffic sampled on side connection during this time
 };
 
 struct LoadServerChannelsResponce : LoadServerChannelsRequest {
@@ -23,38 +23,88 @@
 #include <common/qt/logger.h>  // for LOG_ERROR
 #include <common/sprintf.h>
 
-#include "proxy/driver/idriver.h"  // for IDriver
+#include "proxy/cluster/icluster.h"  // for ICluster
+#include "proxy/driver/idriver.h"    // for IDriver
 
 namespace fastonosql {
 namespace proxy {
-
-IServer::IServer(IDriver* drv) : drv_(drv), server_info_(), current_database_info_(), timer_check_key_exists_id_(0) {
-  VERIFY(QObject::connect(drv_, &IDriver::ChildAdded, this, &IServer::ChildAdded));
-  VERIFY(QObject::connect(drv_, &IDriver::ItemUpdated, this, &IServer::ItemUpdated));
-  VERIFY(QObject::connect(drv_, &IDriver::ServerInfoSnapShooted, this, &IServer::ServerInfoSnapShooted));
-
-  VERIFY(QObject::connect(drv_, &IDriver::DBCreated, this, &IServer::CreateDatabase));
-  VERIFY(QObject::connect(drv_, &IDriver::DBRemoved, this, &IServer::RemoveDatabase));
-  VERIFY(QObject::connect(drv_, &IDriver::DBFlushed, this, &IServer::FlushCurrentDatabase));
-  VERIFY(QObject::connect(drv_, &IDriver::DBChanged, this, &IServer::ChangeCurrentDatabase));
-
-  VERIFY(QObject::connect(drv_, &IDriver::KeyRemoved, this, &IServer::RemoveKey));
-  VERIFY(QObject::connect(drv_, &IDriver::KeyAdded, this, &IServer::AddKey));
-  VERIFY(QObject::connect(drv_, &IDriver::KeyLoaded, this, &IServer::LoadKey));
-  VERIFY(QObject::connect(drv_, &IDriver::KeyRenamed, this, &IServer::RenameKey));
-  VERIFY(QObject::connect(drv_, &IDriver::KeyTTLChanged, this, &IServer::ChangeKeyTTL));
-  VERIFY(QObject::connect(drv_, &IDriver::KeyTTLLoaded, this, &IServer::LoadKeyTTL));
-  VERIFY(QObject::connect(drv_, &IDriver::ModuleLoaded, this, &IServer::LoadModule));
-  VERIFY(QObject::connect(drv_, &IDriver::ModuleUnLoaded, this, &IServer::UnLoadModule));
-  VERIFY(QObject::connect(drv_, &IDriver::Disconnected, this, &IServer::Disconnected));
-
-  drv_->Start();
+namespace {
+
+// whole request goes to streaming lane if one of its commands streams replies until interrupted
+bool IsStreamingRequest(const events_info::ExecuteInfoRequest& req) {
+  return core::HasStreamingCommand(req.text);
+}
+
+template <typename event_t>
+bool IsResponceEvent(QEvent* ev, QObject** sender) {
+  if (ev->type() != static_cast<QEvent::Type>(event_t::EventType)) {
+    return false;
+  }
+
+  *sender = static_cast<event_t*>(ev)->sender();
+  return true;
+}
+
+QObject* GetResponceSender(QEvent* ev) {
+  QObject* sender = nullptr;
+  if (IsResponceEvent<events::ConnectResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::DisconnectResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::ExecuteResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::LoadDatabasesInfoResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::ServerInfoResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::ServerInfoHistoryResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::ClearServerHistoryResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::ServerPropertyInfoResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::ChangeServerPropertyInfoResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::LoadServerChannelsResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::BackupResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::RestoreResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::LoadDatabaseContentResponceEvent>(ev, &sender) ||
+      IsResponceEvent<events::DiscoveryInfoResponceEvent>(ev, &sender)) {
+    return sender;
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+IServer::IServer(IDriver* drv) : IServer(drv, nullptr, nullptr, nullptr) {}
+
+IServer::IServer(IDriver* drv, IDriver* bulk_drv, IDriver* monitoring_drv, IDriver* streaming_drv)
+    : drv_(drv),
+      lanes_{drv, bulk_drv, monitoring_drv, streaming_drv},
+      lanes_connected_{false, false, false, false},
+      lanes_requests_{0, 0, 0, 0},
+      lanes_database_(),
+      cluster_(nullptr),
+      server_info_(),
+      current_database_info_(),
+      timer_check_key_exists_id_(0) {
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    if (lanes_[i]) {
+      if (monitoring_drv && i != MONITORING_LANE) {  // history snapshots collected only by monitoring lane
+        lanes_[i]->SetServerInfoHistoryEnabled(false);
+      }
+      ConnectLaneSignals(lanes_[i]);
+      lanes_[i]->Start();
+    }
+  }
 }
 
 IServer::~IServer() {
-  StopCurrentEvent();
-  drv_->Stop();
-  delete drv_;
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    if (lanes_[i]) {
+      lanes_[i]->Interrupt();
+    }
+  }
+
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    if (lanes_[i]) {
+      lanes_[i]->Stop();
+      delete lanes_[i];
+    }
+  }
 }
 
 void IServer::StartCheckKeyExistTimer() {
@@ -70,7 +120,16 @@ void IServer::StopCheckKeyExistTimer() {
 }
 
 void IServer::StopCurrentEvent() {
-  drv_->Interrupt();
+  if (cluster_) {
+    cluster_->StopExecute(this);
+  }
+
+  // lanes running or having queued requests, idle ones keep working
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    if (lanes_[i] && lanes_requests_[i]) {
+      lanes_[i]->Interrupt();
+    }
+  }
 }
 
 bool IServer::IsConnected() const {
@@ -122,6 +181,10 @@ IServer::database_t IServer::GetCurrentDatabaseInfo() const {
   return database_t();
 }
 
+ICluster* IServer::GetCluster() const {
+  return cluster_;
+}
+
 std::string IServer::GetDelimiter() const {
   return drv_->GetDelimiter();
 }
@@ -163,6 +226,7 @@ void IServer::Connect(const events_info::ConnectInfoRequest& req) {
 
 void IServer::Disconnect(const events_info::DisConnectInfoRequest& req) {
   StopCurrentEvent();
+  DisconnectLanes(req);
   emit DisconnectStarted(req);
   QEvent* ev = new events::DisconnectRequestEvent(this, req);
   NotifyStartEvent(ev);
@@ -182,6 +246,14 @@ void IServer::LoadDatabaseContent(const events_info::LoadDatabaseContentRequest&
 
 void IServer::Execute(const events_info::ExecuteInfoRequest& req) {
   emit ExecuteStarted(req);
+  if (cluster_ && req.initiator() != cluster_ && cluster_->RouteExecute(this, req)) {
+    return;  // output comes back by ExecuteDirect with replies of nodes
+  }
+
+  ExecuteDirect(req);
+}
+
+void IServer::ExecuteDirect(const events_info::ExecuteInfoRequest& req) {
   QEvent* ev = new events::ExecuteRequestEvent(this, req);
   NotifyStartEvent(ev);
 }
@@ -235,14 +307,29 @@ void IServer::LoadChannels(const events_info::LoadServerChannelsRequest& req) {
 }
 
 void IServer::customEvent(QEvent* event) {
+  FinishLaneRequest(event);
+
   QEvent::Type type = event->type();
   if (type == static_cast<QEvent::Type>(events::ConnectResponceEvent::EventType)) {
     events::ConnectResponceEvent* ev = static_cast<events::ConnectResponceEvent*>(event);
-    HandleConnectEvent(ev);
-
     events::ConnectResponceEvent::value_type v = ev->value();
     common::Error err(v.errorInfo());
+    if (ev->sender() != drv_) {  // lane connected, until then requests served by interactive driver
+      const int lane = FindLane(ev->sender());
+      if (lane != -1) {
+        lanes_connected_[lane] = !err;
+        lanes_database_[lane].clear();
+      }
+      if (err) {
+        LOG_ERROR(err, common::logging::LOG_LEVEL_WARNING, false);
+      }
+      return QObject::customEvent(event);
+    }
+
+    HandleConnectEvent(ev);
     if (!err) {
+      ConnectLanes(v);
+
       events_info::ServerInfoRequest sreq(this);
       LoadServerInfo(sreq);
 
@@ -265,6 +352,9 @@ void IServer::customEvent(QEvent* event) {
     emit RootCompleated(v);
   } else if (type == static_cast<QEvent::Type>(events::DisconnectResponceEvent::EventType)) {
     events::DisconnectResponceEvent* ev = static_cast<events::DisconnectResponceEvent*>(event);
+    if (ev->sender() != drv_) {
+      return QObject::customEvent(event);
+    }
     HandleDisconnectEvent(ev);
   } else if (type == static_cast<QEvent::Type>(events::LoadDatabasesInfoResponceEvent::EventType)) {
     events::LoadDatabasesInfoResponceEvent* ev = static_cast<events::LoadDatabasesInfoResponceEvent*>(event);
@@ -299,6 +389,16 @@ void IServer::customEvent(QEvent* event) {
     HandleLoadDatabaseContentEvent(ev);
   } else if (type == static_cast<QEvent::Type>(events::ExecuteResponceEvent::EventType)) {
     events::ExecuteResponceEvent* ev = static_cast<events::ExecuteResponceEvent*>(event);
+    events::ExecuteResponceEvent::value_type v = ev->value();
+    if (ev->sender() != drv_ && v.initiator() == this) {  // database selected by SelectLaneDatabase
+      common::Error err(v.errorInfo());
+      const int lane = FindLane(ev->sender());
+      if (err && lane != -1) {
+        lanes_database_[lane].clear();
+        LOG_ERROR(err, common::logging::LOG_LEVEL_WARNING, false);
+      }
+      return QObject::customEvent(event);
+    }
     HandleExecuteEvent(ev);
   } else if (type == static_cast<QEvent::Type>(events::DiscoveryInfoResponceEvent::EventType)) {
     events::DiscoveryInfoResponceEvent* ev = static_cast<events::DiscoveryInfoResponceEvent*>(event);
@@ -323,7 +423,136 @@ void IServer::timerEvent(QTimerEvent* event) {
 void IServer::NotifyStartEvent(QEvent* ev) {
   events_info::ProgressInfoResponce resp(0);
   emit ProgressChanged(resp);
-  qApp->postEvent(drv_, ev);
+  const DriverLane lane = GetLane(ev);
+  if (lane != INTERACTIVE_LANE) {
+    SelectLaneDatabase(lane);
+  }
+  PostToLane(lane, ev);
+}
+
+IServer::DriverLane IServer::GetLane(QEvent* ev) const {
+  const QEvent::Type type = ev->type();
+  DriverLane lane = INTERACTIVE_LANE;
+  if (type == static_cast<QEvent::Type>(events::ServerInfoRequestEvent::EventType) ||
+      type == static_cast<QEvent::Type>(events::ServerInfoHistoryRequestEvent::EventType) ||
+      type == static_cast<QEvent::Type>(events::ClearServerHistoryRequestEvent::EventType) ||
+      type == static_cast<QEvent::Type>(events::ServerPropertyInfoRequestEvent::EventType) ||
+      type == static_cast<QEvent::Type>(events::LoadServerChannelsRequestEvent::EventType)) {
+    lane = MONITORING_LANE;
+  } else if (type == static_cast<QEvent::Type>(events::BackupRequestEvent::EventType) ||
+             type == static_cast<QEvent::Type>(events::RestoreRequestEvent::EventType) ||
+             type == static_cast<QEvent::Type>(events::LoadDatabaseContentRequestEvent::EventType)) {
+    lane = BULK_LANE;
+  } else if (type == static_cast<QEvent::Type>(events::ExecuteRequestEvent::EventType) &&
+             IsStreamingRequest(static_cast<events::ExecuteRequestEvent*>(ev)->value())) {
+    lane = STREAMING_LANE;
+  }
+
+  // history file owned by monitoring lane even if it is not connected
+  const bool history_request = type == static_cast<QEvent::Type>(events::ServerInfoHistoryRequestEvent::EventType) ||
+                               type == static_cast<QEvent::Type>(events::ClearServerHistoryRequestEvent::EventType);
+  if (lanes_[lane] && (lanes_connected_[lane] || history_request)) {
+    return lane;
+  }
+
+  return INTERACTIVE_LANE;
+}
+
+int IServer::FindLane(QObject* drv) const {
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    if (lanes_[i] && lanes_[i] == drv) {
+      return static_cast<int>(i);
+    }
+  }
+
+  return -1;
+}
+
+void IServer::PostToLane(DriverLane lane, QEvent* ev) {
+  lanes_requests_[lane]++;
+  qApp->postEvent(lanes_[lane], ev);
+}
+
+void IServer::SelectLaneDatabase(DriverLane lane) {
+  if (!current_database_info_ || lanes_database_[lane] == current_database_info_->GetName()) {
+    return;
+  }
+
+  core::command_buffer_t select_cmd;
+  common::Error err = GetTranslator()->SelectDBCommand(current_database_info_->GetName(), &select_cmd);
+  if (err) {
+    return;
+  }
+
+  // queued before request, so it runs in same database as on interactive lane
+  lanes_database_[lane] = current_database_info_->GetName();
+  events_info::ExecuteInfoRequest req(this, select_cmd, 0, 0, false, true, core::C_INNER);
+  PostToLane(lane, new events::ExecuteRequestEvent(this, req));
+}
+
+void IServer::FinishLaneRequest(QEvent* ev) {
+  const int lane = FindLane(GetResponceSender(ev));
+  if (lane != -1 && lanes_requests_[lane]) {
+    lanes_requests_[lane]--;
+  }
+}
+
+void IServer::ConnectLaneSignals(IDriver* lane) {
+  VERIFY(QObject::connect(lane, &IDriver::ChildAdded, this, &IServer::ChildAdded));
+  VERIFY(QObject::connect(lane, &IDriver::ItemUpdated, this, &IServer::ItemUpdated));
+  VERIFY(QObject::connect(lane, &IDriver::ServerInfoSnapShooted, this, &IServer::ServerInfoSnapShooted));
+
+  VERIFY(QObject::connect(lane, &IDriver::DBCreated, this, &IServer::CreateDatabase));
+  VERIFY(QObject::connect(lane, &IDriver::DBRemoved, this, &IServer::RemoveDatabase));
+  VERIFY(QObject::connect(lane, &IDriver::DBFlushed, this, &IServer::FlushCurrentDatabase));
+  VERIFY(QObject::connect(lane, &IDriver::DBChanged, this, &IServer::ChangeCurrentDatabase));
+
+  VERIFY(QObject::connect(lane, &IDriver::KeyRemoved, this, &IServer::RemoveKey));
+  VERIFY(QObject::connect(lane, &IDriver::KeyAdded, this, &IServer::AddKey));
+  VERIFY(QObject::connect(lane, &IDriver::KeyLoaded, this, &IServer::LoadKey));
+  VERIFY(QObject::connect(lane, &IDriver::KeyRenamed, this, &IServer::RenameKey));
+  VERIFY(QObject::connect(lane, &IDriver::KeyTTLChanged, this, &IServer::ChangeKeyTTL));
+  VERIFY(QObject::connect(lane, &IDriver::KeyTTLLoaded, this, &IServer::LoadKeyTTL));
+  VERIFY(QObject::connect(lane, &IDriver::ModuleLoaded, this, &IServer::LoadModule));
+  VERIFY(QObject::connect(lane, &IDriver::ModuleUnLoaded, this, &IServer::UnLoadModule));
+  if (lane == drv_) {
+    VERIFY(QObject::connect(lane, &IDriver::Disconnected, this, &IServer::Disconnected));
+  } else {  // lost lane, requests go to interactive driver
+    VERIFY(QObject::connect(lane, &IDriver::Disconnected, this, &IServer::DisconnectLane));
+  }
+}
+
+void IServer::DisconnectLane() {
+  const int lane = FindLane(sender());
+  if (lane != -1) {
+    lanes_connected_[lane] = false;
+    lanes_database_[lane].clear();
+  }
+}
+
+void IServer::ConnectLanes(const events_info::ConnectInfoRequest& req) {
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    IDriver* lane = lanes_[i];
+    if (!lane || lane == drv_) {
+      continue;
+    }
+
+    lane->PrepareSettings();
+    PostToLane(static_cast<DriverLane>(i), new events::ConnectRequestEvent(this, req));
+  }
+}
+
+void IServer::DisconnectLanes(const events_info::DisConnectInfoRequest& req) {
+  for (size_t i = 0; i < DRIVER_LANES_COUNT; ++i) {
+    IDriver* lane = lanes_[i];
+    if (!lane || lane == drv_ || !lanes_connected_[i]) {
+      continue;
+    }
+
+    lanes_connected_[i] = false;
+    lanes_database_[i].clear();
+    PostToLane(static_cast<DriverLane>(i), new events::DisconnectRequestEvent(this, req));
+  }
 }
 
 void IServer::HandleConnectEvent(events::ConnectResponceEvent* ev) {
@@ -493,6 +722,14 @@ void IServer::FlushCurrentDatabase() {
 }
 
 void IServer::ChangeCurrentDatabase(core::IDataBaseInfoSPtr db) {
+  const int lane = FindLane(sender());
+  if (lane != -1) {
+    lanes_database_[lane] = db->GetName();
+  }
+  if (lane != -1 && lanes_[lane] != drv_) {  // current database is one of interactive lane, others follow it
+    return;
+  }
+
   database_t cdb = GetCurrentDatabaseInfo();
   if (cdb) {
     if (db->GetName() == cdb->GetName()) {
@@ -30,11 +30,15 @@ namespace fastonosql {
 namespace proxy {
 
 class IDriver;
+class ICluster;
 class IServer : public IServerBase, public std::enable_shared_from_this<IServer> {
   Q_OBJECT
+  friend class ICluster;
+
  public:
   typedef core::IDataBaseInfoSPtr database_t;
   typedef std::vector<database_t> databases_t;
+  enum DriverLane { INTERACTIVE_LANE = 0, BULK_LANE, MONITORING_LANE, STREAMING_LANE, DRIVER_LANES_COUNT };
   virtual ~IServer();
 
   // sync methods
@@ -52,6 +56,7 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
 
   database_t GetCurrentDatabaseInfo() const;
   core::IServerInfoSPtr GetCurrentServerInfo() const;
+  ICluster* GetCluster() const;  // nullptr if not node of cluster
 
   std::string GetDelimiter() const;
   std::string GetNsSeparator() const;
@@ -139,7 +144,8 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
                                                                          // LoadDatabasesFinished
   void LoadDatabaseContent(const events_info::LoadDatabaseContentRequest& req);  // signals: LoadDataBaseContentStarted,
                                                                                  // LoadDatabaseContentFinished
-  void Execute(const events_info::ExecuteInfoRequest& req);                      // signals: ExecuteStarted
+  void Execute(const events_info::ExecuteInfoRequest& req);  // signals: ExecuteStarted, commands of cluster node
+                                                             // routed by cluster
 
   void BackupToPath(const events_info::BackupInfoRequest& req);      // signals: BackupStarted, BackupFinished
   void RestoreFromPath(const events_info::RestoreInfoRequest& req);  // signals: ExportStarted, ExportFinished
@@ -162,6 +168,8 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
 
  protected:
   explicit IServer(IDriver* drv);  // take ownerships
+  // each lane own connection and thread, null lane served by interactive driver
+  IServer(IDriver* drv, IDriver* bulk_drv, IDriver* monitoring_drv, IDriver* streaming_drv);  // take ownerships
 
   void StartCheckKeyExistTimer();
   void StopCheckKeyExistTimer();
@@ -207,6 +215,7 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void LoadKeyTTL(core::NKey key, core::ttl_t ttl);
   void LoadModule(core::ModuleInfo module);
   void UnLoadModule(core::ModuleInfo module);
+  void DisconnectLane();
 
  private:
   void HandleCheckDBKeys(core::IDataBaseInfoSPtr db, core::ttl_t expired_time);
@@ -220,6 +229,21 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
 
   void ProcessDiscoveryInfo(const events_info::DiscoveryInfoRequest& req);
 
+  void ExecuteDirect(const events_info::ExecuteInfoRequest& req);  // without cluster routing
+  DriverLane GetLane(QEvent* ev) const;  // interactive lane if own lane of request is not connected
+  int FindLane(QObject* drv) const;      // -1 if not a lane driver
+  void PostToLane(DriverLane lane, QEvent* ev);
+  void SelectLaneDatabase(DriverLane lane);  // lanes follow database selected on interactive one
+  void FinishLaneRequest(QEvent* ev);
+  void ConnectLaneSignals(IDriver* lane);
+  void ConnectLanes(const events_info::ConnectInfoRequest& req);
+  void DisconnectLanes(const events_info::DisConnectInfoRequest& req);
+
+  IDriver* lanes_[DRIVER_LANES_COUNT];
+  bool lanes_connected_[DRIVER_LANES_COUNT];
+  size_t lanes_requests_[DRIVER_LANES_COUNT];       // posted and not answered, interrupted by StopCurrentEvent
+  std::string lanes_database_[DRIVER_LANES_COUNT];  // selected on lane connection, empty - unknown
+  ICluster* cluster_;                               // set while server is node of cluster
   core::IServerInfoSPtr server_info_;
   database_t current_database_info_;
   int timer_check_key_exists_id_;
@@ -25,5 +25,10 @@ IServerRemote::IServerRemote(IDriver* drv) : IServer(drv) {
   CHECK(IsCanRemote());
 }
 
+IServerRemote::IServerRemote(IDriver* drv, IDriver* bulk_drv, IDriver* monitoring_drv, IDriver* streaming_drv)
+    : IServer(drv, bulk_drv, monitoring_drv, streaming_drv) {
+  CHECK(IsCanRemote());
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
@@ -34,6 +34,7 @@ class IServerRemote : public IServer {
 
  protected:
   explicit IServerRemote(IDriver* drv);
+  IServerRemote(IDriver* drv, IDriver* bulk_drv, IDriver* monitoring_drv, IDriver* streaming_drv);
 };
 
 }  // namespace proxy
@@ -49,10 +49,17 @@
 #define AUTOOPENCONSOLE PREFIX "auto_open_console"
 #define AUTOCONNECTDB "auto_connect_db"
 #define FASTVIEWKEYS PREFIX "fast_view_keys"
+#define OUTPUT_RING_SIZE PREFIX "output_ring_size"
+#define OUTPUT_SPILL PREFIX "output_spill"
+#define QUERY_COST_THRESHOLD PREFIX "query_cost_threshold"
+#define QUERY_COST_CONFIRM PREFIX "query_cost_confirm"
 #define WINDOW_SETTINGS PREFIX "window_settings"
 #define PYTHON_PATH PREFIX "python_path"
 #define CONFIG_VERSION PREFIX "version"
 
+#define DEFAULT_OUTPUT_RING_SIZE 10000
+#define DEFAULT_QUERY_COST_THRESHOLD 100000
+
 #ifdef OS_WIN
 #define PYTHON_FILE_NAME "python.exe"
 #else
@@ -96,6 +103,10 @@ SettingsManager::SettingsManager()
       auto_completion_(),
       auto_open_console_(),
       fast_view_keys_(),
+      output_ring_size_(DEFAULT_OUTPUT_RING_SIZE),
+      output_spill_(),
+      query_cost_threshold_(DEFAULT_QUERY_COST_THRESHOLD),
+      query_cost_confirm_(true),
       window_settings_(),
       python_path_(),
       user_info_() {}
@@ -304,6 +315,38 @@ void SettingsManager::SetFastViewKeys(bool fast_view) {
   fast_view_keys_ = fast_view;
 }
 
+uint32_t SettingsManager::GetOutputRingSize() const {
+  return output_ring_size_;
+}
+
+void SettingsManager::SetOutputRingSize(uint32_t size) {
+  output_ring_size_ = size;
+}
+
+bool SettingsManager::GetOutputSpill() const {
+  return output_spill_;
+}
+
+void SettingsManager::SetOutputSpill(bool spill) {
+  output_spill_ = spill;
+}
+
+uint32_t SettingsManager::GetQueryCostThreshold() const {
+  return query_cost_threshold_;
+}
+
+void SettingsManager::SetQueryCostThreshold(uint32_t threshold) {
+  query_cost_threshold_ = threshold;
+}
+
+bool SettingsManager::GetQueryCostConfirm() const {
+  return query_cost_confirm_;
+}
+
+void SettingsManager::SetQueryCostConfirm(bool confirm) {
+  query_cost_confirm_ = confirm;
+}
+
 QByteArray SettingsManager::GetWindowSettings() const {
   return window_settings_;
 }
@@ -402,6 +445,10 @@ void SettingsManager::ReloadFromPath(const std::string& path, bool merge) {
   auto_open_console_ = settings.value(AUTOOPENCONSOLE, true).toBool();
   auto_connect_db_ = settings.value(AUTOCONNECTDB, true).toBool();
   fast_view_keys_ = settings.value(FASTVIEWKEYS, true).toBool();
+  output_ring_size_ = settings.value(OUTPUT_RING_SIZE, DEFAULT_OUTPUT_RING_SIZE).toUInt();
+  output_spill_ = settings.value(OUTPUT_SPILL, false).toBool();
+  query_cost_threshold_ = settings.value(QUERY_COST_THRESHOLD, DEFAULT_QUERY_COST_THRESHOLD).toUInt();
+  query_cost_confirm_ = settings.value(QUERY_COST_CONFIRM, true).toBool();
   window_settings_ = settings.value(WINDOW_SETTINGS, QByteArray()).toByteArray();
 
   QString qpython_path;
@@ -484,6 +531,10 @@ void SettingsManager::Save() {
   settings.setValue(AUTOOPENCONSOLE, auto_open_console_);
   settings.setValue(AUTOCONNECTDB, auto_connect_db_);
   settings.setValue(FASTVIEWKEYS, fast_view_keys_);
+  settings.setValue(OUTPUT_RING_SIZE, output_ring_size_);
+  settings.setValue(OUTPUT_SPILL, output_spill_);
+  settings.setValue(QUERY_COST_THRESHOLD, query_cost_threshold_);
+  settings.setValue(QUERY_COST_CONFIRM, query_cost_confirm_);
   settings.setValue(WINDOW_SETTINGS, window_settings_);
   settings.setValue(PYTHON_PATH, python_path_);
   settings.setValue(CONFIG_VERSION, config_version_);
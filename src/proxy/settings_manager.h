@@ -104,6 +104,20 @@ class SettingsManager : public common::patterns::Singleton<SettingsManager> {
   bool GetFastViewKeys() const;
   void SetFastViewKeys(bool fast_view);
 
+  // last messages kept by streaming commands (MONITOR, SUBSCRIBE, SYNC), 0 - unlimited
+  uint32_t GetOutputRingSize() const;
+  void SetOutputRingSize(uint32_t size);
+
+  bool GetOutputSpill() const;
+  void SetOutputSpill(bool spill);
+
+  // elements above which KEYS/HGETALL/SMEMBERS/ranges are read page by page, 0 - no pre-flight
+  uint32_t GetQueryCostThreshold() const;
+  void SetQueryCostThreshold(uint32_t threshold);
+
+  bool GetQueryCostConfirm() const;  // ask before expensive reads typed in shell
+  void SetQueryCostConfirm(bool confirm);
+
   QByteArray GetWindowSettings() const;
   void SetWindowSettings(const QByteArray& settings);
 
@@ -139,6 +153,10 @@ class SettingsManager : public common::patterns::Singleton<SettingsManager> {
   bool auto_open_console_;
   bool auto_connect_db_;
   bool fast_view_keys_;
+  uint32_t output_ring_size_;
+  bool output_spill_;
+  uint32_t query_cost_threshold_;
+  bool query_cost_confirm_;
   QByteArray window_settings_;
   QString python_path_;
 
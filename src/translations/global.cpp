@@ -99,6 +99,8 @@ const QString trErrors = QObject::tr("Errors");
 const QString trCalculating = QObject::tr("Calculate...");
 const QString trName = QObject::tr("Name");
 const QString trNumberOfSubscribers = QObject::tr("Number of subscribers");
+const QString trMessagesPerSecond = QObject::tr("Messages/sec");
+const QString trBytesPerSecond = QObject::tr("Bytes/sec");
 const QString trAddress = QObject::tr("Address");
 const QString trPassword = QObject::tr("Password");
 const QString trAuthentication = QObject::tr("Authentication");
@@ -173,6 +175,7 @@ const QString trViewKeysDialog = QObject::tr("View keys dialog");
 const QString trPubSubDialog = QObject::tr("Publish/Subscribe dialog");
 const QString trPublish = QObject::tr("Publish");
 const QString trEncodeDecode = QObject::tr("Encode/Decode");
+const QString trWorkload = QObject::tr("Workload");
 const QString trEncode = QObject::tr("Encode");
 const QString trDecode = QObject::tr("Decode");
 const QString trConnectionDiagnostic = QObject::tr("Connection diagnostic");
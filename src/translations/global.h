@@ -99,6 +99,8 @@ extern const QString trErrors;
 extern const QString trCalculating;
 extern const QString trName;
 extern const QString trNumberOfSubscribers;
+extern const QString trMessagesPerSecond;
+extern const QString trBytesPerSecond;
 extern const QString trAddress;
 extern const QString trPassword;
 extern const QString trAuthentication;
@@ -173,6 +175,7 @@ extern const QString trViewKeysDialog;
 extern const QString trPubSubDialog;
 extern const QString trPublish;
 extern const QString trEncodeDecode;
+extern const QString trWorkload;
 extern const QString trEncode;
 extern const QString trDecode;
 extern const QString trConnectionDiagnostic;
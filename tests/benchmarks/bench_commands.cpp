@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <common/convert2string.h>
+
+#include "core/glob_pattern.h"
+#include "core/icommand_translator.h"
+#include "core/types.h"
+
+using namespace fastonosql;
+
+namespace {
+
+core::command_buffer_t MakeScript(size_t lines) {
+  core::command_buffer_t script;
+  for (size_t i = 0; i < lines; ++i) {
+    script += "  SET key:" + common::ConvertToString(i) + "   \"some value with spaces\"  \n";
+  }
+  return script;
+}
+
+core::readable_string_t MakeData(size_t size, bool binary) {
+  core::readable_string_t data;
+  data.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    data.push_back(binary ? static_cast<char>(i % 256) : static_cast<char>('a' + i % 26));
+  }
+  return data;
+}
+
+}  // namespace
+
+static void BM_StableCommand(benchmark::State& state) {
+  const core::command_buffer_t input = "   HMSET   user:1000 name \"John Smith\" email john@example.com   ";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(core::StableCommand(input));
+  }
+}
+BENCHMARK(BM_StableCommand);
+
+static void BM_ParseCommands(benchmark::State& state) {
+  const core::command_buffer_t script = MakeScript(state.range(0));
+  for (auto _ : state) {
+    std::vector<core::command_buffer_t> cmds;
+    common::Error err = core::ParseCommands(script, &cmds);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(cmds);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * script.size());
+}
+BENCHMARK(BM_ParseCommands)->Arg(1)->Arg(100)->Arg(10000);
+
+// construction classifies data as text or binary
+static void BM_ReadableStringDetect(benchmark::State& state) {
+  const core::readable_string_t data = MakeData(state.range(0), state.range(1));
+  for (auto _ : state) {
+    core::ReadableString str(data);
+    benchmark::DoNotOptimize(str.GetType());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_ReadableStringDetect)->Args({16, 0})->Args({16, 1})->Args({4096, 0})->Args({4096, 1});
+
+static void BM_ReadableStringForCommandLine(benchmark::State& state) {
+  const core::ReadableString str(MakeData(state.range(0), state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(str.GetForCommandLine());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadableStringForCommandLine)->Args({16, 0})->Args({16, 1})->Args({4096, 0})->Args({4096, 1});
+
+static void BM_ReadableStringHumanReadable(benchmark::State& state) {
+  const core::ReadableString str(MakeData(state.range(0), true));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(str.GetHumanReadable());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadableStringHumanReadable)->Arg(16)->Arg(4096);
+
+static void BM_GlobMatch(benchmark::State& state) {
+  const core::GlobPattern glob("user:*:session:[0-9]?*:active");
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 1024; ++i) {
+    keys.push_back("user:" + common::ConvertToString(i) + ":session:" + common::ConvertToString(i * 7) +
+                   (i % 2 ? ":active" : ":expired"));
+  }
+
+  for (auto _ : state) {
+    size_t matched = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      matched += glob.Match(keys[i]);
+    }
+    benchmark::DoNotOptimize(matched);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_GlobMatch);
@@ -0,0 +1,255 @@
+#include <benchmark/benchmark.h>
+
+#include <common/convert2string.h>
+#include <common/file_system/file_system.h>
+
+#include "core/global.h"
+
+#ifdef BUILD_WITH_FORESTDB
+#include "core/db/forestdb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_LEVELDB
+#include "core/db/leveldb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_LMDB
+#include "core/db/lmdb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_ROCKSDB
+#include "core/db/rocksdb/db_connection.h"
+#endif
+#ifdef BUILD_WITH_UNQLITE
+#include "core/db/unqlite/db_connection.h"
+#endif
+#ifdef BUILD_WITH_UPSCALEDB
+#include "core/db/upscaledb/db_connection.h"
+#endif
+
+#define BENCHMARKS_DB_DIR "core_benchmarks_db"
+
+using namespace fastonosql;
+
+namespace {
+
+void PrepareDirectory() {
+  common::ErrnoError errn = common::file_system::remove_directory(BENCHMARKS_DB_DIR, true);
+  UNUSED(errn);  // may not exist
+  errn = common::file_system::create_directory(BENCHMARKS_DB_DIR, true);
+  DCHECK(!errn);
+}
+
+void CleanupDirectory() {
+  common::ErrnoError errn = common::file_system::remove_directory(BENCHMARKS_DB_DIR, true);
+  DCHECK(!errn);
+}
+
+core::NKey MakeKey(size_t i) {
+  core::key_t key_str("bench:" + common::ConvertToString(i));
+  return core::NKey(key_str);
+}
+
+core::NDbKValue MakeKeyValue(size_t i, size_t value_size) {
+  core::NValue val(common::Value::CreateStringValue(std::string(value_size, 'v')));
+  return core::NDbKValue(MakeKey(i), val);
+}
+
+#ifdef BUILD_WITH_FORESTDB
+struct ForestDBTraits {
+  typedef core::forestdb::DBConnection connection_t;
+  static core::forestdb::Config MakeConfig() {
+    core::forestdb::Config cfg;
+    cfg.db_path = BENCHMARKS_DB_DIR "/forestdb.db";
+    return cfg;
+  }
+};
+#endif
+#ifdef BUILD_WITH_LEVELDB
+struct LevelDBTraits {
+  typedef core::leveldb::DBConnection connection_t;
+  static core::leveldb::Config MakeConfig() {
+    core::leveldb::Config cfg;
+    cfg.db_path = BENCHMARKS_DB_DIR "/leveldb";
+    cfg.create_if_missing = true;
+    return cfg;
+  }
+};
+#endif
+#ifdef BUILD_WITH_LMDB
+struct LMDBTraits {
+  typedef core::lmdb::DBConnection connection_t;
+  static core::lmdb::Config MakeConfig() {
+    core::lmdb::Config cfg;
+    cfg.db_path = BENCHMARKS_DB_DIR "/lmdb.db";
+    cfg.SetReadOnlyDB(false);
+    return cfg;
+  }
+};
+#endif
+#ifdef BUILD_WITH_ROCKSDB
+struct RocksDBTraits {
+  typedef core::rocksdb::DBConnection connection_t;
+  static core::rocksdb::Config MakeConfig() {
+    core::rocksdb::Config cfg;
+    cfg.db_path = BENCHMARKS_DB_DIR "/rocksdb";
+    cfg.create_if_missing = true;
+    return cfg;
+  }
+};
+#endif
+#ifdef BUILD_WITH_UNQLITE
+struct UnqliteTraits {
+  typedef core::unqlite::DBConnection connection_t;
+  static core::unqlite::Config MakeConfig() {
+    core::unqlite::Config cfg;
+    cfg.db_path = BENCHMARKS_DB_DIR "/unqlite.db";
+    cfg.SetCreateIfMissingDB(true);
+    return cfg;
+  }
+};
+#endif
+#ifdef BUILD_WITH_UPSCALEDB
+struct UpscaleDBTraits {
+  typedef core::upscaledb::DBConnection connection_t;
+  static core::upscaledb::Config MakeConfig() {
+    core::upscaledb::Config cfg;
+    cfg.db_path = BENCHMARKS_DB_DIR "/upscaledb.db";
+    cfg.create_if_missing = true;
+    return cfg;
+  }
+};
+#endif
+
+// connection to a fresh temporary database filled with count keys
+template <typename Traits>
+class TemporaryDB {
+ public:
+  TemporaryDB(benchmark::State& state, size_t count, size_t value_size) : db_(nullptr), state_(state) {
+    PrepareDirectory();
+    common::Error err = db_.Connect(Traits::MakeConfig());
+    if (err) {
+      state_.SkipWithError(err->GetDescription().c_str());
+      return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      core::NDbKValue added;
+      err = db_.Set(MakeKeyValue(i, value_size), &added);
+      if (err) {
+        state_.SkipWithError(err->GetDescription().c_str());
+        return;
+      }
+    }
+  }
+
+  ~TemporaryDB() {
+    if (db_.IsConnected()) {
+      common::Error err = db_.Disconnect();
+      DCHECK(!err);
+    }
+    CleanupDirectory();
+  }
+
+  bool IsValid() const { return db_.IsConnected() && !state_.error_occurred(); }
+
+  typename Traits::connection_t* operator->() { return &db_; }
+
+ private:
+  typename Traits::connection_t db_;
+  benchmark::State& state_;
+};
+
+}  // namespace
+
+// range(0) value size in bytes
+template <typename Traits>
+static void BM_EngineSet(benchmark::State& state) {
+  TemporaryDB<Traits> db(state, 0, 0);
+  if (!db.IsValid()) {
+    return;
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    core::NDbKValue added;
+    common::Error err = db->Set(MakeKeyValue(i++, state.range(0)), &added);
+    benchmark::DoNotOptimize(err);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// range(0) keys in database
+template <typename Traits>
+static void BM_EngineGet(benchmark::State& state) {
+  const size_t count = state.range(0);
+  TemporaryDB<Traits> db(state, count, 128);
+  if (!db.IsValid()) {
+    return;
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    core::NDbKValue loaded;
+    common::Error err = db->Get(MakeKey(i++ % count), &loaded);
+    benchmark::DoNotOptimize(err);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// range(0) keys in database, range(1) keys per page
+template <typename Traits>
+static void BM_EngineScan(benchmark::State& state) {
+  TemporaryDB<Traits> db(state, state.range(0), 16);
+  if (!db.IsValid()) {
+    return;
+  }
+
+  for (auto _ : state) {
+    std::vector<std::string> keys;
+    core::cursor_t cursor_out = 0;
+    common::Error err = db->Scan(0, ALL_KEYS_PATTERNS, state.range(1), &keys, &cursor_out);
+    benchmark::DoNotOptimize(err);
+    benchmark::DoNotOptimize(keys);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// CommandHandler::Execute: tokenizing, lookup in the translator commands table, arity checks and the handler
+template <typename Traits>
+static void BM_CommandHandlerExecute(benchmark::State& state, const core::command_buffer_t& command) {
+  TemporaryDB<Traits> db(state, 1, 16);
+  if (!db.IsValid()) {
+    return;
+  }
+
+  for (auto _ : state) {
+    core::FastoObjectIPtr root = core::FastoObject::CreateRoot(command);
+    common::Error err = db->Execute(command, root.get());
+    benchmark::DoNotOptimize(err);
+  }
+}
+
+#define REGISTER_ENGINE_BENCHMARKS(Traits)                                                               \
+  BENCHMARK_TEMPLATE(BM_EngineSet, Traits)->Arg(16)->Arg(4096);                                          \
+  BENCHMARK_TEMPLATE(BM_EngineGet, Traits)->Arg(10000);                                                  \
+  BENCHMARK_TEMPLATE(BM_EngineScan, Traits)->Args({10000, 100})->Args({10000, 10000});                   \
+  BENCHMARK_CAPTURE(BM_CommandHandlerExecute<Traits>, get, core::command_buffer_t("GET bench:0"));       \
+  BENCHMARK_CAPTURE(BM_CommandHandlerExecute<Traits>, wrong_arity, core::command_buffer_t("GET"))
+
+#ifdef BUILD_WITH_FORESTDB
+REGISTER_ENGINE_BENCHMARKS(ForestDBTraits);
+#endif
+#ifdef BUILD_WITH_LEVELDB
+REGISTER_ENGINE_BENCHMARKS(LevelDBTraits);
+#endif
+#ifdef BUILD_WITH_LMDB
+REGISTER_ENGINE_BENCHMARKS(LMDBTraits);
+#endif
+#ifdef BUILD_WITH_ROCKSDB
+REGISTER_ENGINE_BENCHMARKS(RocksDBTraits);
+#endif
+#ifdef BUILD_WITH_UNQLITE
+REGISTER_ENGINE_BENCHMARKS(UnqliteTraits);
+#endif
+#ifdef BUILD_WITH_UPSCALEDB
+REGISTER_ENGINE_BENCHMARKS(UpscaleDBTraits);
+#endif
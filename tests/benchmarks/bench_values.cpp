@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <stdlib.h>  // for calloc, free
+#include <string.h>  // for memcpy
+
+#include <memory>
+
+#include <common/convert2string.h>
+
+#include "core/value.h"
+
+#ifdef BUILD_WITH_REDIS
+#include <hiredis/hiredis.h>
+
+#include "core/db/redis_compatible/db_connection.h"
+#endif
+
+using namespace fastonosql;
+
+namespace {
+
+common::ArrayValue* MakeArray(size_t size) {
+  common::ArrayValue* array = common::Value::CreateArrayValue();
+  for (size_t i = 0; i < size; ++i) {
+    array->Append(common::Value::CreateStringValue("member:" + common::ConvertToString(i)));
+  }
+  return array;
+}
+
+common::HashValue* MakeHash(size_t size) {
+  common::HashValue* hash = common::Value::CreateHashValue();
+  for (size_t i = 0; i < size; ++i) {
+    std::string key = "field:" + common::ConvertToString(i);
+    std::string val = "value:" + common::ConvertToString(i);
+    hash->Insert(key, val);
+  }
+  return hash;
+}
+
+#ifdef BUILD_WITH_REDIS
+// synthetic replies owned by the benchmark, hiredis allocator is not involved
+redisReply* MakeStringReply(const std::string& str) {
+  redisReply* reply = static_cast<redisReply*>(calloc(1, sizeof(redisReply)));
+  reply->type = REDIS_REPLY_STRING;
+  reply->len = str.size();
+  reply->str = static_cast<char*>(malloc(str.size() + 1));
+  memcpy(reply->str, str.c_str(), str.size() + 1);
+  return reply;
+}
+
+redisReply* MakeArrayReply(size_t size, size_t depth) {
+  redisReply* reply = static_cast<redisReply*>(calloc(1, sizeof(redisReply)));
+  reply->type = REDIS_REPLY_ARRAY;
+  reply->elements = size;
+  reply->element = static_cast<redisReply**>(calloc(size, sizeof(redisReply*)));
+  for (size_t i = 0; i < size; ++i) {
+    reply->element[i] =
+        depth > 1 ? MakeArrayReply(size, depth - 1) : MakeStringReply("element:" + common::ConvertToString(i));
+  }
+  return reply;
+}
+
+void FreeReply(redisReply* reply) {
+  if (reply->type == REDIS_REPLY_ARRAY) {
+    for (size_t i = 0; i < reply->elements; ++i) {
+      FreeReply(reply->element[i]);
+    }
+    free(reply->element);
+  }
+  free(reply->str);
+  free(reply);
+}
+#endif
+
+}  // namespace
+
+static void BM_ConvertValueArray(benchmark::State& state) {
+  std::unique_ptr<common::ArrayValue> array(MakeArray(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(core::ConvertValue(array.get(), " "));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertValueArray)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void BM_ConvertValueHash(benchmark::State& state) {
+  std::unique_ptr<common::HashValue> hash(MakeHash(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(core::ConvertValue(hash.get(), " "));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertValueHash)->Arg(10)->Arg(1000)->Arg(100000);
+
+#ifdef BUILD_WITH_REDIS
+// range(0) elements per array, range(1) nesting depth
+static void BM_ValueFromReplay(benchmark::State& state) {
+  redisReply* reply = MakeArrayReply(state.range(0), state.range(1));
+  for (auto _ : state) {
+    common::Value* value = nullptr;
+    common::Error err = core::redis_compatible::ValueFromReplay(reply, &value);
+    benchmark::DoNotOptimize(err);
+    delete value;
+  }
+  FreeReply(reply);
+}
+BENCHMARK(BM_ValueFromReplay)->Args({1, 1})->Args({1000, 1})->Args({100000, 1})->Args({100, 2});
+#endif
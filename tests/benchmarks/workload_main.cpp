@@ -0,0 +1,102 @@
+#include <stdio.h>   // for printf
+#include <stdlib.h>  // for EXIT_SUCCESS, EXIT_FAILURE
+#include <string.h>  // for strcmp
+
+#include <common/convert2string.h>
+
+#include "core/workload.h"
+
+using namespace fastonosql;
+
+namespace {
+
+void Usage(const char* name) {
+  printf(
+      "Usage: %s [options]\n"
+      "  -e <engine>       LevelDB, RocksDB, LMDB, UnQLite, UpscaleDB, ForestDB or all (default all)\n"
+      "  -r <count>        records inserted in load phase\n"
+      "  -o <count>        operations in run phase\n"
+      "  -read <p>         read proportion\n"
+      "  -update <p>       update proportion\n"
+      "  -insert <p>       insert proportion\n"
+      "  -scan <p>         scan proportion\n"
+      "  -d <distribution> uniform or zipfian\n"
+      "  -v <bytes>        value size\n"
+      "  -s <count>        keys per scan\n"
+      "  -t <count>        threads\n"
+      "  -p <path>         directory for temporary databases\n",
+      name);
+}
+
+template <typename T>
+bool ParseNumber(const char* arg, T* out) {
+  return common::ConvertFromString(std::string(arg), out);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  core::WorkloadConfig config;
+  std::string engine = "all";
+  std::string directory = "core_workload_db";
+  bool ok = true;
+  for (int i = 1; i < argc && ok; i++) {
+    const bool lastarg = i == argc - 1;
+    if (!strcmp(argv[i], "-e") && !lastarg) {
+      engine = argv[++i];
+    } else if (!strcmp(argv[i], "-r") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.record_count);
+    } else if (!strcmp(argv[i], "-o") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.operation_count);
+    } else if (!strcmp(argv[i], "-read") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.proportions[core::WORKLOAD_READ]);
+    } else if (!strcmp(argv[i], "-update") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.proportions[core::WORKLOAD_UPDATE]);
+    } else if (!strcmp(argv[i], "-insert") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.proportions[core::WORKLOAD_INSERT]);
+    } else if (!strcmp(argv[i], "-scan") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.proportions[core::WORKLOAD_SCAN]);
+    } else if (!strcmp(argv[i], "-d") && !lastarg) {
+      ok = common::ConvertFromString(std::string(argv[++i]), &config.distribution);
+    } else if (!strcmp(argv[i], "-v") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.value_size);
+    } else if (!strcmp(argv[i], "-s") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.scan_length);
+    } else if (!strcmp(argv[i], "-t") && !lastarg) {
+      ok = ParseNumber(argv[++i], &config.threads);
+    } else if (!strcmp(argv[i], "-p") && !lastarg) {
+      directory = argv[++i];
+    } else {
+      ok = false;
+    }
+  }
+
+  if (!ok || !config.IsValid()) {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  int status = EXIT_SUCCESS;
+  bool found = false;
+  for (core::connectionTypes type : core::g_compiled_types) {
+    if (!core::IsLocalType(type) || (engine != "all" && engine != common::ConvertToString(type))) {
+      continue;
+    }
+
+    found = true;
+    core::WorkloadResult result;
+    common::Error err = core::RunLocalWorkload(type, directory, config, &result);
+    if (err) {
+      printf("%s: %s\n", core::ConnectionTypeToString(type), err->GetDescription().c_str());
+      status = EXIT_FAILURE;
+      continue;
+    }
+    printf("%s", result.ToString().c_str());
+  }
+
+  if (!found) {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  return status;
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <common/macros.h>
+
+#include "core/db/redis_compatible/cluster_slots.h"
+#include "core/db/redis_compatible/command_translator.h"
+
+using namespace fastonosql;
+
+namespace {
+
+common::Error test(core::internal::CommandHandler* handler, core::commands_args_t argv, core::FastoObject* out) {
+  UNUSED(handler);
+  UNUSED(argv);
+  UNUSED(out);
+  return common::Error();
+}
+
+const std::vector<core::CommandHolder> cmds = {
+    core::CommandHolder("GET", "<key>", "Get the value of a key", UNDEFINED_SINCE, UNDEFINED_EXAMPLE_STR, 1, 0,
+                        core::CommandInfo::Native, &test),
+    core::CommandHolder("MGET", "<key> [key ...]", "Get the values of all the given keys", UNDEFINED_SINCE,
+                        UNDEFINED_EXAMPLE_STR, 1, INFINITE_COMMAND_ARGS, core::CommandInfo::Native, &test),
+    core::CommandHolder("INFO", "[section]", "Get information and statistics about the server", UNDEFINED_SINCE,
+                        UNDEFINED_EXAMPLE_STR, 0, 1, core::CommandInfo::Native, &test)};
+
+}  // namespace
+
+TEST(ClusterSlots, hash_slot) {
+  ASSERT_EQ(core::redis_compatible::Crc16("123456789", 9), 0x31C3);
+  ASSERT_EQ(core::redis_compatible::KeyHashSlot("foo"), 12182);
+  ASSERT_EQ(core::redis_compatible::KeyHashSlot("{user1000}.following"),
+            core::redis_compatible::KeyHashSlot("{user1000}.followers"));
+  ASSERT_EQ(core::redis_compatible::KeyHashSlot("{}foo"), core::redis_compatible::Crc16("{}foo", 5) & 16383);
+}
+
+TEST(ClusterSlots, slot_map) {
+  core::redis_compatible::SlotMap map;
+  ASSERT_TRUE(map.IsEmpty());
+  common::net::HostAndPort host;
+  ASSERT_FALSE(map.GetKeyOwner("foo", &host));
+
+  const common::net::HostAndPort first("127.0.0.1", 30001);
+  const common::net::HostAndPort second("127.0.0.1", 30002);
+  map.SetSlotsOwner(0, 8191, first);
+  map.SetSlotsOwner(8192, 16383, second);
+  ASSERT_TRUE(map.GetKeyOwner("foo", &host));
+  ASSERT_EQ(host, second);
+  ASSERT_TRUE(map.GetSlotOwner(0, &host));
+  ASSERT_EQ(host, first);
+
+  map.SetSlotOwner(12182, first);  // MOVED
+  ASSERT_TRUE(map.GetKeyOwner("foo", &host));
+  ASSERT_EQ(host, first);
+
+  map.RemoveHost(first);
+  ASSERT_FALSE(map.GetSlotOwner(0, &host));
+  ASSERT_TRUE(map.GetSlotOwner(8192, &host));
+  ASSERT_EQ(host, second);
+
+  map.Clear();
+  ASSERT_TRUE(map.IsEmpty());
+}
+
+TEST(ClusterSlots, split_command) {
+  core::redis_compatible::CommandTranslator tran(cmds);
+  std::vector<core::redis_compatible::SlotCommand> routed;
+  ASSERT_FALSE(core::redis_compatible::SplitCommandBySlots(&tran, "INFO", &routed));
+  ASSERT_EQ(routed.size(), 1u);
+  ASSERT_FALSE(routed[0].keyed);
+
+  routed.clear();
+  ASSERT_FALSE(core::redis_compatible::SplitCommandBySlots(&tran, "GET foo", &routed));
+  ASSERT_EQ(routed.size(), 1u);
+  ASSERT_TRUE(routed[0].keyed);
+  ASSERT_EQ(routed[0].slot, 12182);
+
+  routed.clear();
+  ASSERT_FALSE(core::redis_compatible::SplitCommandBySlots(&tran, "MGET {a}1 b {a}2", &routed));
+  ASSERT_EQ(routed.size(), 2u);
+  ASSERT_EQ(routed[0].command, "MGET {a}1 {a}2");
+  ASSERT_EQ(routed[1].command, "MGET b");
+  ASSERT_EQ(routed[0].slot, core::redis_compatible::KeyHashSlot("a"));
+}
+
+TEST(ClusterSlots, parse_cluster_slots) {
+  common::ArrayValue* master = common::Value::CreateArrayValue();
+  master->Append(common::Value::CreateStringValue("127.0.0.1"));
+  master->Append(common::Value::CreateLongLongIntegerValue(30002));
+  master->Append(common::Value::CreateStringValue("node-id"));
+  common::ArrayValue* range = common::Value::CreateArrayValue();
+  range->Append(common::Value::CreateLongLongIntegerValue(5461));
+  range->Append(common::Value::CreateLongLongIntegerValue(10922));
+  range->Append(master);
+  std::unique_ptr<common::ArrayValue> reply(common::Value::CreateArrayValue());
+  reply->Append(range);
+
+  core::redis_compatible::SlotMap map;
+  ASSERT_FALSE(core::redis_compatible::ParseClusterSlots(reply.get(), &map));
+  common::net::HostAndPort host;
+  ASSERT_FALSE(map.GetSlotOwner(5460, &host));
+  ASSERT_TRUE(map.GetSlotOwner(5461, &host));
+  ASSERT_EQ(host, common::net::HostAndPort("127.0.0.1", 30002));
+  ASSERT_TRUE(map.GetSlotOwner(10922, &host));
+  ASSERT_FALSE(map.GetSlotOwner(10923, &host));
+
+  reply->Append(common::Value::CreateStringValue("garbage"));
+  ASSERT_TRUE(core::redis_compatible::ParseClusterSlots(reply.get(), &map));
+}
+
+TEST(ClusterSlots, merge_replies) {
+  core::redis_compatible::CommandTranslator tran(cmds);
+  std::vector<core::redis_compatible::SlotCommand> routed;
+  ASSERT_FALSE(core::redis_compatible::SplitCommandBySlots(&tran, "MGET {a}1 b {a}2", &routed));
+  ASSERT_EQ(routed.size(), 2u);
+
+  std::unique_ptr<common::ArrayValue> first(common::Value::CreateArrayValue());
+  first->Append(common::Value::CreateStringValue("a1"));
+  first->Append(common::Value::CreateStringValue("a2"));
+  std::unique_ptr<common::ArrayValue> second(common::Value::CreateArrayValue());
+  second->Append(common::Value::CreateNullValue());
+
+  common::Value* merged = nullptr;
+  ASSERT_FALSE(core::redis_compatible::MergeSlotReplies(routed, {first.get(), second.get()}, &merged));
+  std::unique_ptr<common::Value> merged_holder(merged);
+  common::ArrayValue* merged_arr = nullptr;
+  ASSERT_TRUE(merged->GetAsList(&merged_arr));
+  ASSERT_EQ(merged_arr->GetSize(), 3u);
+  std::string value;
+  ASSERT_TRUE(merged_arr->GetString(0, &value));
+  ASSERT_EQ(value, "a1");
+  ASSERT_TRUE(merged_arr->GetString(2, &value));
+  ASSERT_EQ(value, "a2");
+
+  std::unique_ptr<common::Value> one(common::Value::CreateLongLongIntegerValue(1));
+  std::unique_ptr<common::Value> two(common::Value::CreateLongLongIntegerValue(2));
+  common::Value* sum = nullptr;
+  ASSERT_FALSE(core::redis_compatible::MergeSlotReplies(routed, {one.get(), two.get()}, &sum));
+  std::unique_ptr<common::Value> sum_holder(sum);
+  long long count = 0;
+  ASSERT_TRUE(sum->GetAsLongLongInteger(&count));
+  ASSERT_EQ(count, 3);
+}
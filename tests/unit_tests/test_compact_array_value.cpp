@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "core/value.h"
+
+using namespace fastonosql::core;
+
+TEST(CompactArrayValue, AppendGet) {
+  CompactArrayValue arr;
+  arr.Append("one");
+  arr.Append(std::string());
+  arr.Append(std::string("th\0ree", 6));
+  ASSERT_EQ(arr.GetSize(), 3u);
+  ASSERT_EQ(arr.GetType(), CompactArrayValue::TYPE_COMPACT_ARRAY);
+
+  std::string str;
+  ASSERT_TRUE(arr.GetString(0, &str));
+  ASSERT_EQ(str, "one");
+  ASSERT_TRUE(arr.GetString(1, &str));
+  ASSERT_EQ(str, std::string());
+  ASSERT_TRUE(arr.GetString(2, &str));
+  ASSERT_EQ(str, std::string("th\0ree", 6));
+  ASSERT_FALSE(arr.GetString(3, &str));
+
+  std::unique_ptr<CompactArrayValue> copy(arr.DeepCopy());
+  ASSERT_TRUE(copy->Equals(&arr));
+  copy->Append("four");
+  ASSERT_FALSE(copy->Equals(&arr));
+}
+
+TEST(CompactArrayValue, SameTextAsArrayValue) {
+  CompactArrayValue compact;
+  std::unique_ptr<common::ArrayValue> arr(common::Value::CreateArrayValue());
+  for (size_t i = 0; i < 1000; ++i) {
+    const std::string item = i % 10 ? "item" : std::string();
+    compact.Append(item);
+    arr->Append(common::Value::CreateStringValue(item));
+  }
+
+  ASSERT_EQ(ConvertValue(&compact, ","), ConvertValue(arr.get(), ","));
+  ASSERT_EQ(ConvertValuePreview(&compact, ",", 10), ConvertValuePreview(arr.get(), ",", 10));
+  ASSERT_EQ(ConvertValuePreview(&compact, ",", 100000), ConvertValuePreview(arr.get(), ",", 100000));
+  ASSERT_STREQ(GetTypeName(compact.GetType()), GetTypeName(arr->GetType()));
+
+  std::unique_ptr<common::ArrayValue> expanded(compact.ToArrayValue());
+  ASSERT_TRUE(expanded->Equals(arr.get()));
+}
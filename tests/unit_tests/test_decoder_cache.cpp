@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "core/decoder_cache.h"
+
+using namespace fastonosql::core;
+
+TEST(DecoderCache, FindInsert) {
+  DecoderCache cache(1024);
+  std::string out;
+  ASSERT_FALSE(cache.Find("snappy", "input", &out));
+  cache.Insert("snappy", "input", "output");
+  ASSERT_TRUE(cache.Find("snappy", "input", &out));
+  ASSERT_EQ(out, "output");
+  ASSERT_FALSE(cache.Find("lz4", "input", &out));
+  ASSERT_FALSE(cache.Find("snappy", "inpu", &out));
+  ASSERT_EQ(cache.GetCount(), 1u);
+  ASSERT_EQ(cache.GetBytes(), std::string("snappyinputoutput").size());
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetCount(), 0u);
+  ASSERT_EQ(cache.GetBytes(), 0u);
+  ASSERT_FALSE(cache.Find("snappy", "input", &out));
+}
+
+TEST(DecoderCache, EvictLeastRecentlyUsed) {
+  DecoderCache cache(30);  // two entries of 12 bytes
+  cache.Insert("d", "aaaaa", "AAAAAA");
+  cache.Insert("d", "bbbbb", "BBBBBB");
+  std::string out;
+  ASSERT_TRUE(cache.Find("d", "aaaaa", &out));  // b is oldest now
+  cache.Insert("d", "ccccc", "CCCCCC");
+  ASSERT_EQ(cache.GetCount(), 2u);
+  ASSERT_FALSE(cache.Find("d", "bbbbb", &out));
+  ASSERT_TRUE(cache.Find("d", "aaaaa", &out));
+  ASSERT_EQ(out, "AAAAAA");
+  ASSERT_TRUE(cache.Find("d", "ccccc", &out));
+  ASSERT_LE(cache.GetBytes(), cache.GetMaxBytes());
+}
+
+TEST(DecoderCache, TooBigEntry) {
+  DecoderCache cache(8);
+  cache.Insert("d", "input", "output");
+  std::string out;
+  ASSERT_FALSE(cache.Find("d", "input", &out));
+  ASSERT_EQ(cache.GetCount(), 0u);
+}
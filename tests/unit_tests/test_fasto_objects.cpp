@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "core/global.h"
+#include "core/object_arena.h"
 
 using namespace fastonosql::core;
 
@@ -19,3 +20,43 @@ TEST(FastoObject, LifeTimeScope) {
     root->AddChildren(ptr);
   }
 }
+
+TEST(FastoObject, ChildrensLimit) {
+  FastoObjectIPtr root = FastoObject::CreateRoot("root");
+  root->SetChildrensLimit(3);
+  for (int i = 0; i < 5; ++i) {
+    root->AddChildren(new FastoObject(root.get(), common::Value::CreateIntegerValue(i), "/n"));
+  }
+
+  FastoObject::childs_t childrens = root->GetChildrens();
+  ASSERT_EQ(childrens.size(), 3u);
+  ASSERT_EQ(root->GetChildrensTotal(), 5u);
+  for (int i = 0; i < 3; ++i) {
+    int val = 0;
+    ASSERT_TRUE(childrens[i]->GetValue()->GetAsInteger(&val));
+    ASSERT_EQ(val, i + 2);
+  }
+
+  root->SetChildrensLimit(2);
+  childrens = root->GetChildrens();
+  ASSERT_EQ(childrens.size(), 2u);
+  int val = 0;
+  ASSERT_TRUE(childrens[0]->GetValue()->GetAsInteger(&val));
+  ASSERT_EQ(val, 3);
+}
+
+TEST(FastoObject, ArenaTree) {
+  ObjectArena* arena = ObjectArena::Create();
+  ObjectArena* previous = ObjectArena::SetCurrent(arena);
+  FastoObjectIPtr root = FastoObject::CreateRoot("root");
+  root->SetChildrensLimit(10);
+  for (int i = 0; i < 100; ++i) {
+    root->AddChildren(new FastoObject(root.get(), common::Value::CreateIntegerValue(i), "/n"));
+  }
+  ASSERT_EQ(arena->GetLiveCount(), 11u);  // evicted childrens are freed back to arena
+
+  root.reset();
+  ASSERT_EQ(arena->GetLiveCount(), 0u);
+  ASSERT_TRUE(ObjectArena::SetCurrent(previous) == arena);
+  arena->Release();
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "core/glob_pattern.h"
+
+using namespace fastonosql;
+
+TEST(GlobPattern, prefix_suffix) {
+  core::GlobPattern all("*");
+  ASSERT_TRUE(all.IsMatchAll());
+  ASSERT_TRUE(all.GetPrefix().empty());
+  ASSERT_TRUE(all.Match("anything"));
+  ASSERT_FALSE(all.IsPastPrefix("anything"));
+
+  core::GlobPattern ns("user:1234:*");
+  ASSERT_EQ(ns.GetPrefix(), "user:1234:");
+  ASSERT_TRUE(ns.GetSuffix().empty());
+  ASSERT_TRUE(ns.Match("user:1234:name"));
+  ASSERT_FALSE(ns.Match("user:1235:name"));
+  ASSERT_FALSE(ns.IsPastPrefix("user:1234:zzz"));
+  ASSERT_TRUE(ns.IsPastPrefix("user:1235:"));
+
+  core::GlobPattern fixed("log:*:error");
+  ASSERT_EQ(fixed.GetPrefix(), "log:");
+  ASSERT_EQ(fixed.GetSuffix(), ":error");
+  ASSERT_TRUE(fixed.Match("log:2018:error"));
+  ASSERT_FALSE(fixed.Match("log:2018:info"));
+  ASSERT_FALSE(fixed.Match("log:error"));
+
+  core::GlobPattern literal("key");
+  ASSERT_EQ(literal.GetPrefix(), "key");
+  ASSERT_TRUE(literal.Match("key"));
+  ASSERT_FALSE(literal.Match("key1"));
+  ASSERT_FALSE(literal.IsPastPrefix("key"));
+  ASSERT_TRUE(literal.IsPastPrefix("key1"));
+
+  core::GlobPattern single("k?y");
+  ASSERT_EQ(single.GetPrefix(), "k");
+  ASSERT_EQ(single.GetSuffix(), "y");
+  ASSERT_TRUE(single.Match("key"));
+  ASSERT_FALSE(single.Match("ky"));
+
+  ASSERT_TRUE(core::GlobPattern("a*[bc]").GetSuffix().empty());
+  ASSERT_EQ(core::GlobPattern("a*[bc]d").GetSuffix(), "d");
+  ASSERT_EQ(core::GlobPattern("a*\\*x").GetSuffix(), "*x");
+  ASSERT_EQ(literal.GetSuffix(), "key");
+}
+
+TEST(GlobPattern, wildcards_and_classes) {
+  core::GlobPattern middle("a*b*c");
+  ASSERT_TRUE(middle.Match("abc"));
+  ASSERT_TRUE(middle.Match("axxbyybzc"));
+  ASSERT_FALSE(middle.Match("axxcyyb"));
+  ASSERT_FALSE(middle.Match("ab"));
+
+  core::GlobPattern stars("**");
+  ASSERT_TRUE(stars.Match(""));
+  ASSERT_TRUE(stars.Match("key"));
+
+  core::GlobPattern range("id:[0-9][^a-z]");
+  ASSERT_TRUE(range.Match("id:1A"));
+  ASSERT_FALSE(range.Match("id:1a"));
+  ASSERT_FALSE(range.Match("id:x1"));
+
+  core::GlobPattern set("*[xyz]?");
+  ASSERT_TRUE(set.Match("abcy1"));
+  ASSERT_FALSE(set.Match("abcw1"));
+
+  core::GlobPattern escaped("a\\*b\\?");
+  ASSERT_TRUE(escaped.Match("a*b?"));
+  ASSERT_FALSE(escaped.Match("axb?"));
+
+  core::GlobPattern binary(std::string("k\0*", 3));
+  ASSERT_TRUE(binary.Match(std::string("k\0\1\2", 4)));
+  ASSERT_FALSE(binary.Match("k1"));
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "core/json_pretty_printer.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+bool Format(const std::string& json, std::string* out) {
+  JsonPrettyPrinter printer(out);
+  return printer.Write(json) && printer.Finish();
+}
+
+}  // namespace
+
+TEST(JsonPrettyPrinter, Format) {
+  std::string out;
+  ASSERT_TRUE(Format("{\"a\":1,\"b\":[true, null,\"x y\"],\"c\":{},\"d\":[]}", &out));
+  ASSERT_EQ(out,
+            "{\n"
+            "  \"a\": 1,\n"
+            "  \"b\": [\n"
+            "    true,\n"
+            "    null,\n"
+            "    \"x y\"\n"
+            "  ],\n"
+            "  \"c\": {},\n"
+            "  \"d\": []\n"
+            "}");
+
+  out.clear();
+  ASSERT_TRUE(Format(" -12.5e+3 ", &out));
+  ASSERT_EQ(out, "-12.5e+3");
+
+  out.clear();
+  ASSERT_TRUE(Format("\"a\\\"{[\"", &out));
+  ASSERT_EQ(out, "\"a\\\"{[\"");
+}
+
+TEST(JsonPrettyPrinter, SplitInput) {
+  const std::string json = "{\"key\":[1,2,{\"n\":\"va\\\"lue\"}],\"t\":false}";
+  std::string whole;
+  ASSERT_TRUE(Format(json, &whole));
+
+  for (size_t split = 0; split <= json.size(); ++split) {
+    std::string out;
+    JsonPrettyPrinter printer(&out);
+    ASSERT_TRUE(printer.Write(json.data(), split));
+    ASSERT_TRUE(printer.Write(json.data() + split, json.size() - split));
+    ASSERT_TRUE(printer.Finish());
+    ASSERT_EQ(out, whole);
+  }
+}
+
+TEST(JsonPrettyPrinter, Invalid) {
+  const char* invalid[] = {"",      "hello", "{",         "[1,]",       "{\"a\" 1}", "{1:2}", "[1 2]",
+                           "01",    "1.",    "\"open",    "[1]]",       "{\"a\":1]", "1 2",   "tru",
+                           "[nul]", "-",     "\"a\nb\"", "{\"a\":1,}", "]"};
+  for (const char* json : invalid) {
+    std::string out;
+    ASSERT_FALSE(Format(json, &out)) << json;
+  }
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "core/keys_filter.h"
+
+using namespace fastonosql;
+
+TEST(KeysFilter, defaults_pass_everything) {
+  core::KeysFilter filter;
+  ASSERT_TRUE(filter.IsEmpty());
+  ASSERT_FALSE(filter.HasSizeRange());
+  ASSERT_TRUE(filter.IsPlainStringsAllowed());
+  ASSERT_TRUE(filter.IsTypeAllowed(common::Value::TYPE_HASH));
+  ASSERT_TRUE(filter.IsTTLAllowed(NO_TTL));
+  ASSERT_TRUE(filter.IsTTLAllowed(100));
+  ASSERT_TRUE(filter.IsSizeAllowed(0));
+}
+
+TEST(KeysFilter, type_ttl_size) {
+  core::KeysFilter filter;
+  filter.types.push_back(common::Value::TYPE_SET);
+  ASSERT_FALSE(filter.IsEmpty());
+  ASSERT_TRUE(filter.IsTypeAllowed(common::Value::TYPE_SET));
+  ASSERT_FALSE(filter.IsTypeAllowed(common::Value::TYPE_STRING));
+  ASSERT_FALSE(filter.IsPlainStringsAllowed());
+
+  core::KeysFilter ttl;
+  ttl.no_ttl = false;
+  ttl.min_ttl = 10;
+  ttl.max_ttl = 60;
+  ASSERT_FALSE(ttl.IsEmpty());
+  ASSERT_FALSE(ttl.IsTTLAllowed(NO_TTL));
+  ASSERT_FALSE(ttl.IsTTLAllowed(5));
+  ASSERT_TRUE(ttl.IsTTLAllowed(30));
+  ASSERT_FALSE(ttl.IsTTLAllowed(61));
+
+  core::KeysFilter size;
+  size.min_size = 1024;
+  ASSERT_TRUE(size.HasSizeRange());
+  ASSERT_FALSE(size.IsSizeAllowed(100));
+  ASSERT_TRUE(size.IsSizeAllowed(4096));
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include "core/object_arena.h"
+
+using namespace fastonosql::core;
+
+TEST(ObjectArena, HeapWithoutCurrentArena) {
+  ASSERT_TRUE(ObjectArena::GetCurrent() == nullptr);
+  void* ptr = ObjectArena::Allocate(100);
+  ASSERT_TRUE(ptr != nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, 0u);
+  ObjectArena::Free(ptr);
+  ObjectArena::Free(nullptr);
+}
+
+TEST(ObjectArena, ReusesFreedNodes) {
+  ObjectArena* arena = ObjectArena::Create(4096);
+  ObjectArena* previous = ObjectArena::SetCurrent(arena);
+  ASSERT_TRUE(previous == nullptr);
+
+  std::vector<void*> nodes;
+  for (size_t i = 0; i < 1000; ++i) {
+    void* node = ObjectArena::Allocate(100);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(node) % 16, 0u);
+    nodes.push_back(node);
+  }
+  ASSERT_EQ(arena->GetLiveCount(), 1000u);
+  const size_t blocks = arena->GetBlocksCount();
+  ASSERT_GT(blocks, 1u);
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    ObjectArena::Free(nodes[i]);
+  }
+  ASSERT_EQ(arena->GetLiveCount(), 0u);
+
+  // same size nodes come from free list, no new blocks
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    nodes[i] = ObjectArena::Allocate(100);
+  }
+  ASSERT_EQ(arena->GetBlocksCount(), blocks);
+
+  // big objects go to heap
+  void* big = ObjectArena::Allocate(ObjectArena::max_object_size * 2);
+  ASSERT_EQ(arena->GetLiveCount(), 1000u);
+  ObjectArena::Free(big);
+
+  ASSERT_TRUE(ObjectArena::SetCurrent(previous) == arena);
+  arena->Release();  // nodes still alive, arena stays until last one is freed
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    ObjectArena::Free(nodes[i]);
+  }
+}
+
+TEST(ObjectArena, FreeFromOtherThread) {
+  ObjectArena* arena = ObjectArena::Create();
+  ObjectArena* previous = ObjectArena::SetCurrent(arena);
+  std::vector<void*> nodes;
+  for (size_t i = 0; i < 100; ++i) {
+    nodes.push_back(ObjectArena::Allocate(48));
+  }
+  ObjectArena::SetCurrent(previous);
+  arena->Release();
+
+  std::thread th([&nodes]() {
+    ASSERT_TRUE(ObjectArena::GetCurrent() == nullptr);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      ObjectArena::Free(nodes[i]);
+    }
+  });
+  th.join();
+}
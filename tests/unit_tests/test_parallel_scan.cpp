@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "core/internal/parallel_scan.h"
+
+using namespace fastonosql;
+
+TEST(ParallelScan, split_key_range) {
+  core::internal::key_ranges_t one = core::internal::SplitKeyRange("key", "key");
+  ASSERT_EQ(one.size(), 1u);
+  ASSERT_TRUE(one[0].start.empty());
+  ASSERT_TRUE(one[0].limit.empty());
+
+  core::internal::key_ranges_t ranges = core::internal::SplitKeyRange("user:a", "user:c");
+  ASSERT_EQ(ranges.size(), 3u);
+  ASSERT_EQ(ranges[0].limit, "user:b");
+  ASSERT_EQ(ranges[1].start, "user:b");
+  ASSERT_EQ(ranges[1].limit, "user:c");
+  ASSERT_EQ(ranges[2].start, "user:c");
+  ASSERT_TRUE(ranges[2].limit.empty());
+
+  ASSERT_FALSE(ranges[0].IsPastLimit("user:a"));
+  ASSERT_FALSE(ranges[0].IsPastLimit("user:azzz"));
+  ASSERT_TRUE(ranges[0].IsPastLimit("user:b"));
+  ASSERT_FALSE(ranges[2].IsPastLimit("zzz"));
+}
+
+TEST(ParallelScan, merge_key_ranges) {
+  core::internal::key_ranges_t ranges = core::internal::SplitKeyRange("a", "d");
+  ASSERT_EQ(ranges.size(), 4u);
+  core::internal::key_ranges_t merged = core::internal::MergeKeyRanges(ranges, {10, 0, 0, 10}, 2);
+  ASSERT_EQ(merged.size(), 2u);
+  ASSERT_TRUE(merged[0].start.empty());
+  ASSERT_EQ(merged[0].limit, merged[1].start);
+  ASSERT_TRUE(merged[1].limit.empty());
+
+  core::internal::key_ranges_t unknown = core::internal::MergeKeyRanges(ranges, {0, 0, 0, 0}, 2);
+  ASSERT_EQ(unknown.size(), 4u);
+}
+
+TEST(ParallelScan, parallel_for) {
+  std::atomic<size_t> sum(0);
+  common::Error err = core::internal::ParallelFor(100, 4, [&sum](size_t task) {
+    sum += task;
+    return common::Error();
+  });
+  ASSERT_FALSE(err);
+  ASSERT_EQ(sum.load(), 4950u);
+
+  err = core::internal::ParallelFor(100, 4, [](size_t task) {
+    return task == 10 ? common::make_error("failed") : common::Error();
+  });
+  ASSERT_TRUE(err);
+}
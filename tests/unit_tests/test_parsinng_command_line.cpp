@@ -9,6 +9,8 @@ extern "C" {
 
 #include <string.h>
 
+#include "core/types.h"
+
 TEST(sds, sdssplitargslong) {
   const std::string json = R"({
                              "array": [
@@ -87,3 +89,40 @@ TEST(sds, sdssplitargslong) {
     sdsfreesplitres(argv, argc);
   }
 }
+
+TEST(TypedCommand, argv) {
+  fastonosql::core::TypedCommand cmd("CONFIG GET");
+  cmd << "hello world" << 10;
+  ASSERT_EQ(cmd.GetArgc(), 4u);
+  const fastonosql::core::commands_args_t argv = cmd.GetArgv();
+  ASSERT_EQ(argv[0], "CONFIG");
+  ASSERT_EQ(argv[1], "GET");
+  ASSERT_EQ(argv[2], "hello world");
+  ASSERT_EQ(argv[3], "10");
+
+  const fastonosql::core::command_buffer_t line = cmd.GetCommandLine();
+  int argc = 0;
+  sds* largv = sdssplitargslong(line.c_str(), &argc);
+  ASSERT_TRUE(largv && argc == 4);
+  if (largv) {
+    ASSERT_STREQ(largv[2], "hello world");
+    ASSERT_STREQ(largv[3], "10");
+    sdsfreesplitres(largv, argc);
+  }
+}
+
+TEST(TypedCommand, quoted_args) {
+  const fastonosql::core::commands_args_t argv = {"SET", "say \"hi\"", "c:\\dir name", "a  b", "{\"k\": 1}",
+                                                  "it's \"x\"", "", "x \\x41 y", "a\tb", "\\x41\\x42"};
+  const fastonosql::core::command_buffer_t line =
+      fastonosql::core::StableCommand(fastonosql::core::TypedCommand(argv).GetCommandLine());
+  int argc = 0;
+  sds* largv = sdssplitargslong(line.c_str(), &argc);
+  ASSERT_TRUE(largv && argc == static_cast<int>(argv.size()));
+  if (largv) {
+    for (int i = 0; i < argc; ++i) {
+      ASSERT_EQ(std::string(largv[i], sdslen(largv[i])), argv[i]);
+    }
+    sdsfreesplitres(largv, argc);
+  }
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "core/db/redis_compatible/query_cost.h"
+
+using namespace fastonosql;
+
+TEST(QueryCost, probes) {
+  core::commands_args_t probe;
+  ASSERT_TRUE(core::redis_compatible::GetQueryCostProbe({"keys", "user:*"}, &probe));
+  ASSERT_EQ(probe, core::commands_args_t({"DBSIZE"}));
+  ASSERT_TRUE(core::redis_compatible::GetQueryCostProbe({"HGETALL", "h"}, &probe));
+  ASSERT_EQ(probe, core::commands_args_t({"HLEN", "h"}));
+  ASSERT_TRUE(core::redis_compatible::GetQueryCostProbe({"ZRANGE", "z", "0", "-1", "WITHSCORES"}, &probe));
+  ASSERT_EQ(probe, core::commands_args_t({"ZCARD", "z"}));
+  ASSERT_TRUE(core::redis_compatible::GetQueryCostProbe({"XRANGE", "s", "-", "+", "COUNT", "10"}, &probe));
+  ASSERT_EQ(probe, core::commands_args_t({"XLEN", "s"}));
+
+  ASSERT_FALSE(core::redis_compatible::GetQueryCostProbe({"GET", "k"}, &probe));
+  ASSERT_FALSE(core::redis_compatible::GetQueryCostProbe({"LRANGE", "l", "0"}, &probe));
+  ASSERT_FALSE(core::redis_compatible::GetQueryCostProbe({"XRANGE", "s", "-", "+", "LIMIT", "10"}, &probe));
+}
+
+TEST(QueryCost, estimate) {
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"KEYS", "*"}, 500000), 500000u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"LRANGE", "l", "0", "-1"}, 1000), 1000u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"LRANGE", "l", "0", "9"}, 1000), 10u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"LRANGE", "l", "-10", "100000"}, 1000), 10u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"ZRANGE", "z", "5", "2"}, 1000), 0u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"XRANGE", "s", "-", "+", "COUNT", "10"}, 1000), 10u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"XRANGE", "s", "-", "+"}, 1000), 1000u);
+  ASSERT_EQ(core::redis_compatible::EstimateQueryCost({"SMEMBERS", "s"}, 0), 0u);
+}
+
+TEST(QueryCost, stream_id) {
+  std::string next;
+  ASSERT_TRUE(core::redis_compatible::IncrementStreamId("1526919030474-55", &next));
+  ASSERT_EQ(next, "1526919030474-56");
+  ASSERT_TRUE(core::redis_compatible::IncrementStreamId("7", &next));
+  ASSERT_EQ(next, "7-1");
+  ASSERT_TRUE(core::redis_compatible::IncrementStreamId("7-18446744073709551615", &next));
+  ASSERT_EQ(next, "8-0");
+  ASSERT_FALSE(core::redis_compatible::IncrementStreamId("-", &next));
+}
+
+TEST(QueryCost, scan_pager) {
+  core::redis_compatible::QueryPager pager({"keys", "user:*"}, 0, 1000);
+  ASSERT_TRUE(pager.IsValid());
+  ASSERT_TRUE(pager.IsScan());
+  ASSERT_EQ(pager.GetItemSize(), 1u);
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"SCAN", "0", "MATCH", "user:*", "COUNT", "1000"}));
+  pager.NextPage("17", 1000);
+  ASSERT_FALSE(pager.IsDone());
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"SCAN", "17", "MATCH", "user:*", "COUNT", "1000"}));
+  pager.NextPage("0", 3);
+  ASSERT_TRUE(pager.IsDone());
+
+  core::redis_compatible::QueryPager hash({"HGETALL", "h"}, 0, 10);
+  ASSERT_EQ(hash.GetItemSize(), 2u);
+  ASSERT_EQ(hash.GetPage(), core::commands_args_t({"HSCAN", "h", "0", "COUNT", "10"}));
+}
+
+TEST(QueryCost, range_pager) {
+  core::redis_compatible::QueryPager pager({"ZRANGE", "z", "0", "-1", "withscores"}, 25, 10);
+  ASSERT_TRUE(pager.IsValid());
+  ASSERT_FALSE(pager.IsScan());
+  ASSERT_EQ(pager.GetItemSize(), 2u);
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"ZRANGE", "z", "0", "9", "WITHSCORES"}));
+  pager.NextPage(std::string(), 10);
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"ZRANGE", "z", "10", "19", "WITHSCORES"}));
+  pager.NextPage(std::string(), 10);
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"ZRANGE", "z", "20", "24", "WITHSCORES"}));
+  pager.NextPage(std::string(), 5);
+  ASSERT_TRUE(pager.IsDone());
+
+  core::redis_compatible::QueryPager shrunk({"LRANGE", "l", "0", "-1"}, 25, 10);
+  shrunk.NextPage(std::string(), 4);
+  ASSERT_TRUE(shrunk.IsDone());
+
+  ASSERT_FALSE(core::redis_compatible::QueryPager({"ZRANGE", "z", "0", "-1", "LIMIT"}, 25, 10).IsValid());
+}
+
+TEST(QueryCost, stream_pager) {
+  core::redis_compatible::QueryPager pager({"XRANGE", "s", "-", "+", "COUNT", "15"}, 100, 10);
+  ASSERT_TRUE(pager.IsValid());
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"XRANGE", "s", "-", "+", "COUNT", "10"}));
+  pager.NextPage("1-9", 10);
+  ASSERT_EQ(pager.GetPage(), core::commands_args_t({"XRANGE", "s", "1-10", "+", "COUNT", "5"}));
+  pager.NextPage("2-0", 5);
+  ASSERT_TRUE(pager.IsDone());
+
+  core::redis_compatible::QueryPager unbounded({"XRANGE", "s", "-", "+"}, 100, 10);
+  unbounded.NextPage("3-3", 7);
+  ASSERT_TRUE(unbounded.IsDone());
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "core/types.h"
+
+using namespace fastonosql;
+
+TEST(ReadableString, text_forms) {
+  core::ReadableString small("key");
+  ASSERT_EQ(small.GetType(), core::ReadableString::TEXT_DATA);
+  ASSERT_EQ(small.GetData(), "key");
+  ASSERT_EQ(small.GetHumanReadable(), "key");
+  ASSERT_EQ(small.GetForCommandLine(), "key");
+
+  core::ReadableString spaced("hello world");
+  ASSERT_EQ(spaced.GetType(), core::ReadableString::TEXT_DATA);
+  ASSERT_EQ(spaced.GetHumanReadable(), "hello world");
+  ASSERT_EQ(spaced.GetForCommandLine(), "\"hello world\"");
+
+  const std::string long_text = "some:long:key:that:does:not:fit:inline";
+  core::ReadableString large(long_text);
+  ASSERT_EQ(large.GetType(), core::ReadableString::TEXT_DATA);
+  ASSERT_EQ(large.GetData(), long_text);
+  ASSERT_EQ(large.GetForCommandLine(), long_text);
+
+  core::ReadableString json("{\"a\": 1}");
+  ASSERT_EQ(json.GetForCommandLine(), "{\"a\": 1}");
+}
+
+TEST(ReadableString, binary_forms) {
+  const std::string bin("\x01\x02", 2);
+  core::ReadableString raw(bin);
+  ASSERT_EQ(raw.GetType(), core::ReadableString::BINARY_DATA);
+  ASSERT_EQ(raw.GetData(), bin);
+  ASSERT_EQ(raw.GetHumanReadable(), core::detail::hex_string(bin));
+  ASSERT_EQ(raw.GetForCommandLine(), "\"" + core::detail::hex_string(bin) + "\"");
+
+  // control byte after the first word
+  const std::string tail = std::string(17, 'a') + '\n';
+  ASSERT_TRUE(core::detail::is_binary_data(tail));
+  ASSERT_FALSE(core::detail::is_binary_data(std::string(17, 'a')));
+  ASSERT_FALSE(core::detail::is_binary_data("\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82"));
+  ASSERT_TRUE(core::detail::is_binary_data(std::string("abcdefg\0", 8)));
+}
+
+TEST(ReadableString, copies_and_equality) {
+  const std::string bin("\x00\x01\x02\x03", 4);
+  core::ReadableString first(bin);
+  core::ReadableString copy = first;
+  ASSERT_EQ(copy.GetHumanReadable(), first.GetHumanReadable());
+  ASSERT_TRUE(first.Equals(copy));
+  ASSERT_TRUE(first.Equals(core::ReadableString(bin)));
+  ASSERT_FALSE(first.Equals(core::ReadableString("\x01\x02")));
+
+  copy.SetData("other");
+  ASSERT_EQ(copy.GetData(), "other");
+  ASSERT_EQ(first.GetData(), bin);
+  ASSERT_FALSE(first.Equals(copy));
+}
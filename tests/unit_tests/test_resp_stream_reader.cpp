@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "core/db/redis_compatible/resp_stream_reader.h"
+
+using namespace fastonosql;
+
+namespace {
+
+class Recorder : public core::redis_compatible::RespStreamReader::IObserver {
+ public:
+  virtual void OnArrayStart(size_t count) override { events.push_back("[" + std::to_string(count)); }
+  virtual void OnArrayEnd() override { events.push_back("]"); }
+  virtual void OnBulkStart(size_t size) override {
+    events.push_back("$" + std::to_string(size));
+    chunks = 0;
+  }
+  virtual void OnBulkChunk(const char* data, size_t size) override {
+    events.back() += ":" + std::string(data, size);
+    chunks++;
+  }
+  virtual void OnBulkEnd() override {}
+  virtual void OnStatus(const char* data, size_t size) override { events.push_back("+" + std::string(data, size)); }
+  virtual void OnError(const char* data, size_t size) override { events.push_back("-" + std::string(data, size)); }
+  virtual void OnInteger(long long value) override { events.push_back(":" + std::to_string(value)); }
+  virtual void OnNil() override { events.push_back("nil"); }
+
+  std::vector<std::string> events;
+  size_t chunks = 0;
+};
+
+typedef core::redis_compatible::RespStreamReader reader_t;
+
+}  // namespace
+
+TEST(RespStreamReader, simple_values) {
+  Recorder rec;
+  reader_t reader(&rec);
+  const std::string status = "+OK\r\n";
+  size_t consumed = 0;
+  ASSERT_EQ(reader.Feed(status.data(), status.size(), &consumed), reader_t::COMPLETE);
+  ASSERT_EQ(consumed, status.size());
+  ASSERT_TRUE(reader.IsComplete());
+
+  reader.Reset();
+  const std::string integer = ":-42\r\n";
+  ASSERT_EQ(reader.Feed(integer.data(), integer.size(), &consumed), reader_t::COMPLETE);
+
+  reader.Reset();
+  const std::string error = "-ERR wrong\r\n";
+  ASSERT_EQ(reader.Feed(error.data(), error.size(), &consumed), reader_t::COMPLETE);
+
+  reader.Reset();
+  const std::string nil = "$-1\r\n";
+  ASSERT_EQ(reader.Feed(nil.data(), nil.size(), &consumed), reader_t::COMPLETE);
+
+  const std::vector<std::string> expected = {"+OK", ":-42", "-ERR wrong", "nil"};
+  ASSERT_EQ(rec.events, expected);
+}
+
+TEST(RespStreamReader, nested_arrays_byte_by_byte) {
+  Recorder rec;
+  reader_t reader(&rec);
+  const std::string reply = "*3\r\n$3\r\nfoo\r\n*2\r\n:1\r\n*0\r\n$0\r\n\r\n";
+  for (size_t i = 0; i < reply.size(); ++i) {
+    size_t consumed = 0;
+    reader_t::Status st = reader.Feed(reply.data() + i, 1, &consumed);
+    ASSERT_EQ(consumed, 1u);
+    ASSERT_EQ(st, i + 1 == reply.size() ? reader_t::COMPLETE : reader_t::NEED_MORE);
+  }
+
+  const std::vector<std::string> expected = {"[3", "$3:f:o:o", "[2", ":1", "[0", "]", "]", "$0", "]"};
+  ASSERT_EQ(rec.events, expected);
+  ASSERT_EQ(reader.GetDeclaredSize(), 3u);
+  ASSERT_EQ(reader.GetReceivedSize(), 3u);
+}
+
+TEST(RespStreamReader, progress_and_rest) {
+  Recorder rec;
+  reader_t reader(&rec);
+  const std::string reply = "*2\r\n$5\r\nhello\r\n$5\r\nworld\r\n+NEXT\r\n";
+  size_t consumed = 0;
+  ASSERT_EQ(reader.Feed(reply.data(), 16, &consumed), reader_t::NEED_MORE);
+  ASSERT_EQ(reader.GetDeclaredSize(), 2u);
+  ASSERT_EQ(reader.GetReceivedSize(), 1u);
+
+  size_t rest = 0;
+  ASSERT_EQ(reader.Feed(reply.data() + 16, reply.size() - 16, &rest), reader_t::COMPLETE);
+  ASSERT_EQ(reply.substr(16 + rest), "+NEXT\r\n");
+  ASSERT_EQ(reader.GetReceivedSize(), 2u);
+}
+
+TEST(RespStreamReader, bulk_in_chunks) {
+  Recorder rec;
+  reader_t reader(&rec);
+  const std::string payload(10000, 'x');
+  const std::string reply = "$10000\r\n" + payload + "\r\n";
+  size_t pos = 0;
+  reader_t::Status st = reader_t::NEED_MORE;
+  while (pos < reply.size()) {
+    size_t consumed = 0;
+    st = reader.Feed(reply.data() + pos, std::min<size_t>(1024, reply.size() - pos), &consumed);
+    if (st == reader_t::NEED_MORE) {
+      ASSERT_EQ(reader.GetDeclaredSize(), payload.size());
+      ASSERT_LE(reader.GetReceivedSize(), payload.size());
+    }
+    pos += consumed;
+  }
+
+  ASSERT_EQ(st, reader_t::COMPLETE);
+  ASSERT_EQ(rec.chunks, 10u);
+  ASSERT_EQ(reader.GetReceivedSize(), payload.size());
+}
+
+TEST(RespStreamReader, protocol_errors) {
+  Recorder rec;
+  reader_t reader(&rec);
+  size_t consumed = 0;
+  const std::string bad_type = "?what\r\n";
+  ASSERT_EQ(reader.Feed(bad_type.data(), bad_type.size(), &consumed), reader_t::PROTOCOL_ERROR);
+  ASSERT_FALSE(reader.GetError().empty());
+
+  reader.Reset();
+  const std::string bad_len = "$abc\r\n";
+  ASSERT_EQ(reader.Feed(bad_len.data(), bad_len.size(), &consumed), reader_t::PROTOCOL_ERROR);
+
+  reader.Reset();
+  const std::string no_crlf = "$3\r\nfooXX";
+  ASSERT_EQ(reader.Feed(no_crlf.data(), no_crlf.size(), &consumed), reader_t::PROTOCOL_ERROR);
+
+  reader.Reset();
+  const std::string overflow = ":99999999999999999999\r\n";
+  ASSERT_EQ(reader.Feed(overflow.data(), overflow.size(), &consumed), reader_t::PROTOCOL_ERROR);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "core/value_encoding.h"
+
+using namespace fastonosql::core;
+
+TEST(ValueEncoding, Text) {
+  ASSERT_EQ(DetectValueEncoding(std::string()), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("hello world"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("{not json at all"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("{\"a\": 1} {"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("{a; b}"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("x^ starts like zlib"), VALUE_ENCODING_TEXT);
+}
+
+TEST(ValueEncoding, Structured) {
+  ASSERT_EQ(DetectValueEncoding(" {\"a\": [1, 2.5e3, true, null], \"b\": \"}{\"}\n"), VALUE_ENCODING_JSON);
+  ASSERT_EQ(DetectValueEncoding("[]"), VALUE_ENCODING_JSON);
+  ASSERT_EQ(DetectValueEncoding("{\"a\": \"b\"]"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding("<root><item id=\"1\"/></root>"), VALUE_ENCODING_XML);
+
+  // sample doesn't cover whole value, only structure of sample is checked
+  std::string big = "[";
+  for (int i = 0; i < 2000; ++i) {
+    big += "{\"k\": \"v\"},";
+  }
+  big += "{}]";
+  ASSERT_EQ(DetectValueEncoding(big), VALUE_ENCODING_JSON);
+}
+
+TEST(ValueEncoding, Compressed) {
+  ASSERT_EQ(DetectValueEncoding(std::string("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\x03", 10)), VALUE_ENCODING_GZIP);
+  ASSERT_EQ(DetectValueEncoding(std::string("\x78\x9c\xcb\x48\xcd\xc9\xc9\x07\x00", 9)), VALUE_ENCODING_GZIP);
+  ASSERT_EQ(DetectValueEncoding(std::string("BZh91AY&SY\x00\x01", 12)), VALUE_ENCODING_BZIP2);
+  ASSERT_EQ(DetectValueEncoding("BZh9 is just text"), VALUE_ENCODING_TEXT);
+  ASSERT_EQ(DetectValueEncoding(std::string("\x04\x22\x4d\x18\x64\x40\xa7", 7)), VALUE_ENCODING_LZ4);
+  ASSERT_EQ(DetectValueEncoding(std::string("\xff\x06\x00\x00sNaPpY", 10)), VALUE_ENCODING_SNAPPY);
+  // raw snappy: length 200, literal of 4 bytes, copy with offset 4
+  ASSERT_EQ(DetectValueEncoding(std::string("\xc8\x01\x0c\x80\x81\x82\x83\xfe\x04\x00", 10)), VALUE_ENCODING_SNAPPY);
+}
+
+TEST(ValueEncoding, MsgPack) {
+  ASSERT_EQ(DetectValueEncoding(std::string("\x81\xa1\x61\x01", 4)), VALUE_ENCODING_MSGPACK);
+  ASSERT_EQ(DetectValueEncoding(std::string("\x92\xcd\x01\x00\xc3", 5)), VALUE_ENCODING_MSGPACK);
+  ASSERT_EQ(DetectValueEncoding(std::string("\x81\xa1\x61\x01\x00", 5)), VALUE_ENCODING_BINARY);  // trailing byte
+  ASSERT_EQ(DetectValueEncoding(std::string("\x81\xa1\x61", 3)), VALUE_ENCODING_BINARY);          // truncated
+  ASSERT_EQ(DetectValueEncoding(std::string("\x91\xc1", 2)), VALUE_ENCODING_BINARY);              // unused type
+}
+
+TEST(ValueEncoding, RandomIsBinary) {
+  std::string data;
+  unsigned int seed = 12345;
+  for (int i = 0; i < 8192; ++i) {
+    seed = seed * 1103515245 + 12345;
+    data += static_cast<char>(seed >> 16);
+  }
+  data[0] = '\x00';  // not a snappy length
+  ASSERT_EQ(DetectValueEncoding(data), VALUE_ENCODING_BINARY);
+  ASSERT_GT(detail::bytes_entropy(reinterpret_cast<const unsigned char*>(data.data()), data.size()), 7.9);
+}
+
+TEST(ValueEncoding, Utf8) {
+  const unsigned char valid[] = {'a', 0xc3, 0xa9, 0xe2, 0x82, 0xac, 0xf0, 0x9f, 0x98, 0x80};
+  ASSERT_TRUE(detail::is_valid_utf8(valid, sizeof(valid), false));
+  ASSERT_FALSE(detail::is_valid_utf8(valid, sizeof(valid) - 1, false));
+  ASSERT_TRUE(detail::is_valid_utf8(valid, sizeof(valid) - 1, true));
+
+  const unsigned char overlong[] = {0xc0, 0xaf};
+  ASSERT_FALSE(detail::is_valid_utf8(overlong, sizeof(overlong), false));
+  const unsigned char surrogate[] = {0xed, 0xa0, 0x80};
+  ASSERT_FALSE(detail::is_valid_utf8(surrogate, sizeof(surrogate), false));
+  const unsigned char bad_continuation[] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 0xc3, 'i'};
+  ASSERT_FALSE(detail::is_valid_utf8(bad_continuation, sizeof(bad_continuation), false));
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "core/value.h"
+
+using namespace fastonosql::core;
+
+TEST(ValuePreview, ShortValuesAreNotChanged) {
+  std::unique_ptr<common::Value> str(common::Value::CreateStringValue("hello"));
+  ASSERT_EQ(ConvertValuePreview(str.get(), ",", 16), ConvertValue(str.get(), ","));
+
+  std::unique_ptr<common::ArrayValue> arr(common::Value::CreateArrayValue());
+  arr->Append(common::Value::CreateStringValue("a"));
+  arr->Append(common::Value::CreateStringValue("b"));
+  ASSERT_EQ(ConvertValuePreview(arr.get(), ",", 16), "a,b");
+  ASSERT_EQ(ConvertValuePreview(arr.get(), ",", 16), ConvertValue(arr.get(), ","));
+}
+
+TEST(ValuePreview, LongStringIsTruncated) {
+  std::unique_ptr<common::Value> str(common::Value::CreateStringValue(std::string(100, 'x')));
+  ASSERT_EQ(ConvertValuePreview(str.get(), ",", 10), std::string(10, 'x') + "\xE2\x80\xA6(90 more bytes)");
+
+  // multibyte character is not split
+  std::unique_ptr<common::Value> utf(common::Value::CreateStringValue("ab\xD0\xAF" "cd"));
+  ASSERT_EQ(ConvertValuePreview(utf.get(), ",", 3), "ab\xE2\x80\xA6(4 more bytes)");
+}
+
+TEST(ValuePreview, BigArrayCountsRestOfElements) {
+  std::unique_ptr<common::ArrayValue> arr(common::Value::CreateArrayValue());
+  for (size_t i = 0; i < 1000; ++i) {
+    arr->Append(common::Value::CreateStringValue("item"));
+  }
+
+  ASSERT_EQ(ConvertValuePreview(arr.get(), ",", 10), "item,item,\xE2\x80\xA6(998 more)");
+}
+
+TEST(ValuePreview, BinaryMarkerIsNotHexed) {
+  std::unique_ptr<common::Value> bin(common::Value::CreateStringValue(std::string(100, '\x01')));
+  ASSERT_EQ(ConvertValuePreview(bin.get(), ",", 8), "\\x01\\x01\xE2\x80\xA6(98 more bytes)");
+}
+
+TEST(ValuePreview, HashPairSharesBudget) {
+  std::unique_ptr<common::HashValue> hash(common::Value::CreateHashValue());
+  hash->Insert(common::Value::CreateStringValue(std::string(20, 'k')), common::Value::CreateStringValue("v"));
+
+  ASSERT_EQ(ConvertValuePreview(hash.get(), ",", 10), std::string(5, 'k') + "\xE2\x80\xA6(15 more bytes) v");
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <common/convert2string.h>
+
+#include "core/workload.h"
+
+using namespace fastonosql;
+
+TEST(Workload, config) {
+  core::WorkloadConfig config;
+  ASSERT_TRUE(config.IsValid());
+  config.proportions[core::WORKLOAD_SCAN] = 0.5;
+  ASSERT_FALSE(config.IsValid());
+  config.proportions[core::WORKLOAD_UPDATE] = 0;
+  ASSERT_TRUE(config.IsValid());
+  config.record_count = 0;
+  ASSERT_FALSE(config.IsValid());
+
+  core::KeyDistribution distribution;
+  ASSERT_TRUE(common::ConvertFromString("uniform", &distribution));
+  ASSERT_EQ(distribution, core::UNIFORM_DISTRIBUTION);
+  ASSERT_FALSE(common::ConvertFromString("latest", &distribution));
+}
+
+TEST(Workload, key_generator) {
+  const uint64_t items = 1000;
+  for (core::KeyDistribution distribution : {core::UNIFORM_DISTRIBUTION, core::ZIPFIAN_DISTRIBUTION}) {
+    core::KeyGenerator keys(distribution, items, 1);
+    std::vector<size_t> hits(items, 0);
+    for (size_t i = 0; i < 100000; ++i) {
+      uint64_t index = keys.Next();
+      ASSERT_LT(index, items);
+      hits[index]++;
+    }
+
+    const size_t hottest = *std::max_element(hits.begin(), hits.end());
+    if (distribution == core::ZIPFIAN_DISTRIBUTION) {
+      ASSERT_GT(hottest, 5000u);  // first rank gets ~13% with theta 0.99 on 1000 items
+    } else {
+      ASSERT_LT(hottest, 500u);
+    }
+  }
+
+  core::KeyGenerator grown(core::ZIPFIAN_DISTRIBUTION, items, 1);
+  bool inserted_hit = false;
+  for (size_t i = 0; i < 100000; ++i) {
+    uint64_t index = grown.Next(items * 2);
+    ASSERT_LT(index, items * 2);
+    inserted_hit |= index >= items;
+  }
+  ASSERT_TRUE(inserted_hit);
+
+  ASSERT_NE(core::MakeWorkloadKey(0), core::MakeWorkloadKey(1));
+  ASSERT_LT(core::MakeWorkloadKey(0), core::MakeWorkloadKeyEnd());
+}
+
+TEST(Workload, latency_histogram) {
+  core::LatencyHistogram first;
+  core::LatencyHistogram second;
+  for (uint64_t i = 1; i <= 50; ++i) {
+    first.Add(i);
+    second.Add(i + 50);
+  }
+  first.Merge(second);
+  ASSERT_EQ(first.GetCount(), 100u);
+  ASSERT_EQ(first.GetMax(), 100u);
+  ASSERT_DOUBLE_EQ(first.GetAverage(), 50.5);
+  ASSERT_EQ(first.GetPercentile(50), 51u);
+  ASSERT_EQ(first.GetPercentile(99), 100u);
+}